@@ -378,11 +378,8 @@ void WriteRpc::ProcessResponseFromTserver(Status status) {
         ql_op->mutable_response()->Swap(resp_.mutable_ql_response_batch(ql_idx));
         const auto& ql_response = ql_op->response();
         if (ql_response.has_rows_data_sidecar()) {
-          Slice rows_data;
-          CHECK_OK(retrier().controller().GetSidecar(
-              ql_response.rows_data_sidecar(), &rows_data));
-          down_cast<YBqlWriteOp*>(yb_op)->mutable_rows_data()->assign(
-              util::to_char_ptr(rows_data.data()), rows_data.size());
+          CHECK_OK(retrier().controller().GetSidecarBuffer(
+              ql_response.rows_data_sidecar(), ql_op->mutable_rows_data()));
         }
         ql_idx++;
         break;
@@ -442,6 +439,14 @@ ReadRpc::ReadRpc(
         // in ProcessResponseFromTserver.
         auto* ql_op = down_cast<YBqlReadOp*>(op->yb_op.get());
         req_.add_ql_batch()->Swap(ql_op->mutable_request());
+        // The batch is served within the tightest staleness bound of its reads.
+        if (yb_consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX &&
+            ql_op->max_staleness()) {
+          const uint32_t max_staleness_ms = ql_op->max_staleness().ToMilliseconds();
+          if (!req_.has_max_staleness_ms() || max_staleness_ms < req_.max_staleness_ms()) {
+            req_.set_max_staleness_ms(max_staleness_ms);
+          }
+        }
         break;
       }
       case YBOperation::Type::INSERT: FALLTHROUGH_INTENDED;
@@ -536,11 +541,8 @@ void ReadRpc::ProcessResponseFromTserver(Status status) {
         ql_op->mutable_response()->Swap(resp_.mutable_ql_batch(ql_idx));
         const auto& ql_response = ql_op->response();
         if (ql_response.has_rows_data_sidecar()) {
-          Slice rows_data;
-          CHECK_OK(retrier().controller().GetSidecar(
-              ql_response.rows_data_sidecar(), &rows_data));
-          down_cast<YBqlReadOp*>(yb_op)->mutable_rows_data()->assign(
-              util::to_char_ptr(rows_data.data()), rows_data.size());
+          CHECK_OK(retrier().controller().GetSidecarBuffer(
+              ql_response.rows_data_sidecar(), ql_op->mutable_rows_data()));
         }
         ql_idx++;
         break;
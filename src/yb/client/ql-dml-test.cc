@@ -32,8 +32,12 @@
 DECLARE_bool(mini_cluster_reuse_data);
 DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(yb_num_shards_per_tserver);
+DECLARE_int32(tserver_read_batch_parallel_threshold);
+DECLARE_int32(read_batch_chunk_delay_ms);
 DECLARE_int64(db_block_cache_size_bytes);
 
+METRIC_DECLARE_counter(concurrent_read_batches);
+
 using namespace std::chrono_literals; // NOLINT
 
 namespace yb {
@@ -1124,5 +1128,49 @@ TEST_F(QLDmlTest, TestError) {
   }
 }
 
+TEST_F(QLDmlTest, ParallelBatchedReads) {
+  FLAGS_tserver_read_batch_parallel_threshold = 4;
+  // Make sure that the chunks of a batch are still being processed when the others start.
+  FLAGS_read_batch_chunk_delay_ms = 100;
+  constexpr int kNumRows = 100;
+
+  {
+    const shared_ptr<YBSession> session(client_->NewSession(false /* read_only */));
+    ASSERT_OK(session->SetFlushMode(YBSession::MANUAL_FLUSH));
+    for (int i = 0; i != kNumRows; ++i) {
+      InsertRow(session, 1, "a", i, "b", i * 2, "c" + std::to_string(i));
+    }
+    ASSERT_OK(FlushSession(session.get()));
+  }
+
+  // All rows share the hash key, so the reads below are sent to the tablet as a single batch.
+  const shared_ptr<YBSession> session(client_->NewSession(true /* read_only */));
+  ASSERT_OK(session->SetFlushMode(YBSession::MANUAL_FLUSH));
+  std::vector<shared_ptr<YBqlReadOp>> ops;
+  for (int i = kNumRows; i-- > 0;) {
+    ops.push_back(SelectRow(session, {"c1", "c2"}, 1, "a", i, "b"));
+  }
+  ASSERT_OK(FlushSession(session.get()));
+
+  for (int i = 0; i != kNumRows; ++i) {
+    const auto& op = ops[i];
+    const int r1 = kNumRows - 1 - i;
+    ASSERT_EQ(QLResponsePB::YQL_STATUS_OK, op->response().status());
+    auto rowblock = RowsResult(op.get()).GetRowBlock();
+    ASSERT_EQ(1, rowblock->row_count());
+    const auto& row = rowblock->row(0);
+    ASSERT_EQ(r1 * 2, row.column(0).int32_value());
+    ASSERT_EQ("c" + std::to_string(r1), row.column(1).string_value());
+  }
+
+  // The chunks of the batch were processed at the same time.
+  int64_t concurrent_read_batches = 0;
+  for (int i = 0; i < cluster_->num_tablet_servers(); ++i) {
+    concurrent_read_batches += METRIC_concurrent_read_batches.Instantiate(
+        cluster_->mini_tablet_server(i)->server()->metric_entity())->value();
+  }
+  ASSERT_GT(concurrent_read_batches, 0);
+}
+
 }  // namespace client
 }  // namespace yb
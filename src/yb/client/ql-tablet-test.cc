@@ -29,6 +29,9 @@
 
 #include "yb/ql/util/statement_result.h"
 
+#include "yb/tablet/tablet_metrics.h"
+#include "yb/tablet/tablet_peer.h"
+
 #include "yb/tserver/mini_tablet_server.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/tserver_service.proxy.h"
@@ -37,6 +40,7 @@ using namespace std::literals; // NOLINT
 
 DECLARE_uint64(initial_seqno);
 DECLARE_int32(leader_lease_duration_ms);
+DECLARE_int32(follower_read_max_wait_ms);
 
 namespace yb {
 namespace client {
@@ -444,5 +448,90 @@ TEST_F(QLTabletTest, LeaderLease) {
   ASSERT_TRUE(status.IsIOError()) << "Status: " << status;
 }
 
+// Sums the tablet metric returned by 'get' over the replicas of 'table' that are leaders, or that
+// are not.
+int64_t SumTabletMetric(
+    MiniCluster* cluster, const TableHandle& table, bool leaders,
+    const std::function<int64_t(const tablet::TabletMetrics&)>& get) {
+  int64_t result = 0;
+  for (int i = 0; i != cluster->num_tablet_servers(); ++i) {
+    std::vector<tablet::TabletPeerPtr> peers;
+    cluster->mini_tablet_server(i)->server()->tablet_manager()->GetTabletPeers(&peers);
+    for (const auto& peer : peers) {
+      if (peer->tablet_metadata()->table_name() != table.name().table_name() || !peer->tablet()) {
+        continue;
+      }
+      const bool is_leader =
+          peer->LeaderStatus() == consensus::Consensus::LeaderStatus::LEADER_AND_READY;
+      if (is_leader == leaders) {
+        result += get(*peer->tablet()->metrics());
+      }
+    }
+  }
+  return result;
+}
+
+int64_t FollowerReads(const tablet::TabletMetrics& metrics) {
+  return metrics.follower_reads->value();
+}
+
+int64_t StaleFollowerReadRejections(const tablet::TabletMetrics& metrics) {
+  return metrics.stale_follower_read_rejections->value();
+}
+
+int64_t QLReads(const tablet::TabletMetrics& metrics) {
+  return metrics.ql_read_latency->TotalCount();
+}
+
+TEST_F(QLTabletTest, BoundedStalenessFollowerReads) {
+  TableHandle table;
+  CreateTable(kTable1Name, &table);
+
+  FillTable(0, kTotalKeys, &table);
+
+  auto session = client_->NewSession(true /* read_only */);
+  auto read_all = [this, &session, &table](MonoDelta max_staleness) {
+    for (int i = 0; i != kTotalKeys; ++i) {
+      auto op = CreateReadOp(i, &table);
+      op->set_yb_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+      op->set_max_staleness(max_staleness);
+      ASSERT_OK(session->Apply(op));
+      ASSERT_EQ(QLResponsePB::YQL_STATUS_OK, op->response().status());
+      auto rowblock = RowsResult(op.get()).GetRowBlock();
+      ASSERT_EQ(1, rowblock->row_count())
+          << "i: " << i << ", max staleness: " << max_staleness.ToString();
+      ASSERT_EQ(ValueForKey(i), rowblock->row(0).column(0).int32_value());
+    }
+  };
+
+  // WaitSync() has already read from every replica, so only look at what changes from here on.
+  const int64_t initial_follower_ql_reads =
+      SumTabletMetric(cluster_.get(), table, false, QLReads);
+  const int64_t initial_leader_ql_reads = SumTabletMetric(cluster_.get(), table, true, QLReads);
+
+  // Followers serve reads within a loose staleness bound, and every read served by a follower is
+  // a bounded staleness one.
+  ASSERT_NO_FATALS(read_all(MonoDelta::FromSeconds(30)));
+  const int64_t follower_reads = SumTabletMetric(cluster_.get(), table, false, FollowerReads);
+  ASSERT_GT(follower_reads, 0);
+  ASSERT_EQ(initial_follower_ql_reads + follower_reads,
+            SumTabletMetric(cluster_.get(), table, false, QLReads));
+  ASSERT_EQ(0, SumTabletMetric(cluster_.get(), table, false, StaleFollowerReadRejections));
+  ASSERT_EQ(0, SumTabletMetric(cluster_.get(), table, true, FollowerReads));
+  const int64_t leader_ql_reads = SumTabletMetric(cluster_.get(), table, true, QLReads);
+  ASSERT_EQ(initial_leader_ql_reads + kTotalKeys - follower_reads, leader_ql_reads);
+
+  // The safe time of a follower is only propagated with Raft requests, so it is always older than
+  // 1ms. Without waiting for it to catch up, the followers must redirect every read to the
+  // leaders, which then serve all of them.
+  FLAGS_follower_read_max_wait_ms = 0;
+  ASSERT_NO_FATALS(read_all(MonoDelta::FromMilliseconds(1)));
+  ASSERT_GT(SumTabletMetric(cluster_.get(), table, false, StaleFollowerReadRejections), 0);
+  ASSERT_EQ(follower_reads, SumTabletMetric(cluster_.get(), table, false, FollowerReads));
+  ASSERT_EQ(initial_follower_ql_reads + follower_reads,
+            SumTabletMetric(cluster_.get(), table, false, QLReads));
+  ASSERT_EQ(leader_ql_reads + kTotalKeys, SumTabletMetric(cluster_.get(), table, true, QLReads));
+}
+
 } // namespace client
 } // namespace yb
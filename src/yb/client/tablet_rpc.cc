@@ -191,6 +191,14 @@ bool TabletInvoker::Done(Status* status) {
     *status = resp_error_status;
   }
 
+  // The follower we read from lags behind the staleness bound of the read, so fall back to the
+  // leader.
+  if (ErrorCode(rpc_->response_error()) == tserver::TabletServerErrorPB::STALE_FOLLOWER) {
+    consistent_prefix_ = false;
+    retrier_->DelayedRetry(command_, *status);
+    return false;
+  }
+
   // Oops, we failed over to a replica that wasn't a LEADER. Unlikely as
   // we're using consensus configuration information from the master, but still possible
   // (e.g. leader restarted and became a FOLLOWER). Try again.
@@ -40,6 +40,9 @@
 
 #include "yb/client/meta_cache.h"
 
+#include "yb/util/monotime.h"
+#include "yb/util/ref_cnt_buffer.h"
+
 namespace yb {
 
 class EncodedKey;
@@ -317,9 +320,11 @@ class YBqlOp : public YBOperation {
 
   QLResponsePB* mutable_response() { return ql_response_.get(); }
 
-  std::string&& rows_data() { return std::move(rows_data_); }
+  // Rows returned by the tablet server, already serialized in the wire format of the request's
+  // client. The buffer is shared with the RPC sidecar it was received in, not copied.
+  const RefCntSlice& rows_data() const { return rows_data_; }
 
-  std::string* mutable_rows_data() { return &rows_data_; }
+  RefCntSlice* mutable_rows_data() { return &rows_data_; }
 
   // Set the hash key in the partial row of this QL operation.
   virtual void SetHashCode(uint16_t hash_code) override = 0;
@@ -327,7 +332,7 @@ class YBqlOp : public YBOperation {
  protected:
   explicit YBqlOp(const std::shared_ptr<YBTable>& table);
   std::unique_ptr<QLResponsePB> ql_response_;
-  std::string rows_data_;
+  RefCntSlice rows_data_;
 };
 
 class YBqlWriteOp : public YBqlOp {
@@ -394,6 +399,12 @@ class YBqlReadOp : public YBqlOp {
     yb_consistency_level_ = yb_consistency_level;
   }
 
+  // Maximum staleness of the data returned when a CONSISTENT_PREFIX read is served by a follower.
+  // A follower lagging further behind redirects the read to the leader. Unbounded if not set.
+  const MonoDelta& max_staleness() const { return max_staleness_; }
+
+  void set_max_staleness(const MonoDelta& max_staleness) { max_staleness_ = max_staleness; }
+
  protected:
   virtual Type type() const override { return QL_READ; }
 
@@ -402,6 +413,7 @@ class YBqlReadOp : public YBqlOp {
   explicit YBqlReadOp(const std::shared_ptr<YBTable>& table);
   std::unique_ptr<QLReadRequestPB> ql_read_request_;
   YBConsistencyLevel yb_consistency_level_;
+  MonoDelta max_staleness_;
 };
 
 
@@ -42,21 +42,25 @@ using strings::Substitute;
 
 IteratorStats::IteratorStats()
     : data_blocks_read_from_disk(0),
+      data_blocks_prefetched(0),
       bytes_read_from_disk(0),
       cells_read_from_disk(0) {
 }
 
 string IteratorStats::ToString() const {
   return Substitute("data_blocks_read_from_disk=$0 "
-                    "bytes_read_from_disk=$1 "
-                    "cells_read_from_disk=$2",
+                    "data_blocks_prefetched=$1 "
+                    "bytes_read_from_disk=$2 "
+                    "cells_read_from_disk=$3",
                     data_blocks_read_from_disk,
+                    data_blocks_prefetched,
                     bytes_read_from_disk,
                     cells_read_from_disk);
 }
 
 void IteratorStats::AddStats(const IteratorStats& other) {
   data_blocks_read_from_disk += other.data_blocks_read_from_disk;
+  data_blocks_prefetched += other.data_blocks_prefetched;
   bytes_read_from_disk += other.bytes_read_from_disk;
   cells_read_from_disk += other.cells_read_from_disk;
   DCheckNonNegative();
@@ -64,6 +68,7 @@ void IteratorStats::AddStats(const IteratorStats& other) {
 
 void IteratorStats::SubtractStats(const IteratorStats& other) {
   data_blocks_read_from_disk -= other.data_blocks_read_from_disk;
+  data_blocks_prefetched -= other.data_blocks_prefetched;
   bytes_read_from_disk -= other.bytes_read_from_disk;
   cells_read_from_disk -= other.cells_read_from_disk;
   DCheckNonNegative();
@@ -71,6 +76,7 @@ void IteratorStats::SubtractStats(const IteratorStats& other) {
 
 void IteratorStats::DCheckNonNegative() const {
   DCHECK_GE(data_blocks_read_from_disk, 0);
+  DCHECK_GE(data_blocks_prefetched, 0);
   DCHECK_GE(bytes_read_from_disk, 0);
   DCHECK_GE(cells_read_from_disk, 0);
 }
@@ -45,6 +45,9 @@ struct IteratorStats {
   // The number of data blocks read from disk (or cache) by the iterator.
   int64_t data_blocks_read_from_disk;
 
+  // The number of data blocks read from disk ahead of the iterator, before it needed them.
+  int64_t data_blocks_prefetched;
+
   // The number of bytes read from disk (or cache) by the iterator.
   int64_t bytes_read_from_disk;
 
@@ -131,7 +131,7 @@ Status QLRowBlock::Deserialize(const QLClient client, Slice* data) {
   return Status::OK();
 }
 
-Status QLRowBlock::GetRowCount(const QLClient client, const std::string& data, size_t* count) {
+Status QLRowBlock::GetRowCount(const QLClient client, const Slice& data, size_t* count) {
   CHECK_EQ(client, YQL_CLIENT_CQL);
   int32_t cnt = 0;
   Slice slice(data);
@@ -141,7 +141,7 @@ Status QLRowBlock::GetRowCount(const QLClient client, const std::string& data, s
 }
 
 Status QLRowBlock::AppendRowsData(
-    const QLClient client, const std::string& src, std::string* dst) {
+    const QLClient client, const Slice& src, std::string* dst) {
   CHECK_EQ(client, YQL_CLIENT_CQL);
   int32_t src_cnt = 0;
   Slice src_slice(src);
@@ -151,7 +151,7 @@ Status QLRowBlock::AppendRowsData(
     Slice dst_slice(*dst);
     RETURN_NOT_OK(CQLDecodeNum(sizeof(dst_cnt), NetworkByteOrder::Load32, &dst_slice, &dst_cnt));
     if (dst_cnt == 0) {
-      *dst = src;
+      *dst = src.ToBuffer();
     } else {
       dst->append(util::to_char_ptr(src_slice.data()), src_slice.size());
       dst_cnt += src_cnt;
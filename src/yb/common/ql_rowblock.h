@@ -112,10 +112,10 @@ class QLRowBlock {
 
   //-------------------------- utility functions for rows data ------------------------------
   // Return row count.
-  static CHECKED_STATUS GetRowCount(QLClient client, const std::string& data, size_t* count);
+  static CHECKED_STATUS GetRowCount(QLClient client, const Slice& data, size_t* count);
 
   // Append rows data. Caller should ensure the column schemas are the same.
-  static CHECKED_STATUS AppendRowsData(QLClient client, const std::string& src, std::string* dst);
+  static CHECKED_STATUS AppendRowsData(QLClient client, const Slice& src, std::string* dst);
 
  private:
   // Schema of the selected columns. (Note: this schema has no key column definitions)
@@ -469,12 +469,20 @@ class TableProperties {
   TableProperties()
       : default_time_to_live_(kNoDefaultTtl),
         contain_counters_(false),
-        is_transactional_(false) {}
+        is_transactional_(false),
+        range_aware_bloom_filter_(false),
+        block_cache_reserved_bytes_(0),
+        block_cache_priority_(NORMAL_BLOCK_CACHE_PRIORITY),
+        compact_doc_key_(false) {}
 
   TableProperties(const TableProperties& other) {
     default_time_to_live_ = other.default_time_to_live_;
     contain_counters_ = other.contain_counters_;
     is_transactional_ = other.is_transactional_;
+    range_aware_bloom_filter_ = other.range_aware_bloom_filter_;
+    block_cache_reserved_bytes_ = other.block_cache_reserved_bytes_;
+    block_cache_priority_ = other.block_cache_priority_;
+    compact_doc_key_ = other.compact_doc_key_;
   }
 
   // Containing counters is a internal property instead of a user-defined property, so we don't use
@@ -515,12 +523,48 @@ class TableProperties {
     is_transactional_ = is_transactional;
   }
 
+  bool range_aware_bloom_filter() const {
+    return range_aware_bloom_filter_;
+  }
+
+  void SetRangeAwareBloomFilter(bool range_aware_bloom_filter) {
+    range_aware_bloom_filter_ = range_aware_bloom_filter;
+  }
+
+  uint64_t block_cache_reserved_bytes() const {
+    return block_cache_reserved_bytes_;
+  }
+
+  void SetBlockCacheReservedBytes(uint64_t block_cache_reserved_bytes) {
+    block_cache_reserved_bytes_ = block_cache_reserved_bytes;
+  }
+
+  BlockCachePriority block_cache_priority() const {
+    return block_cache_priority_;
+  }
+
+  void SetBlockCachePriority(BlockCachePriority block_cache_priority) {
+    block_cache_priority_ = block_cache_priority;
+  }
+
+  bool compact_doc_key() const {
+    return compact_doc_key_;
+  }
+
+  void SetCompactDocKey(bool compact_doc_key) {
+    compact_doc_key_ = compact_doc_key;
+  }
+
   void ToTablePropertiesPB(TablePropertiesPB *pb) const {
     if (HasDefaultTimeToLive()) {
       pb->set_default_time_to_live(default_time_to_live_);
     }
     pb->set_contain_counters(contain_counters_);
     pb->set_is_transactional(is_transactional_);
+    pb->set_range_aware_bloom_filter(range_aware_bloom_filter_);
+    pb->set_block_cache_reserved_bytes(block_cache_reserved_bytes_);
+    pb->set_block_cache_priority(block_cache_priority_);
+    pb->set_compact_doc_key(compact_doc_key_);
   }
 
   static TableProperties FromTablePropertiesPB(const TablePropertiesPB& pb) {
@@ -534,6 +578,18 @@ class TableProperties {
     if (pb.has_is_transactional()) {
       table_properties.SetTransactional(pb.is_transactional());
     }
+    if (pb.has_range_aware_bloom_filter()) {
+      table_properties.SetRangeAwareBloomFilter(pb.range_aware_bloom_filter());
+    }
+    if (pb.has_block_cache_reserved_bytes()) {
+      table_properties.SetBlockCacheReservedBytes(pb.block_cache_reserved_bytes());
+    }
+    if (pb.has_block_cache_priority()) {
+      table_properties.SetBlockCachePriority(pb.block_cache_priority());
+    }
+    if (pb.has_compact_doc_key()) {
+      table_properties.SetCompactDocKey(pb.compact_doc_key());
+    }
     return table_properties;
   }
 
@@ -550,6 +606,10 @@ class TableProperties {
     default_time_to_live_ = kNoDefaultTtl;
     contain_counters_ = false;
     is_transactional_ = false;
+    range_aware_bloom_filter_ = false;
+    block_cache_reserved_bytes_ = 0;
+    block_cache_priority_ = NORMAL_BLOCK_CACHE_PRIORITY;
+    compact_doc_key_ = false;
   }
 
  private:
@@ -557,6 +617,10 @@ class TableProperties {
   int64_t default_time_to_live_;
   bool contain_counters_;
   bool is_transactional_;
+  bool range_aware_bloom_filter_;
+  uint64_t block_cache_reserved_bytes_;
+  BlockCachePriority block_cache_priority_;
+  bool compact_doc_key_;
 };
 
 // The schema for a set of rows.
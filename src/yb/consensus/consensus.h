@@ -32,6 +32,7 @@
 #ifndef YB_CONSENSUS_CONSENSUS_H_
 #define YB_CONSENSUS_CONSENSUS_H_
 
+#include <functional>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -39,6 +40,7 @@
 
 #include <boost/optional/optional_fwd.hpp>
 
+#include "yb/common/hybrid_time.h"
 #include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/ref_counted_replicate.h"
@@ -88,6 +90,14 @@ typedef StatusCallback ConsensusReplicatedCallback;
 typedef scoped_refptr<ConsensusRound> ConsensusRoundPtr;
 typedef std::vector<ConsensusRoundPtr> ConsensusRounds;
 
+// Returns the safe time of the tablet, which the leader propagates to followers.
+typedef std::function<HybridTime()> SafeTimeProvider;
+
+// Invoked on a follower with the safe time propagated by the leader and the committed index up to
+// which operations have to be applied before reading at that safe time.
+typedef std::function<void(int64_t committed_index, HybridTime safe_time)>
+    PropagatedSafeTimeListener;
+
 struct ConsensusOptions {
   std::string tablet_id;
 };
@@ -302,6 +312,14 @@ class Consensus : public RefCountedThreadSafe<Consensus> {
   // Returns the leader status (see LeaderStatus type description for details).
   virtual LeaderStatus leader_status() const = 0;
 
+  // Returns the leader status for serving a read locally at a hybrid time no later than ht.
+  // In addition to the leader_status() checks, the hybrid time lease replicated to a majority must
+  // extend past ht, so that no newer leader could have committed a write at or below it.
+  // If the status is caused by a lease, the corresponding lease status is stored to
+  // leader_lease_status, otherwise it is set to HAS_LEASE.
+  virtual LeaderStatus LeaderStatusForRead(
+      HybridTime ht, LeaderLeaseStatus* leader_lease_status = nullptr) const = 0;
+
   // Returns the uuid of this peer.
   virtual std::string peer_uuid() const = 0;
 
@@ -344,6 +362,11 @@ class Consensus : public RefCountedThreadSafe<Consensus> {
 
   virtual Status CheckIsActiveLeaderAndHasLease() const = 0;
 
+  // Sets up propagation of the tablet safe time from the leader to followers. Must be called
+  // before Start().
+  virtual void SetPropagatedSafeTimeCallbacks(SafeTimeProvider provider,
+                                              PropagatedSafeTimeListener listener) {}
+
  protected:
   friend class RefCountedThreadSafe<Consensus>;
   friend class tablet::TabletPeer;
@@ -493,6 +516,11 @@ class ReplicaOperationFactory {
  public:
   virtual CHECKED_STATUS StartReplicaOperation(const ConsensusRoundPtr& context) = 0;
 
+  // Invoked before and after a batch of committed rounds is notified of replication, so the
+  // factory can group the work done while applying them.
+  virtual void StartApplyingCommittedRounds() {}
+  virtual void FinishApplyingCommittedRounds() {}
+
   virtual ~ReplicaOperationFactory() {}
 };
 
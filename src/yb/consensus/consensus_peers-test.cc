@@ -46,6 +46,8 @@
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
 
+DECLARE_int32(raft_heartbeat_interval_ms);
+
 METRIC_DECLARE_entity(tablet);
 
 namespace yb {
@@ -346,6 +348,62 @@ TEST_F(ConsensusPeersTest, TestDontSendOneRpcPerWriteWhenPeerIsDown) {
   ASSERT_LT(mock_proxy->update_count(), 5);
 }
 
+// Tests that a signal that finds nothing to send does not keep the peer from sending the following
+// requests, heartbeats in particular.
+TEST_F(ConsensusPeersTest, TestHeartbeatAfterEmptyRequest) {
+  // Heartbeats are triggered explicitly by this test.
+  FLAGS_raft_heartbeat_interval_ms = 3600 * 1000;
+
+  message_queue_->Init(MinimumOpId());
+  message_queue_->SetLeaderMode(MinimumOpId(),
+                                MinimumOpId().term(),
+                                BuildRaftConfigPBForTests(3));
+
+  auto mock_proxy = new MockedPeerProxy(pool_.get());
+  std::unique_ptr<Peer> peer;
+  ASSERT_OK(Peer::NewRemotePeer(FakeRaftPeerPB(kFollowerUuid),
+                                kTabletId,
+                                kLeaderUuid,
+                                message_queue_.get(),
+                                pool_.get(),
+                                gscoped_ptr<PeerProxy>(mock_proxy),
+                                nullptr,
+                                &peer));
+
+  ConsensusResponsePB resp;
+  resp.set_responder_uuid(kFollowerUuid);
+  resp.set_responder_term(0);
+  resp.mutable_status()->mutable_last_received()->CopyFrom(MakeOpId(1, 1));
+  resp.mutable_status()->mutable_last_received_current_leader()->CopyFrom(MakeOpId(1, 1));
+  resp.mutable_status()->set_last_committed_idx(0);
+  mock_proxy->set_update_response(resp);
+
+  AppendReplicateMessagesToQueue(message_queue_.get(), clock_, 1, 1);
+  ASSERT_OK(peer->SignalRequest(RequestTriggerMode::ALWAYS_SEND));
+  WaitForMajorityReplicatedIndex(1);
+
+  // Let the peer send the new committed index, until there is nothing left to send.
+  int update_count;
+  do {
+    update_count = mock_proxy->update_count();
+    ASSERT_OK(peer->SignalRequest(RequestTriggerMode::NON_EMPTY_ONLY));
+    pool_->Wait();
+  } while (mock_proxy->update_count() != update_count);
+
+  // This signal finds nothing to send.
+  ASSERT_OK(peer->SignalRequest(RequestTriggerMode::NON_EMPTY_ONLY));
+  pool_->Wait();
+  ASSERT_EQ(update_count, mock_proxy->update_count());
+
+  // The heartbeat should still be sent.
+  ASSERT_OK(peer->SignalRequest(RequestTriggerMode::ALWAYS_SEND));
+  ASSERT_OK(WaitFor([mock_proxy, update_count] {
+    return mock_proxy->update_count() > update_count;
+  }, MonoDelta::FromSeconds(10), "Wait for heartbeat"));
+
+  peer->Close();
+}
+
 }  // namespace consensus
 }  // namespace yb
 
@@ -63,6 +63,12 @@ DEFINE_int32(consensus_rpc_timeout_ms, 2000,
              "Timeout used for all consensus internal RPC communications.");
 TAG_FLAG(consensus_rpc_timeout_ms, advanced);
 
+DEFINE_int32(consensus_max_pipelined_requests_per_peer, 1,
+             "The maximum number of UpdateConsensus requests the leader keeps in flight to a "
+             "single peer. Values above 1 allow new operations to be sent to the peer before "
+             "the previous request is responded to.");
+TAG_FLAG(consensus_max_pipelined_requests_per_peer, advanced);
+
 DECLARE_int32(raft_heartbeat_interval_ms);
 
 DEFINE_test_flag(double, fault_crash_on_leader_request_fraction, 0.0,
@@ -116,16 +122,25 @@ Peer::Peer(
       proxy_(proxy.Pass()),
       queue_(queue),
       failed_attempts_(0),
-      sem_(1),
+      max_requests_in_flight_(std::max(FLAGS_consensus_max_pipelined_requests_per_peer, 1)),
+      sem_(max_requests_in_flight_),
       heartbeater_(
           peer_pb.permanent_uuid(), MonoDelta::FromMilliseconds(FLAGS_raft_heartbeat_interval_ms),
           std::bind(&Peer::SignalRequest, this, RequestTriggerMode::ALWAYS_SEND)),
       thread_pool_(thread_pool),
       state_(kPeerCreated),
-      consensus_(consensus) {}
+      consensus_(consensus) {
+  requests_.reserve(max_requests_in_flight_);
+  for (int i = 0; i != max_requests_in_flight_; ++i) {
+    requests_.emplace_back(new InFlightRequest);
+    free_requests_.push_back(requests_.back().get());
+  }
+}
 
 void Peer::SetTermForTest(int term) {
-  response_.set_responder_term(term);
+  for (auto& request : requests_) {
+    request->response.set_responder_term(term);
+  }
 }
 
 Status Peer::Init() {
@@ -137,144 +152,255 @@ Status Peer::Init() {
 }
 
 Status Peer::SignalRequest(RequestTriggerMode trigger_mode) {
-  // If the peer is currently sending, return Status::OK().
-  // If there are new requests in the queue we'll get them on ProcessResponse().
-  if (!sem_.TryAcquire()) {
-    return Status::OK();
-  }
+  InFlightRequest* request = nullptr;
   {
     std::lock_guard<simple_spinlock> l(peer_lock_);
 
     if (PREDICT_FALSE(state_ == kPeerClosed)) {
-      sem_.Release();
       return STATUS(IllegalState, "Peer was closed.");
     }
 
-    // For the first request sent by the peer, we send it even if the queue is empty, which it will
-    // always appear to be for the first request, since this is the negotiation round.
-    if (PREDICT_FALSE(state_ == kPeerStarted)) {
-      trigger_mode = RequestTriggerMode::ALWAYS_SEND;
-      state_ = kPeerRunning;
-    }
-    DCHECK_EQ(state_, kPeerRunning);
-
-    // If our last request generated an error, and this is not a normal heartbeat request (i.e.
-    // we're not forcing a request even if the queue is empty, unlike we do during heartbeats),
-    // then don't send the "per-RPC" request. Instead, we'll wait for the heartbeat.
-    //
-    // TODO: we could consider looking at the number of consecutive failed attempts, and instead of
-    // ignoring the signal, ask the heartbeater to "expedite" the next heartbeat in order to achieve
-    // something like exponential backoff after an error. As it is implemented today, any transient
-    // error will result in a latency blip as long as the heartbeat period.
-    if (failed_attempts_ > 0 && trigger_mode == RequestTriggerMode::NON_EMPTY_ONLY) {
-      sem_.Release();
+    // If the peer is currently sending, return Status::OK().
+    // If there are new requests in the queue we'll get them on ProcessResponse().
+    if (!StartPreparingUnlocked(&trigger_mode, &request)) {
       return Status::OK();
     }
   }
 
-  auto status = thread_pool_->SubmitClosure(
-      Bind(&Peer::SendNextRequest, Unretained(this), trigger_mode));
+  auto status = thread_pool_->SubmitFunc(
+      std::bind(&Peer::SendNextRequest, this, trigger_mode, request));
   if (!status.ok()) {
-    sem_.Release();
+    FinishRequest(request, false /* sent */, false /* success */);
   }
   return status;
 }
 
-void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
-  DCHECK_LE(sem_.GetValue(), 0) << "Cannot send request";
+bool Peer::StartPreparingUnlocked(RequestTriggerMode* trigger_mode, InFlightRequest** request) {
+  DCHECK(peer_lock_.is_locked());
+
+  if (preparing_request_) {
+    // The request being prepared might have been assembled before the new operations were
+    // appended. If it does not get sent, we will prepare another one.
+    if (!pending_trigger_mode_ || *trigger_mode == RequestTriggerMode::ALWAYS_SEND) {
+      pending_trigger_mode_ = *trigger_mode;
+    }
+    return false;
+  }
 
-  // The peer has no pending request nor is sending: send the request.
-  bool needs_remote_bootstrap = false;
-  bool last_exchange_successful = false;
-  RaftPeerPB::MemberType member_type = RaftPeerPB::UNKNOWN_MEMBER_TYPE;
-  int64_t commit_index_before = request_.has_committed_index() ?
-      request_.committed_index().index() : kMinimumOpIdIndex;
-  Status s = queue_->RequestForPeer(peer_pb_.permanent_uuid(), &request_,
-      &replicate_msg_refs_, &needs_remote_bootstrap, &member_type, &last_exchange_successful);
-  int64_t commit_index_after = request_.has_committed_index() ?
-      request_.committed_index().index() : kMinimumOpIdIndex;
+  if (num_requests_in_flight_ > 0) {
+    // Heartbeats are not needed while requests are in flight, and new operations are pipelined
+    // only behind a successful exchange. Otherwise the responses will trigger the next request.
+    if (*trigger_mode == RequestTriggerMode::ALWAYS_SEND || !pipelining_allowed_ ||
+        free_requests_.empty()) {
+      return false;
+    }
+  }
 
-  if (PREDICT_FALSE(!s.ok())) {
-    LOG_WITH_PREFIX_UNLOCKED(INFO) << "Could not obtain request from queue for peer: "
-        << peer_pb_.permanent_uuid() << ". Status: " << s.ToString();
-    sem_.Release();
-    return;
+  // For the first request sent by the peer, we send it even if the queue is empty, which it will
+  // always appear to be for the first request, since this is the negotiation round.
+  if (PREDICT_FALSE(state_ == kPeerStarted)) {
+    *trigger_mode = RequestTriggerMode::ALWAYS_SEND;
+    state_ = kPeerRunning;
+  }
+  DCHECK_EQ(state_, kPeerRunning);
+
+  // If our last request generated an error, and this is not a normal heartbeat request (i.e.
+  // we're not forcing a request even if the queue is empty, unlike we do during heartbeats),
+  // then don't send the "per-RPC" request. Instead, we'll wait for the heartbeat.
+  //
+  // TODO: we could consider looking at the number of consecutive failed attempts, and instead of
+  // ignoring the signal, ask the heartbeater to "expedite" the next heartbeat in order to achieve
+  // something like exponential backoff after an error. As it is implemented today, any transient
+  // error will result in a latency blip as long as the heartbeat period.
+  if (failed_attempts_ > 0 && *trigger_mode == RequestTriggerMode::NON_EMPTY_ONLY) {
+    return false;
+  }
+
+  if (!sem_.TryAcquire()) {
+    return false;
   }
+  DCHECK(!free_requests_.empty());
+  *request = free_requests_.back();
+  free_requests_.pop_back();
+  preparing_request_ = true;
+  return true;
+}
 
-  if (PREDICT_FALSE(needs_remote_bootstrap)) {
-    Status s = SendRemoteBootstrapRequest();
-    if (!s.ok()) {
-      LOG_WITH_PREFIX_UNLOCKED(WARNING) << "Unable to generate remote bootstrap request for peer: "
-                                        << s.ToString();
-      sem_.Release();
+void Peer::SendNextRequest(RequestTriggerMode trigger_mode, InFlightRequest* request) {
+  while (!DoSendNextRequest(trigger_mode, request)) {
+    {
+      std::lock_guard<simple_spinlock> l(peer_lock_);
+      if (pending_trigger_mode_ && state_ != kPeerClosed) {
+        // We were signaled while preparing the request that was not sent, so try again.
+        trigger_mode = *pending_trigger_mode_;
+        pending_trigger_mode_.reset();
+        continue;
+      }
+      // There is nothing to send. Release the request under the same lock that was used to check
+      // for pending signals, otherwise a signal arriving in between would be dropped.
+      preparing_request_ = false;
+      free_requests_.push_back(request);
     }
+    sem_.Release();
     return;
   }
+}
+
+bool Peer::DoSendNextRequest(RequestTriggerMode trigger_mode, InFlightRequest* request) {
+  DCHECK_LE(sem_.GetValue(), max_requests_in_flight_ - 1) << "Cannot send request";
+
+  bool pipelined;
+  {
+    std::lock_guard<simple_spinlock> l(peer_lock_);
+    pipelined = num_requests_in_flight_ > 0;
+  }
+
+  if (pipelined) {
+    bool has_request = false;
+    Status s = queue_->PipelinedRequestForPeer(
+        peer_pb_.permanent_uuid(), &request->request, &request->msg_refs, &has_request);
+    if (PREDICT_FALSE(!s.ok())) {
+      LOG_WITH_PREFIX_UNLOCKED(INFO) << "Could not obtain pipelined request from queue for peer: "
+          << peer_pb_.permanent_uuid() << ". Status: " << s.ToString();
+    }
+    if (PREDICT_FALSE(!s.ok())) {
+      FinishRequest(request, false /* sent */, false /* success */);
+      return true;
+    }
+    if (!has_request) {
+      // Let SendNextRequest check for a signal that arrived while we were preparing the request,
+      // its operations could have been appended after we looked at the queue.
+      return false;
+    }
+    last_request_committed_index_ = request->request.committed_index().index();
+    // Pipelined requests always carry new operations or a new committed index.
+    heartbeater_.Reset();
+  } else {
+    // The peer has no pending request nor is sending: send the request.
+    bool needs_remote_bootstrap = false;
+    bool last_exchange_successful = false;
+    RaftPeerPB::MemberType member_type = RaftPeerPB::UNKNOWN_MEMBER_TYPE;
+    int64_t commit_index_before = last_request_committed_index_;
+    Status s = queue_->RequestForPeer(peer_pb_.permanent_uuid(), &request->request,
+        &request->msg_refs, &needs_remote_bootstrap, &member_type, &last_exchange_successful);
+    int64_t commit_index_after = request->request.has_committed_index() ?
+        request->request.committed_index().index() : kMinimumOpIdIndex;
+    last_request_committed_index_ = commit_index_after;
+
+    if (PREDICT_FALSE(!s.ok())) {
+      LOG_WITH_PREFIX_UNLOCKED(INFO) << "Could not obtain request from queue for peer: "
+          << peer_pb_.permanent_uuid() << ". Status: " << s.ToString();
+      FinishRequest(request, false /* sent */, false /* success */);
+      return true;
+    }
 
-  // If the peer doesn't need remote bootstrap, but it is a PRE_VOTER or PRE_OBSERVER in the config,
-  // we need to promote it.
-  if (last_exchange_successful &&
-      (member_type == RaftPeerPB::PRE_VOTER || member_type == RaftPeerPB::PRE_OBSERVER)) {
-    if (PREDICT_TRUE(consensus_)) {
-      sem_.Release();
-      consensus::ChangeConfigRequestPB req;
-      consensus::ChangeConfigResponsePB resp;
-
-      req.set_tablet_id(tablet_id_);
-      req.set_type(consensus::CHANGE_ROLE);
-      RaftPeerPB *peer = req.mutable_server();
-      peer->set_permanent_uuid(peer_pb_.permanent_uuid());
-
-      boost::optional<tserver::TabletServerErrorPB::Code> error_code;
-
-      // If another ChangeConfig is being processed, our request will be rejected.
-      LOG(INFO) << "Sending ChangeConfig request";
-      auto status = consensus_->ChangeConfig(req, Bind(&DoNothingStatusCB), &error_code);
-      if (PREDICT_FALSE(!status.ok())) {
-        LOG(WARNING) << "Unable to change role for peer " << peer_pb_.permanent_uuid()
-            << ": " << status.ToString(false);
-        // Since we released the semaphore, we need to call SignalRequest again to send a message
-        status = SignalRequest(RequestTriggerMode::ALWAYS_SEND);
+    if (PREDICT_FALSE(needs_remote_bootstrap)) {
+      Status s = SendRemoteBootstrapRequest(request);
+      if (!s.ok()) {
+        LOG_WITH_PREFIX_UNLOCKED(WARNING)
+            << "Unable to generate remote bootstrap request for peer: " << s.ToString();
+        FinishRequest(request, false /* sent */, false /* success */);
+      }
+      return true;
+    }
+
+    // If the peer doesn't need remote bootstrap, but it is a PRE_VOTER or PRE_OBSERVER in the
+    // config, we need to promote it.
+    if (last_exchange_successful &&
+        (member_type == RaftPeerPB::PRE_VOTER || member_type == RaftPeerPB::PRE_OBSERVER)) {
+      if (PREDICT_TRUE(consensus_)) {
+        FinishRequest(request, false /* sent */, false /* success */);
+        consensus::ChangeConfigRequestPB req;
+        consensus::ChangeConfigResponsePB resp;
+
+        req.set_tablet_id(tablet_id_);
+        req.set_type(consensus::CHANGE_ROLE);
+        RaftPeerPB *peer = req.mutable_server();
+        peer->set_permanent_uuid(peer_pb_.permanent_uuid());
+
+        boost::optional<tserver::TabletServerErrorPB::Code> error_code;
+
+        // If another ChangeConfig is being processed, our request will be rejected.
+        LOG(INFO) << "Sending ChangeConfig request";
+        auto status = consensus_->ChangeConfig(req, Bind(&DoNothingStatusCB), &error_code);
         if (PREDICT_FALSE(!status.ok())) {
-          LOG(WARNING) << "Unexpected error when trying to send request: "
-                       << status.ToString(false);
+          LOG(WARNING) << "Unable to change role for peer " << peer_pb_.permanent_uuid()
+              << ": " << status.ToString(false);
+          // Since we released the semaphore, we need to call SignalRequest again to send a message
+          status = SignalRequest(RequestTriggerMode::ALWAYS_SEND);
+          if (PREDICT_FALSE(!status.ok())) {
+            LOG(WARNING) << "Unexpected error when trying to send request: "
+                         << status.ToString(false);
+          }
         }
+        return true;
       }
-      return;
     }
-  }
 
-  request_.set_tablet_id(tablet_id_);
-  request_.set_caller_uuid(leader_uuid_);
-  request_.set_dest_uuid(peer_pb_.permanent_uuid());
+    const bool req_has_ops =
+        (request->request.ops_size() > 0) || (commit_index_after > commit_index_before);
 
-  const bool req_has_ops = (request_.ops_size() > 0) || (commit_index_after > commit_index_before);
+    // If the queue is empty, check if we were told to send a status-only message (which is what
+    // happens during heartbeats). If not, just return.
+    if (PREDICT_FALSE(!req_has_ops && trigger_mode == RequestTriggerMode::NON_EMPTY_ONLY)) {
+      return false;
+    }
 
-  // If the queue is empty, check if we were told to send a status-only message (which is what
-  // happens during heartbeats). If not, just return.
-  if (PREDICT_FALSE(!req_has_ops && trigger_mode == RequestTriggerMode::NON_EMPTY_ONLY)) {
-    sem_.Release();
-    return;
+    // If we're actually sending ops there's no need to heartbeat for a while, reset the
+    // heartbeater.
+    if (req_has_ops) {
+      heartbeater_.Reset();
+    }
   }
 
-  // If we're actually sending ops there's no need to heartbeat for a while, reset the heartbeater.
-  if (req_has_ops) {
-    heartbeater_.Reset();
-  }
+  request->request.set_tablet_id(tablet_id_);
+  request->request.set_caller_uuid(leader_uuid_);
+  request->request.set_dest_uuid(peer_pb_.permanent_uuid());
 
   MAYBE_FAULT(FLAGS_fault_crash_on_leader_request_fraction);
-  controller_.Reset();
+  request->controller.Reset();
+
+  // Only the requests that are actually sent carry leases that the responses could confirm.
+  queue_->RequestSent(peer_pb_.permanent_uuid(), request->request);
+  RequestSent();
+  proxy_->UpdateAsync(&request->request, &request->response, &request->controller,
+                      std::bind(&Peer::ProcessResponse, this, request));
+  return true;
+}
 
-  proxy_->UpdateAsync(&request_, &response_, &controller_, std::bind(&Peer::ProcessResponse, this));
+void Peer::RequestSent() {
+  std::lock_guard<simple_spinlock> l(peer_lock_);
+  ++num_requests_in_flight_;
+  preparing_request_ = false;
+  // The response to this request will tell whether there is more to send.
+  pending_trigger_mode_.reset();
 }
 
-void Peer::ProcessResponse() {
+void Peer::FinishRequest(InFlightRequest* request, bool sent, bool success) {
+  {
+    std::lock_guard<simple_spinlock> l(peer_lock_);
+    if (sent) {
+      --num_requests_in_flight_;
+      pipelining_allowed_ = success;
+    } else {
+      preparing_request_ = false;
+      pending_trigger_mode_.reset();
+    }
+    free_requests_.push_back(request);
+  }
+  sem_.Release();
+}
+
+void Peer::ProcessResponse(InFlightRequest* request) {
   // Note: This method runs on the reactor thread.
 
-  DCHECK_LE(sem_.GetValue(), 0) << "Got a response when nothing was pending";
+  DCHECK_LE(sem_.GetValue(), max_requests_in_flight_ - 1)
+      << "Got a response when nothing was pending";
 
-  if (!controller_.status().ok()) {
-    if (controller_.status().IsRemoteError()) {
+  const auto& controller = request->controller;
+  const auto& response = request->response;
+  if (!controller.status().ok()) {
+    if (controller.status().IsRemoteError()) {
       // Most controller errors are caused by network issues or corner cases like shutdown and
       // failure to serialize a protobuf. Therefore, we generally consider these errors to indicate
       // an unreachable peer.  However, a RemoteError wraps some other error propagated from the
@@ -282,51 +408,77 @@ void Peer::ProcessResponse() {
       // remote is responsive.
       queue_->NotifyPeerIsResponsiveDespiteError(peer_pb_.permanent_uuid());
     }
-    ProcessResponseError(controller_.status());
+    ProcessResponseError(request, controller.status());
     return;
   }
 
   // Pass through errors we can respond to, like not found, since in that case
   // we will need to remotely bootstrap. TODO: Handle DELETED response once implemented.
-  if ((response_.has_error() &&
-      response_.error().code() != tserver::TabletServerErrorPB::TABLET_NOT_FOUND) ||
-      (response_.status().has_error() &&
-          response_.status().error().code() == consensus::ConsensusErrorPB::CANNOT_PREPARE)) {
+  if ((response.has_error() &&
+      response.error().code() != tserver::TabletServerErrorPB::TABLET_NOT_FOUND) ||
+      (response.status().has_error() &&
+          response.status().error().code() == consensus::ConsensusErrorPB::CANNOT_PREPARE)) {
     // Again, let the queue know that the remote is still responsive, since we will not be sending
     // this error response through to the queue.
     queue_->NotifyPeerIsResponsiveDespiteError(peer_pb_.permanent_uuid());
-    ProcessResponseError(StatusFromPB(response_.error().status()));
+    ProcessResponseError(request, StatusFromPB(response.error().status()));
     return;
   }
 
   // The queue's handling of the peer response may generate IO (reads against the WAL) and
   // SendNextRequest() may do the same thing. So we run the rest of the response handling logic on
   // our thread pool and not on the reactor thread.
-  Status s = thread_pool_->SubmitClosure(Bind(&Peer::DoProcessResponse, Unretained(this)));
+  Status s = thread_pool_->SubmitFunc(std::bind(&Peer::DoProcessResponse, this, request));
   if (PREDICT_FALSE(!s.ok())) {
     LOG_WITH_PREFIX_UNLOCKED(WARNING) << "Unable to process peer response: " << s.ToString()
-        << ": " << response_.ShortDebugString();
-    sem_.Release();
+        << ": " << response.ShortDebugString();
+    FinishRequest(request, true /* sent */, false /* success */);
   }
 }
 
-void Peer::DoProcessResponse() {
+void Peer::DoProcessResponse(InFlightRequest* request) {
   failed_attempts_ = 0;
 
   bool more_pending;
-  queue_->ResponseFromPeer(peer_pb_.permanent_uuid(), response_, &more_pending);
+  queue_->ResponseFromPeer(peer_pb_.permanent_uuid(), request->response, &more_pending);
+  const bool success = !request->response.has_error() && !request->response.status().has_error();
 
-  // We're OK to read the state_ without a lock here -- if we get a race,
-  // the worst thing that could happen is that we'll make one more request before
-  // noticing a close.
-  if (more_pending && ANNOTATE_UNPROTECTED_READ(state_) != kPeerClosed) {
-    SendNextRequest(RequestTriggerMode::ALWAYS_SEND);
+  bool send_next = false;
+  auto trigger_mode = RequestTriggerMode::ALWAYS_SEND;
+  {
+    std::lock_guard<simple_spinlock> l(peer_lock_);
+    --num_requests_in_flight_;
+    pipelining_allowed_ = success;
+    if (num_requests_in_flight_ > 0) {
+      // Only new operations could be pipelined behind the requests that are still in flight.
+      trigger_mode = RequestTriggerMode::NON_EMPTY_ONLY;
+    }
+    // We're OK to send the next request if it's not going to be pipelined behind a failed one.
+    if (more_pending && state_ != kPeerClosed &&
+        (num_requests_in_flight_ == 0 || pipelining_allowed_)) {
+      if (preparing_request_) {
+        if (!pending_trigger_mode_ || trigger_mode == RequestTriggerMode::ALWAYS_SEND) {
+          pending_trigger_mode_ = trigger_mode;
+        }
+      } else {
+        // Reuse the slot of this request for the next one.
+        preparing_request_ = true;
+        send_next = true;
+      }
+    }
+    if (!send_next) {
+      free_requests_.push_back(request);
+    }
+  }
+
+  if (send_next) {
+    SendNextRequest(trigger_mode, request);
   } else {
     sem_.Release();
   }
 }
 
-Status Peer::SendRemoteBootstrapRequest() {
+Status Peer::SendRemoteBootstrapRequest(InFlightRequest* request) {
   if (!FLAGS_enable_remote_bootstrap) {
     failed_attempts_++;
     return STATUS(NotSupported, "remote bootstrap is disabled");
@@ -334,29 +486,30 @@ Status Peer::SendRemoteBootstrapRequest() {
 
   LOG_WITH_PREFIX_UNLOCKED(INFO) << "Sending request to remotely bootstrap";
   RETURN_NOT_OK(queue_->GetRemoteBootstrapRequestForPeer(peer_pb_.permanent_uuid(), &rb_request_));
-  controller_.Reset();
+  request->controller.Reset();
+  RequestSent();
   proxy_->StartRemoteBootstrap(
-      &rb_request_, &rb_response_, &controller_,
-      std::bind(&Peer::ProcessRemoteBootstrapResponse, this));
+      &rb_request_, &rb_response_, &request->controller,
+      std::bind(&Peer::ProcessRemoteBootstrapResponse, this, request));
   return Status::OK();
 }
 
-void Peer::ProcessRemoteBootstrapResponse() {
+void Peer::ProcessRemoteBootstrapResponse(InFlightRequest* request) {
   // We treat remote bootstrap as fire-and-forget.
   if (rb_response_.has_error()) {
     LOG_WITH_PREFIX_UNLOCKED(WARNING) << "Unable to begin remote bootstrap on peer: "
                                       << rb_response_.ShortDebugString();
   }
-  sem_.Release();
+  FinishRequest(request, true /* sent */, false /* success */);
 }
 
-void Peer::ProcessResponseError(const Status& status) {
+void Peer::ProcessResponseError(InFlightRequest* request, const Status& status) {
   failed_attempts_++;
   LOG_WITH_PREFIX_UNLOCKED(WARNING) << "Couldn't send request to peer " << peer_pb_.permanent_uuid()
       << " for tablet " << tablet_id_
       << " Status: " << status.ToString() << ". Retrying in the next heartbeat period."
       << " Already tried " << failed_attempts_ << " times.";
-  sem_.Release();
+  FinishRequest(request, true /* sent */, false /* success */);
 }
 
 string Peer::LogPrefixUnlocked() const {
@@ -377,14 +530,21 @@ void Peer::Close() {
   }
   LOG_WITH_PREFIX_UNLOCKED(INFO) << "Closing peer: " << peer_pb_.permanent_uuid();
 
-  // Acquire the semaphore to wait for any concurrent request to finish.  They will see the state_
-  // == kPeerClosed and not start any new requests, but we can't currently cancel the already-sent
-  // ones. (see KUDU-699)
-  std::lock_guard<Semaphore> l(sem_);
+  // Acquire all the slots of the semaphore to wait for any concurrent requests to finish.  They
+  // will see the state_ == kPeerClosed and not start any new requests, but we can't currently
+  // cancel the already-sent ones. (see KUDU-699)
+  for (int i = 0; i != max_requests_in_flight_; ++i) {
+    sem_.Acquire();
+  }
   queue_->UntrackPeer(peer_pb_.permanent_uuid());
-  // We don't own the ops (the queue does).
-  request_.mutable_ops()->ExtractSubrange(0, request_.ops_size(), nullptr);
-  replicate_msg_refs_.clear();
+  for (auto& request : requests_) {
+    // We don't own the ops (the queue does).
+    request->request.mutable_ops()->ExtractSubrange(0, request->request.ops_size(), nullptr);
+    request->msg_refs.clear();
+  }
+  for (int i = 0; i != max_requests_in_flight_; ++i) {
+    sem_.Release();
+  }
 }
 
 Peer::~Peer() {
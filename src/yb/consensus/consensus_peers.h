@@ -37,6 +37,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/optional/optional.hpp>
+
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/metadata.pb.h"
@@ -116,6 +118,11 @@ class VoteResponsePB;
 //        v                               v
 //  SignalRequest()                    return
 //
+// Requests may also be pipelined: after a successful exchange, up to
+// FLAGS_consensus_max_pipelined_requests_per_peer requests could be in flight to the peer, each
+// carrying the operations following the ones sent in the previous request. If any request fails,
+// no more requests are pipelined until all the requests in flight are responded to, and sending
+// resumes from the last operation acked by the peer.
 class Peer {
  public:
   // Initializes a peer and get its status.
@@ -153,32 +160,62 @@ class Peer {
       std::unique_ptr<Peer>* peer);
 
  private:
+  // A consensus update request sent to the peer, along with its response.
+  struct InFlightRequest {
+    ConsensusRequestPB request;
+    ConsensusResponsePB response;
+
+    // Reference-counted pointers to any ReplicateMsgs which are in-flight to the peer. We may have
+    // loaded these messages from the LogCache, in which case we are potentially sharing the same
+    // object as other peers. Since the PB request itself can't hold reference counts, this holds
+    // them.
+    ReplicateMsgs msg_refs;
+
+    rpc::RpcController controller;
+  };
+
   Peer(const RaftPeerPB& peer, std::string tablet_id, std::string leader_uuid,
        gscoped_ptr<PeerProxy> proxy, PeerMessageQueue* queue,
        ThreadPool* thread_pool, Consensus* consensus);
 
-  void SendNextRequest(RequestTriggerMode trigger_mode);
+  // Checks whether a new request should be prepared, and if so, reserves 'request' for it.
+  // Could change trigger_mode for the first request to the peer.
+  bool StartPreparingUnlocked(RequestTriggerMode* trigger_mode, InFlightRequest** request);
+
+  // Prepares and sends the next request using 'request', which was reserved by
+  // StartPreparingUnlocked() or whose response was just processed.
+  void SendNextRequest(RequestTriggerMode trigger_mode, InFlightRequest* request);
+
+  // Prepares the next request and sends it. Returns false if it was not sent, in which case
+  // 'request' is still reserved.
+  bool DoSendNextRequest(RequestTriggerMode trigger_mode, InFlightRequest* request);
+
+  // Marks the request being prepared as sent.
+  void RequestSent();
+
+  // Returns 'request' that was not sent or got its response, and releases its slot in sem_.
+  void FinishRequest(InFlightRequest* request, bool sent, bool success);
 
   // Signals that a response was received from the peer.  This method is called from the reactor
   // thread and calls DoProcessResponse() on thread_pool_ to do any work that requires IO or
   // lock-taking.
-  void ProcessResponse();
+  void ProcessResponse(InFlightRequest* request);
 
   // Run on 'thread_pool'. Does response handling that requires IO or may block.
-  void DoProcessResponse();
+  void DoProcessResponse(InFlightRequest* request);
 
   // Fetch the desired remote bootstrap request from the queue and send it to the peer. The callback
   // goes to ProcessRemoteBootstrapResponse().
   //
   // Returns a bad Status if remote bootstrap is disabled, or if the request cannot be generated for
   // some reason.
-  CHECKED_STATUS SendRemoteBootstrapRequest();
+  CHECKED_STATUS SendRemoteBootstrapRequest(InFlightRequest* request);
 
   // Handle RPC callback from initiating remote bootstrap.
-  void ProcessRemoteBootstrapResponse();
+  void ProcessRemoteBootstrapResponse(InFlightRequest* request);
 
   // Signals there was an error sending the request to the peer.
-  void ProcessResponseError(const Status& status);
+  void ProcessResponseError(InFlightRequest* request, const Status& status);
 
   std::string LogPrefixUnlocked() const;
 
@@ -194,24 +231,22 @@ class Peer {
   PeerMessageQueue* queue_;
   uint64_t failed_attempts_;
 
-  // The latest consensus update request and response.
-  ConsensusRequestPB request_;
-  ConsensusResponsePB response_;
+  // The maximum number of requests in flight to the peer.
+  const int max_requests_in_flight_;
+
+  // The requests to the peer, max_requests_in_flight_ of them.
+  std::vector<std::unique_ptr<InFlightRequest>> requests_;
+
+  // The committed index sent in the last request prepared by SendNextRequest().
+  int64_t last_request_committed_index_ = kMinimumOpIdIndex;
 
   // The latest remote bootstrap request and response.
   StartRemoteBootstrapRequestPB rb_request_;
   StartRemoteBootstrapResponsePB rb_response_;
 
-  // Reference-counted pointers to any ReplicateMsgs which are in-flight to the peer. We may have
-  // loaded these messages from the LogCache, in which case we are potentially sharing the same
-  // object as other peers. Since the PB request_ itself can't hold reference counts, this holds
-  // them.
-  ReplicateMsgs replicate_msg_refs_;
-
-  rpc::RpcController controller_;
-
-  // Held if there is an outstanding request.  This is used in order to ensure that we only have a
-  // single request oustanding at a time, and to wait for the outstanding requests at Close().
+  // A slot is held for each request that is being prepared or is outstanding. This is used in
+  // order to limit the number of requests outstanding at a time, and to wait for the outstanding
+  // requests at Close().
   Semaphore sem_;
 
   // Heartbeater for remote peer implementations.  This will send status only requests to the remote
@@ -233,6 +268,24 @@ class Peer {
   mutable simple_spinlock peer_lock_;
   State state_;
   Consensus* consensus_ = nullptr;
+
+  // The requests that are neither being prepared nor outstanding. Protected by peer_lock_.
+  std::vector<InFlightRequest*> free_requests_;
+
+  // The number of requests sent and not responded to yet. Protected by peer_lock_.
+  int num_requests_in_flight_ = 0;
+
+  // Whether a request is being prepared. Only one request is prepared at a time, so that each
+  // pipelined request follows the previous one. Protected by peer_lock_.
+  bool preparing_request_ = false;
+
+  // Set if the peer was signaled while a request was being prepared. If that request ends up not
+  // being sent, the next one is prepared right away. Protected by peer_lock_.
+  boost::optional<RequestTriggerMode> pending_trigger_mode_;
+
+  // Whether the last exchange with the peer was successful, so the next requests could be
+  // pipelined. Protected by peer_lock_.
+  bool pipelining_allowed_ = false;
 };
 
 // A proxy to another peer. Usually a thin wrapper around an rpc proxy but can be replaced for
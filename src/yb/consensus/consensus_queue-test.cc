@@ -255,6 +255,76 @@ TEST_F(ConsensusQueueTest, TestStartTrackingAfterStart) {
   request.mutable_ops()->ExtractSubrange(0, request.ops_size(), nullptr);
 }
 
+// Tests that new operations are pipelined to the peer only behind a successful exchange, and that
+// a response to an earlier pipelined request arriving after a later one does not move the peer's
+// watermark backward.
+TEST_F(ConsensusQueueTest, TestPipelinedRequests) {
+  queue_->Init(MinimumOpId());
+  queue_->SetLeaderMode(MinimumOpId(), MinimumOpId().term(), BuildRaftConfigPBForTests(2));
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, 100);
+
+  ConsensusRequestPB request;
+  ConsensusResponsePB response;
+  response.set_responder_uuid(kPeerUuid);
+  bool more_pending = false;
+
+  UpdatePeerWatermarkToOp(&request, &response, MakeOpId(7, 50), MinimumOpId(), &more_pending);
+  ASSERT_TRUE(more_pending);
+
+  ReplicateMsgs refs;
+  bool needs_remote_bootstrap;
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(50, request.ops_size());
+  queue_->RequestSent(kPeerUuid, request);
+
+  // The last exchange was an LMP mismatch, so nothing could be pipelined yet.
+  ConsensusRequestPB pipelined_request;
+  ReplicateMsgs pipelined_refs;
+  bool has_request = true;
+  ASSERT_OK(queue_->PipelinedRequestForPeer(
+      kPeerUuid, &pipelined_request, &pipelined_refs, &has_request));
+  ASSERT_FALSE(has_request);
+
+  SetLastReceivedAndLastCommitted(&response, request.ops(49).id());
+  queue_->ResponseFromPeer(response.responder_uuid(), response, &more_pending);
+  ASSERT_FALSE(more_pending);
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 101, 10);
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(10, request.ops_size());
+  ASSERT_EQ(101, request.ops(0).id().index());
+  queue_->RequestSent(kPeerUuid, request);
+
+  // Operations appended after the request was sent are pipelined behind it.
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 111, 10);
+  ASSERT_OK(queue_->PipelinedRequestForPeer(
+      kPeerUuid, &pipelined_request, &pipelined_refs, &has_request));
+  ASSERT_TRUE(has_request);
+  ASSERT_EQ(10, pipelined_request.ops_size());
+  ASSERT_EQ(111, pipelined_request.ops(0).id().index());
+  queue_->RequestSent(kPeerUuid, pipelined_request);
+  ASSERT_OK(queue_->PipelinedRequestForPeer(
+      kPeerUuid, &pipelined_request, &pipelined_refs, &has_request));
+  ASSERT_FALSE(has_request);
+
+  // The response to the pipelined request arrives first.
+  SetLastReceivedAndLastCommitted(&response, MakeOpId(120 / 7, 120));
+  queue_->ResponseFromPeer(response.responder_uuid(), response, &more_pending);
+  ASSERT_FALSE(more_pending);
+
+  // The late response to the first request should not make the queue resend operations.
+  SetLastReceivedAndLastCommitted(&response, MakeOpId(110 / 7, 110));
+  queue_->ResponseFromPeer(response.responder_uuid(), response, &more_pending);
+  ASSERT_FALSE(more_pending);
+
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(0, request.ops_size());
+
+  // extract the ops from the requests to avoid double free
+  request.mutable_ops()->ExtractSubrange(0, request.ops_size(), nullptr);
+  pipelined_request.mutable_ops()->ExtractSubrange(0, pipelined_request.ops_size(), nullptr);
+}
+
 // Tests that the peers gets the messages pages, with the size of a page
 // being 'consensus_max_batch_size_bytes'
 TEST_F(ConsensusQueueTest, TestGetPagedMessages) {
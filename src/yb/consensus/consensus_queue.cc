@@ -39,6 +39,7 @@
 #include <utility>
 
 #include <boost/container/small_vector.hpp>
+#include <boost/optional.hpp>
 
 #include <gflags/gflags.h>
 
@@ -111,6 +112,11 @@ METRIC_DEFINE_gauge_int64(tablet, in_progress_ops, "Leader Operations in Progres
                           MetricUnit::kOperations,
                           "Number of operations in the leader queue ack'd by a minority of "
                           "peers.");
+METRIC_DEFINE_histogram(tablet, requests_in_flight_per_peer,
+                        "Leader Requests in Flight per Peer",
+                        MetricUnit::kRequests,
+                        "Number of UpdateConsensus requests in flight to a peer, including the one "
+                        "being sent, i.e. the occupancy of the pipelining window.", 64, 2);
 
 std::string PeerMessageQueue::TrackedPeer::ToString() const {
   return Substitute("Peer: $0, Is new: $1, Last received: $2, Next index: $3, "
@@ -126,7 +132,9 @@ std::string PeerMessageQueue::TrackedPeer::ToString() const {
   x.Instantiate(metric_entity, 0)
 PeerMessageQueue::Metrics::Metrics(const scoped_refptr<MetricEntity>& metric_entity)
   : num_majority_done_ops(INSTANTIATE_METRIC(METRIC_majority_done_ops)),
-    num_in_progress_ops(INSTANTIATE_METRIC(METRIC_in_progress_ops)) {
+    num_in_progress_ops(INSTANTIATE_METRIC(METRIC_in_progress_ops)),
+    requests_in_flight_per_peer(
+        METRIC_requests_in_flight_per_peer.Instantiate(metric_entity)) {
 }
 #undef INSTANTIATE_METRIC
 
@@ -134,10 +142,12 @@ PeerMessageQueue::PeerMessageQueue(const scoped_refptr<MetricEntity>& metric_ent
                                    const scoped_refptr<log::Log>& log,
                                    const RaftPeerPB& local_peer_pb,
                                    const string& tablet_id,
-                                   const server::ClockPtr& clock)
+                                   const server::ClockPtr& clock,
+                                   ThreadPool* log_cache_read_ahead_pool)
     : local_peer_pb_(local_peer_pb),
       tablet_id_(tablet_id),
-      log_cache_(metric_entity, log, local_peer_pb.permanent_uuid(), tablet_id),
+      log_cache_(metric_entity, log, local_peer_pb.permanent_uuid(), tablet_id,
+                 log_cache_read_ahead_pool),
       metrics_(metric_entity),
       clock_(clock) {
   DCHECK(local_peer_pb_.has_permanent_uuid());
@@ -305,9 +315,51 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
                                         bool* needs_remote_bootstrap,
                                         RaftPeerPB::MemberType* member_type,
                                         bool* last_exchange_successful) {
+  return DoRequestForPeer(uuid, false /* pipelined */, request, msg_refs, needs_remote_bootstrap,
+                          member_type, last_exchange_successful, nullptr /* has_request */);
+}
+
+Status PeerMessageQueue::PipelinedRequestForPeer(const string& uuid,
+                                                 ConsensusRequestPB* request,
+                                                 ReplicateMsgs* msg_refs,
+                                                 bool* has_request) {
+  bool needs_remote_bootstrap = false;
+  return DoRequestForPeer(uuid, true /* pipelined */, request, msg_refs, &needs_remote_bootstrap,
+                          nullptr /* member_type */, nullptr /* last_exchange_successful */,
+                          has_request);
+}
+
+void PeerMessageQueue::RequestSent(const string& uuid, const ConsensusRequestPB& request) {
+  LockGuard lock(queue_lock_);
+  TrackedPeer* peer = FindPtrOrNull(peers_map_, uuid);
+  if (PREDICT_FALSE(peer == nullptr)) {
+    return;
+  }
+
+  // The follower starts its lease when it receives the request, so the lease computed from the time
+  // of sending it never expires later than the follower's one.
+  peer->leases_in_flight.push_back(SentLeases{
+      MonoTime::FineNow() + MonoDelta::FromMilliseconds(request.leader_lease_duration_ms()),
+      request.ht_lease_expiration()});
+  metrics_.requests_in_flight_per_peer->Increment(peer->leases_in_flight.size());
+}
+
+Status PeerMessageQueue::DoRequestForPeer(const string& uuid,
+                                          bool pipelined,
+                                          ConsensusRequestPB* request,
+                                          ReplicateMsgs* msg_refs,
+                                          bool* needs_remote_bootstrap,
+                                          RaftPeerPB::MemberType* member_type,
+                                          bool* last_exchange_successful,
+                                          bool* has_request) {
   TrackedPeer* peer = nullptr;
   OpId preceding_id;
+  int64_t next_index = kInvalidOpIdIndex;
   MonoDelta unreachable_time = MonoDelta::kMin;
+  // The safe time has to be read before the committed index, so that every operation at or below
+  // it is known to be committed at the index sent to the peer.
+  const HybridTime safe_time =
+      safe_time_provider_ ? safe_time_provider_() : HybridTime::kInvalidHybridTime;
   {
     LockGuard lock(queue_lock_);
     DCHECK_EQ(queue_state_.state, State::kQueueOpen);
@@ -318,13 +370,37 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
       return STATUS(NotFound, "Peer not tracked or queue not in leader mode.");
     }
 
+    if (pipelined) {
+      *has_request = false;
+      // Pipeline only behind successful exchanges, otherwise we have to wait for the responses to
+      // find out where to resume from.
+      if (peer->is_new || peer->needs_remote_bootstrap || !peer->is_last_exchange_successful ||
+          peer->pipelined_next_index == kInvalidOpIdIndex) {
+        return Status::OK();
+      }
+      next_index = std::max(peer->next_index, peer->pipelined_next_index);
+      if (!log_cache_.HasOpBeenWritten(next_index) &&
+          queue_state_.committed_index.index() <= peer->last_sent_committed_idx) {
+        return Status::OK();
+      }
+      *has_request = true;
+    } else {
+      // Nothing is in flight to the peer, so the leases left by the requests that failed could be
+      // dropped.
+      peer->leases_in_flight.clear();
+      next_index = peer->next_index;
+    }
+
     auto ht_lease_expiration_micros = clock_->Now().GetPhysicalValueMicros() +
                                       FLAGS_ht_lease_duration_ms * 1000;
     request->set_leader_lease_duration_ms(FLAGS_leader_lease_duration_ms);
     request->set_ht_lease_expiration(ht_lease_expiration_micros);
-    peer->last_leader_lease_expiration_sent_to_follower =
-        MonoTime::FineNow() + MonoDelta::FromMilliseconds(FLAGS_leader_lease_duration_ms);
-    peer->last_ht_lease_expiration_sent_to_follower = ht_lease_expiration_micros;
+    peer->last_sent_committed_idx = queue_state_.committed_index.index();
+    if (safe_time.is_valid()) {
+      request->set_propagated_safe_time(safe_time.ToUint64());
+    } else {
+      request->clear_propagated_safe_time();
+    }
 
     // Clear the requests without deleting the entries, as they may be in use by other peers.
     request->mutable_ops()->ExtractSubrange(0, request->ops_size(), nullptr);
@@ -353,7 +429,7 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
 
   if (member_type) *member_type = peer->member_type;
   if (last_exchange_successful) *last_exchange_successful = peer->is_last_exchange_successful;
-  if (PREDICT_FALSE(peer->needs_remote_bootstrap)) {
+  if (PREDICT_FALSE(!pipelined && peer->needs_remote_bootstrap)) {
     LOG_WITH_PREFIX_UNLOCKED(INFO) << "Peer needs remote bootstrap: " << peer->ToString();
     *needs_remote_bootstrap = true;
     return Status::OK();
@@ -370,7 +446,7 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     int max_batch_size = FLAGS_consensus_max_batch_size_bytes - request->ByteSize();
 
     // We try to get the follower's next_index from our log.
-    Status s = log_cache_.ReadOps(peer->next_index - 1,
+    Status s = log_cache_.ReadOps(next_index - 1,
                                   max_batch_size,
                                   &messages,
                                   &preceding_id);
@@ -407,6 +483,10 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     }
     msg_refs->swap(messages);
     DCHECK_LE(request->ByteSize(), FLAGS_consensus_max_batch_size_bytes);
+
+    LockGuard lock(queue_lock_);
+    peer->pipelined_next_index =
+        msg_refs->empty() ? next_index : msg_refs->back()->id().index() + 1;
   }
 
   DCHECK(preceding_id.IsInitialized());
@@ -631,6 +711,16 @@ void PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
       return;
     }
 
+    // The lease sent in the request this response is for, see TrackedPeer::leases_in_flight.
+    // Whether other requests are still in flight tells if the operations up to pipelined_next_index
+    // are already on the way to the peer.
+    boost::optional<SentLeases> sent_leases;
+    if (!peer->leases_in_flight.empty()) {
+      sent_leases = peer->leases_in_flight.front();
+      peer->leases_in_flight.pop_front();
+    }
+    const bool other_requests_in_flight = !peer->leases_in_flight.empty();
+
     // Remotely bootstrap the peer if the tablet is not found or deleted.
     if (response.has_error()) {
       // We only let special types of errors through to this point from the peer.
@@ -688,7 +778,15 @@ void PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
     // is guaranteed by the Raft protocol to be a valid op.
 
     bool peer_has_prefix_of_log = IsOpInLog(status.last_received());
-    if (peer_has_prefix_of_log) {
+    if (peer_has_prefix_of_log && !status.has_error() && !previous.is_new &&
+        previous.is_last_exchange_successful &&
+        status.last_received().index() < previous.last_received.index()) {
+      // This is a response that arrived after the response to a later pipelined request, the peer
+      // already acked more operations.
+      VLOG_WITH_PREFIX_UNLOCKED(2) << "Ignoring reordered response from peer: "
+                                   << response.ShortDebugString();
+
+    } else if (peer_has_prefix_of_log) {
       // If the latest thing in their log is in our log, we are in sync.
       peer->last_received = status.last_received();
       peer->next_index = peer->last_received.index() + 1;
@@ -713,6 +811,8 @@ void PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
 
     if (PREDICT_FALSE(status.has_error())) {
       peer->is_last_exchange_successful = false;
+      // Requests in flight are no longer useful, resume sending from next_index.
+      peer->pipelined_next_index = kInvalidOpIdIndex;
       switch (status.error().code()) {
         case ConsensusErrorPB::PRECEDING_ENTRY_DIDNT_MATCH: {
           DCHECK(status.has_last_received());
@@ -760,8 +860,11 @@ void PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
     }
 
     // If our log has the next request for the peer or if the peer's committed index is
-    // lower than our own, set 'more_pending' to true.
-    *more_pending = log_cache_.HasOpBeenWritten(peer->next_index) ||
+    // lower than our own, set 'more_pending' to true. Operations that are already in flight to the
+    // peer are not pending.
+    const int64_t next_index_to_send = other_requests_in_flight
+        ? std::max(peer->next_index, peer->pipelined_next_index) : peer->next_index;
+    *more_pending = log_cache_.HasOpBeenWritten(next_index_to_send) ||
         (peer->last_known_committed_idx < queue_state_.committed_index.index());
 
     mode_copy = queue_state_.mode;
@@ -776,11 +879,12 @@ void PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
       }
       majority_replicated.op_id = queue_state_.majority_replicated_opid;
 
-      peer->last_leader_lease_expiration_received_by_follower =
-          peer->last_leader_lease_expiration_sent_to_follower;
+      if (sent_leases) {
+        peer->last_leader_lease_expiration_received_by_follower =
+            sent_leases->leader_lease_expiration;
 
-      peer->last_ht_lease_expiration_received_by_follower =
-          peer->last_ht_lease_expiration_sent_to_follower;
+        peer->last_ht_lease_expiration_received_by_follower = sent_leases->ht_lease_expiration;
+      }
 
       majority_replicated.leader_lease_expiration = LeaderLeaseExpirationWatermark();
 
@@ -33,6 +33,7 @@
 #ifndef YB_CONSENSUS_CONSENSUS_QUEUE_H_
 #define YB_CONSENSUS_CONSENSUS_QUEUE_H_
 
+#include <deque>
 #include <iosfwd>
 #include <map>
 #include <string>
@@ -60,6 +61,7 @@
 namespace yb {
 template<class T>
 class AtomicGauge;
+class Histogram;
 class MemTracker;
 class MetricEntity;
 class ThreadPool;
@@ -84,10 +86,19 @@ extern const char kConsensusQueueParentTrackerId[];
 //
 // This class is used only on the LEADER side.
 //
-// TODO Currently this class is able to track one outstanding operation per peer. If we want to have
-// more than one outstanding RPC we need to modify it.
+// Several requests may be outstanding to a peer at the same time when they are pipelined, see
+// PipelinedRequestForPeer().
 class PeerMessageQueue {
  public:
+  // Leader leases sent to a follower in a request.
+  struct SentLeases {
+    // The time of sending the request + leader lease duration. This is not actually sent to the
+    // follower: what we're sending is the lease duration, not an expiration timestamp, because the
+    // timestamp is specific to the leader's monotonic clock.
+    MonoTime leader_lease_expiration;
+    MicrosTime ht_lease_expiration;
+  };
+
   struct TrackedPeer {
     explicit TrackedPeer(std::string uuid)
         : uuid(std::move(uuid)),
@@ -112,6 +123,13 @@ class PeerMessageQueue {
     // Next index to send to the peer.  This corresponds to "nextIndex" as specified in Raft.
     int64_t next_index = kInvalidOpIdIndex;
 
+    // The index following the last operation sent to the peer, which might not be acked yet.
+    // Pipelined requests continue from this index rather than from next_index.
+    int64_t pipelined_next_index = kInvalidOpIdIndex;
+
+    // The committed index sent to the peer in the last request.
+    int64_t last_sent_committed_idx = kMinimumOpIdIndex;
+
     // The last operation that we've sent to this peer and that it acked. Used for watermark
     // movement.
     OpId last_received;
@@ -127,21 +145,18 @@ class PeerMessageQueue {
     // successful communication ever took place.
     MonoTime last_successful_communication_time;
 
-    // The leader sets this field to the time of sending request + leader lease duration, and uses
-    // it when handling the response to establish the majority replicated lease expiration
-    // timestamp. This is not actually sent to the follower: what we're sending is the lease
-    // duration, not an expiration timestamp, because the timestamp is specific to the leader's
-    // monotonic clock.
-    MonoTime last_leader_lease_expiration_sent_to_follower;
+    // The leases sent to the follower in the requests that were not responded to yet, in the order
+    // the requests were sent. The leader uses them when handling the responses to establish the
+    // majority replicated lease expiration timestamp. Responses to pipelined requests may arrive
+    // out of order, so the k-th response is credited with the k-th lease sent, which is never later
+    // than any of the leases actually received by the follower.
+    std::deque<SentLeases> leases_in_flight;
 
     // The last leader lease expiration timestamp received by the follower described by this
     // TrackedPeer. We set this to the value of what we sent to that follower
-    // (last_leader_lease_expiration_sent_to_follower) when we receive the follower's response.
+    // (leases_in_flight) when we receive the follower's response.
     MonoTime last_leader_lease_expiration_received_by_follower;
 
-    MicrosTime last_ht_lease_expiration_sent_to_follower =
-        HybridTime::kMin.GetPhysicalValueMicros();
-
     MicrosTime last_ht_lease_expiration_received_by_follower =
         HybridTime::kMin.GetPhysicalValueMicros();
 
@@ -162,7 +177,8 @@ class PeerMessageQueue {
                    const scoped_refptr<log::Log>& log,
                    const RaftPeerPB& local_peer_pb,
                    const std::string& tablet_id,
-                   const server::ClockPtr& clock);
+                   const server::ClockPtr& clock,
+                   ThreadPool* log_cache_read_ahead_pool = nullptr);
 
   // Initialize the queue.
   virtual void Init(const OpId& last_locally_replicated);
@@ -237,6 +253,22 @@ class PeerMessageQueue {
       RaftPeerPB::MemberType* member_type = nullptr,
       bool* last_exchange_successful = nullptr);
 
+  // Assembles a request for a peer that follows the operations sent in the requests that are still
+  // in flight to this peer, so that several requests could be pipelined. Sets 'has_request' to
+  // false if there is nothing new to send, or if the last exchange with the peer was not
+  // successful, in which case the caller should wait for the responses to the requests in flight
+  // and then use RequestForPeer() to resume from the last acked operation.
+  CHECKED_STATUS PipelinedRequestForPeer(
+      const std::string& uuid,
+      ConsensusRequestPB* request,
+      ReplicateMsgs* msg_refs,
+      bool* has_request);
+
+  // Records the leases carried by a request assembled by RequestForPeer() or
+  // PipelinedRequestForPeer(), right before it is sent to the peer. Requests that are assembled but
+  // not sent must not be recorded, since no response would ever confirm their leases.
+  void RequestSent(const std::string& uuid, const ConsensusRequestPB& request);
+
   // Fill in a StartRemoteBootstrapRequest for the specified peer.  If that peer should not remotely
   // bootstrap, returns a non-OK status.  On success, also internally resets
   // peer->needs_remote_bootstrap to false.
@@ -276,6 +308,11 @@ class PeerMessageQueue {
 
   void RegisterObserver(PeerMessageQueueObserver* observer);
 
+  // Sets the source of the safe time sent to followers with each request.
+  void SetSafeTimeProvider(SafeTimeProvider provider) {
+    safe_time_provider_ = std::move(provider);
+  }
+
   CHECKED_STATUS UnRegisterObserver(PeerMessageQueueObserver* observer);
 
   bool CanPeerBecomeLeader(const std::string& peer_uuid) const;
@@ -286,6 +323,8 @@ class PeerMessageQueue {
     scoped_refptr<AtomicGauge<int64_t> > num_majority_done_ops;
     // Keeps track of the number of ops. that are still in progress (IsDone() returns false).
     scoped_refptr<AtomicGauge<int64_t> > num_in_progress_ops;
+    // Number of requests in flight to a peer, recorded whenever a request is assembled.
+    scoped_refptr<Histogram> requests_in_flight_per_peer;
 
     explicit Metrics(const scoped_refptr<MetricEntity>& metric_entity);
   };
@@ -356,6 +395,19 @@ class PeerMessageQueue {
     std::string ToString() const;
   };
 
+  // Implements RequestForPeer() and PipelinedRequestForPeer(). When 'pipelined' is true, the
+  // request starts after the operations already in flight, and 'has_request' is set to false if
+  // there is nothing to pipeline.
+  CHECKED_STATUS DoRequestForPeer(
+      const std::string& uuid,
+      bool pipelined,
+      ConsensusRequestPB* request,
+      ReplicateMsgs* msg_refs,
+      bool* needs_remote_bootstrap,
+      RaftPeerPB::MemberType* member_type,
+      bool* last_exchange_successful,
+      bool* has_request);
+
   // Returns true iff given 'desired_op' is found in the local WAL.
   // If the op is not found, returns false.
   // If the log cache returns some error other than NotFound, crashes with a fatal error.
@@ -444,6 +496,8 @@ class PeerMessageQueue {
   Metrics metrics_;
 
   server::ClockPtr clock_;
+
+  SafeTimeProvider safe_time_provider_;
 };
 
 inline std::ostream& operator <<(std::ostream& out, PeerMessageQueue::Mode mode) {
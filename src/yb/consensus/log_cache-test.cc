@@ -46,6 +46,7 @@
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
 #include "yb/util/test_util.h"
+#include "yb/util/threadpool.h"
 
 using std::shared_ptr;
 
@@ -82,6 +83,7 @@ class LogCacheTest : public YBTest {
                             NULL,
                             &log_));
 
+    ASSERT_OK(ThreadPoolBuilder("log-cache-read-ahead").Build(&read_ahead_pool_));
     CloseAndReopenCache(MinimumOpId());
     clock_.reset(new server::HybridClock());
     ASSERT_OK(clock_->Init());
@@ -98,7 +100,8 @@ class LogCacheTest : public YBTest {
     cache_.reset(new LogCache(metric_entity_,
                               log_.get(),
                               kPeerUuid,
-                              kTestTablet));
+                              kTestTablet,
+                              read_ahead_pool_.get()));
     cache_->Init(preceding_id);
   }
 
@@ -125,6 +128,7 @@ class LogCacheTest : public YBTest {
   MetricRegistry metric_registry_;
   scoped_refptr<MetricEntity> metric_entity_;
   gscoped_ptr<FsManager> fs_manager_;
+  gscoped_ptr<ThreadPool> read_ahead_pool_;
   gscoped_ptr<LogCache> cache_;
   scoped_refptr<log::Log> log_;
   scoped_refptr<server::Clock> clock_;
@@ -320,5 +324,78 @@ TEST_F(LogCacheTest, TestReplaceMessages) {
             cache_->ToString());
 }
 
+// Test that once a reader misses the cache, the following operations are read ahead from disk in
+// the background, so that the next batches are served from the cache.
+TEST_F(LogCacheTest, TestReadAhead) {
+  const int kPayloadSize = 1024;
+  ASSERT_OK(AppendReplicateMessagesToCache(1, 100, kPayloadSize));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  cache_->EvictThroughOp(100);
+  ASSERT_EQ(0, cache_->num_cached_ops());
+
+  ReplicateMsgs messages;
+  OpId preceding;
+  ASSERT_OK(cache_->ReadOps(0, 10 * kPayloadSize, &messages, &preceding));
+  ASSERT_GT(messages.size(), 0U);
+  ASSERT_LT(messages.size(), 100U);
+  ASSERT_EQ(1, cache_->metrics_.log_cache_disk_reads->value());
+  const int64_t last_read_index = messages.back()->id().index();
+
+  // The rest of the log fits into one read-ahead.
+  ASSERT_OK(WaitFor([this]() -> bool { return cache_->num_cached_ops() == 100; },
+                    MonoDelta::FromSeconds(10), "Wait for read-ahead"));
+  ASSERT_EQ(2, cache_->metrics_.log_cache_disk_reads->value());
+
+  messages.clear();
+  ASSERT_OK(cache_->ReadOps(last_read_index, 8 * 1024 * 1024, &messages, &preceding));
+  ASSERT_EQ(100 - last_read_index, static_cast<int64_t>(messages.size()));
+  ASSERT_EQ(2, cache_->metrics_.log_cache_disk_reads->value());
+}
+
+// Test that read-ahead only reads as many operations as the spare memory of the cache allows, so
+// that the operations it reads are not dropped right away.
+TEST_F(LogCacheTest, TestReadAheadMemoryLimit) {
+  FLAGS_log_cache_size_limit_mb = 1;
+  CloseAndReopenCache(MinimumOpId());
+
+  const int kPayloadSize = 1024;
+  const int64_t kSpareBytes = 16 * kPayloadSize;
+  ASSERT_OK(AppendReplicateMessagesToCache(1, 100, kPayloadSize));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  cache_->EvictThroughOp(100);
+  ASSERT_EQ(0, cache_->num_cached_ops());
+
+  ScopedTrackedConsumption consumption(cache_->tracker_,
+                                       cache_->tracker_->limit() - kSpareBytes);
+
+  ReplicateMsgs messages;
+  OpId preceding;
+  ASSERT_OK(cache_->ReadOps(0, 4 * kPayloadSize, &messages, &preceding));
+  ASSERT_GT(messages.size(), 0U);
+  ASSERT_OK(WaitFor([this]() { return cache_->metrics_.log_cache_disk_reads->value() == 2; },
+                    MonoDelta::FromSeconds(10), "Wait for read-ahead"));
+  cache_->WaitForReadAhead(std::numeric_limits<int64_t>::max());
+
+  // Everything that was read ahead fits into the cache.
+  const int64_t num_cached_ops = cache_->num_cached_ops();
+  ASSERT_GT(num_cached_ops, static_cast<int64_t>(messages.size()));
+  ASSERT_LT(num_cached_ops, 100);
+  {
+    std::lock_guard<simple_spinlock> l(cache_->lock_);
+    ASSERT_EQ(num_cached_ops, cache_->read_ahead_end_index_ - 1);
+  }
+  ASSERT_LE(cache_->tracker_->consumption(), cache_->tracker_->limit());
+
+  // Without spare memory there is nothing to read ahead.
+  ScopedTrackedConsumption no_spare(cache_->tracker_, cache_->tracker_->SpareCapacity());
+  const int64_t last_cached_index = num_cached_ops;
+  messages.clear();
+  ASSERT_OK(cache_->ReadOps(last_cached_index, 4 * kPayloadSize, &messages, &preceding));
+  ASSERT_GT(messages.size(), 0U);
+  cache_->WaitForReadAhead(std::numeric_limits<int64_t>::max());
+  ASSERT_EQ(3, cache_->metrics_.log_cache_disk_reads->value());
+  ASSERT_EQ(num_cached_ops, cache_->num_cached_ops());
+}
+
 } // namespace consensus
 } // namespace yb
@@ -33,6 +33,7 @@
 #include "yb/consensus/log_cache.h"
 
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <vector>
@@ -55,6 +56,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/locks.h"
 #include "yb/util/logging.h"
+#include "yb/util/threadpool.h"
 
 DEFINE_int32(log_cache_size_limit_mb, 128,
              "The total per-tablet size of consensus entries which may be kept in memory. "
@@ -68,6 +70,12 @@ DEFINE_int32(global_log_cache_size_limit_mb, 1024,
              "caching log entries across all tablets is kept under this threshold.");
 TAG_FLAG(global_log_cache_size_limit_mb, advanced);
 
+DEFINE_int32(log_cache_read_ahead_bytes, 8 * 1024 * 1024,
+             "The maximum size of consensus entries read from disk into the log cache in the "
+             "background when a peer falls behind the cached entries. Reads are further limited "
+             "to the spare memory of the log cache. 0 disables read-ahead.");
+TAG_FLAG(log_cache_read_ahead_bytes, advanced);
+
 using strings::Substitute;
 
 namespace yb {
@@ -79,6 +87,10 @@ METRIC_DEFINE_gauge_int64(tablet, log_cache_num_ops, "Log Cache Operation Count"
 METRIC_DEFINE_gauge_int64(tablet, log_cache_size, "Log Cache Memory Usage",
                           MetricUnit::kBytes,
                           "Amount of memory in use for caching the local log.");
+METRIC_DEFINE_counter(tablet, log_cache_disk_reads, "Log Cache Disk Reads",
+                      MetricUnit::kRequests,
+                      "Number of times operations missing from the log cache were read from disk, "
+                      "including read-ahead.");
 
 static const char kParentMemTrackerId[] = "log_cache";
 
@@ -87,12 +99,14 @@ typedef vector<const ReplicateMsg*>::const_iterator MsgIter;
 LogCache::LogCache(const scoped_refptr<MetricEntity>& metric_entity,
                    const scoped_refptr<log::Log>& log,
                    const string& local_uuid,
-                   const string& tablet_id)
+                   const string& tablet_id,
+                   ThreadPool* read_ahead_pool)
   : log_(log),
     local_uuid_(local_uuid),
     tablet_id_(tablet_id),
     next_sequential_op_index_(0),
     min_pinned_op_index_(0),
+    read_ahead_pool_(read_ahead_pool),
     metrics_(metric_entity) {
 
 
@@ -103,6 +117,10 @@ LogCache::LogCache(const scoped_refptr<MetricEntity>& metric_entity,
   // to the root tracker so that it's always global.
   parent_tracker_ = MemTracker::FindOrCreateTracker(global_max_ops_size_bytes,
                                                     kParentMemTrackerId);
+  // Every replicated operation of every tablet goes through this tracker. Batching it, rather
+  // than the per-tablet trackers, keeps the lag of the root tracker independent of the number of
+  // tablets.
+  parent_tracker_->EnableConsumptionBatching();
 
   // And create a child tracker with the per-tablet limit.
   tracker_ = MemTracker::CreateTracker(
@@ -118,6 +136,11 @@ LogCache::LogCache(const scoped_refptr<MetricEntity>& metric_entity,
 }
 
 LogCache::~LogCache() {
+  {
+    // The pool is shared with other tablets, so wait for our own read-ahead to complete.
+    std::unique_lock<std::mutex> read_ahead_lock(read_ahead_mutex_);
+    read_ahead_cond_.wait(read_ahead_lock, [this] { return read_ahead_from_index_ == -1; });
+  }
   tracker_->Release(tracker_->consumption());
   cache_.clear();
 
@@ -150,6 +173,7 @@ Status LogCache::AppendOperations(const ReplicateMsgs& msgs,
     // If the index is not consecutive then it must be lower than or equal
     // to the last index, i.e. we're overwriting.
     CHECK_LE(first_idx_in_batch, next_sequential_op_index_);
+    ++overwrite_epoch_;
 
     // Now remove the overwritten operations.
     for (int64_t i = first_idx_in_batch; i < next_sequential_op_index_; ++i) {
@@ -296,6 +320,7 @@ Status LogCache::ReadOps(int64_t after_op_index,
 
   std::unique_lock<simple_spinlock> l(lock_);
   int64_t next_index = after_op_index + 1;
+  bool waited_for_read_ahead = false;
 
   // Return as many operations as we can, up to the limit
   int64_t remaining_space = max_size_bytes;
@@ -313,17 +338,29 @@ Status LogCache::ReadOps(int64_t after_op_index,
         // Read up to the next entry that's in the cache
         up_to = iter->first - 1;
       }
+      const int64_t overwrite_epoch = overwrite_epoch_;
 
       l.unlock();
 
+      // Don't read the same operations twice if they are being read ahead already.
+      if (!waited_for_read_ahead) {
+        waited_for_read_ahead = true;
+        if (WaitForReadAhead(next_index)) {
+          l.lock();
+          continue;
+        }
+      }
+
       ReplicateMsgs raw_replicate_ptrs;
       RETURN_NOT_OK_PREPEND(
         log_->GetLogReader()->ReadReplicatesInRange(
           next_index, up_to, remaining_space, &raw_replicate_ptrs),
         Substitute("Failed to read ops $0..$1", next_index, up_to));
+      metrics_.log_cache_disk_reads->Increment();
       l.lock();
       LOG_WITH_PREFIX_UNLOCKED(INFO) << "Successfully read " << raw_replicate_ptrs.size() << " ops "
                             << "from disk.";
+      InsertLoadedMessagesUnlocked(raw_replicate_ptrs, overwrite_epoch);
 
       for (auto& msg : raw_replicate_ptrs) {
         CHECK_EQ(next_index, msg->id().index());
@@ -354,9 +391,157 @@ Status LogCache::ReadOps(int64_t after_op_index,
       }
     }
   }
+  l.unlock();
+
+  MaybeScheduleReadAhead(next_index);
   return Status::OK();
 }
 
+void LogCache::InsertLoadedMessagesUnlocked(const ReplicateMsgs& msgs, int64_t overwrite_epoch) {
+  DCHECK(lock_.is_locked());
+  if (overwrite_epoch != overwrite_epoch_) {
+    VLOG_WITH_PREFIX_UNLOCKED(1) << "Operations were overwritten while reading them from disk";
+    return;
+  }
+
+  for (const auto& msg : msgs) {
+    const int64_t index = msg->id().index();
+    if (index >= next_sequential_op_index_) {
+      break;
+    }
+    if (ContainsKey(cache_, index)) {
+      continue;
+    }
+    // Unlike appended operations, the ones read from disk are only cached while there is spare
+    // memory.
+    const int64_t size = msg->SpaceUsed();
+    if (!tracker_->TryConsume(size)) {
+      break;
+    }
+    cache_.emplace(index, msg);
+    metrics_.log_cache_size->IncrementBy(size);
+    metrics_.log_cache_num_ops->Increment();
+  }
+}
+
+// Reads ahead on the pool shared by all the tablets. The task is destroyed after it runs, or
+// without running when it could not be submitted or the pool is shut down, so the cache is notified
+// that the read-ahead is over in every case.
+class LogCache::ReadAheadTask : public Runnable {
+ public:
+  ReadAheadTask(LogCache* cache, int64_t from_index) : cache_(cache), from_index_(from_index) {}
+
+  ~ReadAheadTask() {
+    cache_->ReadAheadDone();
+  }
+
+  void Run() override {
+    cache_->ReadAhead(from_index_);
+  }
+
+ private:
+  LogCache* const cache_;
+  const int64_t from_index_;
+};
+
+void LogCache::MaybeScheduleReadAhead(int64_t next_index) {
+  if (read_ahead_pool_ == nullptr || FLAGS_log_cache_read_ahead_bytes <= 0) {
+    return;
+  }
+
+  int64_t from_index;
+  {
+    std::lock_guard<std::mutex> read_ahead_lock(read_ahead_mutex_);
+    if (read_ahead_from_index_ != -1) {
+      return;
+    }
+
+    std::lock_guard<simple_spinlock> l(lock_);
+    if (next_index >= next_sequential_op_index_) {
+      return;
+    }
+    if (!ContainsKey(cache_, next_index)) {
+      from_index = next_index;
+    } else if (next_index >= read_ahead_trigger_index_ &&
+               read_ahead_end_index_ < next_sequential_op_index_ &&
+               !ContainsKey(cache_, read_ahead_end_index_)) {
+      from_index = read_ahead_end_index_;
+    } else {
+      return;
+    }
+    read_ahead_trigger_index_ = std::numeric_limits<int64_t>::max();
+    read_ahead_from_index_ = from_index;
+  }
+
+  VLOG_WITH_PREFIX_UNLOCKED(1) << "Scheduling read-ahead from " << from_index;
+  // Submitted without holding read_ahead_mutex_, since a task that is not accepted by the pool is
+  // destroyed right away.
+  Status s = read_ahead_pool_->Submit(std::make_shared<ReadAheadTask>(this, from_index));
+  if (!s.ok()) {
+    LOG_WITH_PREFIX_UNLOCKED(WARNING) << "Failed to schedule read-ahead: " << s;
+  }
+}
+
+void LogCache::ReadAhead(int64_t from_index) {
+  int64_t up_to;
+  int64_t overwrite_epoch;
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    up_to = next_sequential_op_index_ - 1;
+    // Stop at the first operation that is already cached.
+    auto iter = cache_.lower_bound(from_index);
+    if (iter != cache_.end()) {
+      up_to = std::min<int64_t>(up_to, iter->first - 1);
+    }
+    overwrite_epoch = overwrite_epoch_;
+  }
+
+  // Operations read ahead are only cached while there is spare memory, so don't read more than
+  // what would be cached, instead of throwing the rest away and reading it again for the peer.
+  const int64_t max_bytes = std::min<int64_t>(FLAGS_log_cache_read_ahead_bytes,
+                                              tracker_->SpareCapacity());
+  if (max_bytes <= 0) {
+    VLOG_WITH_PREFIX_UNLOCKED(1) << "No spare memory to read ahead ops from " << from_index;
+    return;
+  }
+
+  ReplicateMsgs msgs;
+  if (from_index <= up_to) {
+    Status s = log_->GetLogReader()->ReadReplicatesInRange(from_index, up_to, max_bytes, &msgs);
+    metrics_.log_cache_disk_reads->Increment();
+    if (!s.ok()) {
+      LOG_WITH_PREFIX_UNLOCKED(WARNING) << "Failed to read ahead ops " << from_index << ".."
+                                        << up_to << ": " << s;
+      msgs.clear();
+    }
+  }
+
+  if (!msgs.empty()) {
+    std::lock_guard<std::mutex> read_ahead_lock(read_ahead_mutex_);
+    std::lock_guard<simple_spinlock> l(lock_);
+    InsertLoadedMessagesUnlocked(msgs, overwrite_epoch);
+    read_ahead_end_index_ = msgs.back()->id().index() + 1;
+    read_ahead_trigger_index_ = msgs[msgs.size() / 2]->id().index();
+    VLOG_WITH_PREFIX_UNLOCKED(1) << "Read ahead " << msgs.size() << " ops from " << from_index;
+  }
+}
+
+void LogCache::ReadAheadDone() {
+  std::lock_guard<std::mutex> read_ahead_lock(read_ahead_mutex_);
+  read_ahead_from_index_ = -1;
+  // Notified under the lock, so that the destructor could not destroy the condition first.
+  read_ahead_cond_.notify_all();
+}
+
+bool LogCache::WaitForReadAhead(int64_t index) {
+  std::unique_lock<std::mutex> read_ahead_lock(read_ahead_mutex_);
+  if (read_ahead_from_index_ == -1 || read_ahead_from_index_ > index) {
+    return false;
+  }
+  read_ahead_cond_.wait(read_ahead_lock, [this] { return read_ahead_from_index_ == -1; });
+  return true;
+}
+
 
 void LogCache::EvictThroughOp(int64_t index) {
   std::lock_guard<simple_spinlock> lock(lock_);
@@ -490,7 +675,8 @@ void LogCache::DumpToHtml(std::ostream& out) const {
   x.Instantiate(metric_entity, 0)
 LogCache::Metrics::Metrics(const scoped_refptr<MetricEntity>& metric_entity)
   : log_cache_num_ops(INSTANTIATE_METRIC(METRIC_log_cache_num_ops)),
-    log_cache_size(INSTANTIATE_METRIC(METRIC_log_cache_size)) {
+    log_cache_size(INSTANTIATE_METRIC(METRIC_log_cache_size)),
+    log_cache_disk_reads(METRIC_log_cache_disk_reads.Instantiate(metric_entity)) {
 }
 #undef INSTANTIATE_METRIC
 
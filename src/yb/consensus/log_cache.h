@@ -32,8 +32,11 @@
 #ifndef YB_CONSENSUS_LOG_CACHE_H
 #define YB_CONSENSUS_LOG_CACHE_H
 
+#include <condition_variable>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -51,6 +54,7 @@ namespace yb {
 
 class MetricEntity;
 class MemTracker;
+class ThreadPool;
 
 namespace log {
 class Log;
@@ -67,12 +71,20 @@ class ReplicateMsg;
 // can be appended to the end as they are written to the log. Readers
 // fetch entries that were explicitly appended, or they can fetch older
 // entries which are asynchronously fetched from the disk.
+//
+// The appended messages are shared with the log, and the messages read back from disk are shared
+// between all the peers reading them. When a reader falls behind the cached operations, the
+// following operations are read ahead from disk in the background, so that a catching up peer
+// does not have to wait for a disk read for every batch.
 class LogCache {
  public:
+  // 'read_ahead_pool' is shared by the log caches of all the tablets of the server and has to
+  // outlive this cache. Read-ahead is disabled when it is null.
   LogCache(const scoped_refptr<MetricEntity>& metric_entity,
            const scoped_refptr<log::Log>& log,
            const std::string& local_uuid,
-           const std::string& tablet_id);
+           const std::string& tablet_id,
+           ThreadPool* read_ahead_pool);
   ~LogCache();
 
   // Initialize the cache.
@@ -95,7 +107,8 @@ class LogCache {
   // The index of this OpId will match 'after_op_index'.
   //
   // If the ops being requested are not available in the log, this will synchronously
-  // read these ops from disk. Therefore, this function may take a substantial amount
+  // read these ops from disk, unless a read-ahead of them is already in progress, in which case it
+  // waits for the read-ahead. Therefore, this function may take a substantial amount
   // of time and should not be called with important locks held, etc.
   CHECKED_STATUS ReadOps(int64_t after_op_index,
                  int max_size_bytes,
@@ -152,8 +165,12 @@ class LogCache {
   FRIEND_TEST(LogCacheTest, TestAppendAndGetMessages);
   FRIEND_TEST(LogCacheTest, TestGlobalMemoryLimit);
   FRIEND_TEST(LogCacheTest, TestReplaceMessages);
+  FRIEND_TEST(LogCacheTest, TestReadAhead);
+  FRIEND_TEST(LogCacheTest, TestReadAheadMemoryLimit);
   friend class LogCacheTest;
 
+  class ReadAheadTask;
+
   // Try to evict the oldest operations from the queue, stopping either when
   // 'bytes_to_evict' bytes have been evicted, or the op with index
   // 'stop_after_index' has been evicted, whichever comes first.
@@ -163,6 +180,26 @@ class LogCache {
   // given message.
   void AccountForMessageRemovalUnlocked(const ReplicateMsgPtr& msg);
 
+  // Insert the messages read from disk, as long as the memory limits allow it. The messages are
+  // dropped if some operations were overwritten since 'overwrite_epoch' was captured, or if they
+  // are already cached.
+  void InsertLoadedMessagesUnlocked(const ReplicateMsgs& msgs, int64_t overwrite_epoch);
+
+  // Schedule a read-ahead when a reader that is about to read 'next_index' would miss the cache,
+  // or has consumed half of the operations loaded by the previous read-ahead.
+  void MaybeScheduleReadAhead(int64_t next_index);
+
+  // Read the operations starting from 'from_index' from disk into the cache, as long as they fit
+  // into the spare memory of the cache.
+  void ReadAhead(int64_t from_index);
+
+  // Called once the scheduled read-ahead task is destroyed, whether it ran or not.
+  void ReadAheadDone();
+
+  // Wait for the read-ahead in progress if it is going to load the operation with the given index.
+  // Returns true if we waited.
+  bool WaitForReadAhead(int64_t index);
+
   // Return a string with stats
   std::string StatsStringUnlocked() const;
 
@@ -213,6 +250,25 @@ class LogCache {
   // A MemTracker for this instance.
   std::shared_ptr<MemTracker> tracker_;
 
+  // Incremented whenever appended operations overwrite existing ones, so that operations that were
+  // concurrently read from disk are not inserted into the cache.
+  // Protected by lock_.
+  int64_t overwrite_epoch_ = 0;
+
+  // The index following the last operation loaded by the previous read-ahead, and the index at
+  // which the next read-ahead starts once a reader gets there.
+  // Protected by lock_.
+  int64_t read_ahead_end_index_ = 0;
+  int64_t read_ahead_trigger_index_ = std::numeric_limits<int64_t>::max();
+
+  // The index the read-ahead in progress starts from, or -1 if there is none.
+  // Protected by read_ahead_mutex_, which has to be acquired before lock_.
+  int64_t read_ahead_from_index_ = -1;
+  std::mutex read_ahead_mutex_;
+  std::condition_variable read_ahead_cond_;
+
+  ThreadPool* const read_ahead_pool_;
+
   struct Metrics {
     explicit Metrics(const scoped_refptr<MetricEntity>& metric_entity);
 
@@ -221,6 +277,9 @@ class LogCache {
 
     // Keeps track of the memory consumed by the cache, in bytes.
     scoped_refptr<AtomicGauge<int64_t> > log_cache_size;
+
+    // Number of reads of operations from disk, including read-ahead.
+    scoped_refptr<Counter> log_cache_disk_reads;
   };
   Metrics metrics_;
 
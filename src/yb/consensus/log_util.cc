@@ -429,10 +429,38 @@ Status ReadableLogSegment::ParseFooterMagicAndFooterLength(const Slice &data,
 }
 
 Status ReadableLogSegment::ReadEntries(LogEntries* entries, int64_t* end_offset) {
+  return ReadEntries([entries](LogEntries* batch_entries) {
+    for (auto& entry : *batch_entries) {
+      entries->push_back(std::move(entry));
+    }
+    return Status::OK();
+  }, end_offset);
+}
+
+namespace {
+
+std::string DescribeEntry(const LogEntryPB& entry) {
+  string opid_str;
+  if (entry.type() == log::REPLICATE && entry.has_replicate()) {
+    opid_str = consensus::OpIdToString(entry.replicate().id());
+  } else if (entry.has_commit() && entry.commit().has_commited_op_id()) {
+    opid_str = consensus::OpIdToString(entry.commit().commited_op_id());
+  } else {
+    opid_str = "<unknown>";
+  }
+  return Substitute("$0 ($1)", LogEntryTypePB_Name(entry.type()), opid_str);
+}
+
+} // namespace
+
+Status ReadableLogSegment::ReadEntries(const LogEntryBatchHandler& handler, int64_t* end_offset) {
   TRACE_EVENT1("log", "ReadableLogSegment::ReadEntries",
                "path", path_);
 
   std::vector<int64_t> recent_offsets(4, -1);
+  // Include up to the last 4 entries in the segment into corruption messages.
+  constexpr size_t kNumRecentEntries = 4;
+  std::vector<std::string> recent_entries;
   int batches_read = 0;
 
   int64_t offset = first_entry_offset();
@@ -453,6 +481,7 @@ Status ReadableLogSegment::ReadEntries(LogEntries* entries, int64_t* end_offset)
   }
 
   int num_entries_read = 0;
+  LogEntries batch_entries;
   while (offset < read_up_to) {
     const int64_t this_batch_offset = offset;
     recent_offsets[batches_read++ % recent_offsets.size()] = offset;
@@ -475,7 +504,7 @@ Status ReadableLogSegment::ReadEntries(LogEntries* entries, int64_t* end_offset)
 
       Status corruption_status = MakeCorruptionStatus(
           batches_read, this_batch_offset, &recent_offsets,
-          *entries, s);
+          recent_entries, s);
 
       // If we have a valid footer in the segment, then the segment was correctly
       // closed, and we shouldn't see any corruption anywhere (including the last
@@ -510,13 +539,23 @@ Status ReadableLogSegment::ReadEntries(LogEntries* entries, int64_t* end_offset)
     if (VLOG_IS_ON(3)) {
       VLOG(3) << "Read Log entry batch: " << current_batch.DebugString();
     }
+    batch_entries.clear();
+    batch_entries.reserve(current_batch.entry_size());
     for (size_t i = 0; i < current_batch.entry_size(); ++i) {
-      entries->emplace_back(current_batch.mutable_entry(i));
+      batch_entries.emplace_back(current_batch.mutable_entry(i));
       num_entries_read++;
     }
     current_batch.mutable_entry()->ExtractSubrange(0,
                                                    current_batch.entry_size(),
                                                    nullptr);
+    for (size_t i = batch_entries.size() - std::min(batch_entries.size(), kNumRecentEntries);
+         i < batch_entries.size(); ++i) {
+      if (recent_entries.size() == kNumRecentEntries) {
+        recent_entries.erase(recent_entries.begin());
+      }
+      recent_entries.push_back(DescribeEntry(*batch_entries[i]));
+    }
+    RETURN_NOT_OK(handler(&batch_entries));
     if (end_offset != nullptr) {
       *end_offset = offset;
     }
@@ -579,7 +618,7 @@ Status ReadableLogSegment::MakeCorruptionStatus(
     int batch_number,
     int64_t batch_offset,
     std::vector<int64_t>* recent_offsets,
-    const std::vector<std::unique_ptr<LogEntryPB>>& entries,
+    const std::vector<std::string>& recent_entries,
     const Status& status) const {
 
   string err = "Log file corruption detected. ";
@@ -592,22 +631,10 @@ Status ReadableLogSegment::MakeCorruptionStatus(
       SubstituteAndAppend(&err, " $0", offset);
     }
   }
-  if (!entries.empty()) {
+  if (!recent_entries.empty()) {
     err.append("; Last log entries read:");
-    const int kNumEntries = 4; // Include up to the last 4 entries in the segment.
-    for (int i = std::max(0, static_cast<int>(entries.size()) - kNumEntries);
-        i < entries.size(); i++) {
-      LogEntryPB* entry = entries[i].get();
-      LogEntryTypePB type = entry->type();
-      string opid_str;
-      if (type == log::REPLICATE && entry->has_replicate()) {
-        opid_str = consensus::OpIdToString(entry->replicate().id());
-      } else if (entry->has_commit() && entry->commit().has_commited_op_id()) {
-        opid_str = consensus::OpIdToString(entry->commit().commited_op_id());
-      } else {
-        opid_str = "<unknown>";
-      }
-      SubstituteAndAppend(&err, " [$0 ($1)]", LogEntryTypePB_Name(type), opid_str);
+    for (const auto& entry : recent_entries) {
+      SubstituteAndAppend(&err, " [$0]", entry);
     }
   }
 
@@ -783,12 +810,10 @@ Status WritableLogSegment::WriteEntryBatch(const Slice& data) {
   uint32_t header_crc = crc::Crc32c(&header_buf, 8);
   InlineEncodeFixed32(&header_buf[8], header_crc);
 
-  // Write the header to the file, followed by the batch data itself.
-  RETURN_NOT_OK(writable_file_->Append(Slice(header_buf, sizeof(header_buf))));
-  written_offset_ += sizeof(header_buf);
-
-  RETURN_NOT_OK(writable_file_->Append(data));
-  written_offset_ += data.size();
+  // Write the header to the file, followed by the batch data itself, with a single vectored
+  // write.
+  RETURN_NOT_OK(writable_file_->AppendVector({Slice(header_buf, sizeof(header_buf)), data}));
+  written_offset_ += sizeof(header_buf) + data.size();
 
   return Status::OK();
 }
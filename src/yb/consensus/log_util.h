@@ -33,6 +33,7 @@
 #ifndef YB_CONSENSUS_LOG_UTIL_H_
 #define YB_CONSENSUS_LOG_UTIL_H_
 
+#include <functional>
 #include <iosfwd>
 #include <map>
 #include <memory>
@@ -97,6 +98,10 @@ struct LogOptions {
 typedef std::vector<scoped_refptr<ReadableLogSegment> > SegmentSequence;
 typedef std::vector<std::unique_ptr<LogEntryPB>> LogEntries;
 
+// Invoked with the entries of each batch read from a log segment. The handler may take ownership
+// of (i.e. move out) any of the entries.
+typedef std::function<Status(LogEntries* batch_entries)> LogEntryBatchHandler;
+
 // A segment of the log can either be a ReadableLogSegment (for replay and
 // consensus catch-up) or a WritableLogSegment (where the Log actually stores
 // state). LogSegments have a maximum size defined in LogOptions (set from the
@@ -146,6 +151,15 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
   CHECKED_STATUS ReadEntries(LogEntries* entries,
                              int64_t* end_offset = nullptr);
 
+  // Same as above, but instead of accumulating all entries of the segment in memory passes
+  // the entries of each batch to 'handler' as soon as the batch is read. Stops reading and
+  // returns the handler's status if the handler fails.
+  //
+  // If the log is corrupted, all the batches read up to the corrupted one have already been
+  // passed to the handler when the Corruption status is returned.
+  CHECKED_STATUS ReadEntries(const LogEntryBatchHandler& handler,
+                             int64_t* end_offset = nullptr);
+
   // Rebuilds this segment's footer by scanning its entries.
   // This is an expensive operation as it reads and parses the whole segment
   // so it should be only used in the case of a crash, where the footer is
@@ -244,9 +258,10 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
   CHECKED_STATUS ScanForValidEntryHeaders(int64_t offset, bool* has_valid_entries);
 
   // Format a nice error message to report on a corruption in a log file.
+  // 'recent_entries' contains descriptions of the last few entries read.
   CHECKED_STATUS MakeCorruptionStatus(int batch_number, int64_t batch_offset,
                               std::vector<int64_t>* recent_offsets,
-                              const std::vector<std::unique_ptr<LogEntryPB>>& entries,
+                              const std::vector<std::string>& recent_entries,
                               const Status& status) const;
 
   CHECKED_STATUS ReadEntryHeaderAndBatch(int64_t* offset,
@@ -465,6 +465,82 @@ TEST_F(RaftConsensusTest, TestCommittedIndexWhenTermsChange) {
   ASSERT_OPID_EQ(last_config_round->id(), committed_index);
 }
 
+// Tests that reads are only served by the leader when its hybrid time lease covers the read time,
+// and that a leader which has been replaced by a newer one stops serving reads.
+TEST_F(RaftConsensusTest, TestLeaderStatusForRead) {
+  SetUpConsensus(kMinimumTerm, 3);
+  SetUpGeneralExpectations();
+  EXPECT_CALL(*peer_manager_, UpdateRaftConfig(_))
+      .Times(1)
+      .WillOnce(Return(Status::OK()));
+  EXPECT_CALL(*queue_, Init(_))
+      .Times(1);
+  EXPECT_CALL(*queue_, SetLeaderMode(_, _, _))
+      .Times(1);
+  EXPECT_CALL(*queue_, SetNonLeaderMode())
+      .Times(AnyNumber());
+  EXPECT_CALL(*consensus_.get(), AppendNewRoundsToQueueUnlocked(_))
+      .Times(1);
+  EXPECT_CALL(*queue_, AppendOperationsMock(_, _))
+      .Times(1).WillRepeatedly(Return(Status::OK()));
+
+  const MicrosTime ht_lease_expiration = 1000000;
+  const HybridTime covered_ht = HybridTime::FromMicros(ht_lease_expiration - 1);
+  const HybridTime expired_ht = HybridTime::FromMicros(ht_lease_expiration);
+
+  ConsensusBootstrapInfo info;
+  ASSERT_OK(consensus_->Start(info));
+
+  LeaderLeaseStatus lease_status;
+  ASSERT_EQ(Consensus::LeaderStatus::NOT_LEADER,
+            consensus_->LeaderStatusForRead(covered_ht, &lease_status));
+
+  ASSERT_OK(consensus_->EmulateElection());
+
+  // The no-op of the new term has not been committed yet.
+  ASSERT_EQ(Consensus::LeaderStatus::LEADER_BUT_NOT_READY,
+            consensus_->LeaderStatusForRead(covered_ht, &lease_status));
+
+  OpId committed_index;
+  consensus_->UpdateMajorityReplicated(
+      { rounds_[0]->id(), MonoTime::FineNow() + MonoDelta::FromSeconds(60), ht_lease_expiration },
+      &committed_index);
+  ASSERT_OPID_EQ(rounds_[0]->id(), committed_index);
+
+  ASSERT_EQ(Consensus::LeaderStatus::LEADER_AND_READY,
+            consensus_->LeaderStatusForRead(covered_ht, &lease_status));
+  ASSERT_EQ(LeaderLeaseStatus::HAS_LEASE, lease_status);
+
+  // The hybrid time lease does not cover reads at or after its expiration, but we still hold the
+  // leader lease, so the read should be retried on this server.
+  ASSERT_EQ(Consensus::LeaderStatus::LEADER_BUT_NOT_READY,
+            consensus_->LeaderStatusForRead(expired_ht, &lease_status));
+  ASSERT_EQ(LeaderLeaseStatus::NO_MAJORITY_REPLICATED_LEASE, lease_status);
+
+  // Once the leader lease itself expires, the client has to look the leader up again.
+  consensus_->UpdateMajorityReplicated(
+      { rounds_[0]->id(), MonoTime::FineNow() - MonoDelta::FromSeconds(1), ht_lease_expiration },
+      &committed_index);
+  ASSERT_EQ(Consensus::LeaderStatus::NOT_LEADER,
+            consensus_->LeaderStatusForRead(covered_ht, &lease_status));
+  ASSERT_EQ(LeaderLeaseStatus::NO_MAJORITY_REPLICATED_LEASE, lease_status);
+
+  consensus_->UpdateMajorityReplicated(
+      { rounds_[0]->id(), MonoTime::FineNow() + MonoDelta::FromSeconds(60), ht_lease_expiration },
+      &committed_index);
+  ASSERT_EQ(Consensus::LeaderStatus::LEADER_AND_READY,
+            consensus_->LeaderStatusForRead(covered_ht, &lease_status));
+
+  // Another peer is elected in a later term, so this one is a stale leader now and should stop
+  // serving reads even though the lease it has recorded still covers the read time.
+  ConsensusRequestPB request = MakeConsensusRequest(
+      rounds_[0]->id().term() + 1, config_.peers(0).permanent_uuid(), rounds_[0]->id());
+  ConsensusResponsePB response;
+  ASSERT_OK(consensus_->Update(&request, &response));
+  ASSERT_EQ(Consensus::LeaderStatus::NOT_LEADER,
+            consensus_->LeaderStatusForRead(covered_ht, &lease_status));
+}
+
 // Asserts that a ConsensusRound has an OpId set in its ReplicateMsg.
 MATCHER(HasOpId, "") { return arg->id().IsInitialized(); }
 
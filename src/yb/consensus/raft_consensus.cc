@@ -225,6 +225,7 @@ scoped_refptr<RaftConsensus> RaftConsensus::Create(
     ReplicaOperationFactory* operation_factory,
     const shared_ptr<rpc::Messenger>& messenger,
     const scoped_refptr<log::Log>& log,
+    ThreadPool* log_cache_read_ahead_pool,
     const shared_ptr<MemTracker>& parent_mem_tracker,
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
@@ -237,7 +238,8 @@ scoped_refptr<RaftConsensus> RaftConsensus::Create(
                                                            log,
                                                            local_peer_pb,
                                                            options.tablet_id,
-                                                           clock));
+                                                           clock,
+                                                           log_cache_read_ahead_pool));
 
   gscoped_ptr<ThreadPool> thread_pool;
   CHECK_OK(ThreadPoolBuilder(Substitute("$0-raft", options.tablet_id.substr(0, 6)))
@@ -1516,6 +1518,11 @@ Status RaftConsensus::UpdateReplica(ConsensusRequestPB* request,
     // 4 - Mark operations as committed
     RETURN_NOT_OK(MarkOperationsAsCommittedUnlocked(*request, deduped_req, last_from_leader));
 
+    if (request->has_propagated_safe_time() && propagated_safe_time_listener_) {
+      propagated_safe_time_listener_(
+          request->committed_index().index(), HybridTime(request->propagated_safe_time()));
+    }
+
     // Fill the response with the current state. We will not mutate anymore state until
     // we actually reply to the leader, we'll just wait for the messages to be durable.
     FillConsensusResponseOKUnlocked(response);
@@ -2207,6 +2214,12 @@ Status RaftConsensus::CheckIsActiveLeaderAndHasLease() const {
   return state_->CheckIsActiveLeaderAndHasLease();
 }
 
+void RaftConsensus::SetPropagatedSafeTimeCallbacks(SafeTimeProvider provider,
+                                                   PropagatedSafeTimeListener listener) {
+  queue_->SetSafeTimeProvider(std::move(provider));
+  propagated_safe_time_listener_ = std::move(listener);
+}
+
 std::string RaftConsensus::GetRequestVoteLogPrefixUnlocked() const {
   return state_->LogPrefixUnlocked() + "Leader election vote request";
 }
@@ -2346,6 +2359,45 @@ RaftPeerPB::Role RaftConsensus::role() const {
 Consensus::LeaderStatus RaftConsensus::leader_status() const {
   ReplicaState::UniqueLock lock;
   CHECK_OK(state_->LockForRead(&lock));
+  return LeaderStatusUnlocked(nullptr);
+}
+
+Consensus::LeaderStatus RaftConsensus::LeaderStatusForRead(
+    HybridTime ht, LeaderLeaseStatus* leader_lease_status) const {
+  ReplicaState::UniqueLock lock;
+  CHECK_OK(state_->LockForRead(&lock));
+
+  const auto result = LeaderStatusUnlocked(leader_lease_status);
+  if (result != LeaderStatus::LEADER_AND_READY) {
+    return result;
+  }
+
+  const auto ht_lease_status = state_->GetHybridTimeLeaseStatusAtUnlocked(
+      ht.GetPhysicalValueMicros());
+  if (leader_lease_status) {
+    *leader_lease_status = ht_lease_status;
+  }
+  switch (ht_lease_status) {
+    case LeaderLeaseStatus::OLD_LEADER_MAY_HAVE_LEASE:
+    case LeaderLeaseStatus::NO_MAJORITY_REPLICATED_LEASE:
+      // We still hold the leader lease, so the hybrid time lease should be extended by one of the
+      // next heartbeats. Will retry on the same server.
+      VLOG(1) << state_->LogPrefixUnlocked() << "Hybrid time lease does not cover " << ht << ": "
+              << LeaderLeaseStatus_Name(ht_lease_status);
+      return LeaderStatus::LEADER_BUT_NOT_READY;
+
+    case LeaderLeaseStatus::HAS_LEASE:
+      return LeaderStatus::LEADER_AND_READY;
+  }
+
+  FATAL_INVALID_ENUM_VALUE(LeaderLeaseStatus, ht_lease_status);
+}
+
+Consensus::LeaderStatus RaftConsensus::LeaderStatusUnlocked(
+    LeaderLeaseStatus* leader_lease_status) const {
+  if (leader_lease_status) {
+    *leader_lease_status = LeaderLeaseStatus::HAS_LEASE;
+  }
 
   if (GetRoleUnlocked() != RaftPeerPB::LEADER) {
     return LeaderStatus::NOT_LEADER;
@@ -2358,6 +2410,9 @@ Consensus::LeaderStatus RaftConsensus::leader_status() const {
 
   MonoDelta remaining_old_leader_lease;
   const auto lease_status = state_->GetLeaderLeaseStatusUnlocked(&remaining_old_leader_lease);
+  if (leader_lease_status) {
+    *leader_lease_status = lease_status;
+  }
   switch (lease_status) {
     case LeaderLeaseStatus::OLD_LEADER_MAY_HAVE_LEASE:
       // Will retry on the same server.
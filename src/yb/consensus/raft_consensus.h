@@ -93,6 +93,7 @@ class RaftConsensus : public Consensus,
     ReplicaOperationFactory* operation_factory,
     const std::shared_ptr<rpc::Messenger>& messenger,
     const scoped_refptr<log::Log>& log,
+    ThreadPool* log_cache_read_ahead_pool,
     const std::shared_ptr<MemTracker>& parent_mem_tracker,
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
@@ -163,10 +164,15 @@ class RaftConsensus : public Consensus,
 
   RaftPeerPB::Role GetRoleUnlocked() const;
 
+  LeaderStatus LeaderStatusUnlocked(LeaderLeaseStatus* leader_lease_status) const;
+
   virtual RaftPeerPB::Role role() const override;
 
   LeaderStatus leader_status() const override;
 
+  LeaderStatus LeaderStatusForRead(
+      HybridTime ht, LeaderLeaseStatus* leader_lease_status) const override;
+
   virtual std::string peer_uuid() const override;
 
   virtual std::string tablet_id() const override;
@@ -246,6 +252,9 @@ class RaftConsensus : public Consensus,
 
   Status CheckIsActiveLeaderAndHasLease() const override;
 
+  void SetPropagatedSafeTimeCallbacks(SafeTimeProvider provider,
+                                      PropagatedSafeTimeListener listener) override;
+
  private:
   friend class ReplicaState;
   friend class RaftConsensusQuorumTest;
@@ -599,6 +608,8 @@ class RaftConsensus : public Consensus,
 
   std::function<void()> lost_leadership_listener_;
 
+  PropagatedSafeTimeListener propagated_safe_time_listener_;
+
   DISALLOW_COPY_AND_ASSIGN(RaftConsensus);
 };
 
@@ -777,6 +777,9 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(IndexToRoundMap::iterator it
 
   OpId prev_id = last_committed_index_;
 
+  if (operation_factory_) {
+    operation_factory_->StartApplyingCommittedRounds();
+  }
   while (iter != end_iter) {
     scoped_refptr<ConsensusRound> round = (*iter).second; // Make a copy.
     DCHECK(round);
@@ -830,6 +833,9 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(IndexToRoundMap::iterator it
     prev_id.CopyFrom(round->id());
     round->NotifyReplicationFinished(Status::OK());
   }
+  if (operation_factory_) {
+    operation_factory_->FinishApplyingCommittedRounds();
+  }
 
   SetLastCommittedIndexUnlocked(committed_index);
 
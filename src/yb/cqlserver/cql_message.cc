@@ -727,10 +727,29 @@ void CQLResponse::Serialize(faststring* mesg) const {
   const size_t start_pos = mesg->size(); // save the start position
   SerializeHeader(mesg);
   SerializeBody(mesg);
+  const RefCntSlice* tail = SharedBodyTail();
+  if (tail != nullptr && !tail->empty()) {
+    mesg->append(tail->data(), tail->size());
+  }
   SERIALIZE_INT(
       mesg->data(), start_pos + kHeaderPosLength, mesg->size() - start_pos - kMessageHeaderLength);
 }
 
+void CQLResponse::SerializeWithSharedTail(faststring* mesg, RefCntSlice* tail) const {
+  const RefCntSlice* shared_tail = SharedBodyTail();
+  if (shared_tail == nullptr || shared_tail->empty()) {
+    Serialize(mesg);
+    return;
+  }
+  const size_t start_pos = mesg->size(); // save the start position
+  SerializeHeader(mesg);
+  SerializeBody(mesg);
+  *tail = *shared_tail;
+  SERIALIZE_INT(
+      mesg->data(), start_pos + kHeaderPosLength,
+      mesg->size() - start_pos - kMessageHeaderLength + tail->size());
+}
+
 void CQLResponse::SerializeHeader(faststring* mesg) const {
   uint8_t buffer[kMessageHeaderLength];
   SERIALIZE_BYTE(buffer, kHeaderPosVersion, version());
@@ -1432,7 +1451,7 @@ void RowsResultResponse::SerializeResultBody(faststring* mesg) const {
   SerializeRowsMetadata(
       RowsMetadata(result_->table_name(), result_->column_schemas(),
                    result_->paging_state(), skip_metadata_), mesg);
-  mesg->append(result_->rows_data());
+  // The rows follow, see SharedBodyTail().
 }
 
 //----------------------------------------------------------------------------------------
@@ -1660,7 +1679,7 @@ CQLServerEvent::CQLServerEvent(std::unique_ptr<EventResponse> event_response)
   serialized_response_ = RefCntBuffer(temp);
 }
 
-void CQLServerEvent::Serialize(std::deque<RefCntBuffer>* output) const {
+void CQLServerEvent::Serialize(std::deque<RefCntSlice>* output) const {
   output->push_back(serialized_response_);
 }
 
@@ -1677,7 +1696,7 @@ void CQLServerEventList::Transferred(const Status& status, rpc::Connection*) {
   }
 }
 
-void CQLServerEventList::Serialize(std::deque<RefCntBuffer>* output) const {
+void CQLServerEventList::Serialize(std::deque<RefCntSlice>* output) const {
   for (const auto& cql_server_event : cql_server_events_) {
     cql_server_event->Serialize(output);
   }
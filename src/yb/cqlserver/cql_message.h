@@ -461,6 +461,12 @@ class RegisterRequest : public CQLRequest {
 class CQLResponse : public CQLMessage {
  public:
   virtual void Serialize(faststring* mesg) const;
+
+  // Like Serialize(), but if the end of the body is held in a shared buffer (see
+  // SharedBodyTail()), it is not copied into 'mesg' but returned in 'tail', to be sent right
+  // after 'mesg'. The length in the frame header accounts for it.
+  void SerializeWithSharedTail(faststring* mesg, RefCntSlice* tail) const;
+
   virtual ~CQLResponse();
  protected:
   CQLResponse(const CQLRequest& request, Opcode opcode);
@@ -469,6 +475,10 @@ class CQLResponse : public CQLMessage {
 
   // Function to serialize a response body that all CQLResponse subclasses need to implement
   virtual void SerializeBody(faststring* mesg) const = 0;
+
+  // The end of the body, if the response holds it already serialized in a shared buffer.
+  // SerializeBody() serializes everything before it.
+  virtual const RefCntSlice* SharedBodyTail() const { return nullptr; }
 };
 
 // ------------------------------ Individual CQL responses -----------------------------------
@@ -731,6 +741,9 @@ class RowsResultResponse : public ResultResponse {
  protected:
   virtual void SerializeResultBody(faststring* mesg) const override;
 
+  // The rows, as serialized by the tablet server.
+  virtual const RefCntSlice* SharedBodyTail() const override { return &result_->rows_data(); }
+
  private:
   const ql::RowsResult::SharedPtr result_;
   const bool skip_metadata_;
@@ -901,7 +914,7 @@ class AuthSuccessResponse : public CQLResponse {
 class CQLServerEvent : public rpc::ServerEvent {
  public:
   explicit CQLServerEvent(std::unique_ptr<EventResponse> event_response);
-  void Serialize(std::deque<RefCntBuffer>* output) const override;
+  void Serialize(std::deque<RefCntSlice>* output) const override;
   std::string ToString() const override;
  private:
 
@@ -916,7 +929,7 @@ class CQLServerEventList : public rpc::ServerEventList {
  public:
   CQLServerEventList();
   void AddEvent(std::unique_ptr<CQLServerEvent> event);
-  void Serialize(std::deque<RefCntBuffer>* output) const override;
+  void Serialize(std::deque<RefCntSlice>* output) const override;
   std::string ToString() const override;
  private:
   void Transferred(const Status& status, rpc::Connection*) override;
@@ -19,6 +19,7 @@
 #include "yb/gutil/strings/escaping.h"
 #include "yb/rpc/rpc_context.h"
 #include "yb/util/crypt.h"
+#include "yb/util/flag_tags.h"
 
 METRIC_DEFINE_histogram(
     server, handler_latency_yb_cqlserver_CQLServerService_GetProcessor,
@@ -46,6 +47,18 @@ METRIC_DEFINE_histogram(
 METRIC_DEFINE_counter(
     server, yb_cqlserver_CQLServerService_ParsingErrors, "Errors encountered when parsing ",
     yb::MetricUnit::kRequests, "Errors encountered when parsing ");
+METRIC_DEFINE_counter(
+    server, yb_cqlserver_CQLServerService_AutoParameterizedCacheHits,
+    "Unprepared queries executed with a cached auto-parameterized statement",
+    yb::MetricUnit::kRequests,
+    "Number of unprepared queries executed with a cached auto-parameterized statement, without "
+    "being parsed and analyzed");
+METRIC_DEFINE_counter(
+    server, yb_cqlserver_CQLServerService_AutoParameterizedCacheMisses,
+    "Unprepared queries whose auto-parameterized statement was not cached",
+    yb::MetricUnit::kRequests,
+    "Number of unprepared queries whose auto-parameterized statement was not cached and had to be "
+    "prepared");
 METRIC_DEFINE_histogram(
     server, handler_latency_yb_cqlserver_CQLServerService_Any,
     "yb.cqlserver.CQLServerService.AnyMethod RPC Time", yb::MetricUnit::kMicroseconds,
@@ -54,13 +67,21 @@ METRIC_DEFINE_histogram(
     "RPC requests",
     60000000LU, 2);
 
+DEFINE_bool(cql_auto_parameterize_queries, true,
+            "Execute unprepared DML queries that differ only in their literals through a shared "
+            "prepared statement, in which the literals are replaced by bind markers, to avoid "
+            "parsing and analyzing each of them.");
+TAG_FLAG(cql_auto_parameterize_queries, advanced);
+
 namespace yb {
 namespace cqlserver {
 
 extern const char* const kRoleColumnNameSaltedHash;
 
 using std::shared_ptr;
+using std::string;
 using std::unique_ptr;
+using std::vector;
 
 using client::YBClient;
 using client::YBSession;
@@ -96,6 +117,10 @@ CQLMetrics::CQLMetrics(const scoped_refptr<yb::MetricEntity>& metric_entity)
       METRIC_handler_latency_yb_cqlserver_CQLServerService_Any.Instantiate(metric_entity);
   num_errors_parsing_cql_ =
       METRIC_yb_cqlserver_CQLServerService_ParsingErrors.Instantiate(metric_entity);
+  num_auto_parameterized_cache_hits_ =
+      METRIC_yb_cqlserver_CQLServerService_AutoParameterizedCacheHits.Instantiate(metric_entity);
+  num_auto_parameterized_cache_misses_ =
+      METRIC_yb_cqlserver_CQLServerService_AutoParameterizedCacheMisses.Instantiate(metric_entity);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -150,9 +175,11 @@ void CQLProcessor::SendResponse(const CQLResponse& response) {
   // Serialize the response to return to the CQL client. In case of error, an error response
   // should still be present.
   MonoTime response_begin = MonoTime::Now(MonoTime::FINE);
+  // Rows of a SELECT are passed on in the buffer they were received from the tablet server in.
   faststring msg;
-  response.Serialize(&msg);
-  call_->RespondSuccess(RefCntBuffer(msg), cql_metrics_->rpc_method_metrics_);
+  RefCntSlice rows_data;
+  response.SerializeWithSharedTail(&msg, &rows_data);
+  call_->RespondSuccess(RefCntBuffer(msg), rows_data, cql_metrics_->rpc_method_metrics_);
 
   MonoTime response_done = MonoTime::Now(MonoTime::FINE);
   cql_metrics_->time_to_process_request_->Increment(
@@ -169,6 +196,8 @@ void CQLProcessor::SendResponse(const CQLResponse& response) {
   request_ = nullptr;
   stmts_.clear();
   parse_trees_.clear();
+  auto_parameterized_stmt_ = nullptr;
+  auto_parameterized_params_ = nullptr;
   SetCurrentCall(nullptr);
   Return();
 }
@@ -231,10 +260,86 @@ CQLResponse* CQLProcessor::ProcessExecute(const ExecuteRequest& req) {
 
 CQLResponse* CQLProcessor::ProcessQuery(const QueryRequest& req) {
   VLOG(1) << "QUERY " << req.query();
+  if (FLAGS_cql_auto_parameterize_queries && ExecuteAutoParameterized(req)) {
+    return nullptr;
+  }
   RunAsync(req.query(), req.params(), statement_executed_cb_);
   return nullptr;
 }
 
+bool CQLProcessor::ExecuteAutoParameterized(const QueryRequest& req) {
+  // Queries with bind values are left alone, and so is a retry after stale metadata, which is
+  // parsed and analyzed again by itself.
+  if (!req.params().values.empty() || retry_count_ > 0) {
+    return false;
+  }
+  string normalized;
+  vector<QueryLiteral> literals;
+  if (!AutoParameterizeQuery(req.query(), &normalized, &literals)) {
+    return false;
+  }
+
+  const CQLMessage::QueryId query_id = CQLStatement::GetQueryId(
+      ql_env_.CurrentKeyspace(), normalized);
+  shared_ptr<const CQLStatement> stmt = service_impl_->GetAutoParameterizedStatement(query_id);
+  const bool cached = stmt != nullptr;
+  if (!cached) {
+    if (service_impl_->IsUnparameterizableQuery(query_id)) {
+      return false;
+    }
+    cql_metrics_->num_auto_parameterized_cache_misses_->Increment();
+    // The statement is cached apart from the ones prepared by clients, so that ad-hoc queries
+    // don't evict those.
+    shared_ptr<CQLStatement> new_stmt = service_impl_->AllocateAutoParameterizedStatement(
+        query_id, ql_env_.CurrentKeyspace(), normalized);
+    const Status s = new_stmt->Prepare(
+        this, service_impl_->auto_parameterized_stmts_mem_tracker());
+    if (!s.ok()) {
+      service_impl_->DeleteAutoParameterizedStatement(new_stmt);
+      // A missing object or stale metadata may be gone the next time. Otherwise the literals are
+      // in places where bind markers are not accepted.
+      const bool transient = s.IsQLError() &&
+                             (GetErrorCode(s) == ErrorCode::STALE_METADATA ||
+                              GetErrorCode(s) == ErrorCode::TABLE_NOT_FOUND ||
+                              GetErrorCode(s) == ErrorCode::KEYSPACE_NOT_FOUND ||
+                              GetErrorCode(s) == ErrorCode::TYPE_NOT_FOUND);
+      if (!transient) {
+        service_impl_->AddUnparameterizableQuery(query_id);
+      }
+      return false;
+    }
+    stmt = new_stmt;
+  }
+
+  // Literals that cannot be bound as the datatypes of their bind variables, e.g. a string for a
+  // timestamp column or an out of range number, are left to the regular path to convert or reject.
+  vector<std::shared_ptr<QLType>> types;
+  if (!stmt->GetBindVariableTypes(&types).ok() || types.size() != literals.size()) {
+    return false;
+  }
+  vector<QLValuePB> values(literals.size());
+  for (size_t i = 0; i < literals.size(); i++) {
+    if (types[i] == nullptr || !literals[i].ToQLValue(types[i], &values[i])) {
+      return false;
+    }
+  }
+
+  // Only count a hit when the cached statement is actually executed, not when the query falls back
+  // to the regular path above.
+  if (cached) {
+    cql_metrics_->num_auto_parameterized_cache_hits_->Increment();
+  }
+  stmt->clear_reparsed();
+  auto_parameterized_stmt_ = stmt;
+  auto_parameterized_params_.reset(
+      new AutoParameterizedQueryParameters(req.params(), std::move(values)));
+  const Status s = stmt->ExecuteAsync(this, *auto_parameterized_params_, statement_executed_cb_);
+  if (PREDICT_FALSE(!s.ok())) {
+    StatementExecuted(s);
+  }
+  return true;
+}
+
 CQLResponse* CQLProcessor::ProcessBatch(const BatchRequest& req) {
   VLOG(1) << "BATCH " << req.queries().size();
 
@@ -337,6 +442,11 @@ CQLResponse* CQLProcessor::ProcessResult(Status s, const ExecutedResult::SharedP
             unprepared_id_ = stmt->query_id();
           }
         }
+        // The client does not know about the auto-parameterized statement of its query, so it is
+        // just dropped and the query is retried below.
+        if (auto_parameterized_stmt_ != nullptr && auto_parameterized_stmt_->stale()) {
+          service_impl_->DeleteAutoParameterizedStatement(auto_parameterized_stmt_);
+        }
         if (!unprepared_id_.empty()) {
           return new UnpreparedErrorResponse(*request_, unprepared_id_);
         }
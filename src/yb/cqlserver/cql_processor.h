@@ -45,6 +45,8 @@ class CQLMetrics : public ql::QLMetrics {
 
   scoped_refptr<yb::Histogram> time_to_queue_cql_response_;
   scoped_refptr<yb::Counter> num_errors_parsing_cql_;
+  scoped_refptr<yb::Counter> num_auto_parameterized_cache_hits_;
+  scoped_refptr<yb::Counter> num_auto_parameterized_cache_misses_;
   // Rpc level metrics
   yb::rpc::RpcMethodMetrics rpc_method_metrics_;
 };
@@ -75,6 +77,11 @@ class CQLProcessor : public ql::QLProcessor {
   CQLResponse* ProcessBatch(const BatchRequest& req);
   CQLResponse* ProcessAuthResponse(const AuthResponseRequest& req);
 
+  // Execute an unprepared query through the cached statement of its auto-parameterized text,
+  // preparing the statement if it is not cached yet. Returns false if the query cannot be executed
+  // that way and has to be parsed and analyzed by itself.
+  bool ExecuteAutoParameterized(const QueryRequest& req);
+
   // Get a prepared statement and adds it to the set of statements currently being executed.
   std::shared_ptr<const CQLStatement> GetPreparedStatement(const CQLMessage::QueryId& id);
 
@@ -107,6 +114,10 @@ class CQLProcessor : public ql::QLProcessor {
   std::unordered_set<std::shared_ptr<const CQLStatement>> stmts_;
   std::unordered_set<ql::ParseTree::UniPtr> parse_trees_;
 
+  // Auto-parameterized statement of the unprepared query being executed and its parameters.
+  std::shared_ptr<const CQLStatement> auto_parameterized_stmt_;
+  std::unique_ptr<AutoParameterizedQueryParameters> auto_parameterized_params_;
+
   // Current retry count.
   int retry_count_ = 0;
 
@@ -161,11 +161,14 @@ const std::string& CQLInboundCall::method_name() const {
   return result;
 }
 
-void CQLInboundCall::Serialize(std::deque<RefCntBuffer>* output) const {
+void CQLInboundCall::Serialize(std::deque<RefCntSlice>* output) const {
   TRACE_EVENT0("rpc", "CQLInboundCall::Serialize");
   CHECK_GT(response_msg_buf_.size(), 0);
 
   output->push_back(response_msg_buf_);
+  if (!response_msg_tail_.empty()) {
+    output->push_back(response_msg_tail_);
+  }
 }
 
 void CQLInboundCall::RespondFailure(rpc::ErrorStatusPB::RpcErrorCodePB error_code,
@@ -195,14 +198,16 @@ void CQLInboundCall::RespondFailure(rpc::ErrorStatusPB::RpcErrorCodePB error_cod
     }
   }
   response_msg_buf_ = RefCntBuffer(msg);
+  response_msg_tail_.Reset();
 
   QueueResponse(false);
 }
 
-void CQLInboundCall::RespondSuccess(const RefCntBuffer& buffer,
+void CQLInboundCall::RespondSuccess(const RefCntBuffer& buffer, const RefCntSlice& tail,
                                     const yb::rpc::RpcMethodMetrics& metrics) {
   RecordHandlingCompleted(metrics.handler_latency);
   response_msg_buf_ = buffer;
+  response_msg_tail_ = tail;
 
   QueueResponse(true);
 }
@@ -71,7 +71,7 @@ class CQLInboundCall : public rpc::InboundCall {
 
   // Serialize the response packet for the finished call.
   // The resulting slices refer to memory in this object.
-  void Serialize(std::deque<RefCntBuffer>* output) const override;
+  void Serialize(std::deque<RefCntSlice>* output) const override;
 
   void LogTrace() const override;
   std::string ToString() const override;
@@ -100,7 +100,9 @@ class CQLInboundCall : public rpc::InboundCall {
   const std::string& service_name() const override;
   const std::string& method_name() const override;
   void RespondFailure(rpc::ErrorStatusPB::RpcErrorCodePB error_code, const Status& status) override;
-  void RespondSuccess(const RefCntBuffer& buffer, const yb::rpc::RpcMethodMetrics& metrics);
+  // 'tail', if not empty, is sent right after 'buffer' as the end of the same response frame.
+  void RespondSuccess(const RefCntBuffer& buffer, const RefCntSlice& tail,
+                      const yb::rpc::RpcMethodMetrics& metrics);
   void GetCallDetails(rpc::RpcCallInProgressPB *call_in_progress_pb);
   void SetRequest(std::shared_ptr<const CQLRequest> request, CQLServiceImpl* service_impl) {
     service_impl_ = service_impl;
@@ -116,6 +118,9 @@ class CQLInboundCall : public rpc::InboundCall {
 
   Callback<void(void)>* resume_from_ = nullptr;
   RefCntBuffer response_msg_buf_;
+  // End of the response frame that is shared with the result it came from, e.g. the rows of a
+  // SELECT as received from the tablet server.
+  RefCntSlice response_msg_tail_;
   ql::QLSession::SharedPtr ql_session_;
   uint16_t stream_id_;
   std::shared_ptr<const CQLRequest> request_;
@@ -32,6 +32,10 @@
 DEFINE_int64(cql_service_max_prepared_statement_size_bytes, 0,
              "The maximum amount of memory the CQL proxy should use to maintain prepared "
              "statements. 0 or negative means unlimited.");
+DEFINE_int64(cql_service_max_auto_parameterized_statement_size_bytes, 64 * 1024 * 1024,
+             "The maximum amount of memory the CQL proxy should use to maintain the statements "
+             "of auto-parameterized unprepared queries, separately from the statements prepared "
+             "by clients. 0 or negative means unlimited.");
 DEFINE_int32(cql_ybclient_reactor_threads, 24,
              "The number of reactor threads to be used for processing ybclient "
              "requests originating in the cql layer");
@@ -66,14 +70,11 @@ CQLServiceImpl::CQLServiceImpl(CQLServer* server, const CQLServerOptions& opts)
   // TODO(ENG-446): Handle metrics for all the methods individually.
   cql_metrics_ = std::make_shared<CQLMetrics>(server->metric_entity());
 
-  // Setup prepared statements' memory tracker. Add garbage-collect function to delete least
-  // recently used statements when limit is hit.
-  prepared_stmts_mem_tracker_ = MemTracker::CreateTracker(
-      FLAGS_cql_service_max_prepared_statement_size_bytes > 0 ?
-      FLAGS_cql_service_max_prepared_statement_size_bytes : -1,
-      "CQL prepared statements' memory usage", server->mem_tracker());
-  prepared_stmts_mem_tracker_->AddGcFunction(
-      std::bind(&CQLServiceImpl::DeleteLruPreparedStatement, this));
+  InitStatementCache(&prepared_stmts_, FLAGS_cql_service_max_prepared_statement_size_bytes,
+                     "CQL prepared statements' memory usage");
+  InitStatementCache(&auto_parameterized_stmts_,
+                     FLAGS_cql_service_max_auto_parameterized_statement_size_bytes,
+                     "CQL auto-parameterized statements' memory usage");
 
   auth_prepared_stmt_ = std::make_shared<ql::Statement>(
       "",
@@ -153,41 +154,80 @@ void CQLServiceImpl::ReturnProcessor(const CQLProcessorListPos& pos) {
   next_available_processor_ = pos;
 }
 
+void CQLServiceImpl::InitStatementCache(
+    StatementCache* cache, int64_t limit, const string& tracker_id) {
+  // Setup the statements' memory tracker. Add garbage-collect function to delete least recently
+  // used statements when limit is hit.
+  cache->mem_tracker = MemTracker::CreateTracker(
+      limit > 0 ? limit : -1, tracker_id, server_->mem_tracker());
+  cache->mem_tracker->AddGcFunction(
+      std::bind(&CQLServiceImpl::DeleteLruStatement, this, cache));
+}
+
 shared_ptr<CQLStatement> CQLServiceImpl::AllocatePreparedStatement(
     const CQLMessage::QueryId& query_id, const string& keyspace, const string& ql_stmt) {
-  // Get exclusive lock before allocating a prepared statement and updating the LRU list.
+  return AllocateStatement(&prepared_stmts_, query_id, keyspace, ql_stmt);
+}
+
+shared_ptr<const CQLStatement> CQLServiceImpl::GetPreparedStatement(
+    const CQLMessage::QueryId& query_id) {
+  return GetStatement(&prepared_stmts_, query_id);
+}
+
+void CQLServiceImpl::DeletePreparedStatement(const shared_ptr<const CQLStatement>& stmt) {
+  DeleteStatement(&prepared_stmts_, stmt);
+}
+
+shared_ptr<CQLStatement> CQLServiceImpl::AllocateAutoParameterizedStatement(
+    const CQLMessage::QueryId& query_id, const string& keyspace, const string& ql_stmt) {
+  return AllocateStatement(&auto_parameterized_stmts_, query_id, keyspace, ql_stmt);
+}
+
+shared_ptr<const CQLStatement> CQLServiceImpl::GetAutoParameterizedStatement(
+    const CQLMessage::QueryId& query_id) {
+  return GetStatement(&auto_parameterized_stmts_, query_id);
+}
+
+void CQLServiceImpl::DeleteAutoParameterizedStatement(const shared_ptr<const CQLStatement>& stmt) {
+  DeleteStatement(&auto_parameterized_stmts_, stmt);
+}
+
+shared_ptr<CQLStatement> CQLServiceImpl::AllocateStatement(
+    StatementCache* cache, const CQLMessage::QueryId& query_id, const string& keyspace,
+    const string& ql_stmt) {
+  // Get exclusive lock before allocating a statement and updating the LRU list.
   std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
 
   shared_ptr<CQLStatement> stmt;
-  const auto itr = prepared_stmts_map_.find(query_id);
-  if (itr == prepared_stmts_map_.end()) {
+  const auto itr = cache->map.find(query_id);
+  if (itr == cache->map.end()) {
     // Allocate the prepared statement placeholder that multiple clients trying to prepare the same
     // statement to contend on. The statement will then be prepared by one client while the rest
     // wait for the results.
-    stmt = prepared_stmts_map_.emplace(
+    stmt = cache->map.emplace(
         query_id, std::make_shared<CQLStatement>(
-            keyspace, ql_stmt, prepared_stmts_list_.end())).first->second;
-    InsertLruPreparedStatementUnlocked(stmt);
+            keyspace, ql_stmt, cache->list.end())).first->second;
+    InsertLruStatementUnlocked(cache, stmt);
   } else {
     // Return existing statement if found.
     stmt = itr->second;
-    MoveLruPreparedStatementUnlocked(stmt);
+    MoveLruStatementUnlocked(cache, stmt);
   }
 
-  VLOG(1) << "InsertPreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
-          << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
+  VLOG(1) << "InsertPreparedStatement: CQL " << cache->name << " statement cache count = "
+          << cache->map.size() << "/" << cache->list.size()
+          << ", memory usage = " << cache->mem_tracker->consumption();
 
   return stmt;
 }
 
-shared_ptr<const CQLStatement> CQLServiceImpl::GetPreparedStatement(
-    const CQLMessage::QueryId& query_id) {
-  // Get exclusive lock before looking up a prepared statement and updating the LRU list.
+shared_ptr<const CQLStatement> CQLServiceImpl::GetStatement(
+    StatementCache* cache, const CQLMessage::QueryId& query_id) {
+  // Get exclusive lock before looking up a statement and updating the LRU list.
   std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
 
-  const auto itr = prepared_stmts_map_.find(query_id);
-  if (itr == prepared_stmts_map_.end()) {
+  const auto itr = cache->map.find(query_id);
+  if (itr == cache->map.end()) {
     return nullptr;
   }
 
@@ -199,64 +239,80 @@ shared_ptr<const CQLStatement> CQLServiceImpl::GetPreparedStatement(
   }
   // If the statement is stale, delete it.
   if (stmt->stale()) {
-    DeletePreparedStatementUnlocked(stmt);
+    DeleteStatementUnlocked(cache, stmt);
     return nullptr;
   }
 
-  MoveLruPreparedStatementUnlocked(stmt);
+  MoveLruStatementUnlocked(cache, stmt);
   return stmt;
 }
 
-void CQLServiceImpl::DeletePreparedStatement(const shared_ptr<const CQLStatement>& stmt) {
-  // Get exclusive lock before deleting the prepared statement.
+void CQLServiceImpl::DeleteStatement(
+    StatementCache* cache, const shared_ptr<const CQLStatement>& stmt) {
+  // Get exclusive lock before deleting the statement.
   std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
 
-  DeletePreparedStatementUnlocked(stmt);
+  DeleteStatementUnlocked(cache, stmt);
 
-  VLOG(1) << "DeletePreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
-          << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
+  VLOG(1) << "DeletePreparedStatement: CQL " << cache->name << " statement cache count = "
+          << cache->map.size() << "/" << cache->list.size()
+          << ", memory usage = " << cache->mem_tracker->consumption();
+}
+
+void CQLServiceImpl::AddUnparameterizableQuery(const CQLMessage::QueryId& query_id) {
+  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  if (unparameterizable_queries_.size() >= kMaxUnparameterizableQueries) {
+    unparameterizable_queries_.clear();
+  }
+  unparameterizable_queries_.insert(query_id);
+}
+
+bool CQLServiceImpl::IsUnparameterizableQuery(const CQLMessage::QueryId& query_id) {
+  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  return unparameterizable_queries_.count(query_id) != 0;
 }
 
-void CQLServiceImpl::InsertLruPreparedStatementUnlocked(const shared_ptr<CQLStatement>& stmt) {
+void CQLServiceImpl::InsertLruStatementUnlocked(
+    StatementCache* cache, const shared_ptr<CQLStatement>& stmt) {
   // Insert the statement at the front of the LRU list.
-  stmt->set_pos(prepared_stmts_list_.insert(prepared_stmts_list_.begin(), stmt));
+  stmt->set_pos(cache->list.insert(cache->list.begin(), stmt));
 }
 
-void CQLServiceImpl::MoveLruPreparedStatementUnlocked(const shared_ptr<CQLStatement>& stmt) {
+void CQLServiceImpl::MoveLruStatementUnlocked(
+    StatementCache* cache, const shared_ptr<CQLStatement>& stmt) {
   // Move the statement to the front of the LRU list.
-  prepared_stmts_list_.splice(prepared_stmts_list_.begin(), prepared_stmts_list_, stmt->pos());
+  cache->list.splice(cache->list.begin(), cache->list, stmt->pos());
 }
 
-void CQLServiceImpl::DeletePreparedStatementUnlocked(
-    const std::shared_ptr<const CQLStatement> stmt) {
+void CQLServiceImpl::DeleteStatementUnlocked(
+    StatementCache* cache, const std::shared_ptr<const CQLStatement> stmt) {
   // Remove statement from cache by looking it up by query ID and only when it is same statement
   // object. Note that the "stmt" parameter above is not a ref ("&") intentionally so that we have
-  // a separate copy of the shared_ptr and not the very shared_ptr in prepared_stmts_map_ or
-  // prepared_stmt_list_ we are deleting.
-  const auto itr = prepared_stmts_map_.find(stmt->query_id());
-  if (itr != prepared_stmts_map_.end() && itr->second == stmt) {
-    prepared_stmts_map_.erase(itr);
+  // a separate copy of the shared_ptr and not the very shared_ptr in the map or the list we are
+  // deleting.
+  const auto itr = cache->map.find(stmt->query_id());
+  if (itr != cache->map.end() && itr->second == stmt) {
+    cache->map.erase(itr);
   }
   // Remove statement from LRU list only when it is in the list, i.e. pos() != end().
-  if (stmt->pos() != prepared_stmts_list_.end()) {
-    prepared_stmts_list_.erase(stmt->pos());
-    stmt->set_pos(prepared_stmts_list_.end());
+  if (stmt->pos() != cache->list.end()) {
+    cache->list.erase(stmt->pos());
+    stmt->set_pos(cache->list.end());
   }
 }
 
-void CQLServiceImpl::DeleteLruPreparedStatement() {
+void CQLServiceImpl::DeleteLruStatement(StatementCache* cache) {
   // Get exclusive lock before deleting the least recently used statement at the end of the LRU
   // list from the cache.
   std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
 
-  if (!prepared_stmts_list_.empty()) {
-    DeletePreparedStatementUnlocked(prepared_stmts_list_.back());
+  if (!cache->list.empty()) {
+    DeleteStatementUnlocked(cache, cache->list.back());
   }
 
-  VLOG(1) << "DeleteLruPreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
-          << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
+  VLOG(1) << "DeleteLruPreparedStatement: CQL " << cache->name << " statement cache count = "
+          << cache->map.size() << "/" << cache->list.size()
+          << ", memory usage = " << cache->mem_tracker->consumption();
 }
 
 }  // namespace cqlserver
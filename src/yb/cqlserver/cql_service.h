@@ -17,6 +17,7 @@
 #ifndef YB_CQLSERVER_CQL_SERVICE_H_
 #define YB_CQLSERVER_CQL_SERVICE_H_
 
+#include <unordered_set>
 #include <vector>
 
 #include "yb/cqlserver/cql_message.h"
@@ -73,9 +74,29 @@ class CQLServiceImpl : public CQLServerServiceIf {
   // Delete the prepared statement from the cache.
   void DeletePreparedStatement(const std::shared_ptr<const CQLStatement>& stmt);
 
+  // Same as the above for the statements of auto-parameterized unprepared queries. They are kept
+  // in a cache of their own, so that the shapes of ad-hoc queries don't evict the statements
+  // prepared by clients.
+  std::shared_ptr<CQLStatement> AllocateAutoParameterizedStatement(
+      const CQLMessage::QueryId& id, const std::string& keyspace, const std::string& ql_stmt);
+  std::shared_ptr<const CQLStatement> GetAutoParameterizedStatement(const CQLMessage::QueryId& id);
+  void DeleteAutoParameterizedStatement(const std::shared_ptr<const CQLStatement>& stmt);
+
+  // Record that the auto-parameterized statement of an unprepared query with the given id failed
+  // to prepare, so that it is not tried again.
+  void AddUnparameterizableQuery(const CQLMessage::QueryId& id);
+
+  // Return true if the auto-parameterized statement with the given id failed to prepare before.
+  bool IsUnparameterizableQuery(const CQLMessage::QueryId& id);
+
   // Return the memory tracker for prepared statements.
   std::shared_ptr<MemTracker> prepared_stmts_mem_tracker() const {
-    return prepared_stmts_mem_tracker_;
+    return prepared_stmts_.mem_tracker;
+  }
+
+  // Return the memory tracker for the statements of auto-parameterized queries.
+  std::shared_ptr<MemTracker> auto_parameterized_stmts_mem_tracker() const {
+    return auto_parameterized_stmts_.mem_tracker;
   }
 
   // Return the YBClient to communicate with either master or tserver.
@@ -96,23 +117,56 @@ class CQLServiceImpl : public CQLServerServiceIf {
  private:
   constexpr static int kRpcTimeoutSec = 5;
 
+  // Maximum number of unparameterizable queries remembered.
+  constexpr static size_t kMaxUnparameterizableQueries = 10000;
+
+  // A cache of statements by their ids, with an LRU list of them and a memory tracker to limit
+  // their memory usage.
+  struct StatementCache {
+    // Name of the statements in log messages.
+    const char* name;
+
+    // Statements by their ids.
+    CQLStatementMap map;
+
+    // LRU list of the statements (least recently used one at the end).
+    CQLStatementList list;
+
+    // Tracker to measure and limit memory usage of the statements.
+    std::shared_ptr<MemTracker> mem_tracker;
+  };
+
   // Either gets an available processor or creates a new one.
   CQLProcessor *GetProcessor();
 
-  // Insert a prepared statement at the front of the LRU list. "prepared_stmts_mutex_" needs to be
+  // Sets up the memory tracker of the cache with the given limit, deleting least recently used
+  // statements when the limit is hit.
+  void InitStatementCache(StatementCache* cache, int64_t limit, const std::string& tracker_id);
+
+  std::shared_ptr<CQLStatement> AllocateStatement(
+      StatementCache* cache, const CQLMessage::QueryId& id, const std::string& keyspace,
+      const std::string& ql_stmt);
+
+  std::shared_ptr<const CQLStatement> GetStatement(
+      StatementCache* cache, const CQLMessage::QueryId& id);
+
+  void DeleteStatement(StatementCache* cache, const std::shared_ptr<const CQLStatement>& stmt);
+
+  // Insert a statement at the front of the LRU list. "prepared_stmts_mutex_" needs to be
   // locked before this call.
-  void InsertLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
+  void InsertLruStatementUnlocked(StatementCache* cache, const std::shared_ptr<CQLStatement>& stmt);
 
-  // Move a prepared statement to the front of the LRU list. "prepared_stmts_mutex_" needs to be
+  // Move a statement to the front of the LRU list. "prepared_stmts_mutex_" needs to be
   // locked before this call.
-  void MoveLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
+  void MoveLruStatementUnlocked(StatementCache* cache, const std::shared_ptr<CQLStatement>& stmt);
 
-  // Delete a prepared statement from the cache and the LRU list. "prepared_stmts_mutex_" needs to
+  // Delete a statement from the cache and the LRU list. "prepared_stmts_mutex_" needs to
   // be locked before this call.
-  void DeletePreparedStatementUnlocked(const std::shared_ptr<const CQLStatement> stmt);
+  void DeleteStatementUnlocked(StatementCache* cache,
+                               const std::shared_ptr<const CQLStatement> stmt);
 
-  // Delete the least recently used prepared statement from the cache to free up memory.
-  void DeleteLruPreparedStatement();
+  // Delete the least recently used statement from the cache to free up memory.
+  void DeleteLruStatement(StatementCache* cache);
 
   // CQLServer of this service.
   CQLServer* const server_;
@@ -135,20 +189,20 @@ class CQLServiceImpl : public CQLServerServiceIf {
   // Mutex that protects access to processors_.
   std::mutex processors_mutex_;
 
-  // Prepared statements cache.
-  CQLStatementMap prepared_stmts_map_;
+  // Statements prepared by clients.
+  StatementCache prepared_stmts_{"prepared"};
 
-  // Prepared statements LRU list (least recently used one at the end).
-  CQLStatementList prepared_stmts_list_;
+  // Statements of auto-parameterized unprepared queries.
+  StatementCache auto_parameterized_stmts_{"auto-parameterized"};
 
-  // Mutex that protects the prepared statements and the LRU list.
+  // Ids of auto-parameterized statements that failed to prepare. Cleared when it grows too large.
+  std::unordered_set<CQLMessage::QueryId> unparameterizable_queries_;
+
+  // Mutex that protects the statement caches and the unparameterizable queries.
   std::mutex prepared_stmts_mutex_;
 
   std::shared_ptr<ql::Statement> auth_prepared_stmt_;
 
-  // Tracker to measure and limit memory usage of prepared statements.
-  std::shared_ptr<MemTracker> prepared_stmts_mem_tracker_;
-
   // Metrics to be collected and reported.
   yb::rpc::RpcMethodMetrics metrics_;
 
@@ -17,9 +17,15 @@
 
 #include <openssl/md5.h>
 
+#include "yb/gutil/strings/numbers.h"
+#include "yb/util/string_case.h"
+
 namespace yb {
 namespace cqlserver {
 
+using std::string;
+using std::vector;
+
 //------------------------------------------------------------------------------------------------
 CQLStatement::CQLStatement(
     const string& keyspace, const string& ql_stmt, const CQLStatementListPos pos)
@@ -39,5 +45,231 @@ CQLMessage::QueryId CQLStatement::GetQueryId(const string& keyspace, const strin
   return CQLMessage::QueryId(util::to_char_ptr(md5), sizeof(md5));
 }
 
+//------------------------------------------------------------------------------------------------
+namespace {
+
+bool IsIdentifierStart(const char c) {
+  return isalpha(c) || c == '_';
+}
+
+bool IsIdentifierChar(const char c) {
+  return isalnum(c) || c == '_';
+}
+
+// Returns the last non-space character of the normalized text, or '\0' if there is none.
+char LastNonSpace(const string& normalized) {
+  const size_t pos = normalized.find_last_not_of(' ');
+  return pos == string::npos ? '\0' : normalized[pos];
+}
+
+bool IsOperatorOrSeparator(const char c) {
+  return c != '\0' && strchr("=<>(,[{+-*/%", c) != nullptr;
+}
+
+// Scans a numeric literal starting at pos: digits with an optional fraction and exponent. Returns
+// the position after the literal.
+size_t ScanNumber(const string& query, size_t pos) {
+  const auto scan_digits = [&query](size_t p) {
+    while (p < query.size() && isdigit(query[p])) {
+      p++;
+    }
+    return p;
+  };
+  pos = scan_digits(pos);
+  if (pos + 1 < query.size() && query[pos] == '.' && isdigit(query[pos + 1])) {
+    pos = scan_digits(pos + 1);
+  }
+  if (pos < query.size() && (query[pos] == 'e' || query[pos] == 'E')) {
+    size_t exp = pos + 1;
+    if (exp < query.size() && (query[exp] == '+' || query[exp] == '-')) {
+      exp++;
+    }
+    if (exp < query.size() && isdigit(query[exp])) {
+      pos = scan_digits(exp);
+    }
+  }
+  return pos;
+}
+
+} // namespace
+
+bool AutoParameterizeQuery(
+    const string& query, string* normalized, vector<QueryLiteral>* literals) {
+  normalized->clear();
+  literals->clear();
+
+  // Only DML statements accept bind markers in place of their constants.
+  size_t pos = 0;
+  while (pos < query.size() && isspace(query[pos])) {
+    pos++;
+  }
+  size_t end = pos;
+  while (end < query.size() && IsIdentifierChar(query[end])) {
+    end++;
+  }
+  string keyword;
+  ToLowerCase(query.substr(pos, end - pos), &keyword);
+  if (keyword != "select" && keyword != "insert" && keyword != "update" && keyword != "delete") {
+    return false;
+  }
+
+  normalized->reserve(query.size());
+  while (pos < query.size()) {
+    const char c = query[pos];
+    const char next = pos + 1 < query.size() ? query[pos + 1] : '\0';
+
+    if (isspace(c)) {
+      while (pos < query.size() && isspace(query[pos])) {
+        pos++;
+      }
+      if (pos < query.size()) {
+        normalized->push_back(' ');
+      }
+
+    } else if (c == '\'') {
+      // String literal, in which a quote is escaped by doubling it.
+      QueryLiteral literal{QueryLiteral::Kind::kString, ""};
+      pos++;
+      for (;;) {
+        if (pos == query.size()) {
+          return false;
+        }
+        if (query[pos] == '\'') {
+          if (pos + 1 < query.size() && query[pos + 1] == '\'') {
+            literal.text.push_back('\'');
+            pos += 2;
+            continue;
+          }
+          pos++;
+          break;
+        }
+        literal.text.push_back(query[pos++]);
+      }
+      literals->push_back(std::move(literal));
+      normalized->push_back('?');
+
+    } else if (c == '"') {
+      // Quoted identifier, kept as is.
+      end = pos + 1;
+      for (;;) {
+        end = query.find('"', end);
+        if (end == string::npos) {
+          return false;
+        }
+        end++;
+        if (end < query.size() && query[end] == '"') {
+          end++;
+          continue;
+        }
+        break;
+      }
+      normalized->append(query, pos, end - pos);
+      pos = end;
+
+    } else if (IsIdentifierStart(c)) {
+      end = pos;
+      while (end < query.size() && IsIdentifierChar(query[end])) {
+        end++;
+      }
+      normalized->append(query, pos, end - pos);
+      pos = end;
+
+    } else if (isdigit(c) ||
+               (c == '-' && isdigit(next) && IsOperatorOrSeparator(LastNonSpace(*normalized)))) {
+      // Numeric literal, with its sign when it follows an operator or a separator.
+      end = ScanNumber(query, c == '-' ? pos + 1 : pos);
+      // Hex blobs, UUIDs and durations start like numbers but are not handled.
+      if (end < query.size() && IsIdentifierChar(query[end])) {
+        return false;
+      }
+      literals->push_back(QueryLiteral{QueryLiteral::Kind::kNumber, query.substr(pos, end - pos)});
+      normalized->push_back('?');
+      pos = end;
+
+    } else if (c == '?' || c == ':' || c == '$' ||
+               (c == '-' && next == '-') || (c == '/' && (next == '/' || next == '*'))) {
+      // Bind markers, dollar-quoted strings and comments.
+      return false;
+
+    } else {
+      normalized->push_back(c);
+      pos++;
+    }
+  }
+  return true;
+}
+
+bool QueryLiteral::ToQLValue(const std::shared_ptr<QLType>& type, QLValuePB* value) const {
+  switch (kind) {
+    case Kind::kString:
+      if (type->main() == DataType::STRING) {
+        QLValue::set_string_value(text, value);
+        return true;
+      }
+      return false;
+
+    case Kind::kNumber: {
+      int64_t int_value = 0;
+      double double_value = 0;
+      switch (type->main()) {
+        case DataType::INT8:
+          if (!safe_strto64(text, &int_value) ||
+              int_value < INT8_MIN || int_value > INT8_MAX) {
+            return false;
+          }
+          QLValue::set_int8_value(int_value, value);
+          return true;
+        case DataType::INT16:
+          if (!safe_strto64(text, &int_value) ||
+              int_value < INT16_MIN || int_value > INT16_MAX) {
+            return false;
+          }
+          QLValue::set_int16_value(int_value, value);
+          return true;
+        case DataType::INT32:
+          if (!safe_strto64(text, &int_value) ||
+              int_value < INT32_MIN || int_value > INT32_MAX) {
+            return false;
+          }
+          QLValue::set_int32_value(int_value, value);
+          return true;
+        case DataType::INT64:
+          if (!safe_strto64(text, &int_value)) {
+            return false;
+          }
+          QLValue::set_int64_value(int_value, value);
+          return true;
+        case DataType::FLOAT:
+          if (!safe_strtod(text, &double_value)) {
+            return false;
+          }
+          QLValue::set_float_value(double_value, value);
+          return true;
+        case DataType::DOUBLE:
+          if (!safe_strtod(text, &double_value)) {
+            return false;
+          }
+          QLValue::set_double_value(double_value, value);
+          return true;
+        default:
+          return false;
+      }
+    }
+  }
+  return false;
+}
+
+Status AutoParameterizedQueryParameters::GetBindVariable(const std::string& name,
+                                                         const int64_t pos,
+                                                         const std::shared_ptr<QLType>& type,
+                                                         QLValue* value) const {
+  if (pos < 0 || pos >= literal_values_.size()) {
+    // Return error with 1-based position.
+    return STATUS_SUBSTITUTE(RuntimeError, "Bind variable at position $0 not found", pos + 1);
+  }
+  *value = literal_values_[pos];
+  return Status::OK();
+}
+
 }  // namespace cqlserver
 }  // namespace yb
@@ -20,6 +20,7 @@
 #define YB_CQLSERVER_CQL_STATEMENT_H_
 
 #include <list>
+#include <vector>
 
 #include "yb/cqlserver/cql_message.h"
 #include "yb/ql/statement.h"
@@ -59,6 +60,45 @@ class CQLStatement : public ql::Statement {
   mutable CQLStatementListPos pos_;
 };
 
+// A constant inlined in the text of an unprepared query.
+struct QueryLiteral {
+  enum class Kind {
+    kString,
+    kNumber
+  };
+
+  Kind kind;
+  std::string text;
+
+  // Converts the literal to a value of the given datatype. Returns false if the datatype is not
+  // one the literal can be bound as.
+  bool ToQLValue(const std::shared_ptr<QLType>& type, QLValuePB* value) const;
+};
+
+// Auto-parameterizes the text of an unprepared SELECT, INSERT, UPDATE or DELETE query by replacing
+// its string and numeric literals with bind markers and collapsing whitespace, so that queries
+// differing only in their constants map to the same statement. Returns false if the query is not
+// such a statement or contains constructs that are not handled, e.g. bind markers or comments.
+bool AutoParameterizeQuery(
+    const std::string& query, std::string* normalized, std::vector<QueryLiteral>* literals);
+
+// Parameters of an auto-parameterized query: the literals removed from the query text as bind
+// variables, plus the parameters of the original QUERY request.
+class AutoParameterizedQueryParameters : public CQLMessage::QueryParameters {
+ public:
+  AutoParameterizedQueryParameters(
+      const CQLMessage::QueryParameters& params, std::vector<QLValuePB> values)
+      : CQLMessage::QueryParameters(params), literal_values_(std::move(values)) {}
+
+  CHECKED_STATUS GetBindVariable(const std::string& name,
+                                 int64_t pos,
+                                 const std::shared_ptr<QLType>& type,
+                                 QLValue* value) const override;
+
+ private:
+  const std::vector<QLValuePB> literal_values_;
+};
+
 }  // namespace cqlserver
 }  // namespace yb
 
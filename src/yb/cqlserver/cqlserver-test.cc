@@ -20,12 +20,17 @@
 
 #include "yb/cqlserver/cql_message.h"
 #include "yb/cqlserver/cql_server.h"
+#include "yb/cqlserver/cql_statement.h"
 
 #include "yb/gutil/strings/join.h"
 #include "yb/util/cast.h"
+#include "yb/util/metrics.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/test_util.h"
 
+METRIC_DECLARE_counter(yb_cqlserver_CQLServerService_AutoParameterizedCacheHits);
+METRIC_DECLARE_counter(yb_cqlserver_CQLServerService_AutoParameterizedCacheMisses);
+
 namespace yb {
 namespace cqlserver {
 
@@ -45,6 +50,13 @@ class TestCQLService : public YBTableTestBase {
 
   void SendRequestAndExpectResponse(const string& cmd, const string& resp);
 
+  // Send a V4 QUERY request and return the opcode and the body of the response.
+  Status SendQuery(const string& query, uint8_t* opcode, string* body);
+
+  int64_t GetCounter(const CounterPrototype& prototype) {
+    return prototype.Instantiate(server_->metric_entity())->value();
+  }
+
   int server_port() { return cql_server_port_; }
  private:
   Status SendRequestAndGetResponse(
@@ -120,6 +132,49 @@ Status TestCQLService::SendRequestAndGetResponse(
   return Status::OK();
 }
 
+namespace {
+
+void AppendInt32(uint32_t value, string* buffer) {
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    buffer->push_back(static_cast<char>((value >> shift) & 0xff));
+  }
+}
+
+} // namespace
+
+Status TestCQLService::SendQuery(const string& query, uint8_t* opcode, string* body) {
+  // QUERY body: <query> as long string, <consistency> ONE and no flags.
+  string request_body;
+  AppendInt32(query.length(), &request_body);
+  request_body += query;
+  request_body += BINARY_STRING("\x00\x01" "\x00");
+  string request = BINARY_STRING("\x04\x00\x00\x00\x07");
+  AppendInt32(request_body.length(), &request);
+  request += request_body;
+
+  int32_t bytes_written = 0;
+  RETURN_NOT_OK(client_sock_.Write(
+      util::to_uchar_ptr(request.c_str()), request.length(), &bytes_written));
+  if (static_cast<size_t>(bytes_written) != request.length()) {
+    return STATUS_FORMAT(IOError, "Wrote $0 bytes instead of $1", bytes_written, request.length());
+  }
+
+  // Schema changes may take a while, so wait long enough for the response.
+  MonoTime deadline = MonoTime::Now(MonoTime::FINE);
+  deadline.AddDelta(MonoDelta::FromSeconds(60));
+  uint8_t header[9];
+  size_t bytes_read = 0;
+  RETURN_NOT_OK(client_sock_.BlockingRecv(header, sizeof(header), &bytes_read, deadline));
+  *opcode = header[4];
+  const size_t length = (header[5] << 24) | (header[6] << 16) | (header[7] << 8) | header[8];
+  vector<uint8_t> buffer(length);
+  if (length > 0) {
+    RETURN_NOT_OK(client_sock_.BlockingRecv(buffer.data(), length, &bytes_read, deadline));
+  }
+  body->assign(reinterpret_cast<const char*>(buffer.data()), length);
+  return Status::OK();
+}
+
 void TestCQLService::SendRequestAndExpectTimeout(const string& cmd) {
   // Don't expect to receive even 1 byte.
   ASSERT_TRUE(SendRequestAndGetResponse(cmd, 1).IsTimedOut());
@@ -224,6 +279,58 @@ TEST_F(TestCQLService, InvalidRequest) {
                     "\x00\x00\x00\x0a" "\x00\x17" "Request length too long"));
 }
 
+TEST_F(TestCQLService, AutoParameterizedQueries) {
+  constexpr uint8_t kResultOpcode = 0x08;
+  SendRequestAndExpectResponse(
+      BINARY_STRING("\x04\x00\x00\x00\x01" "\x00\x00\x00\x16"
+                    "\x00\x01" "\x00\x0b" "CQL_VERSION"
+                               "\x00\x05" "3.0.0"),
+      BINARY_STRING("\x84\x00\x00\x00\x02" "\x00\x00\x00\x00"));
+
+  uint8_t opcode = 0;
+  string body;
+  ASSERT_OK(SendQuery("CREATE KEYSPACE test_ks", &opcode, &body));
+  ASSERT_EQ(kResultOpcode, opcode) << body;
+  ASSERT_OK(SendQuery("CREATE TABLE test_ks.t (k int PRIMARY KEY, v int)", &opcode, &body));
+  ASSERT_EQ(kResultOpcode, opcode) << body;
+
+  const auto& hits = METRIC_yb_cqlserver_CQLServerService_AutoParameterizedCacheHits;
+  const auto& misses = METRIC_yb_cqlserver_CQLServerService_AutoParameterizedCacheMisses;
+  const int64_t base_hits = GetCounter(hits);
+  const int64_t base_misses = GetCounter(misses);
+
+  // The first query of a shape prepares its statement, the next one of the same shape reuses it.
+  ASSERT_OK(SendQuery("INSERT INTO test_ks.t (k, v) VALUES (1, 10)", &opcode, &body));
+  ASSERT_EQ(kResultOpcode, opcode) << body;
+  ASSERT_EQ(base_hits, GetCounter(hits));
+  ASSERT_EQ(base_misses + 1, GetCounter(misses));
+
+  ASSERT_OK(SendQuery("INSERT INTO test_ks.t (k, v) VALUES (2, 20)", &opcode, &body));
+  ASSERT_EQ(kResultOpcode, opcode) << body;
+  ASSERT_EQ(base_hits + 1, GetCounter(hits));
+  ASSERT_EQ(base_misses + 1, GetCounter(misses));
+
+  // The cached statement is executed with the literals of the query.
+  ASSERT_OK(SendQuery("SELECT v FROM test_ks.t WHERE k = 2", &opcode, &body));
+  ASSERT_EQ(kResultOpcode, opcode) << body;
+  ASSERT_NE(string::npos, body.find(BINARY_STRING("\x00\x00\x00\x04" "\x00\x00\x00\x14")));
+  ASSERT_EQ(base_hits + 1, GetCounter(hits));
+  ASSERT_EQ(base_misses + 2, GetCounter(misses));
+
+  ASSERT_OK(SendQuery("SELECT v FROM test_ks.t WHERE k = 1", &opcode, &body));
+  ASSERT_EQ(kResultOpcode, opcode) << body;
+  ASSERT_NE(string::npos, body.find(BINARY_STRING("\x00\x00\x00\x04" "\x00\x00\x00\x0a")));
+  ASSERT_EQ(base_hits + 2, GetCounter(hits));
+  ASSERT_EQ(base_misses + 2, GetCounter(misses));
+
+  // A literal that cannot be bound to the cached statement falls back to the regular path, which
+  // rejects it, and is not counted as a hit.
+  ASSERT_OK(SendQuery("INSERT INTO test_ks.t (k, v) VALUES (3, 3000000000)", &opcode, &body));
+  ASSERT_NE(kResultOpcode, opcode);
+  ASSERT_EQ(base_hits + 2, GetCounter(hits));
+  ASSERT_EQ(base_misses + 2, GetCounter(misses));
+}
+
 TEST_F(TestCQLService, TestCQLServerEventConst) {
   std::unique_ptr<SchemaChangeEventResponse> response(
       new SchemaChangeEventResponse("", "", "", "", {}));
@@ -241,5 +348,59 @@ TEST_F(TestCQLService, TestCQLServerEventConst) {
   ASSERT_EQ(0, memcmp(buffer, ptr, kSize));
 }
 
+TEST(TestAutoParameterizeQuery, Literals) {
+  string normalized;
+  vector<QueryLiteral> literals;
+  ASSERT_TRUE(AutoParameterizeQuery(
+      "SELECT v FROM t1\n  WHERE h = 10 AND r >= -2.5e3 AND s = 'it''s' LIMIT 5;",
+      &normalized, &literals));
+  ASSERT_EQ("SELECT v FROM t1 WHERE h = ? AND r >= ? AND s = ? LIMIT ?;", normalized);
+  ASSERT_EQ(4U, literals.size());
+  ASSERT_EQ(QueryLiteral::Kind::kNumber, literals[0].kind);
+  ASSERT_EQ("10", literals[0].text);
+  ASSERT_EQ("-2.5e3", literals[1].text);
+  ASSERT_EQ(QueryLiteral::Kind::kString, literals[2].kind);
+  ASSERT_EQ("it's", literals[2].text);
+  ASSERT_EQ("5", literals[3].text);
+
+  // Queries that differ only in their literals are normalized to the same text.
+  string other;
+  ASSERT_TRUE(AutoParameterizeQuery(
+      "SELECT v FROM t1 WHERE h = 11 AND r >= 0 AND s = '' LIMIT 50;", &other, &literals));
+  ASSERT_EQ(normalized, other);
+
+  ASSERT_TRUE(AutoParameterizeQuery(
+      "insert into \"T\" (k, \"v 1\") values (1, 'a')", &normalized, &literals));
+  ASSERT_EQ("insert into \"T\" (k, \"v 1\") values (?, ?)", normalized);
+  ASSERT_EQ(2U, literals.size());
+
+  // Statements other than DML, bind markers, comments and unhandled literals are left alone.
+  ASSERT_FALSE(AutoParameterizeQuery("CREATE TABLE t (k int PRIMARY KEY)", &normalized, &literals));
+  ASSERT_FALSE(AutoParameterizeQuery("SELECT * FROM t WHERE k = ?", &normalized, &literals));
+  ASSERT_FALSE(AutoParameterizeQuery("SELECT * FROM t WHERE k = :k", &normalized, &literals));
+  ASSERT_FALSE(AutoParameterizeQuery("SELECT * FROM t -- comment", &normalized, &literals));
+  ASSERT_FALSE(AutoParameterizeQuery("SELECT * FROM t WHERE b = 0xab", &normalized, &literals));
+  ASSERT_FALSE(AutoParameterizeQuery("SELECT * FROM t WHERE s = 'abc", &normalized, &literals));
+}
+
+TEST(TestAutoParameterizeQuery, ToQLValue) {
+  QLValuePB value;
+  const QueryLiteral number{QueryLiteral::Kind::kNumber, "300"};
+  ASSERT_TRUE(number.ToQLValue(QLType::Create(DataType::INT32), &value));
+  ASSERT_EQ(300, value.int32_value());
+  ASSERT_TRUE(number.ToQLValue(QLType::Create(DataType::DOUBLE), &value));
+  ASSERT_EQ(300, value.double_value());
+  ASSERT_FALSE(number.ToQLValue(QLType::Create(DataType::INT8), &value));
+  ASSERT_FALSE(number.ToQLValue(QLType::Create(DataType::STRING), &value));
+
+  const QueryLiteral fraction{QueryLiteral::Kind::kNumber, "1.5"};
+  ASSERT_FALSE(fraction.ToQLValue(QLType::Create(DataType::INT64), &value));
+
+  const QueryLiteral str{QueryLiteral::Kind::kString, "abc"};
+  ASSERT_TRUE(str.ToQLValue(QLType::Create(DataType::STRING), &value));
+  ASSERT_EQ("abc", value.string_value());
+  ASSERT_FALSE(str.ToQLValue(QLType::Create(DataType::TIMESTAMP), &value));
+}
+
 }  // namespace cqlserver
 }  // namespace yb
@@ -16,6 +16,9 @@
 #include "yb/rocksdb/db/dbformat.h"
 
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_kv_util.h"
+#include "yb/docdb/value.h"
+#include "yb/gutil/endian.h"
 
 namespace yb {
 namespace docdb {
@@ -29,6 +32,7 @@ Status GetPrimitiveValue(const rocksdb::UserBoundaryValues& values,
 namespace {
 
 constexpr rocksdb::UserBoundaryTag kDocHybridTimeTag = 1;
+constexpr rocksdb::UserBoundaryTag kValueTtlTag = 2;
 // Here we reserve some tags for future use.
 // Because Tag is persistent.
 constexpr rocksdb::UserBoundaryTag kRangeComponentsStart = 10;
@@ -79,6 +83,62 @@ class DocHybridTimeValue : public rocksdb::UserBoundaryValue {
   Slice encoded_;
 };
 
+// Wrapper for UserBoundaryValue that stores TTL explicitly specified in a value, in milliseconds.
+// Values without explicit TTL are stored as 0, because their TTL is defined by the table and could
+// be changed later. So files written before this value was introduced could be distinguished by the
+// absence of this tag.
+class ValueTtlValue : public rocksdb::UserBoundaryValue {
+ public:
+  explicit ValueTtlValue(int64_t ttl_ms) {
+    BigEndian::Store64(buffer_, ttl_ms);
+  }
+
+  static CHECKED_STATUS Create(Slice data, rocksdb::UserBoundaryValuePtr* value) {
+    CHECK_NOTNULL(value);
+    if (data.size() != sizeof(int64_t)) {
+      return STATUS_SUBSTITUTE(Corruption, "Wrong size of encoded value TTL: $0", data.size());
+    }
+
+    *value = std::make_shared<ValueTtlValue>(BigEndian::Load64(data.data()));
+    return Status::OK();
+  }
+
+  // A value without an explicit TTL (kMaxTtl) is stored as 0, so it does not prevent files from
+  // being dropped by the table TTL. kResetTTL is stored as the maximal value, so it wins over any
+  // real TTL and keeps the file from being dropped.
+  static int64_t ToBoundaryMs(const MonoDelta& ttl) {
+    if (ttl.Equals(Value::kMaxTtl)) {
+      return 0;
+    }
+    return ttl.ToMilliseconds() == kResetTTL ? std::numeric_limits<int64_t>::max()
+                                             : ttl.ToMilliseconds();
+  }
+
+  virtual ~ValueTtlValue() {}
+
+  rocksdb::UserBoundaryTag Tag() override {
+    return kValueTtlTag;
+  }
+
+  Slice Encode() override {
+    return Slice(buffer_, sizeof(buffer_));
+  }
+
+  int64_t ttl_ms() const {
+    return BigEndian::Load64(buffer_);
+  }
+
+  int CompareTo(const UserBoundaryValue& pre_rhs) override {
+    const auto* rhs = down_cast<const ValueTtlValue*>(&pre_rhs);
+    const auto lhs_ttl = ttl_ms();
+    const auto rhs_ttl = rhs->ttl_ms();
+    return lhs_ttl < rhs_ttl ? -1 : (lhs_ttl > rhs_ttl ? 1 : 0);
+  }
+
+ private:
+  char buffer_[sizeof(int64_t)];
+};
+
 // Wrapper for UserBoundaryValue that stores PrimitiveValue with index.
 class PrimitiveBoundaryValue : public rocksdb::UserBoundaryValue {
  public:
@@ -146,6 +206,9 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     if (tag == kDocHybridTimeTag) {
       return DocHybridTimeValue::Create(data, value);
     }
+    if (tag == kValueTtlTag) {
+      return ValueTtlValue::Create(data, value);
+    }
     if (tag >= kRangeComponentsStart) {
       return PrimitiveBoundaryValue::Create(tag - kRangeComponentsStart, data, value);
     }
@@ -182,6 +245,11 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
       values->push_back(std::move(temp));
     }
 
+    MonoDelta ttl;
+    auto value_copy = value;
+    RETURN_NOT_OK(Value::DecodeTTL(&value_copy, &ttl));
+    values->push_back(std::make_shared<ValueTtlValue>(ValueTtlValue::ToBoundaryMs(ttl)));
+
     DCHECK(PerformSanityCheck(user_key, slices, *values));
 
     return Status::OK();
@@ -248,9 +316,24 @@ Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime
   return time_value->value(out);
 }
 
+// Returns explicit value TTL boundary in milliseconds (0 means that the table TTL is used), or
+// NotFound if the file was written before value TTLs were tracked.
+Status GetValueTtlMs(const rocksdb::UserBoundaryValues& values, int64_t* out) {
+  auto value = rocksdb::UserValueWithTag(values, kValueTtlTag);
+  if (!value) {
+    return STATUS(NotFound, "Not found value for value TTL");
+  }
+  *out = down_cast<ValueTtlValue*>(value.get())->ttl_ms();
+  return Status::OK();
+}
+
 rocksdb::UserBoundaryTag TagForRangeComponent(size_t index) {
   return PrimitiveBoundaryValue::TagForIndex(index);
 }
 
+rocksdb::UserBoundaryTag TagForHybridTime() {
+  return kDocHybridTimeTag;
+}
+
 } // namespace docdb
 } // namespace yb
@@ -19,9 +19,11 @@
 #include "yb/rocksdb/table/full_filter_block.h"
 
 #include "yb/docdb/docdb_test_util.h"
+#include "yb/docdb/docdb_util.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
 
@@ -400,11 +402,198 @@ TEST(DocKeyTest, TestKeyMatching) {
   ASSERT_FALSE(may_match(EncodeSimpleSubDocKey(absent_key))) << "Key: " << absent_key;
 }
 
+TEST(DocKeyTest, TestRangeAwareKeyMatching) {
+  DocDbAwareFilterPolicy policy(
+      rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr, DocKeyPart::WHOLE_DOC_KEY);
+  DocDbAwareFilterPolicy hashed_policy(
+      rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr);
+  ASSERT_STRNE(policy.Name(), hashed_policy.Name());
+
+  std::string keys[] = { "foo", "bar", "test" };
+
+  std::unique_ptr<FilterBitsBuilder> builder(policy.GetFilterBitsBuilder());
+  ASSERT_NE(builder, nullptr);
+  for (const auto& key : keys) {
+    builder->AddKey(policy.GetKeyTransformer()->Transform(EncodeSimpleSubDocKey(key)));
+  }
+  std::unique_ptr<const char[]> buf;
+  rocksdb::Slice filter = builder->Finish(&buf);
+
+  std::unique_ptr<FilterBitsReader> reader(policy.GetFilterBitsReader(filter));
+
+  auto may_match = [&](const std::string& sub_doc_key_str) {
+    return reader->MayMatch(policy.GetKeyTransformer()->Transform(sub_doc_key_str));
+  };
+
+  for (const auto &key : keys) {
+    ASSERT_TRUE(may_match(EncodeSimpleSubDocKey(key))) << "Key: " << key;
+    // Sub keys and hybrid time are not part of the filter key.
+    ASSERT_TRUE(may_match(EncodeSubDocKey(key, "range_key", "another_sub_key", 55555L)))
+        << "Key: " << key;
+    // Same hashed components, but another row.
+    ASSERT_FALSE(may_match(EncodeSimpleSubDocKeyWithDifferentNonHashPart(key)))
+        << "Key: " << key;
+  }
+}
+
 TEST(DocKeyTest, TestWriteId) {
   SubDocKey subdoc_key(DocKey({PrimitiveValue("a"), PrimitiveValue(135)}),
                        DocHybridTime(1000000, 4091, 135));
   TestRoundTripDocOrSubDocKeyEncodingDecoding(subdoc_key);
 }
 
+TEST(DocKeyTest, TestCompactStringEncoding) {
+  // Compact strings are length-prefixed and not escaped, so zero bytes are stored as is.
+  const DocKey doc_key(
+      0xcafe,
+      {PrimitiveValue::CompactString("hashed1"),
+       PrimitiveValue::CompactString(BINARY_STRING("a\x00b"))},
+      PrimitiveValues("range1"));
+  ASSERT_STR_EQ_VERBOSE_TRIMMED(
+      ApplyEagerLineContinuation(
+          R"#("G\
+               \xca\xfe\
+               R\x07hashed1\
+               R\x03a\x00b\
+               !\
+               Srange1\x00\x00\
+               !")#"),
+      FormatBytesAsStr(doc_key.Encode().data()));
+  TestRoundTripDocOrSubDocKeyEncodingDecoding(doc_key);
+  TestRoundTripDocOrSubDocKeyEncodingDecoding(
+      SubDocKey(doc_key, PrimitiveValue(ColumnId(10)), HybridTime::FromMicros(1000)));
+
+  // A long string needs a multi-byte length.
+  const DocKey long_doc_key(0x1234, {PrimitiveValue::CompactString(std::string(1000, 'x'))}, {});
+  // Hash, value type, two-byte length, the string, and the ends of both groups.
+  ASSERT_EQ(3U + 1 + 2 + 1000 + 2, long_doc_key.Encode().size());
+  TestRoundTripDocOrSubDocKeyEncodingDecoding(long_doc_key);
+
+  // The object comparison must agree with the encoded one, which orders by length first.
+  const std::vector<std::string> strs = {"", "b", "ab", "abc", "b\xff", std::string(200, 'a')};
+  for (const auto& a : strs) {
+    for (const auto& b : strs) {
+      const PrimitiveValue a_value = PrimitiveValue::CompactString(a);
+      const PrimitiveValue b_value = PrimitiveValue::CompactString(b);
+      ASSERT_EQ(Sign(a_value.CompareTo(b_value)),
+                Sign(a_value.ToKeyBytes().CompareTo(b_value.ToKeyBytes())))
+          << "a: " << a_value << ", b: " << b_value;
+    }
+  }
+
+  // Compact strings are only used in keys.
+  PrimitiveValue value;
+  ASSERT_NOK(value.DecodeFromValue(
+      std::string(1, static_cast<char>(ValueType::kCompactString)) + "abc"));
+}
+
+TEST(DocKeyTest, TestCompactDocKey) {
+  const std::string partition_key = BINARY_STRING("customer\x00\x00\x00\x01");
+  google::protobuf::RepeatedPtrField<QLExpressionPB> hashed_column_values;
+  hashed_column_values.Add()->mutable_value()->set_string_value(partition_key);
+  google::protobuf::RepeatedPtrField<QLExpressionPB> range_column_values;
+  range_column_values.Add()->mutable_value()->set_string_value("range");
+
+  const std::vector<ColumnSchema> columns = {
+      ColumnSchema("h", STRING, false /* is_nullable */, true /* is_hash_key */),
+      ColumnSchema("r", STRING, false /* is_nullable */, false /* is_hash_key */),
+      ColumnSchema("v", INT32, true /* is_nullable */, false /* is_hash_key */)};
+  TableProperties table_properties;
+  const Schema schema(columns, 2, table_properties);
+  table_properties.SetCompactDocKey(true);
+  const Schema compact_schema(columns, 2, table_properties);
+
+  std::vector<KeyBytes> encoded_keys;
+  for (const Schema* s : {&schema, &compact_schema}) {
+    std::vector<PrimitiveValue> hashed_components;
+    std::vector<PrimitiveValue> range_components;
+    ASSERT_OK(QLKeyColumnValuesToPrimitiveValues(
+        hashed_column_values, *s, 0, s->num_hash_key_columns(), &hashed_components));
+    ASSERT_OK(QLKeyColumnValuesToPrimitiveValues(
+        range_column_values, *s, s->num_hash_key_columns(), s->num_range_key_columns(),
+        &range_components));
+    ASSERT_EQ(1U, range_components.size());
+    // Range components keep the order-preserving encoding.
+    ASSERT_EQ(ValueType::kString, range_components[0].value_type());
+    ASSERT_EQ(1U, hashed_components.size());
+    ASSERT_EQ(partition_key, hashed_components[0].GetString());
+    encoded_keys.push_back(DocKey(0x1234, hashed_components, range_components).Encode());
+    TestRoundTripDocOrSubDocKeyEncodingDecoding(
+        DocKey(0x1234, hashed_components, range_components));
+  }
+  // The compact key saves the escaping of the three zero bytes and one terminator byte.
+  ASSERT_EQ(encoded_keys[0].size() - 4, encoded_keys[1].size());
+}
+
+////////////////////////////////////////////////////////////
+// Benchmarks
+////////////////////////////////////////////////////////////
+
+#ifdef NDEBUG
+namespace {
+
+constexpr int kNumBenchmarkKeys = 100000;
+constexpr int kNumBenchmarkTrials = 20;
+
+// Keys with a long text partition key and a column id subkey, as in a YCQL table.
+std::vector<SubDocKey> GenBenchmarkSubDocKeys(bool compact) {
+  std::vector<SubDocKey> keys;
+  keys.reserve(kNumBenchmarkKeys);
+  for (int i = 0; i < kNumBenchmarkKeys; ++i) {
+    std::string partition_key = Substitute("user_$0@example.com/profile/settings", i);
+    PrimitiveValue hashed = compact ? PrimitiveValue::CompactString(std::move(partition_key))
+                                    : PrimitiveValue(partition_key);
+    keys.emplace_back(DocKey(i % 0xffff, {std::move(hashed)}, {PrimitiveValue(i)}),
+                      PrimitiveValue(ColumnId(11)), HybridTime::FromMicros(1000));
+  }
+  return keys;
+}
+
+void BenchmarkEncode(bool compact) {
+  const auto keys = GenBenchmarkSubDocKeys(compact);
+  size_t sum_sizes = 0;  // Use the results to force evaluation.
+  LOG_TIMING(INFO, Substitute("Encoding $0 keys", compact ? "compact" : "regular")) {
+    for (int trial = 0; trial < kNumBenchmarkTrials; ++trial) {
+      for (const auto& key : keys) {
+        sum_sizes += key.Encode().size();
+      }
+    }
+  }
+  LOG(INFO) << "Average encoded key size: "
+            << static_cast<double>(sum_sizes) / (kNumBenchmarkKeys * kNumBenchmarkTrials);
+  ASSERT_GT(sum_sizes, 1);
+}
+
+void BenchmarkDecode(bool compact) {
+  std::vector<KeyBytes> encoded_keys;
+  for (const auto& key : GenBenchmarkSubDocKeys(compact)) {
+    encoded_keys.push_back(key.Encode());
+  }
+  int sum_subkeys = 0;
+  LOG_TIMING(INFO, Substitute("Decoding $0 keys", compact ? "compact" : "regular")) {
+    SubDocKey decoded_key;
+    for (int trial = 0; trial < kNumBenchmarkTrials; ++trial) {
+      for (const auto& encoded_key : encoded_keys) {
+        CHECK_OK(decoded_key.FullyDecodeFrom(encoded_key.AsSlice()));
+        sum_subkeys += decoded_key.num_subkeys();
+      }
+    }
+  }
+  ASSERT_EQ(kNumBenchmarkKeys * kNumBenchmarkTrials, sum_subkeys);
+}
+
+}  // namespace
+
+TEST(DocKeyTest, BenchmarkEncode) {
+  BenchmarkEncode(false /* compact */);
+  BenchmarkEncode(true /* compact */);
+}
+
+TEST(DocKeyTest, BenchmarkDecode) {
+  BenchmarkDecode(false /* compact */);
+  BenchmarkDecode(true /* compact */);
+}
+#endif
+
 }  // namespace docdb
 }  // namespace yb
@@ -666,26 +666,39 @@ KeyBytes SubDocKey::AdvanceOutOfDocKeyPrefix() const {
 
 namespace {
 
-class HashedComponentsExtractor : public rocksdb::FilterPolicy::KeyTransformer {
+template <DocKeyPart kPart>
+class DocKeyPartExtractor : public rocksdb::FilterPolicy::KeyTransformer {
  public:
-  HashedComponentsExtractor() {}
-  HashedComponentsExtractor(const HashedComponentsExtractor&) = delete;
-  HashedComponentsExtractor& operator=(const HashedComponentsExtractor&) = delete;
+  DocKeyPartExtractor() {}
+  DocKeyPartExtractor(const DocKeyPartExtractor&) = delete;
+  DocKeyPartExtractor& operator=(const DocKeyPartExtractor&) = delete;
 
-  static HashedComponentsExtractor& GetInstance() {
-    static HashedComponentsExtractor instance;
+  static DocKeyPartExtractor& GetInstance() {
+    static DocKeyPartExtractor instance;
     return instance;
   }
 
   Slice Transform(Slice key) const override {
-    auto size = DocKey::EncodedSize(key, DocKeyPart::HASHED_PART_ONLY);
+    auto size = DocKey::EncodedSize(key, kPart);
     CHECK_OK(size);
     return Slice(key.data(), *size);
   }
 };
 
+typedef DocKeyPartExtractor<DocKeyPart::HASHED_PART_ONLY> HashedComponentsExtractor;
+typedef DocKeyPartExtractor<DocKeyPart::WHOLE_DOC_KEY> WholeDocKeyExtractor;
+
 } // namespace
 
+const char* DocDbAwareFilterPolicy::Name() const {
+  switch (filter_key_part_) {
+    case DocKeyPart::HASHED_PART_ONLY:
+      return "DocKeyHashedComponentsFilter";
+    case DocKeyPart::WHOLE_DOC_KEY:
+      return "DocKeyWholeKeyFilter";
+  }
+  FATAL_INVALID_ENUM_VALUE(DocKeyPart, filter_key_part_);
+}
 
 void DocDbAwareFilterPolicy::CreateFilter(
     const rocksdb::Slice* keys, int n, std::string* dst) const {
@@ -712,7 +725,13 @@ rocksdb::FilterPolicy::FilterType DocDbAwareFilterPolicy::GetFilterType() const
 }
 
 const rocksdb::FilterPolicy::KeyTransformer* DocDbAwareFilterPolicy::GetKeyTransformer() const {
-  return &HashedComponentsExtractor::GetInstance();
+  switch (filter_key_part_) {
+    case DocKeyPart::HASHED_PART_ONLY:
+      return &HashedComponentsExtractor::GetInstance();
+    case DocKeyPart::WHOLE_DOC_KEY:
+      return &WholeDocKeyExtractor::GetInstance();
+  }
+  FATAL_INVALID_ENUM_VALUE(DocKeyPart, filter_key_part_);
 }
 
 }  // namespace docdb
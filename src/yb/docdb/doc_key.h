@@ -497,15 +497,22 @@ inline std::ostream& operator <<(std::ostream& out, const SubDocKey& subdoc_key)
 std::string BestEffortDocDBKeyToStr(const KeyBytes &key_bytes);
 std::string BestEffortDocDBKeyToStr(const rocksdb::Slice &slice);
 
-// This filter policy only takes into account hashed components of keys for filtering.
+// This filter policy only takes into account hashed components of keys for filtering. When
+// constructed with DocKeyPart::WHOLE_DOC_KEY, it filters on the whole DocKey (hashed and range
+// components) instead, which lets point reads by full primary key skip SST files that contain
+// the same hashed components but not the requested row.
 class DocDbAwareFilterPolicy : public rocksdb::FilterPolicy {
  public:
-  explicit DocDbAwareFilterPolicy(size_t filter_block_size_bits, rocksdb::Logger* logger) {
+  DocDbAwareFilterPolicy(size_t filter_block_size_bits, rocksdb::Logger* logger,
+                         DocKeyPart filter_key_part = DocKeyPart::HASHED_PART_ONLY)
+      : filter_key_part_(filter_key_part) {
     builtin_policy_.reset(rocksdb::NewFixedSizeFilterPolicy(
         filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate, logger));
   }
 
-  const char* Name() const override { return "DocKeyHashedComponentsFilter"; }
+  // The name is stored as part of the filter block name in SST files, so files written with a
+  // different key part are never probed with keys transformed by this policy.
+  const char* Name() const override;
 
   void CreateFilter(const rocksdb::Slice* keys, int n, std::string* dst) const override;
 
@@ -519,8 +526,11 @@ class DocDbAwareFilterPolicy : public rocksdb::FilterPolicy {
 
   const KeyTransformer* GetKeyTransformer() const override;
 
+  DocKeyPart filter_key_part() const { return filter_key_part_; }
+
  private:
   std::unique_ptr<const rocksdb::FilterPolicy> builtin_policy_;
+  const DocKeyPart filter_key_part_;
 };
 
 }  // namespace docdb
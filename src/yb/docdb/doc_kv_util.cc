@@ -167,6 +167,32 @@ Status DecodeZeroEncodedStr(rocksdb::Slice* slice, string* result) {
   return DecodeEncodedStr<'\0'>(slice, result);
 }
 
+void AppendLengthPrefixedStrToKey(const string& s, string* dest) {
+  uint8_t buf[util::kMaxVarIntBufferSize];
+  size_t size = 0;
+  util::FastEncodeUnsignedVarInt(s.size(), buf, &size);
+  dest->append(reinterpret_cast<const char*>(buf), size);
+  dest->append(s);
+}
+
+Status DecodeLengthPrefixedStr(rocksdb::Slice* slice, string* result) {
+  uint64_t length = 0;
+  size_t decoded_size = 0;
+  RETURN_NOT_OK(util::FastDecodeUnsignedVarInt(
+      slice->data(), slice->size(), &length, &decoded_size));
+  if (slice->size() - decoded_size < length) {
+    return STATUS_FORMAT(Corruption,
+                         "Length-prefixed string of $0 bytes does not fit in the $1 bytes left",
+                         length, slice->size() - decoded_size);
+  }
+  slice->remove_prefix(decoded_size);
+  if (result != nullptr) {
+    result->assign(slice->cdata(), length);
+  }
+  slice->remove_prefix(length);
+  return Status::OK();
+}
+
 string DecodeZeroEncodedStr(string encoded_str) {
   string result;
   rocksdb::Slice slice(encoded_str);
@@ -225,6 +225,16 @@ std::string DecodeZeroEncodedStr(std::string encoded_str);
 //   result - the resulting decoded string
 yb::Status DecodeComplementZeroEncodedStr(rocksdb::Slice* slice, std::string* result);
 
+// Appends the given string to a RocksDB key as its length (unsigned varint) followed by its raw
+// bytes. Unlike the zero encoding, this needs no escaping and no terminator, but strings encoded
+// this way sort by length first, so it may only be used where the order of the strings does not
+// matter, such as hashed key components.
+void AppendLengthPrefixedStrToKey(const std::string& s, std::string* dest);
+
+// Reverses AppendLengthPrefixedStrToKey, consuming a prefix of the given slice. The result may be
+// null to skip the string.
+yb::Status DecodeLengthPrefixedStr(rocksdb::Slice* slice, std::string* result);
+
 
 // We try to use up to this number of characters when converting raw bytes to strings for debug
 // purposes.
@@ -34,6 +34,7 @@
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
+DECLARE_bool(ycql_enable_packed_row);
 
 using namespace std::literals; // NOLINT
 
@@ -323,6 +324,63 @@ SubDocKey(DocKey(0x0000, [1], []), [ColumnId(3); HT(p=1000, w=3)]) -> 3; ttl: 1.
   EXPECT_EQ(3, row_block.row(0).column(3).int32_value());
 }
 
+TEST_F(DocOperationTest, TestQLPackedRow) {
+  FLAGS_ycql_enable_packed_row = true;
+  Schema schema = CreateSchema();
+  WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, vector<int>({1, 1, 2, 3}),
+           1000, HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(1000, 0));
+
+  AssertDocDbDebugDumpStrEq(R"#(
+SubDocKey(DocKey(0x0000, [1], []), [HT(p=1000)]) -> \
+    PackedRow(v0, {SystemColumnId(0): null, ColumnId(1): 1, ColumnId(2): 2, ColumnId(3): 3}); \
+    ttl: 1.000s
+      )#");
+
+  const HybridTime read_time = HybridClock::HybridTimeFromMicroseconds(2000);
+  QLRowBlock row_block = ReadQLRow(schema, 1, read_time);
+  ASSERT_EQ(1, row_block.row_count());
+  EXPECT_EQ(1, row_block.row(0).column(0).int32_value());
+  EXPECT_EQ(1, row_block.row(0).column(1).int32_value());
+  EXPECT_EQ(2, row_block.row(0).column(2).int32_value());
+  EXPECT_EQ(3, row_block.row(0).column(3).int32_value());
+
+  // Later writes to single columns take precedence over the packed row.
+  const DocKey doc_key(0, PrimitiveValues(PrimitiveValue::Int32(1)), PrimitiveValues());
+  const KeyBytes encoded_doc_key(doc_key.Encode());
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue(ColumnId(2))),
+                         Value(PrimitiveValue::Int32(5)),
+                         HybridClock::HybridTimeFromMicroseconds(1500),
+                         InitMarkerBehavior::OPTIONAL));
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue(ColumnId(3))),
+                         Value(PrimitiveValue(ValueType::kTombstone)),
+                         HybridClock::HybridTimeFromMicroseconds(1500),
+                         InitMarkerBehavior::OPTIONAL));
+
+  row_block = ReadQLRow(schema, 1, read_time);
+  ASSERT_EQ(1, row_block.row_count());
+  EXPECT_EQ(1, row_block.row(0).column(1).int32_value());
+  EXPECT_EQ(5, row_block.row(0).column(2).int32_value());
+  EXPECT_TRUE(row_block.row(0).column(3).IsNull());
+
+  // The same without a projection.
+  SubDocument row;
+  bool doc_found = false;
+  ASSERT_OK(GetSubDocument(rocksdb(), SubDocKey(doc_key), rocksdb::kDefaultQueryId,
+                           kNonTransactionalOperationContext, &row, &doc_found, read_time));
+  ASSERT_TRUE(doc_found);
+  ASSERT_NE(nullptr, row.GetChild(PrimitiveValue(ColumnId(1))));
+  EXPECT_EQ(1, row.GetChild(PrimitiveValue(ColumnId(1)))->GetInt32());
+  ASSERT_NE(nullptr, row.GetChild(PrimitiveValue(ColumnId(2))));
+  EXPECT_EQ(5, row.GetChild(PrimitiveValue(ColumnId(2)))->GetInt32());
+  EXPECT_EQ(nullptr, row.GetChild(PrimitiveValue(ColumnId(3))));
+
+  // The row expires with the TTL of the packed row, except for the columns written later.
+  row_block = ReadQLRow(schema, 1, HybridClock::HybridTimeFromMicroseconds(1002000));
+  ASSERT_EQ(1, row_block.row_count());
+  EXPECT_TRUE(row_block.row(0).column(1).IsNull());
+  EXPECT_EQ(5, row_block.row(0).column(2).int32_value());
+}
+
 TEST_F(DocOperationTest, TestQLReadWithoutLivenessColumn) {
   const DocKey doc_key(0, PrimitiveValues(PrimitiveValue::Int32(100)), PrimitiveValues());
   KeyBytes encoded_doc_key(doc_key.Encode());
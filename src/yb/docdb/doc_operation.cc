@@ -23,6 +23,7 @@
 #include "yb/docdb/doc_expr.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/doc_ql_scanspec.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/server/hybrid_clock.h"
 #include "yb/gutil/strings/substitute.h"
@@ -39,6 +40,10 @@ DEFINE_bool(emulate_redis_responses,
     "and HDEL. If emulate_redis_responses is true, we read the required records to compute the "
     "response as specified by the official Redis API documentation. https://redis.io/commands");
 
+DEFINE_bool(ycql_enable_packed_row, false,
+    "Whether a YCQL INSERT that sets all the non-key, non-static columns of a row to primitive "
+    "values writes them as one packed row value instead of one key/value pair per column.");
+
 namespace yb {
 namespace docdb {
 
@@ -111,13 +116,15 @@ CHECKED_STATUS PrimitiveValueFromSubKeyStrict(const RedisKeyValueSubKeyPB &subke
   return PrimitiveValueFromSubKey(subkey_pb, primitive_value);
 }
 
+// Reads the type with 'iter' if it is specified, otherwise creates a new iterator for the read.
 Status GetRedisValueType(
     rocksdb::DB* rocksdb,
     const HybridTime &hybrid_time,
     const RedisKeyValuePB &key_value_pb,
     RedisDataType *type,
     DocWriteBatch* doc_write_batch = nullptr,
-    int subkey_index = -1) {
+    int subkey_index = -1,
+    IntentAwareIterator* iter = nullptr) {
   if (!key_value_pb.has_key()) {
     return STATUS(Corruption, "Expected KeyValuePB");
   }
@@ -146,6 +153,10 @@ Status GetRedisValueType(
   if (cached_entry) {
     doc_found = true;
     doc = SubDocument(cached_entry->value_type);
+  } else if (iter) {
+    RETURN_NOT_OK(GetSubDocument(
+        iter, subdoc_key, &doc, &doc_found, hybrid_time, Value::kMaxTtl, nullptr /* projection */,
+        true /* return_type_only */, false /* is_iter_valid */));
   } else {
     // TODO(dtxn) - pass correct transaction context when we implement cross-shard transactions
     // support for Redis.
@@ -182,13 +193,15 @@ Status GetRedisValueType(
   }
 }
 
+// Reads the value with 'iter' if it is specified, otherwise creates a new iterator for the read.
 CHECKED_STATUS GetRedisValue(
     rocksdb::DB *rocksdb,
     HybridTime hybrid_time,
     const RedisKeyValuePB &key_value_pb,
     RedisDataType *type,
     string *value,
-    int subkey_index = -1) {
+    int subkey_index = -1,
+    IntentAwareIterator* iter = nullptr) {
   if (!key_value_pb.has_key()) {
     return STATUS(Corruption, "Expected KeyValuePB");
   }
@@ -209,10 +222,16 @@ CHECKED_STATUS GetRedisValue(
   SubDocument doc;
   bool doc_found = false;
 
-  // TODO(dtxn) - pass correct transaction context when we implement cross-shard transactions
-  // support for Redis.
-  RETURN_NOT_OK(GetSubDocument(
-      rocksdb, doc_key, rocksdb::kDefaultQueryId, boost::none, &doc, &doc_found, hybrid_time));
+  if (iter) {
+    RETURN_NOT_OK(GetSubDocument(
+        iter, doc_key, &doc, &doc_found, hybrid_time, Value::kMaxTtl, nullptr /* projection */,
+        false /* return_type_only */, false /* is_iter_valid */));
+  } else {
+    // TODO(dtxn) - pass correct transaction context when we implement cross-shard transactions
+    // support for Redis.
+    RETURN_NOT_OK(GetSubDocument(
+        rocksdb, doc_key, rocksdb::kDefaultQueryId, boost::none, &doc, &doc_found, hybrid_time));
+  }
 
   if (!doc_found) {
     *type = REDIS_TYPE_NONE;
@@ -334,6 +353,28 @@ CHECKED_STATUS PopulateResponseFrom(const SubDocument::ObjectContainer &key_valu
 
 } // anonymous namespace
 
+RedisWriteOperation::RedisWriteOperation(RedisWriteRequestPB* request, HybridTime read_hybrid_time)
+    : response_(), read_hybrid_time_(read_hybrid_time) {
+  request_.Swap(request);
+}
+
+RedisWriteOperation::~RedisWriteOperation() {}
+
+Status RedisWriteOperation::GetValueType(
+    DocWriteBatch* doc_write_batch, RedisDataType* type, int subkey_index) {
+  const RedisKeyValuePB& kv = request_.key_value();
+  if (!iterator_) {
+    doc_key_encoded_ = DocKey::FromRedisKey(kv.hash_code(), kv.key()).Encode();
+    // TODO(dtxn) - pass correct transaction context when we implement cross-shard transactions
+    // support for Redis.
+    iterator_ = CreateIntentAwareIterator(
+        doc_write_batch->rocksdb(), BloomFilterMode::USE_BLOOM_FILTER_ON_WHOLE_DOC_KEY,
+        doc_key_encoded_.AsSlice(), rocksdb::kDefaultQueryId, boost::none, read_hybrid_time_);
+  }
+  return GetRedisValueType(doc_write_batch->rocksdb(), read_hybrid_time_, kv, type,
+                           doc_write_batch, subkey_index, iterator_.get());
+}
+
 Status RedisWriteOperation::Apply(
     DocWriteBatch* doc_write_batch, rocksdb::DB *rocksdb, const HybridTime& hybrid_time) {
   switch (request_.request_case()) {
@@ -370,8 +411,7 @@ Status RedisWriteOperation::ApplySet(DocWriteBatch* doc_write_batch) {
   DocPath doc_path = DocPath::DocPathFromRedisKey(kv.hash_code(), kv.key());
   if (kv.subkey_size() > 0) {
     RedisDataType data_type;
-    RETURN_NOT_OK(GetRedisValueType(doc_write_batch->rocksdb(), read_hybrid_time_, kv, &data_type,
-                                    doc_write_batch));
+    RETURN_NOT_OK(GetValueType(doc_write_batch, &data_type));
     switch (kv.type()) {
       case REDIS_TYPE_TIMESERIES: FALLTHROUGH_INTENDED;
       case REDIS_TYPE_HASH: {
@@ -396,8 +436,7 @@ Status RedisWriteOperation::ApplySet(DocWriteBatch* doc_write_batch) {
         // HMSET and TSADD.
         if (kv.subkey_size() == 1 && EmulateRedisResponse(kv.type())) {
           RedisDataType type;
-          RETURN_NOT_OK(GetRedisValueType(
-              doc_write_batch->rocksdb(), read_hybrid_time_, kv, &type, doc_write_batch, 0));
+          RETURN_NOT_OK(GetValueType(doc_write_batch, &type, 0));
           // For HSET/TSADD, we return 0 or 1 depending on if the key already existed.
           // If flag is false, no int response is returned.
           response_.set_int_response(type == REDIS_TYPE_NONE ? 1 : 0);
@@ -433,8 +472,7 @@ Status RedisWriteOperation::ApplySet(DocWriteBatch* doc_write_batch) {
     const RedisWriteMode mode = request_.set_request().mode();
     if (mode != RedisWriteMode::REDIS_WRITEMODE_UPSERT) {
       RedisDataType data_type;
-      RETURN_NOT_OK(GetRedisValueType(doc_write_batch->rocksdb(), read_hybrid_time_, kv, &data_type,
-                                      doc_write_batch));
+      RETURN_NOT_OK(GetValueType(doc_write_batch, &data_type));
       if ((mode == RedisWriteMode::REDIS_WRITEMODE_INSERT && data_type != REDIS_TYPE_NONE)
           || (mode == RedisWriteMode::REDIS_WRITEMODE_UPDATE && data_type == REDIS_TYPE_NONE)) {
         response_.set_code(RedisResponsePB_RedisStatusCode_NOT_FOUND);
@@ -500,8 +538,7 @@ Status RedisWriteOperation::ApplyAppend(DocWriteBatch* doc_write_batch) {
 Status RedisWriteOperation::ApplyDel(DocWriteBatch* doc_write_batch) {
   const RedisKeyValuePB& kv = request_.key_value();
   RedisDataType data_type;
-  RETURN_NOT_OK(GetRedisValueType(doc_write_batch->rocksdb(), read_hybrid_time_, kv, &data_type,
-                                  doc_write_batch));
+  RETURN_NOT_OK(GetValueType(doc_write_batch, &data_type));
   if (data_type != REDIS_TYPE_NONE && data_type != kv.type() && kv.type() != REDIS_TYPE_NONE) {
     response_.set_code(RedisResponsePB_RedisStatusCode_WRONG_TYPE);
     return Status::OK();
@@ -518,8 +555,7 @@ Status RedisWriteOperation::ApplyDel(DocWriteBatch* doc_write_batch) {
     if (EmulateRedisResponse(kv.type())) {
       for (int i = 0; i < kv.subkey_size(); i++) {
         RedisDataType type;
-        RETURN_NOT_OK(GetRedisValueType(
-            doc_write_batch->rocksdb(), read_hybrid_time_, kv, &type, doc_write_batch, i));
+        RETURN_NOT_OK(GetValueType(doc_write_batch, &type, i));
         if (type == REDIS_TYPE_STRING) {
           values.SetChild(PrimitiveValue(kv.subkey(i).string_subkey()),
                           SubDocument(ValueType::kTombstone));
@@ -635,8 +671,7 @@ Status RedisWriteOperation::ApplyAdd(DocWriteBatch* doc_write_batch) {
   const RedisKeyValuePB& kv = request_.key_value();
 
   RedisDataType data_type;
-  RETURN_NOT_OK(GetRedisValueType(doc_write_batch->rocksdb(), read_hybrid_time_, kv, &data_type,
-                                  doc_write_batch));
+  RETURN_NOT_OK(GetValueType(doc_write_batch, &data_type));
 
   if (data_type != REDIS_TYPE_SET && data_type != REDIS_TYPE_NONE) {
     response_.set_code(RedisResponsePB_RedisStatusCode_WRONG_TYPE);
@@ -657,8 +692,7 @@ Status RedisWriteOperation::ApplyAdd(DocWriteBatch* doc_write_batch) {
     if (FLAGS_emulate_redis_responses) {
       RedisDataType type;
       string value;
-      RETURN_NOT_OK(GetRedisValueType(doc_write_batch->rocksdb(), read_hybrid_time_, kv, &type,
-                                      doc_write_batch, i));
+      RETURN_NOT_OK(GetValueType(doc_write_batch, &type, i));
       if (type != REDIS_TYPE_NONE) {
         num_keys_found++;
       }
@@ -826,7 +860,9 @@ Status RedisReadOperation::ExecuteGet(rocksdb::DB *rocksdb, HybridTime hybrid_ti
     case RedisGetRequestPB_GetRequestType_TSGET: FALLTHROUGH_INTENDED;
     case RedisGetRequestPB_GetRequestType_HGET: {
       string value;
-      RETURN_NOT_OK(GetRedisValue(rocksdb, hybrid_time, request_.key_value(), &type, &value));
+      RETURN_NOT_OK(GetRedisValue(
+          rocksdb, hybrid_time, request_.key_value(), &type, &value, -1 /* subkey_index */,
+          iter_));
 
       // If wrong type, we set the error code in the response.
       if (VerifyTypeAndSetCode(RedisDataType::REDIS_TYPE_STRING, type, &response_)) {
@@ -1229,6 +1265,56 @@ Status QLWriteOperation::IsConditionSatisfied(const QLConditionPB& condition,
   return Status::OK();
 }
 
+Status QLWriteOperation::ApplyPackedInsert(DocWriteBatch* doc_write_batch,
+                                           const QLTableRow& table_row,
+                                           const MonoDelta& ttl,
+                                           bool* packed) {
+  *packed = false;
+  if (!FLAGS_ycql_enable_packed_row || pk_doc_path_ == nullptr) {
+    return Status::OK();
+  }
+
+  PackedRowEncoder encoder(request_.schema_version());
+  encoder.AddColumn(PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn),
+                    PrimitiveValue());
+  ColumnIds packed_columns;
+  for (const auto& column_value : request_.column_values()) {
+    if (!column_value.has_column_id() || !column_value.subscript_args().empty()) {
+      return Status::OK();
+    }
+    const ColumnId column_id(column_value.column_id());
+    const auto& column = schema_.column_by_id(column_id);
+    if (column.is_static() || !packed_columns.insert(column_id).second) {
+      return Status::OK();
+    }
+    WriteAction write_action = WriteAction::REPLACE;
+    SubDocument sub_doc;
+    RETURN_NOT_OK(SubDocument::FromQLExpressionPB(column_value.expr(),
+                                                  column,
+                                                  table_row,
+                                                  &sub_doc,
+                                                  &write_action));
+    // Collections keep their elements under separate keys, so only rows of primitive values (or
+    // nulls, which are tombstones) are packed.
+    if (write_action != WriteAction::REPLACE || !sub_doc.IsTombstoneOrPrimitive()) {
+      return Status::OK();
+    }
+    encoder.AddColumn(PrimitiveValue(column_id), sub_doc);
+  }
+
+  // A packed row replaces the whole row, so every column has to be set by this INSERT.
+  for (size_t i = schema_.num_key_columns(); i < schema_.num_columns(); i++) {
+    if (!schema_.column(i).is_static() && packed_columns.count(schema_.column_id(i)) == 0) {
+      return Status::OK();
+    }
+  }
+
+  RETURN_NOT_OK(doc_write_batch->SetPrimitive(*pk_doc_path_, Value(encoder.Finish(), ttl),
+                                              InitMarkerBehavior::OPTIONAL));
+  *packed = true;
+  return Status::OK();
+}
+
 Status QLWriteOperation::Apply(
     DocWriteBatch* doc_write_batch, rocksdb::DB *rocksdb, const HybridTime& hybrid_time) {
 
@@ -1260,6 +1346,14 @@ Status QLWriteOperation::Apply(
       // primary key at least.
       case QLWriteRequestPB::QL_STMT_INSERT:
       case QLWriteRequestPB::QL_STMT_UPDATE: {
+        if (request_.type() == QLWriteRequestPB::QL_STMT_INSERT &&
+            user_timestamp == Value::kInvalidUserTimestamp) {
+          bool packed = false;
+          RETURN_NOT_OK(ApplyPackedInsert(doc_write_batch, table_row, ttl, &packed));
+          if (packed) {
+            break;
+          }
+        }
         // Add the appropriate liveness column only for inserts.
         // We never use init markers for QL to ensure we perform writes without any reads to
         // ensure our write path is fast while complicating the read path a bit.
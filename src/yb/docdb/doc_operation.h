@@ -32,6 +32,7 @@ namespace yb {
 namespace docdb {
 
 class DocWriteBatch;
+class IntentAwareIterator;
 
 class DocOperation {
  public:
@@ -69,8 +70,9 @@ class KuduWriteOperation: public DocOperation {
 class RedisWriteOperation: public DocOperation {
  public:
   // Construct a RedisWriteOperation. Content of request will be swapped out by the constructor.
-  RedisWriteOperation(RedisWriteRequestPB* request, HybridTime read_hybrid_time)
-      : response_(), read_hybrid_time_(read_hybrid_time) { request_.Swap(request); }
+  RedisWriteOperation(RedisWriteRequestPB* request, HybridTime read_hybrid_time);
+
+  ~RedisWriteOperation();
 
   bool RequireReadSnapshot() const override { return false; }
 
@@ -94,14 +96,29 @@ class RedisWriteOperation: public DocOperation {
   CHECKED_STATUS ApplyAdd(DocWriteBatch *doc_write_batch);
   CHECKED_STATUS ApplyRemove(DocWriteBatch *doc_write_batch);
 
+  // Get the type of the value at the key of this operation, or at its subkey at subkey_index.
+  CHECKED_STATUS GetValueType(DocWriteBatch* doc_write_batch, RedisDataType* type,
+                              int subkey_index = -1);
+
   RedisWriteRequestPB request_;
   RedisResponsePB response_;
   HybridTime read_hybrid_time_;
+
+  // Encoded document key of the operation, the bloom filter of iterator_ refers to it.
+  KeyBytes doc_key_encoded_;
+
+  // All the type checks of the operation are within the document of its key, so they share one
+  // iterator at read_hybrid_time_ instead of creating a new one for every subkey.
+  std::unique_ptr<IntentAwareIterator> iterator_;
 };
 
 class RedisReadOperation {
  public:
-  explicit RedisReadOperation(const yb::RedisReadRequestPB& request) : request_(request) {}
+  // If 'iter' is specified, point reads of a single key use it instead of creating an iterator of
+  // their own. This way a batch of reads, sorted by key, could share one RocksDB iterator.
+  explicit RedisReadOperation(const yb::RedisReadRequestPB& request,
+                              IntentAwareIterator* iter = nullptr)
+      : request_(request), iter_(iter) {}
 
   CHECKED_STATUS Execute(rocksdb::DB *rocksdb, const HybridTime& hybrid_time);
 
@@ -123,6 +140,7 @@ class RedisReadOperation {
 
   const RedisReadRequestPB& request_;
   RedisResponsePB response_;
+  IntentAwareIterator* iter_;
 };
 
 class QLWriteOperation : public DocOperation {
@@ -156,6 +174,13 @@ class QLWriteOperation : public DocOperation {
                              QLTableRow *table_row,
                              const rocksdb::QueryId query_id);
 
+  // Writes a full-row INSERT as one packed row at the primary key if --ycql_enable_packed_row is
+  // set and the row can be packed. Sets "packed" to whether it did.
+  CHECKED_STATUS ApplyPackedInsert(DocWriteBatch* doc_write_batch,
+                                   const QLTableRow& table_row,
+                                   const MonoDelta& ttl,
+                                   bool* packed);
+
   CHECKED_STATUS IsConditionSatisfied(const QLConditionPB& condition,
                                       rocksdb::DB *rocksdb,
                                       const HybridTime& hybrid_time,
@@ -66,6 +66,7 @@ DocRowwiseIterator::DocRowwiseIterator(
       db_(db),
       has_upper_bound_key_(false),
       pending_op_(pending_op_counter),
+      readahead_stats_(std::make_shared<rocksdb::ReadAheadStats>()),
       done_(false) {
   projection_subkeys_.reserve(projection.num_columns() + 1);
   projection_subkeys_.push_back(PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn));
@@ -83,7 +84,8 @@ Status DocRowwiseIterator::Init(ScanSpec *spec) {
   // default to not using bloom filters on scans for these codepaths.
   db_iter_ = CreateIntentAwareIterator(
       db_, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none /* user_key_for_filter */,
-      spec->query_id(), txn_op_context_, hybrid_time_);
+      spec->query_id(), txn_op_context_, hybrid_time_, nullptr /* file_filter */,
+      readahead_stats_);
 
   if (spec != nullptr && spec->lower_bound_key() != nullptr) {
     row_key_ = KuduToDocKey(*spec->lower_bound_key());
@@ -112,7 +114,13 @@ Status DocRowwiseIterator::Init(const common::QLScanSpec& spec) {
   RETURN_NOT_OK(doc_spec.upper_bound(&upper_doc_key));
   const bool is_fixed_point_get = !lower_doc_key.empty() &&
       upper_doc_key.HashedComponentsEqual(lower_doc_key);
-  const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER :
+  // When all range components are fixed as well, we are reading a single row and could also use
+  // a range-aware bloom filter.
+  const bool is_whole_doc_key_get = is_fixed_point_get &&
+      upper_doc_key == lower_doc_key &&
+      lower_doc_key.range_group().size() == schema_.num_range_key_columns();
+  const auto mode = is_whole_doc_key_get ? BloomFilterMode::USE_BLOOM_FILTER_ON_WHOLE_DOC_KEY :
+      is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER :
       BloomFilterMode::DONT_USE_BLOOM_FILTER;
 
   // Start scan with the lower bound doc key.
@@ -121,9 +129,10 @@ Status DocRowwiseIterator::Init(const common::QLScanSpec& spec) {
   const KeyBytes row_key_encoded = row_key_.Encode();
   const Slice row_key_encoded_as_slice = row_key_encoded.AsSlice();
 
+  // Reading a single row does not benefit from read-ahead, any other read is a range scan.
   db_iter_ = CreateIntentAwareIterator(
       db_, mode, row_key_encoded_as_slice, doc_spec.QueryId(), txn_op_context_, hybrid_time_,
-      doc_spec.CreateFileFilter());
+      doc_spec.CreateFileFilter(), is_whole_doc_key_get ? nullptr : readahead_stats_);
 
   RETURN_NOT_OK(db_iter_->SeekWithoutHt(row_key_encoded));
   row_ready_ = false;
@@ -454,11 +463,19 @@ Status DocRowwiseIterator::NextRow(const Schema& projection, QLTableRow* table_r
 }
 
 void DocRowwiseIterator::GetIteratorStats(std::vector<IteratorStats>* stats) const {
-  // A no-op implementation that adds new IteratorStats objects. This is an attempt to fix
-  // linked_list-test with the QL table type.
+  // Adds an IteratorStats object per projection column, as the scanner expects. Rows are read
+  // as a whole, so the data blocks read and prefetched by the scan are attributed to the first
+  // column.
   for (int i = 0; i < projection_.num_columns(); i++) {
     stats->emplace_back();
   }
+  if (projection_.num_columns() > 0) {
+    auto& first_column_stats = (*stats)[stats->size() - projection_.num_columns()];
+    first_column_stats.data_blocks_read_from_disk =
+        readahead_stats_->data_blocks_read.load(std::memory_order_relaxed);
+    first_column_stats.data_blocks_prefetched =
+        readahead_stats_->data_blocks_prefetched.load(std::memory_order_relaxed);
+  }
 }
 
 CHECKED_STATUS DocRowwiseIterator::GetNextReadSubDocKey(SubDocKey* sub_doc_key) const {
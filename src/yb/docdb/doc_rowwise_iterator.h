@@ -140,6 +140,9 @@ class DocRowwiseIterator : public common::QLRowwiseIteratorIf {
   // RocksDB does not get destroyed while the iterator is still in use.
   yb::util::ScopedPendingOperation pending_op_;
 
+  // Numbers of data blocks the scan read from disk and read ahead.
+  std::shared_ptr<rocksdb::ReadAheadStats> readahead_stats_;
+
   // The mutable fields that follow are modified by HasNext, a const method.
 
   // Indicates whether we've already finished iterating.
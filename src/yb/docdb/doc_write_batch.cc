@@ -197,7 +197,7 @@ Status DocWriteBatch::SetPrimitive(const DocPath& doc_path,
   const bool is_deletion = value.primitive_value().value_type() == ValueType::kTombstone;
 
   InternalDocIterator doc_iter(
-      rocksdb_, &cache_, BloomFilterMode::USE_BLOOM_FILTER, encoded_doc_key,
+      rocksdb_, &cache_, BloomFilterMode::USE_BLOOM_FILTER_ON_WHOLE_DOC_KEY, encoded_doc_key,
       rocksdb::kDefaultQueryId, &num_rocksdb_seeks_);
 
   if (num_subkeys > 0 || is_deletion) {
@@ -335,8 +335,8 @@ Status DocWriteBatch::ReplaceInList(
   // Ensure we seek directly to indexes and skip init marker if it exists
   key_bytes.AppendValueType(ValueType::kArrayIndex);
   rocksdb::Slice seek_key = key_bytes.AsSlice();
-  auto iter = CreateRocksDBIterator(rocksdb_, BloomFilterMode::USE_BLOOM_FILTER, seek_key,
-                                    query_id);
+  auto iter = CreateRocksDBIterator(rocksdb_, BloomFilterMode::USE_BLOOM_FILTER_ON_WHOLE_DOC_KEY,
+                                    seek_key, query_id);
   SubDocKey found_key;
   Value found_value;
   int current_index = 0;
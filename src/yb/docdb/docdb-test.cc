@@ -17,12 +17,16 @@
 #include <string>
 
 #include "yb/rocksdb/db.h"
+#include "yb/rocksdb/db/compaction.h"
+#include "yb/rocksdb/db/version_edit.h"
+#include "yb/rocksdb/util/arena.h"
 #include "yb/rocksdb/status.h"
 #include "yb/rocksdb/util/statistics.h"
 
 #include "yb/common/hybrid_time.h"
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/docdb_compaction_filter.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/docdb_test_util.h"
 #include "yb/docdb/in_mem_docdb.h"
@@ -62,6 +66,7 @@ CHECKED_STATUS GetPrimitiveValue(const rocksdb::UserBoundaryValues &values,
     size_t index,
     PrimitiveValue *out);
 CHECKED_STATUS GetDocHybridTime(const rocksdb::UserBoundaryValues &values, DocHybridTime *out);
+CHECKED_STATUS GetValueTtlMs(const rocksdb::UserBoundaryValues &values, int64_t *out);
 
 class DocDBTest: public DocDBTestBase {
  protected:
@@ -829,6 +834,68 @@ SubDocKey(DocKey([], ["k1"]), ["s2"; HT(p=1000)]) -> "v21"; ttl: 0.003s
       )#");
 }
 
+TEST_F(DocDBTest, MinorCompactionHistoryGC) {
+  ASSERT_OK(DisableCompactions());
+  const DocKey doc_key(PrimitiveValues("k1"));
+  KeyBytes encoded_doc_key(doc_key.Encode());
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("s1")), PrimitiveValue("v1"),
+                         HybridTime::FromMicros(1000), InitMarkerBehavior::OPTIONAL));
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("s2")), PrimitiveValue("v2"),
+                         HybridTime::FromMicros(2000), InitMarkerBehavior::OPTIONAL));
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("s1")), PrimitiveValue("v3"),
+                         HybridTime::FromMicros(3000), InitMarkerBehavior::OPTIONAL));
+  ASSERT_OK(DeleteSubDoc(DocPath(encoded_doc_key, PrimitiveValue("s2")),
+                         HybridTime::FromMicros(4000), InitMarkerBehavior::OPTIONAL));
+  ASSERT_OK(FlushRocksDB());
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("s3")), PrimitiveValue("v4"),
+                         HybridTime::FromMicros(5000), InitMarkerBehavior::OPTIONAL));
+  ASSERT_OK(FlushRocksDB());
+
+  // The older versions of s1 and s2 and the tombstone of s2 are all reclaimable, but only once the
+  // history cutoff passes the tombstone, which supersedes the older version of s2.
+  uint64_t total_bytes = 0;
+  uint64_t reclaimable_bytes = 0;
+  ASSERT_OK(EstimateReclaimableBytes(
+      rocksdb(), HybridTime::FromMicros(3500), &total_bytes, &reclaimable_bytes));
+  ASSERT_GT(total_bytes, 0U);
+  ASSERT_EQ(0U, reclaimable_bytes);
+  ASSERT_OK(EstimateReclaimableBytes(
+      rocksdb(), HybridTime::FromMicros(4000), &total_bytes, &reclaimable_bytes));
+  ASSERT_GT(reclaimable_bytes, 0U);
+  ASSERT_LT(reclaimable_bytes, total_bytes);
+
+  std::vector<rocksdb::LiveFileMetaData> files;
+  rocksdb()->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(2U, files.size());
+  const auto& older_file =
+      files[0].smallest.seqno < files[1].smallest.seqno ? files[0] : files[1];
+
+  // A compaction of the older file only removes the versions overwritten in it, but keeps the
+  // tombstone, which could be hiding versions in other files.
+  SetHistoryCutoffHybridTime(HybridTime::FromMicros(4500));
+  ASSERT_OK(rocksdb()->CompactFiles(rocksdb::CompactionOptions(), {older_file.name}, 0));
+  AssertDocDbDebugDumpStrEq(R"#(
+      SubDocKey(DocKey([], ["k1"]), ["s1"; HT(p=3000)]) -> "v3"
+      SubDocKey(DocKey([], ["k1"]), ["s2"; HT(p=4000)]) -> DEL
+      SubDocKey(DocKey([], ["k1"]), ["s3"; HT(p=5000)]) -> "v4"
+      )#");
+
+  files.clear();
+  rocksdb()->GetLiveFilesMetaData(&files);
+  std::vector<std::string> file_names;
+  for (const auto& file : files) {
+    file_names.push_back(file.name);
+  }
+  ASSERT_OK(rocksdb()->CompactFiles(rocksdb::CompactionOptions(), file_names, 0));
+  AssertDocDbDebugDumpStrEq(R"#(
+      SubDocKey(DocKey([], ["k1"]), ["s1"; HT(p=3000)]) -> "v3"
+      SubDocKey(DocKey([], ["k1"]), ["s3"; HT(p=5000)]) -> "v4"
+      )#");
+  ASSERT_OK(EstimateReclaimableBytes(
+      rocksdb(), HybridTime::kMax, &total_bytes, &reclaimable_bytes));
+  ASSERT_EQ(0U, reclaimable_bytes);
+}
+
 TEST_F(DocDBTest, TTLCompactionTest) {
   const DocKey doc_key(PrimitiveValues("k1"));
   const MonoDelta one_ms = MonoDelta::FromMilliseconds(1);
@@ -1001,6 +1068,145 @@ SubDocKey(DocKey([], ["k1"]), ["s3"; HT(p=2000)]) -> "v3"; ttl: 0.000s
       )#");
 }
 
+namespace {
+
+// Converts the metadata of a live file back into the form seen by reads and compactions.
+void ToFileMetaData(const rocksdb::LiveFileMetaData& live_file, rocksdb::FileMetaData* file) {
+  file->smallest.key = rocksdb::InternalKey(live_file.smallest.key, live_file.smallest.seqno,
+                                            rocksdb::kTypeValue);
+  file->smallest.seqno = live_file.smallest.seqno;
+  file->smallest.user_values = live_file.smallest.user_values;
+  file->largest.key = rocksdb::InternalKey(live_file.largest.key, live_file.largest.seqno,
+                                           rocksdb::kTypeValue);
+  file->largest.seqno = live_file.largest.seqno;
+  file->largest.user_values = live_file.largest.user_values;
+}
+
+}  // namespace
+
+class DocDBFileFilterTest : public DocDBTest {
+ protected:
+  // Writes one value with the given TTL at the given hybrid time into a new SST file.
+  void WriteFile(const std::string& key, MicrosTime micros, MonoDelta ttl = Value::kMaxTtl) {
+    const DocKey doc_key(PrimitiveValues(key));
+    ASSERT_OK(SetPrimitive(DocPath(doc_key.Encode()), Value(PrimitiveValue("v"), ttl),
+                           HybridTime::FromMicros(micros), InitMarkerBehavior::OPTIONAL));
+    ASSERT_OK(FlushRocksDB());
+  }
+
+  // Returns the metadata of the live files, from the oldest to the newest.
+  void GetFiles(std::vector<rocksdb::FileMetaData>* files) {
+    std::vector<rocksdb::LiveFileMetaData> live_files;
+    rocksdb()->GetLiveFilesMetaData(&live_files);
+    std::sort(live_files.begin(), live_files.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.name < rhs.name;
+    });
+    files->clear();
+    files->resize(live_files.size());
+    for (size_t i = 0; i != live_files.size(); ++i) {
+      ToFileMetaData(live_files[i], &(*files)[i]);
+    }
+  }
+};
+
+TEST_F(DocDBFileFilterTest, HybridTimeFileFilter) {
+  ASSERT_OK(DisableCompactions());
+  WriteFile("k1", 1000);
+  WriteFile("k2", 5000);
+  std::vector<rocksdb::FileMetaData> files;
+  GetFiles(&files);
+  ASSERT_EQ(2U, files.size());
+
+  rocksdb::Arena arena;
+  const rocksdb::FdWithBoundaries older_file(&arena, files[0]);
+  const rocksdb::FdWithBoundaries newer_file(&arena, files[1]);
+
+  // The newer file only has data written after the read time.
+  auto filter = CreateHybridTimeFileFilter(HybridTime::FromMicros(2000), nullptr);
+  ASSERT_TRUE(filter->Filter(older_file));
+  ASSERT_FALSE(filter->Filter(newer_file));
+
+  filter = CreateHybridTimeFileFilter(HybridTime::FromMicros(5000), nullptr);
+  ASSERT_TRUE(filter->Filter(older_file));
+  ASSERT_TRUE(filter->Filter(newer_file));
+}
+
+TEST_F(DocDBFileFilterTest, CanDropFile) {
+  ASSERT_OK(DisableCompactions());
+  const MonoDelta table_ttl = MonoDelta::FromMilliseconds(1);
+  SetTableTTL(table_ttl.ToMilliseconds());
+  WriteFile("k1", 1000);
+  WriteFile("k2", 10000000);
+  std::vector<rocksdb::FileMetaData> files;
+  GetFiles(&files);
+  ASSERT_EQ(2U, files.size());
+
+  // Only the records of the older file have expired at the history cutoff.
+  const HybridTime history_cutoff = HybridTime::FromMicros(1000000);
+  DocDBCompactionFileFilter file_filter(history_cutoff, table_ttl);
+  ASSERT_TRUE(file_filter.CanDropFile(files[0]));
+  ASSERT_FALSE(file_filter.CanDropFile(files[1]));
+
+  SetHistoryCutoffHybridTime(history_cutoff);
+  DocDBCompactionFilterFactory factory(retention_policy_);
+  std::vector<rocksdb::FileMetaData*> file_ptrs = {&files[0], &files[1]};
+  ASSERT_NE(nullptr, factory.CreateCompactionFileFilter(file_ptrs));
+
+  // An explicit value TTL longer than the table TTL could keep records of any file alive.
+  WriteFile("k3", 1000, MonoDelta::FromSeconds(100));
+  GetFiles(&files);
+  ASSERT_EQ(3U, files.size());
+  file_ptrs = {&files[0], &files[1], &files[2]};
+  ASSERT_EQ(nullptr, factory.CreateCompactionFileFilter(file_ptrs));
+}
+
+TEST_F(DocDBFileFilterTest, UniversalCompactionDropsExpiredFiles) {
+  SetTableTTL(1);
+  SetHistoryCutoffHybridTime(HybridTime::FromMicros(1000000));
+  // The last flush triggers a compaction, which should delete the expired files as a whole and
+  // keep the file that still has live records.
+  const int num_files = rocksdb_options_.level0_file_num_compaction_trigger;
+  for (int i = 0; i != num_files - 1; ++i) {
+    WriteFile("k" + std::to_string(i), 1000 * (i + 1));
+  }
+  WriteFile("live", 10000000);
+
+  ASSERT_OK(WaitFor([this]() -> Result<bool> {
+    std::vector<rocksdb::LiveFileMetaData> live_files;
+    rocksdb()->GetLiveFilesMetaData(&live_files);
+    return live_files.size() == 1;
+  }, MonoDelta::FromSeconds(30), "Expired files dropped"));
+
+  std::vector<rocksdb::FileMetaData> files;
+  GetFiles(&files);
+  ASSERT_EQ(1U, files.size());
+  DocHybridTime smallest_ht;
+  ASSERT_OK(GetDocHybridTime(files[0].smallest.user_values, &smallest_ht));
+  ASSERT_EQ(HybridTime::FromMicros(10000000), smallest_ht.hybrid_time());
+}
+
+TEST_F(DocDBFileFilterTest, ExpiredFilesDroppedBelowCompactionTrigger) {
+  SetTableTTL(1);
+  SetHistoryCutoffHybridTime(HybridTime::FromMicros(1000000));
+  // Too few files for the size ratio trigger, but the expired one is still dropped.
+  ASSERT_GT(rocksdb_options_.level0_file_num_compaction_trigger, 2);
+  WriteFile("expired", 1000);
+  WriteFile("live", 10000000);
+
+  ASSERT_OK(WaitFor([this]() -> Result<bool> {
+    std::vector<rocksdb::LiveFileMetaData> live_files;
+    rocksdb()->GetLiveFilesMetaData(&live_files);
+    return live_files.size() == 1;
+  }, MonoDelta::FromSeconds(30), "Expired file dropped"));
+
+  std::vector<rocksdb::FileMetaData> files;
+  GetFiles(&files);
+  ASSERT_EQ(1U, files.size());
+  DocHybridTime smallest_ht;
+  ASSERT_OK(GetDocHybridTime(files[0].smallest.user_values, &smallest_ht));
+  ASSERT_EQ(HybridTime::FromMicros(10000000), smallest_ht.hybrid_time());
+}
+
 TEST_F(DocDBTest, BasicTest) {
   // A few points to make it easier to understand the expected binary representations here:
   // - Initial bytes such as 'S' (kString), 'I' (kInt64) correspond to members of the enum
@@ -1337,6 +1543,12 @@ class DocDBTestBoundaryValues: public DocDBTest {
           ASSERT_OK(GetDocHybridTime(largest, &temp));
           ASSERT_EQ(times.max, temp.hybrid_time());
         }
+        {
+          // Values were written without explicit TTL.
+          int64_t ttl_ms = -1;
+          ASSERT_OK(GetValueTtlMs(largest, &ttl_ms));
+          ASSERT_EQ(0, ttl_ms);
+        }
         {
           auto &key_ints = trackers[j].key_ints;
           auto &key_strs = trackers[j].key_strs;
@@ -30,6 +30,7 @@
 #include "yb/docdb/docdb_util.h"
 #include "yb/docdb/intent.h"
 #include "yb/docdb/internal_doc_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
@@ -312,6 +313,90 @@ CHECKED_STATUS SeekToLowerBound(const SubDocKeyBound& lower_bound, const HybridT
   return Status::OK();
 }
 
+// Sets the remaining TTL and the write time reported for a primitive value written at write_time
+// with the given TTL and user timestamp, as of high_ts.
+void SetTtlAndWritetime(const MonoDelta& ttl,
+                        const DocHybridTime& write_time,
+                        const UserTimeMicros user_timestamp,
+                        const HybridTime high_ts,
+                        PrimitiveValue* value) {
+  DCHECK_GE(high_ts, write_time.hybrid_time());
+  if (ttl.Equals(Value::kMaxTtl)) {
+    value->SetTtl(-1);
+  } else {
+    int64_t time_since_write_seconds = (
+        server::HybridClock::GetPhysicalValueMicros(high_ts) -
+        server::HybridClock::GetPhysicalValueMicros(write_time.hybrid_time())) /
+        MonoTime::kMicrosecondsPerSecond;
+    int64_t ttl_seconds = std::max(static_cast<int64_t>(0),
+        ttl.ToMilliseconds() / MonoTime::kMillisecondsPerSecond - time_since_write_seconds);
+    value->SetTtl(ttl_seconds);
+  }
+
+  // Choose the user supplied timestamp if present.
+  value->SetWritetime(
+      user_timestamp == Value::kInvalidUserTimestamp
+          ? write_time.hybrid_time().GetPhysicalValueMicros()
+          : user_timestamp);
+}
+
+// Replaces "subdocument" with an object holding the columns of the packed row found at
+// subdocument_key that lie within the subkey bounds. Columns set to null are left out.
+CHECKED_STATUS ExpandPackedRow(
+    const SubDocKey& subdocument_key,
+    const Value& packed_row,
+    const MonoDelta& ttl,
+    const DocHybridTime& write_time,
+    const HybridTime high_ts,
+    const SubDocKeyBound& low_subkey,
+    const SubDocKeyBound& high_subkey,
+    SubDocument* subdocument) {
+  uint32_t schema_version = 0;
+  PackedColumns columns;
+  RETURN_NOT_OK(DecodePackedRow(packed_row.primitive_value(), &schema_version, &columns));
+  *subdocument = SubDocument();
+  for (auto& column : columns) {
+    if (column.second.value_type() == ValueType::kTombstone) {
+      continue;
+    }
+    if (low_subkey.IsValid() || high_subkey.IsValid()) {
+      SubDocKey column_key = subdocument_key;
+      column_key.AppendSubKeysAndMaybeHybridTime(column.first);
+      if ((low_subkey.IsValid() && !low_subkey.CanInclude(column_key)) ||
+          (high_subkey.IsValid() && !high_subkey.CanInclude(column_key))) {
+        continue;
+      }
+    }
+    SetTtlAndWritetime(ttl, write_time, packed_row.user_timestamp(), high_ts, &column.second);
+    subdocument->SetChild(column.first, SubDocument(std::move(column.second)));
+  }
+  return Status::OK();
+}
+
+// Expands doc_value into "packed_row" if it is a packed row written at write_time that has not
+// expired by high_ts.
+CHECKED_STATUS MaybeExpandPackedRow(
+    const SubDocKey& row_key,
+    const Value& doc_value,
+    const DocHybridTime& write_time,
+    const HybridTime high_ts,
+    const MonoDelta& table_ttl,
+    const SubDocKeyBound& low_subkey,
+    const SubDocKeyBound& high_subkey,
+    SubDocument* packed_row) {
+  if (doc_value.value_type() != ValueType::kPackedRow) {
+    return Status::OK();
+  }
+  const MonoDelta ttl = ComputeTTL(doc_value.ttl(), table_ttl);
+  if (!ttl.Equals(Value::kMaxTtl) &&
+      high_ts.CompareTo(server::HybridClock::AddPhysicalTimeToHybridTime(
+          write_time.hybrid_time(), ttl)) > 0) {
+    return Status::OK();
+  }
+  return ExpandPackedRow(row_key, doc_value, ttl, write_time, high_ts, low_subkey, high_subkey,
+                         packed_row);
+}
+
 // This works similar to the ScanSubDocument function, but doesn't assume that object init_markers
 // are present. If no init marker is present, or if a tombstone is found at some level,
 // it still looks for subkeys inside it if they have larger timestamps.
@@ -323,6 +408,9 @@ CHECKED_STATUS SeekToLowerBound(const SubDocKeyBound& lower_bound, const HybridT
 // after the function returns, the iterator should be placed just completely outside the
 // subdocument_key prefix. Although if high_subkey is specified, the iterator is only guaranteed
 // to be positioned after the high_subkey and not necessarily outside the subdocument_key prefix.
+//
+// The value subdocument holds on entry is kept unless something written after low_ts is found, so
+// the caller can pass in a column of a packed row written at low_ts.
 CHECKED_STATUS BuildSubDocument(
     IntentAwareIterator* iter,
     const SubDocKey &subdocument_key,
@@ -339,6 +427,8 @@ CHECKED_STATUS BuildSubDocument(
                   low_ts.ToString(),
                   table_ttl.ToString());
   const KeyBytes encoded_key = subdocument_key.Encode();
+  // Whether the children of subdocument come from a packed row found at this level.
+  bool packed = false;
 
   while (true) {
 
@@ -397,6 +487,19 @@ CHECKED_STATUS BuildSubDocument(
         }
       }
 
+      if (doc_value.value_type() == ValueType::kPackedRow) {
+        // A packed row acts as an init marker followed by all of its columns.
+        if (low_ts < write_time) {
+          low_ts = write_time;
+        }
+        RETURN_NOT_OK(ExpandPackedRow(subdocument_key, doc_value, ttl, write_time, high_ts,
+                                      low_subkey, high_subkey, subdocument));
+        packed = true;
+        DOCDB_DEBUG_LOG("SeekPastSubKey: $0", found_key.ToString());
+        RETURN_NOT_OK(iter->SeekPastSubKey(found_key));
+        continue;
+      }
+
       // We have found some key that matches our entire subdocument_key, i.e. we didn't skip ahead
       // to a lower level key (with optional object init markers).
       if (IsObjectType(doc_value.value_type()) ||
@@ -408,6 +511,9 @@ CHECKED_STATUS BuildSubDocument(
         if (IsObjectType(doc_value.value_type()) ||
             doc_value.value_type() == ValueType::kArray) {
           *subdocument = SubDocument(doc_value.value_type());
+        } else {
+          // The tombstone hides the value the caller passed in.
+          *subdocument = SubDocument(ValueType::kInvalidValueType);
         }
 
         if (IsObjectType(doc_value.value_type()) && low_subkey.IsValid()) {
@@ -424,25 +530,8 @@ CHECKED_STATUS BuildSubDocument(
               "Expected primitive value type, got $0", doc_value.value_type());
         }
 
-        DCHECK_GE(high_ts, write_time.hybrid_time());
-        if (ttl.Equals(Value::kMaxTtl)) {
-          doc_value.mutable_primitive_value()->SetTtl(-1);
-        } else {
-          int64_t time_since_write_seconds = (
-              server::HybridClock::GetPhysicalValueMicros(high_ts) -
-              server::HybridClock::GetPhysicalValueMicros(write_time.hybrid_time())) /
-              MonoTime::kMicrosecondsPerSecond;
-          int64_t ttl_seconds = std::max(static_cast<int64_t>(0),
-              ttl.ToMilliseconds() / MonoTime::kMillisecondsPerSecond - time_since_write_seconds);
-          doc_value.mutable_primitive_value()->SetTtl(ttl_seconds);
-        }
-
-        // Choose the user supplied timestamp if present.
-        const UserTimeMicros user_timestamp = doc_value.user_timestamp();
-        doc_value.mutable_primitive_value()->SetWritetime(
-            user_timestamp == Value::kInvalidUserTimestamp
-                ? write_time.hybrid_time().GetPhysicalValueMicros()
-                : doc_value.user_timestamp());
+        SetTtlAndWritetime(ttl, write_time, doc_value.user_timestamp(), high_ts,
+                           doc_value.mutable_primitive_value());
         *subdocument = SubDocument(doc_value.primitive_value());
         DOCDB_DEBUG_LOG("SeekForward: $0.AdvanceOutOfSubDoc() = $1", found_key.ToString(),
             found_key.AdvanceOutOfSubDoc().ToString());
@@ -455,11 +544,24 @@ CHECKED_STATUS BuildSubDocument(
     // TODO: what if found_key is the same as before? We'll get into an infinite recursion then.
     found_key.remove_hybrid_time();
 
+    // A column of a packed row that was written again later starts from its packed value.
+    const bool packed_column =
+        packed && found_key.num_subkeys() == subdocument_key.num_subkeys() + 1;
+    if (packed_column) {
+      const SubDocument* packed_value = subdocument->GetChild(found_key.subkeys().back());
+      if (packed_value != nullptr) {
+        descendant = *packed_value;
+      }
+    }
+
     RETURN_NOT_OK(BuildSubDocument(iter, found_key, &descendant, high_ts, low_ts, table_ttl,
                                    low_subkey,
                                    high_subkey));
     if (descendant.value_type() == ValueType::kInvalidValueType) {
       // The document was not found in this level (maybe a tombstone was encountered).
+      if (packed_column) {
+        subdocument->DeleteChild(found_key.subkeys().back());
+      }
       continue;
     }
 
@@ -503,8 +605,8 @@ yb::Status GetSubDocument(
     const SubDocKeyBound& high_subkey) {
   const auto doc_key_encoded = subdocument_key.doc_key().Encode();
   auto iter = CreateIntentAwareIterator(
-      db, BloomFilterMode::USE_BLOOM_FILTER, doc_key_encoded.AsSlice(), query_id, txn_op_context,
-      scan_ht);
+      db, BloomFilterMode::USE_BLOOM_FILTER_ON_WHOLE_DOC_KEY, doc_key_encoded.AsSlice(), query_id,
+      txn_op_context, scan_ht);
   return GetSubDocument(
       iter.get(), subdocument_key, result, doc_found, scan_ht, table_ttl,
       nullptr /* projection */, return_type_only, false /* is_iter_valid */, low_subkey,
@@ -548,9 +650,20 @@ yb::Status GetSubDocument(
     RETURN_NOT_OK(db_iter->SeekWithoutHt(key_bytes));
   }
 
-  // Check ancestors for init markers and tombstones, update max_deleted_ts with them.
+  // Check ancestors for init markers and tombstones, update max_deleted_ts with them. A packed row
+  // at the top level holds the columns of the row, some of which may be read below.
+  SubDocument packed_row(ValueType::kInvalidValueType);
+  bool at_top_level = true;
   for (const PrimitiveValue& subkey : subdocument_key.subkeys()) {
-    RETURN_NOT_OK(db_iter->FindLastWriteTime(key_bytes, scan_ht, &max_deleted_ts, nullptr));
+    Value row_value = Value(PrimitiveValue(ValueType::kInvalidValueType));
+    RETURN_NOT_OK(db_iter->FindLastWriteTime(key_bytes, scan_ht, &max_deleted_ts,
+                                             at_top_level ? &row_value : nullptr));
+    if (at_top_level) {
+      RETURN_NOT_OK(MaybeExpandPackedRow(
+          SubDocKey(subdocument_key.doc_key()), row_value, max_deleted_ts, scan_ht, table_ttl,
+          SubDocKeyBound(), SubDocKeyBound(), &packed_row));
+      at_top_level = false;
+    }
     subkey.AppendToKey(&key_bytes);
   }
 
@@ -569,6 +682,12 @@ yb::Status GetSubDocument(
 
   if (projection == nullptr) {
     *result = SubDocument(ValueType::kInvalidValueType);
+    if (subdocument_key.num_subkeys() == 1) {
+      const SubDocument* packed_value = packed_row.GetChild(subdocument_key.subkeys().front());
+      if (packed_value != nullptr) {
+        *result = *packed_value;
+      }
+    }
     RETURN_NOT_OK(BuildSubDocument(db_iter, subdocument_key, result, scan_ht, max_deleted_ts,
         table_ttl, low_subkey, high_subkey));
     *doc_found = result->value_type() != ValueType::kInvalidValueType;
@@ -581,10 +700,20 @@ yb::Status GetSubDocument(
 
     return Status::OK();
   }
+  if (subdocument_key.num_subkeys() == 0) {
+    // The packed row, if any, is the latest write at the top level, so max_deleted_ts is its write
+    // time.
+    RETURN_NOT_OK(MaybeExpandPackedRow(subdocument_key, doc_value, max_deleted_ts, scan_ht,
+                                       table_ttl, low_subkey, high_subkey, &packed_row));
+  }
   // For each subkey in the projection, build subdocument.
   *result = SubDocument();
   for (const PrimitiveValue& subkey : *projection) {
     SubDocument descendant(ValueType::kInvalidValueType);
+    const SubDocument* packed_value = packed_row.GetChild(subkey);
+    if (packed_value != nullptr) {
+      descendant = *packed_value;
+    }
     SubDocKey projection_subdockey = subdocument_key;
     projection_subdockey.AppendSubKeysAndMaybeHybridTime(subkey);
     // This seek is to initialize the iterator for BuildSubDocument call.
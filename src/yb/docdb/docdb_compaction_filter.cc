@@ -13,27 +13,139 @@
 
 #include "yb/docdb/docdb_compaction_filter.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <glog/logging.h>
 
 #include "yb/rocksdb/compaction_filter.h"
+#include "yb/rocksdb/db.h"
+#include "yb/rocksdb/db/version_edit.h"
 #include "yb/rocksdb/util/string_util.h"
 
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_kv_util.h"
 #include "yb/docdb/docdb-internal.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/value.h"
 #include "yb/rocksutil/yb_rocksdb.h"
+#include "yb/util/flag_tags.h"
 
 using std::shared_ptr;
 using std::unique_ptr;
 using std::unordered_set;
 using rocksdb::CompactionFilter;
+using rocksdb::CompactionFileFilter;
 using rocksdb::VectorToString;
 
+DEFINE_bool(docdb_drop_expired_files, true,
+            "Whether compactions should delete SST files whose records have all expired according "
+            "to the table TTL, without rewriting them.");
+
+DEFINE_bool(docdb_history_gc_on_minor_compactions, true,
+            "Whether compactions that do not include all SST files should garbage-collect the "
+            "history they can, i.e. the versions overwritten by newer versions in the same "
+            "compaction. Tombstones are still only removed by full compactions.");
+TAG_FLAG(docdb_history_gc_on_minor_compactions, advanced);
+
 namespace yb {
 namespace docdb {
 
+Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime* out);
+Status GetValueTtlMs(const rocksdb::UserBoundaryValues& values, int64_t* out);
+
+namespace {
+
+// Drops the deleted columns from the packed row in existing_value. Returns whether there were any,
+// in which case new_value is set to the rewritten value.
+bool DropDeletedPackedColumns(const rocksdb::Slice& existing_value,
+                              const ColumnIds& deleted_cols,
+                              std::string* new_value) {
+  Value value;
+  CHECK_OK(value.Decode(existing_value));
+  uint32_t schema_version = 0;
+  PackedColumns columns;
+  CHECK_OK(DecodePackedRow(value.primitive_value(), &schema_version, &columns));
+  PackedRowEncoder encoder(schema_version);
+  for (auto& column : columns) {
+    if (column.first.value_type() == ValueType::kColumnId &&
+        deleted_cols.find(column.first.GetColumnId()) != deleted_cols.end()) {
+      continue;
+    }
+    encoder.AddColumn(std::move(column.first), std::move(column.second));
+  }
+  if (encoder.num_columns() == columns.size()) {
+    return false;
+  }
+  *new_value = Value(encoder.Finish(), value.ttl(), value.user_timestamp()).Encode();
+  return true;
+}
+
+class DocDBReclaimableBytesCollector : public rocksdb::TablePropertiesCollector {
+ public:
+  rocksdb::Status AddUserKey(const rocksdb::Slice& key, const rocksdb::Slice& value,
+                             rocksdb::EntryType type, rocksdb::SequenceNumber /* seq */,
+                             uint64_t /* file_size */) override {
+    if (type != rocksdb::kEntryPut || key.empty() ||
+        static_cast<ValueType>(key[0]) == ValueType::kIntentPrefix) {
+      prev_key_without_ht_.clear();
+      return Status::OK();
+    }
+    int ht_size = 0;
+    DocHybridTime doc_ht;
+    if (!CheckHybridTimeSizeAndValueType(key, &ht_size).ok() || !doc_ht.DecodeFromEnd(key).ok()) {
+      prev_key_without_ht_.clear();
+      return Status::OK();
+    }
+    // Versions of the same key are ordered from the newest to the oldest, so every version but the
+    // first one in the file is superseded. A superseded version can be dropped once the history
+    // cutoff passes the version that supersedes it, a tombstone once the cutoff passes the tombstone.
+    const rocksdb::Slice key_without_ht(key.data(), key.size() - ht_size - 1);
+    ValueType value_type = ValueType::kInvalidValueType;
+    if (key_without_ht == rocksdb::Slice(prev_key_without_ht_)) {
+      AddReclaimable(key.size() + value.size(), prev_ht_);
+    } else if (Value::DecodePrimitiveValueType(value, &value_type).ok() &&
+               value_type == ValueType::kTombstone) {
+      AddReclaimable(key.size() + value.size(), doc_ht.hybrid_time());
+    }
+    prev_key_without_ht_.assign(key_without_ht.cdata(), key_without_ht.size());
+    prev_ht_ = doc_ht.hybrid_time();
+    return Status::OK();
+  }
+
+  rocksdb::Status Finish(rocksdb::UserCollectedProperties* properties) override {
+    for (auto& property : GetReadableProperties()) {
+      (*properties)[property.first] = std::move(property.second);
+    }
+    return Status::OK();
+  }
+
+  rocksdb::UserCollectedProperties GetReadableProperties() const override {
+    return {{kReclaimableBytesPropertyName, std::to_string(reclaimable_bytes_)},
+            {kReclaimableMaxHybridTimePropertyName, std::to_string(max_reclaimable_ht_.ToUint64())}};
+  }
+
+  const char* Name() const override {
+    return "DocDBReclaimableBytesCollector";
+  }
+
+ private:
+  void AddReclaimable(size_t bytes, HybridTime reclaimable_after) {
+    reclaimable_bytes_ += bytes;
+    max_reclaimable_ht_ = std::max(max_reclaimable_ht_, reclaimable_after);
+  }
+
+  std::string prev_key_without_ht_;
+  HybridTime prev_ht_ = HybridTime::kMin;
+  uint64_t reclaimable_bytes_ = 0;
+  HybridTime max_reclaimable_ht_ = HybridTime::kMin;
+};
+
+}  // namespace
+
+const char kReclaimableBytesPropertyName[] = "docdb.reclaimable_bytes";
+const char kReclaimableMaxHybridTimePropertyName[] = "docdb.reclaimable_max_ht";
+
 // ------------------------------------------------------------------------------------------------
 
 DocDBCompactionFilter::DocDBCompactionFilter(HybridTime history_cutoff,
@@ -56,17 +168,18 @@ bool DocDBCompactionFilter::Filter(int level,
                                    const rocksdb::Slice& existing_value,
                                    std::string* new_value,
                                    bool* value_changed) const {
-  if (!is_full_compaction_) {
-    // By default, we only perform history garbage collection on full compactions
-    // (or major compactions, in the HBase terminology).
-    //
-    // TODO: Enable history garbage collection on minor (non-full) compactions as well.
-    //       This should be similar to the existing workflow, but should be extensively tested.
-    //
+  if (!is_full_compaction_ && !FLAGS_docdb_history_gc_on_minor_compactions) {
     // Here, false means "keep the key/value pair" (don't filter it out).
     return false;
   }
 
+  // A minor (non-full) compaction only sees some of the SST files, so it can only remove the
+  // entries that are overwritten by entries it keeps. That is always the case below: an entry is
+  // removed for being older than the overwrite hybrid time of its own or a parent key, and the
+  // entry that set that overwrite hybrid time is kept, unless it belongs to a deleted column, in
+  // which case the removed entry does as well. Tombstones and expired entries could be hiding
+  // older entries in files that are not part of the compaction, so a minor compaction keeps them.
+
   if (!filter_usage_logged_) {
     // TODO: switch this to VLOG if it becomes too chatty.
     LOG(INFO) << "DocDB compaction filter is being used";
@@ -194,6 +307,11 @@ bool DocDBCompactionFilter::Filter(int level,
     // record might expose earlier values which would be incorrect.
     *value_changed = true;
     *new_value = Value(PrimitiveValue(ValueType::kTombstone)).Encode();
+  } else if (value_type == ValueType::kPackedRow && !deleted_cols_->empty()) {
+    // Columns of packed rows are not keys of their own, so they are removed by rewriting the row.
+    if (DropDeletedPackedColumns(existing_value, *deleted_cols_, new_value)) {
+      *value_changed = true;
+    }
   }
 
   // Deletes at or below the history cutoff hybrid_time can always be cleaned up on full (major)
@@ -209,6 +327,26 @@ const char* DocDBCompactionFilter::Name() const {
 
 // ------------------------------------------------------------------------------------------------
 
+bool DocDBCompactionFileFilter::CanDropFile(const rocksdb::FileMetaData& file) const {
+  // Intents sort before regular records. They should only be removed by transaction cleanup.
+  const auto smallest_key = file.smallest.key.user_key();
+  if (smallest_key.empty() ||
+      static_cast<ValueType>(smallest_key[0]) == ValueType::kIntentPrefix) {
+    return false;
+  }
+
+  DocHybridTime largest_ht;
+  if (!GetDocHybridTime(file.largest.user_values, &largest_ht).ok()) {
+    return false;
+  }
+
+  bool has_expired = false;
+  CHECK_OK(HasExpiredTTL(largest_ht.hybrid_time(), table_ttl_, history_cutoff_, &has_expired));
+  return has_expired;
+}
+
+// ------------------------------------------------------------------------------------------------
+
 DocDBCompactionFilterFactory::DocDBCompactionFilterFactory(
     shared_ptr<HistoryRetentionPolicy> retention_policy)
     :
@@ -226,9 +364,70 @@ unique_ptr<CompactionFilter> DocDBCompactionFilterFactory::CreateCompactionFilte
                                 context.is_full_compaction, retention_policy_->GetTableTTL()));
 }
 
+unique_ptr<CompactionFileFilter> DocDBCompactionFilterFactory::CreateCompactionFileFilter(
+    const std::vector<rocksdb::FileMetaData*>& files) {
+  if (!FLAGS_docdb_drop_expired_files) {
+    return nullptr;
+  }
+  const MonoDelta table_ttl = retention_policy_->GetTableTTL();
+  if (table_ttl.Equals(Value::kMaxTtl)) {
+    return nullptr;
+  }
+  for (const auto* file : files) {
+    int64_t max_value_ttl_ms = 0;
+    if (!GetValueTtlMs(file->largest.user_values, &max_value_ttl_ms).ok() ||
+        max_value_ttl_ms > table_ttl.ToMilliseconds()) {
+      return nullptr;
+    }
+  }
+  return std::make_unique<DocDBCompactionFileFilter>(
+      retention_policy_->GetHistoryCutoff(), table_ttl);
+}
+
 const char* DocDBCompactionFilterFactory::Name() const {
   return "DocDBCompactionFilterFactory";
 }
 
+// ------------------------------------------------------------------------------------------------
+
+rocksdb::TablePropertiesCollector*
+DocDBReclaimableBytesCollectorFactory::CreateTablePropertiesCollector(
+    rocksdb::TablePropertiesCollectorFactory::Context context) {
+  return new DocDBReclaimableBytesCollector();
+}
+
+const char* DocDBReclaimableBytesCollectorFactory::Name() const {
+  return "DocDBReclaimableBytesCollectorFactory";
+}
+
+Status EstimateReclaimableBytes(rocksdb::DB* db,
+                                HybridTime history_cutoff,
+                                uint64_t* total_bytes,
+                                uint64_t* reclaimable_bytes) {
+  rocksdb::TablePropertiesCollection props;
+  RETURN_NOT_OK(db->GetPropertiesOfAllTables(&props));
+  *total_bytes = 0;
+  *reclaimable_bytes = 0;
+  for (const auto& file_and_props : props) {
+    const rocksdb::TableProperties& table_props = *file_and_props.second;
+    *total_bytes += table_props.raw_key_size + table_props.raw_value_size;
+    const auto& user_props = table_props.user_collected_properties;
+    const auto it = user_props.find(kReclaimableBytesPropertyName);
+    // Files written before the collector was installed do not have the properties.
+    if (it == user_props.end()) {
+      continue;
+    }
+    // Some of the garbage of the file is still within the retention window, so a compaction now
+    // would not reclaim all of it. Such a file is counted again once the cutoff passes it.
+    const auto ht_it = user_props.find(kReclaimableMaxHybridTimePropertyName);
+    if (ht_it != user_props.end() &&
+        std::strtoull(ht_it->second.c_str(), nullptr, 10) > history_cutoff.ToUint64()) {
+      continue;
+    }
+    *reclaimable_bytes += std::strtoull(it->second.c_str(), nullptr, 10);
+  }
+  return Status::OK();
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -19,11 +19,16 @@
 #include <vector>
 
 #include "yb/rocksdb/compaction_filter.h"
+#include "yb/rocksdb/table_properties.h"
 
 #include "yb/common/schema.h"
 #include "yb/common/hybrid_time.h"
 #include "yb/docdb/doc_key.h"
 
+namespace rocksdb {
+class DB;
+}
+
 namespace yb {
 namespace docdb {
 
@@ -137,18 +142,65 @@ class FixedHybridTimeRetentionPolicy : public HistoryRetentionPolicy {
   MonoDelta table_ttl_;
 };
 
+// Allows universal compaction to delete SST files in which all records have expired according to
+// the table TTL at the history cutoff, without reading them through DocDBCompactionFilter.
+class DocDBCompactionFileFilter : public rocksdb::CompactionFileFilter {
+ public:
+  DocDBCompactionFileFilter(HybridTime history_cutoff, MonoDelta table_ttl)
+      : history_cutoff_(history_cutoff), table_ttl_(table_ttl) {
+  }
+
+  bool CanDropFile(const rocksdb::FileMetaData& file) const override;
+
+ private:
+  const HybridTime history_cutoff_;
+  const MonoDelta table_ttl_;
+};
+
 class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
  public:
   explicit DocDBCompactionFilterFactory(std::shared_ptr<HistoryRetentionPolicy> retention_policy);
   ~DocDBCompactionFilterFactory() override;
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
+
+  // Whole files could only be dropped when the table has a default TTL and no file contains values
+  // with an explicit TTL exceeding it. Otherwise dropping an expired record could expose an older
+  // version of it that is still alive.
+  std::unique_ptr<rocksdb::CompactionFileFilter> CreateCompactionFileFilter(
+      const std::vector<rocksdb::FileMetaData*>& files) override;
   const char* Name() const override;
 
  private:
   std::shared_ptr<HistoryRetentionPolicy> retention_policy_;
 };
 
+// Name of the SST file property that holds the estimated number of reclaimable key/value bytes in
+// the file, as a decimal number.
+extern const char kReclaimableBytesPropertyName[];
+
+// Name of the SST file property that holds the hybrid time the history cutoff has to pass for all
+// the reclaimable bytes of the file to be garbage-collectable, as a decimal HybridTime value.
+extern const char kReclaimableMaxHybridTimePropertyName[];
+
+// Estimates, for each SST file written, the key/value bytes a full compaction could garbage-collect
+// once the history cutoff passes them: tombstones, and versions followed in the same file by a newer
+// version of the same key. Versions shadowed by a parent document overwrite or by an entry in
+// another file are not counted, so the estimate is a lower bound.
+class DocDBReclaimableBytesCollectorFactory : public rocksdb::TablePropertiesCollectorFactory {
+ public:
+  rocksdb::TablePropertiesCollector* CreateTablePropertiesCollector(
+      rocksdb::TablePropertiesCollectorFactory::Context context) override;
+  const char* Name() const override;
+};
+
+// Sums the key/value bytes over all the SST files of the given DocDB RocksDB instance, and the
+// estimated reclaimable bytes over those whose garbage is all older than the given history cutoff.
+CHECKED_STATUS EstimateReclaimableBytes(rocksdb::DB* db,
+                                        HybridTime history_cutoff,
+                                        uint64_t* total_bytes,
+                                        uint64_t* reclaimable_bytes);
+
 }  // namespace docdb
 }  // namespace yb
 
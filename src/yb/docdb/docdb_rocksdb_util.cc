@@ -19,11 +19,14 @@
 
 #include "yb/rocksdb/rate_limiter.h"
 #include "yb/rocksdb/table.h"
+#include "yb/rocksdb/db/compaction.h"
 
+#include "yb/docdb/docdb_compaction_filter.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 #include "yb/server/hybrid_clock.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/trace.h"
 #include "yb/util/logging.h"
 
@@ -58,8 +61,21 @@ DEFINE_int64(db_block_size_bytes, 32 * 1024,
 
 DEFINE_bool(use_docdb_aware_bloom_filter, true,
             "Whether to use the DocDbAwareFilterPolicy for both bloom storage and seeks.");
+DEFINE_bool(use_docdb_hybrid_time_file_filter, true,
+            "Whether non-transactional reads should skip SST files that only contain data written "
+            "after the read time.");
 DEFINE_int32(max_nexts_to_avoid_seek, 8,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
+DEFINE_int64(docdb_scan_readahead_size_bytes, 0,
+             "Maximum number of bytes of data blocks a DocDB range scan reads ahead once it moves "
+             "sequentially through an SST file. The read-ahead window starts at two blocks and "
+             "doubles up to this size. 0 disables scan read-ahead.");
+TAG_FLAG(docdb_scan_readahead_size_bytes, advanced);
+DEFINE_bool(docdb_scan_prefetch_in_background, false,
+            "Whether DocDB range scans prefetch the next read-ahead window on a background thread "
+            "pool while reading the current one.");
+TAG_FLAG(docdb_scan_prefetch_in_background, advanced);
+
 DEFINE_bool(trace_docdb_calls, false, "Whether we should trace calls into the docdb.");
 
 DEFINE_uint64(initial_seqno, 1ULL << 50, "Initial seqno for new RocksDB instances.");
@@ -73,6 +89,7 @@ namespace yb {
 namespace docdb {
 
 std::shared_ptr<rocksdb::BoundaryValuesExtractor> DocBoundaryValuesExtractorInstance();
+rocksdb::UserBoundaryTag TagForHybridTime();
 
 Status SeekToValidKvAtTs(
     rocksdb::Iterator *iter,
@@ -262,6 +279,33 @@ void PerformRocksDBSeek(
 
 namespace {
 
+// Excludes SST files which contain only records written after the given hybrid time, since they
+// could not be visible to a read at that time. Remaining files are passed to the next filter, if
+// any.
+class HybridTimeFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  HybridTimeFileFilter(HybridTime max_hybrid_time, std::shared_ptr<rocksdb::ReadFileFilter> next)
+      : max_hybrid_time_(max_hybrid_time), next_(std::move(next)) {
+  }
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    const auto* smallest = file.smallest.user_value_with_tag(TagForHybridTime());
+    if (smallest != nullptr) {
+      DocHybridTime smallest_ht;
+      // Keep the file if we could not decode its boundaries.
+      if (smallest_ht.FullyDecodeFrom(*smallest).ok() &&
+          smallest_ht.hybrid_time() > max_hybrid_time_) {
+        return false;
+      }
+    }
+    return next_ == nullptr || next_->Filter(file);
+  }
+
+ private:
+  const HybridTime max_hybrid_time_;
+  const std::shared_ptr<rocksdb::ReadFileFilter> next_;
+};
+
 rocksdb::ReadOptions PrepareReadOptions(
     rocksdb::DB* rocksdb,
     BloomFilterMode bloom_filter_mode,
@@ -270,8 +314,13 @@ rocksdb::ReadOptions PrepareReadOptions(
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter) {
   rocksdb::ReadOptions read_opts;
   read_opts.query_id = query_id;
-  if (FLAGS_use_docdb_aware_bloom_filter &&
-    bloom_filter_mode == BloomFilterMode::USE_BLOOM_FILTER) {
+  // A range-aware filter can't tell whether some DocKey with the same hashed components is present
+  // in an SST file, so it could only be used when the whole DocKey is known.
+  const bool use_bloom_filter =
+      bloom_filter_mode == BloomFilterMode::USE_BLOOM_FILTER_ON_WHOLE_DOC_KEY ||
+      (bloom_filter_mode == BloomFilterMode::USE_BLOOM_FILTER &&
+       !UsesRangeAwareBloomFilter(rocksdb));
+  if (FLAGS_use_docdb_aware_bloom_filter && use_bloom_filter) {
     DCHECK(user_key_for_filter);
     read_opts.table_aware_file_filter = rocksdb->GetOptions().table_factory->
         NewTableAwareReadFileFilter(read_opts, user_key_for_filter.get());
@@ -292,6 +341,11 @@ unique_ptr<rocksdb::Iterator> CreateRocksDBIterator(
       bloom_filter_mode, user_key_for_filter, query_id, std::move(file_filter))));
 }
 
+std::shared_ptr<rocksdb::ReadFileFilter> CreateHybridTimeFileFilter(
+    HybridTime max_hybrid_time, std::shared_ptr<rocksdb::ReadFileFilter> next) {
+  return std::make_shared<HybridTimeFileFilter>(max_hybrid_time, std::move(next));
+}
+
 unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     rocksdb::DB* rocksdb,
     BloomFilterMode bloom_filter_mode,
@@ -299,16 +353,42 @@ unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     const rocksdb::QueryId query_id,
     const TransactionOperationContextOpt& txn_op_context,
     const HybridTime high_ht,
-    std::shared_ptr<rocksdb::ReadFileFilter> file_filter) {
+    std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
+    std::shared_ptr<rocksdb::ReadAheadStats> scan_readahead_stats) {
+  // Transactions could see their own intents regardless of the read time, so we only prune files by
+  // hybrid time for non-transactional reads.
+  if (FLAGS_use_docdb_hybrid_time_file_filter && !txn_op_context && high_ht.is_valid() &&
+      high_ht != HybridTime::kMax) {
+    file_filter = CreateHybridTimeFileFilter(high_ht, std::move(file_filter));
+  }
   rocksdb::ReadOptions read_opts = PrepareReadOptions(rocksdb, bloom_filter_mode,
       user_key_for_filter, query_id, std::move(file_filter));
+  if (scan_readahead_stats && FLAGS_docdb_scan_readahead_size_bytes > 0) {
+    read_opts.readahead_size = FLAGS_docdb_scan_readahead_size_bytes;
+    read_opts.readahead_in_background = FLAGS_docdb_scan_prefetch_in_background;
+    read_opts.readahead_stats = std::move(scan_readahead_stats);
+  }
   return std::make_unique<IntentAwareIterator>(rocksdb, read_opts, high_ht, txn_op_context);
 }
 
+bool UsesRangeAwareBloomFilter(rocksdb::DB* rocksdb) {
+  const auto& table_factory = rocksdb->GetOptions().table_factory;
+  if (!table_factory || strcmp(table_factory->Name(), "BlockBasedTable") != 0) {
+    return false;
+  }
+  const auto* table_options =
+      static_cast<const rocksdb::BlockBasedTableOptions*>(table_factory->GetOptions());
+  const auto* filter_policy =
+      dynamic_cast<const DocDbAwareFilterPolicy*>(table_options->filter_policy.get());
+  return filter_policy != nullptr &&
+         filter_policy->filter_key_part() == DocKeyPart::WHOLE_DOC_KEY;
+}
+
 void InitRocksDBOptions(
     rocksdb::Options* options, const string& tablet_id,
     const shared_ptr<rocksdb::Statistics>& statistics,
-    const tablet::TabletOptions& tablet_options) {
+    const tablet::TabletOptions& tablet_options,
+    const TableProperties* table_properties) {
   options->create_if_missing = true;
   options->disableDataSync = true;
   options->statistics = statistics;
@@ -316,7 +396,10 @@ void InitRocksDBOptions(
   options->info_log_level = YBRocksDBLogger::ConvertToRocksDBLogLevel(FLAGS_minloglevel);
   options->initial_seqno = FLAGS_initial_seqno;
   options->boundary_extractor = DocBoundaryValuesExtractorInstance();
+  options->table_properties_collector_factories = {
+      std::make_shared<DocDBReclaimableBytesCollectorFactory>()};
   options->memory_monitor = tablet_options.memory_monitor;
+  options->persistent_cache = tablet_options.persistent_block_cache;
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
       tablet_options.listeners.end()); // Append listeners
@@ -325,6 +408,7 @@ void InitRocksDBOptions(
   rocksdb::BlockBasedTableOptions table_options;
   if (tablet_options.block_cache) {
     table_options.block_cache = tablet_options.block_cache;
+    table_options.block_cache_compressed = tablet_options.compressed_block_cache;
     // Cache the bloom filters in the block cache.
     table_options.cache_index_and_filter_blocks = true;
   } else {
@@ -335,8 +419,11 @@ void InitRocksDBOptions(
 
   // Set our custom bloom filter that is docdb aware.
   if (FLAGS_use_docdb_aware_bloom_filter) {
+    const bool range_aware =
+        table_properties != nullptr && table_properties->range_aware_bloom_filter();
     table_options.filter_policy.reset(new DocDbAwareFilterPolicy(
-        table_options.filter_block_size * 8, options->info_log.get()));
+        table_options.filter_block_size * 8, options->info_log.get(),
+        range_aware ? DocKeyPart::WHOLE_DOC_KEY : DocKeyPart::HASHED_PART_ONLY));
   }
 
   options->table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
@@ -73,6 +73,10 @@ void PerformRocksDBSeek(
 
 enum class BloomFilterMode {
   USE_BLOOM_FILTER,
+  // Same as USE_BLOOM_FILTER, but the caller guarantees that user_key_for_filter contains the
+  // whole DocKey (all hashed and range components) and that the scan does not leave that DocKey.
+  // This allows tables with a range-aware bloom filter to use it for point reads.
+  USE_BLOOM_FILTER_ON_WHOLE_DOC_KEY,
   DONT_USE_BLOOM_FILTER,
 };
 
@@ -82,6 +86,8 @@ enum class BloomFilterMode {
 // Note: bloom_filter_mode should be specified explicitly to avoid using it incorrectly by default.
 // user_key_for_filter is used with BloomFilterMode::USE_BLOOM_FILTER to exclude SST files which
 // have the same hashed components as (Sub)DocKey encoded in user_key_for_filter.
+// For tables with a range-aware bloom filter only BloomFilterMode::USE_BLOOM_FILTER_ON_WHOLE_DOC_KEY
+// excludes SST files, other modes read all of them.
 std::unique_ptr<rocksdb::Iterator> CreateRocksDBIterator(
     rocksdb::DB* rocksdb,
     BloomFilterMode bloom_filter_mode,
@@ -89,8 +95,16 @@ std::unique_ptr<rocksdb::Iterator> CreateRocksDBIterator(
     const rocksdb::QueryId query_id,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr);
 
+// Returns a filter which excludes SST files that only contain records written after
+// max_hybrid_time, and passes the remaining files to next, if any.
+std::shared_ptr<rocksdb::ReadFileFilter> CreateHybridTimeFileFilter(
+    HybridTime max_hybrid_time, std::shared_ptr<rocksdb::ReadFileFilter> next);
+
 // Values and transactions committed later than high_ht can be skipped, so we won't spend time
 // for re-requesting pending transaction status if we already know it wasn't committed at high_ht.
+// scan_readahead_stats should be set for range scans: the iterator then reads data blocks ahead
+// once it moves sequentially through an SST file (see --docdb_scan_readahead_size_bytes), and
+// counts the data blocks it reads and prefetches in scan_readahead_stats.
 std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     rocksdb::DB* rocksdb,
     BloomFilterMode bloom_filter_mode,
@@ -98,15 +112,22 @@ std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     const rocksdb::QueryId query_id,
     const TransactionOperationContextOpt& transaction_context,
     HybridTime high_ht,
-    std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr);
+    std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr,
+    std::shared_ptr<rocksdb::ReadAheadStats> scan_readahead_stats = nullptr);
 
 // Initialize the RocksDB 'options' object for tablet identified by 'tablet_id'. The
 // 'statistics' object provided by the caller will be used by RocksDB to maintain
 // the stats for the tablet specified by 'tablet_id'.
+// If 'table_properties' is specified, table-specific options such as the bloom filter key part are
+// taken from it.
 void InitRocksDBOptions(
     rocksdb::Options* options, const std::string& tablet_id,
     const std::shared_ptr<rocksdb::Statistics>& statistics,
-    const tablet::TabletOptions& tablet_options);
+    const tablet::TabletOptions& tablet_options,
+    const TableProperties* table_properties = nullptr);
+
+// Returns true if the given RocksDB instance builds its bloom filters over the whole DocKey.
+bool UsesRangeAwareBloomFilter(rocksdb::DB* rocksdb);
 
 }  // namespace docdb
 }  // namespace yb
@@ -35,19 +35,26 @@ namespace yb {
 namespace docdb {
 
 // Add primary key column values to the component group. Verify that they are in the same order
-// as in the table schema.
+// as in the table schema. String hashed components of tables with the compact_doc_key property are
+// stored length-prefixed, see ValueType::kCompactString.
 CHECKED_STATUS QLKeyColumnValuesToPrimitiveValues(
     const google::protobuf::RepeatedPtrField<QLExpressionPB> &column_values,
     const Schema &schema, size_t column_idx, const size_t column_count,
     vector<PrimitiveValue> *components) {
+  const bool compact_doc_key = schema.table_properties().compact_doc_key();
   for (const auto& column_value : column_values) {
     DCHECK(schema.is_key_column(column_idx));
     if (!column_value.has_value() || QLValue::IsNull(column_value.value())) {
       return STATUS(InvalidArgument, "Invalid primary key value");
     }
 
-    components->push_back(PrimitiveValue::FromQLExpressionPB(
-        column_value, schema.column(column_idx).sorting_type()));
+    PrimitiveValue component = PrimitiveValue::FromQLExpressionPB(
+        column_value, schema.column(column_idx).sorting_type());
+    if (compact_doc_key && schema.is_hash_key_column(column_idx) &&
+        component.value_type() == ValueType::kString) {
+      component = PrimitiveValue::CompactString(component.GetString());
+    }
+    components->push_back(std::move(component));
     column_idx++;
   }
   return Status::OK();
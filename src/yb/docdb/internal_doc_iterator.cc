@@ -115,7 +115,8 @@ Status InternalDocIterator::SeekToKeyPrefix() {
     if (!iter_) {
       // If iter hasn't been created yet, do so now.
       switch (bloom_filter_mode_) {
-        case BloomFilterMode::USE_BLOOM_FILTER:
+        case BloomFilterMode::USE_BLOOM_FILTER: FALLTHROUGH_INTENDED;
+        case BloomFilterMode::USE_BLOOM_FILTER_ON_WHOLE_DOC_KEY:
           {
             iter_ = CreateRocksDBIterator(db_, bloom_filter_mode_, filter_key_.AsSlice(),
                 query_id_);
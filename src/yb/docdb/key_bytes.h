@@ -74,6 +74,10 @@ class KeyBytes {
     ComplementZeroEncodeAndAppendStrToKey(raw_string, &data_);
   }
 
+  void AppendLengthPrefixedString(const std::string& raw_string) {
+    AppendLengthPrefixedStrToKey(raw_string, &data_);
+  }
+
   void AppendDecimal(const std::string& encoded_decimal_str) {
     data_.append(encoded_decimal_str);
   }
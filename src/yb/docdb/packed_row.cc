@@ -0,0 +1,103 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/packed_row.h"
+
+#include <algorithm>
+
+#include "yb/docdb/key_bytes.h"
+#include "yb/util/fast_varint.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+void AppendUnsignedVarInt(uint64_t v, std::string* dest) {
+  uint8_t buf[util::kMaxVarIntBufferSize];
+  size_t size = 0;
+  util::FastEncodeUnsignedVarInt(v, buf, &size);
+  dest->append(reinterpret_cast<const char*>(buf), size);
+}
+
+CHECKED_STATUS ConsumeUnsignedVarInt(rocksdb::Slice* slice, uint64_t* v) {
+  size_t decoded_size = 0;
+  RETURN_NOT_OK(util::FastDecodeUnsignedVarInt(slice->data(), slice->size(), v, &decoded_size));
+  slice->remove_prefix(decoded_size);
+  return Status::OK();
+}
+
+bool SubKeyLess(const std::pair<PrimitiveValue, PrimitiveValue>& column,
+                const PrimitiveValue& subkey) {
+  return column.first < subkey;
+}
+
+}  // namespace
+
+PrimitiveValue PackedRowEncoder::Finish() {
+  std::sort(columns_.begin(), columns_.end(),
+            [](const PackedColumns::value_type& lhs, const PackedColumns::value_type& rhs) {
+              return lhs.first < rhs.first;
+            });
+  std::string encoded;
+  AppendUnsignedVarInt(schema_version_, &encoded);
+  KeyBytes subkey_bytes;
+  for (const auto& column : columns_) {
+    subkey_bytes.Clear();
+    column.first.AppendToKey(&subkey_bytes);
+    encoded.append(subkey_bytes.data());
+    const std::string value = column.second.ToValue();
+    AppendUnsignedVarInt(value.size(), &encoded);
+    encoded.append(value);
+  }
+  columns_.clear();
+  return PrimitiveValue::PackedRow(std::move(encoded));
+}
+
+Status DecodePackedRow(const PrimitiveValue& packed_row,
+                       uint32_t* schema_version,
+                       PackedColumns* columns) {
+  rocksdb::Slice slice(packed_row.GetPackedRow());
+  uint64_t v = 0;
+  RETURN_NOT_OK_PREPEND(ConsumeUnsignedVarInt(&slice, &v),
+                        "Failed to decode the schema version of a packed row");
+  *schema_version = static_cast<uint32_t>(v);
+  columns->clear();
+  while (!slice.empty()) {
+    PrimitiveValue subkey;
+    RETURN_NOT_OK(subkey.DecodeFromKey(&slice));
+    RETURN_NOT_OK_PREPEND(ConsumeUnsignedVarInt(&slice, &v),
+                          "Failed to decode the value length of a packed column");
+    if (slice.size() < v) {
+      return STATUS_FORMAT(Corruption, "Packed column $0 has $1 value bytes, $2 left",
+                           subkey, v, slice.size());
+    }
+    PrimitiveValue value;
+    RETURN_NOT_OK(value.DecodeFromValue(rocksdb::Slice(slice.data(), v)));
+    slice.remove_prefix(v);
+    columns->emplace_back(std::move(subkey), std::move(value));
+  }
+  return Status::OK();
+}
+
+const PrimitiveValue* FindPackedColumn(const PackedColumns& columns,
+                                       const PrimitiveValue& subkey) {
+  const auto it = std::lower_bound(columns.begin(), columns.end(), subkey, SubKeyLess);
+  if (it == columns.end() || it->first != subkey) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,74 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_PACKED_ROW_H_
+#define YB_DOCDB_PACKED_ROW_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "yb/docdb/primitive_value.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace docdb {
+
+// A packed row stores all the non-key columns of a QL row written by one INSERT as a single value
+// at the row's DocKey, instead of one key/value pair per column at DocKey + column id. Columns
+// updated later are still written as separate key/value pairs and take precedence over the packed
+// ones on read, the same way they would over an object init marker.
+//
+// The encoding, following the kPackedRow value type byte, is:
+//   schema version (unsigned varint)
+//   for each column, in increasing order of the column subkey:
+//     column subkey (key encoding)
+//     value length (unsigned varint)
+//     value (value encoding, without TTL or user timestamp)
+//
+// A column that was set to null holds a tombstone.
+
+// (column subkey, value) pairs of a packed row, sorted by the column subkey.
+typedef std::vector<std::pair<PrimitiveValue, PrimitiveValue>> PackedColumns;
+
+class PackedRowEncoder {
+ public:
+  explicit PackedRowEncoder(uint32_t schema_version) : schema_version_(schema_version) {}
+
+  void AddColumn(PrimitiveValue subkey, PrimitiveValue value) {
+    columns_.emplace_back(std::move(subkey), std::move(value));
+  }
+
+  size_t num_columns() const { return columns_.size(); }
+
+  // Returns the packed row holding the columns added so far.
+  PrimitiveValue Finish();
+
+ private:
+  const uint32_t schema_version_;
+  PackedColumns columns_;
+};
+
+// Decodes the columns of the given packed row.
+CHECKED_STATUS DecodePackedRow(const PrimitiveValue& packed_row,
+                               uint32_t* schema_version,
+                               PackedColumns* columns);
+
+// Returns the value of the column with the given subkey in the decoded columns, or nullptr if the
+// packed row does not have it.
+const PrimitiveValue* FindPackedColumn(const PackedColumns& columns, const PrimitiveValue& subkey);
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_PACKED_ROW_H_
@@ -20,6 +20,7 @@
 #include "yb/docdb/doc_kv_util.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/gutil/stringprintf.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/rocksutil/yb_rocksdb.h"
@@ -52,6 +53,7 @@ using yb::util::FastDecodeSignedVarInt;
     case ValueType::kRedisTS: FALLTHROUGH_INTENDED; \
     case ValueType::kTtl: FALLTHROUGH_INTENDED; \
     case ValueType::kUserTimestamp: FALLTHROUGH_INTENDED; \
+    case ValueType::kPackedRow: FALLTHROUGH_INTENDED; \
     case ValueType::kTombstone: \
       break
 
@@ -93,8 +95,28 @@ string PrimitiveValue::ToString() const {
     case ValueType::kInvalidValueType:
       return "invalid";
     case ValueType::kStringDescending:
+    case ValueType::kCompactString:
     case ValueType::kString:
       return FormatBytesAsStr(str_val_);
+    case ValueType::kPackedRow: {
+      uint32_t schema_version = 0;
+      PackedColumns columns;
+      if (!DecodePackedRow(*this, &schema_version, &columns).ok()) {
+        return "PackedRow(" + FormatBytesAsStr(str_val_) + ")";
+      }
+      std::stringstream ss;
+      ss << "PackedRow(v" << schema_version << ", {";
+      bool first = true;
+      for (const auto& column : columns) {
+        if (!first) {
+          ss << ", ";
+        }
+        first = false;
+        ss << column.first.ToString() << ": " << column.second.ToString();
+      }
+      ss << "})";
+      return ss.str();
+    }
     case ValueType::kInt32Descending: FALLTHROUGH_INTENDED;
     case ValueType::kInt32:
       return std::to_string(int32_val_);
@@ -197,6 +219,10 @@ void PrimitiveValue::AppendToKey(KeyBytes* key_bytes) const {
       key_bytes->AppendString(str_val_);
       return;
 
+    case ValueType::kCompactString:
+      key_bytes->AppendLengthPrefixedString(str_val_);
+      return;
+
     case ValueType::kStringDescending:
       key_bytes->AppendDescendingString(str_val_);
       return;
@@ -332,6 +358,7 @@ string PrimitiveValue::ToValue() const {
     case ValueType::kRedisSet: return result;
 
     case ValueType::kStringDescending: FALLTHROUGH_INTENDED;
+    case ValueType::kPackedRow: FALLTHROUGH_INTENDED;
     case ValueType::kString:
       // No zero encoding necessary when storing the string in a value.
       result.append(str_val_);
@@ -414,6 +441,10 @@ string PrimitiveValue::ToValue() const {
       // Hashes are not allowed in a value.
       break;
 
+    case ValueType::kCompactString:
+      // Only hashed key components are stored this way.
+      break;
+
     case ValueType::kIntentType: FALLTHROUGH_INTENDED;
     case ValueType::kGroupEnd: FALLTHROUGH_INTENDED;
     case ValueType::kGroupEndDescending: FALLTHROUGH_INTENDED;
@@ -493,6 +524,18 @@ Status PrimitiveValue::DecodeKey(rocksdb::Slice* slice, PrimitiveValue* out) {
       return Status::OK();
     }
 
+    case ValueType::kCompactString: {
+      if (out) {
+        string result;
+        RETURN_NOT_OK(DecodeLengthPrefixedStr(slice, &result));
+        new (&out->str_val_) string(std::move(result));
+      } else {
+        RETURN_NOT_OK(DecodeLengthPrefixedStr(slice, nullptr));
+      }
+      type_ref = value_type;
+      return Status::OK();
+    }
+
     case ValueType::kFrozenDescending:
     case ValueType::kFrozen: {
       ValueType end_marker_value_type = ValueType::kGroupEnd;
@@ -811,6 +854,11 @@ Status PrimitiveValue::DecodeFromValue(const rocksdb::Slice& rocksdb_slice) {
       type_ = ValueType::kString;
       return Status::OK();
 
+    case ValueType::kPackedRow:
+      new(&str_val_) string(slice.cdata(), slice.size());
+      type_ = ValueType::kPackedRow;
+      return Status::OK();
+
     case ValueType::kInt32: FALLTHROUGH_INTENDED;
     case ValueType::kInt32Descending: FALLTHROUGH_INTENDED;
     case ValueType::kFloatDescending: FALLTHROUGH_INTENDED;
@@ -893,6 +941,7 @@ Status PrimitiveValue::DecodeFromValue(const rocksdb::Slice& rocksdb_slice) {
     case ValueType::kSystemColumnId: FALLTHROUGH_INTENDED;
     case ValueType::kHybridTime: FALLTHROUGH_INTENDED;
     case ValueType::kStringDescending: FALLTHROUGH_INTENDED;
+    case ValueType::kCompactString: FALLTHROUGH_INTENDED;
     case ValueType::kInetaddressDescending: FALLTHROUGH_INTENDED;
     case ValueType::kDecimalDescending: FALLTHROUGH_INTENDED;
     case ValueType::kUuidDescending: FALLTHROUGH_INTENDED;
@@ -981,6 +1030,20 @@ PrimitiveValue PrimitiveValue::TransactionId(Uuid transaction_id) {
   return primitive_value;
 }
 
+PrimitiveValue PrimitiveValue::CompactString(std::string s) {
+  PrimitiveValue primitive_value;
+  primitive_value.type_ = ValueType::kCompactString;
+  new(&primitive_value.str_val_) std::string(std::move(s));
+  return primitive_value;
+}
+
+PrimitiveValue PrimitiveValue::PackedRow(std::string encoded_columns) {
+  PrimitiveValue primitive_value;
+  primitive_value.type_ = ValueType::kPackedRow;
+  new(&primitive_value.str_val_) std::string(std::move(encoded_columns));
+  return primitive_value;
+}
+
 PrimitiveValue PrimitiveValue::IntentTypeValue(IntentType intent_type) {
   PrimitiveValue primitive_value(static_cast<uint16_t>(intent_type));
   primitive_value.type_ = ValueType::kIntentType;
@@ -1008,6 +1071,7 @@ bool PrimitiveValue::operator==(const PrimitiveValue& other) const {
     case ValueType::kMaxByte: return true;
 
     case ValueType::kStringDescending: FALLTHROUGH_INTENDED;
+    case ValueType::kCompactString: FALLTHROUGH_INTENDED;
     case ValueType::kString: return str_val_ == other.str_val_;
 
     case ValueType::kFrozenDescending: FALLTHROUGH_INTENDED;
@@ -1073,6 +1137,11 @@ int PrimitiveValue::CompareTo(const PrimitiveValue& other) const {
       return other.str_val_.compare(str_val_);
     case ValueType::kString:
       return str_val_.compare(other.str_val_);
+    case ValueType::kCompactString: {
+      // Shorter strings sort first in the length-prefixed encoding.
+      int size_result = CompareUsingLessThan(str_val_.size(), other.str_val_.size());
+      return size_result != 0 ? size_result : str_val_.compare(other.str_val_);
+    }
     case ValueType::kInt64Descending:
       return CompareUsingLessThan(other.int64_val_, int64_val_);
     case ValueType::kInt32Descending:
@@ -1143,7 +1212,8 @@ int PrimitiveValue::CompareTo(const PrimitiveValue& other) const {
 PrimitiveValue::PrimitiveValue(ValueType value_type)
     : type_(value_type) {
   complex_data_structure_ = nullptr;
-  if (value_type == ValueType::kString || value_type == ValueType::kStringDescending) {
+  if (value_type == ValueType::kString || value_type == ValueType::kStringDescending ||
+      value_type == ValueType::kCompactString || value_type == ValueType::kPackedRow) {
     new(&str_val_) std::string();
   } else if (value_type == ValueType::kInetaddress
       || value_type == ValueType::kInetaddressDescending) {
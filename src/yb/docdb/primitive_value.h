@@ -59,7 +59,8 @@ class PrimitiveValue {
   explicit PrimitiveValue(ValueType value_type);
 
   PrimitiveValue(const PrimitiveValue& other) {
-    if (other.type_ == ValueType::kString || other.type_ == ValueType::kStringDescending) {
+    if (other.type_ == ValueType::kString || other.type_ == ValueType::kStringDescending ||
+        other.type_ == ValueType::kCompactString || other.type_ == ValueType::kPackedRow) {
       type_ = other.type_;
       new(&str_val_) std::string(other.str_val_);
     } else if (other.type_ == ValueType::kInetaddress
@@ -207,7 +208,8 @@ class PrimitiveValue {
   std::string ToString() const;
 
   ~PrimitiveValue() {
-    if (type_ == ValueType::kString || type_ == ValueType::kStringDescending) {
+    if (type_ == ValueType::kString || type_ == ValueType::kStringDescending ||
+        type_ == ValueType::kCompactString || type_ == ValueType::kPackedRow) {
       str_val_.~basic_string();
     } else if (type_ == ValueType::kInetaddress || type_ == ValueType::kInetaddressDescending) {
       delete inetaddress_val_;
@@ -240,6 +242,11 @@ class PrimitiveValue {
   static PrimitiveValue Int32(int32_t v, SortOrder sort_order = SortOrder::kAscending);
   static PrimitiveValue TransactionId(Uuid transaction_id);
   static PrimitiveValue IntentTypeValue(IntentType intent_type);
+  // A string stored in a key as its length followed by its raw bytes. Only for hashed key
+  // components, see ValueType::kCompactString.
+  static PrimitiveValue CompactString(std::string s);
+  // A packed row holding the given column encoding, see packed_row.h.
+  static PrimitiveValue PackedRow(std::string encoded_columns);
 
   KeyBytes ToKeyBytes() const;
 
@@ -265,7 +272,7 @@ class PrimitiveValue {
   // This returns a YB slice, not a RocksDB slice, based on what was needed when this function was
   // implemented. This distinction should go away if we merge RocksDB and YB Slice classes.
   Slice GetStringAsSlice() const {
-    DCHECK(ValueType::kString == type_ || ValueType::kStringDescending == type_);
+    DCHECK(IsString());
     return Slice(str_val_);
   }
 
@@ -274,7 +281,8 @@ class PrimitiveValue {
   }
 
   bool IsString() const {
-    return ValueType::kString == type_ || ValueType::kStringDescending == type_;
+    return ValueType::kString == type_ || ValueType::kStringDescending == type_ ||
+           ValueType::kCompactString == type_;
   }
 
   bool IsValidType() const {
@@ -290,6 +298,15 @@ class PrimitiveValue {
     return str_val_;
   }
 
+  bool IsPackedRow() const {
+    return ValueType::kPackedRow == type_;
+  }
+
+  const std::string& GetPackedRow() const {
+    DCHECK(IsPackedRow());
+    return str_val_;
+  }
+
   int32_t GetInt32() const {
     DCHECK(ValueType::kInt32 == type_ || ValueType::kInt32Descending == type_);
     return int32_val_;
@@ -416,7 +433,8 @@ class PrimitiveValue {
 
     ttl_seconds_ = other->ttl_seconds_;
     write_time_ = other->write_time_;
-    if (other->type_ == ValueType::kString || other->type_ == ValueType::kStringDescending) {
+    if (other->type_ == ValueType::kString || other->type_ == ValueType::kStringDescending ||
+        other->type_ == ValueType::kCompactString || other->type_ == ValueType::kPackedRow) {
       type_ = other->type_;
       new(&str_val_) std::string(std::move(other->str_val_));
       // The moved-from object should now be in a "valid but unspecified" state as per the standard.
@@ -32,6 +32,7 @@ string ToString(ValueType value_type) {
     case ValueType::kTrue: return "True";
     case ValueType::kStringDescending: return "StringDescending";
     case ValueType::kString: return "String";
+    case ValueType::kCompactString: return "CompactString";
     case ValueType::kInt64Descending: return "Int64Descending";
     case ValueType::kInt32Descending: return "Int32Descending";
     case ValueType::kInt64: return "Int64";
@@ -58,6 +59,7 @@ string ToString(ValueType value_type) {
     case ValueType::kArray: return "Array";
     case ValueType::kArrayIndex: return "ArrayIndex";
     case ValueType::kTombstone: return "Tombstone";
+    case ValueType::kPackedRow: return "PackedRow";
     case ValueType::kTtl: return "Ttl";
     case ValueType::kUserTimestamp: return "UserTimestamp";
     case ValueType::kTransactionId: return "TransactionId";
@@ -77,6 +77,16 @@ enum class ValueType : char {
   kColumnId = 'K',  // ASCII code 75
   kDoubleDescending = 'L',  // ASCII code 76
   kFloatDescending = 'M', // ASCII code 77
+
+  // A packed row: all the non-key columns of a QL row stored in a single value at the row's DocKey.
+  // Only ever used in values, see packed_row.h.
+  kPackedRow = 'P',  // ASCII code 80
+
+  // A string hashed key component of a table with the compact_doc_key property, stored as its
+  // length followed by its raw bytes instead of zero-escaped and terminated. Only ever used in
+  // keys. These sort by length first, which is fine because hashed components are only ever looked
+  // up by equality.
+  kCompactString = 'R',  // ASCII code 82
   kString = 'S',  // ASCII code 83
   kTrue = 'T',  // ASCII code 84
   kTombstone = 'X',  // ASCII code 88
@@ -199,7 +209,8 @@ constexpr inline bool IsPrimitiveValueType(const ValueType value_type) {
   return kMinPrimitiveValueType <= value_type && value_type <= kMaxPrimitiveValueType &&
          !IsObjectType(value_type) &&
          value_type != ValueType::kArray &&
-         value_type != ValueType::kTombstone;
+         value_type != ValueType::kTombstone &&
+         value_type != ValueType::kPackedRow;
 }
 
 // Decode the first byte of the given slice as a ValueType.
@@ -20,6 +20,7 @@
 #include "yb/master/catalog_manager.h"
 #include "yb/master/cluster_balance.h"
 #include "yb/master/ts_descriptor.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/test_util.h"
 #include "yb/master/cluster_balance_mocked.h"
 
@@ -135,6 +136,9 @@ class TestLoadBalancerBase {
     gflags::SetCommandLineOption("leader_balance_threshold", "2");
     PrepareTestState(ts_descs);
     TestBalancingLeadersWithThreshold();
+
+    PrepareTestState(ts_descs);
+    TestBalancingByTabletSize();
   }
 
  protected:
@@ -680,6 +684,40 @@ class TestLoadBalancerBase {
     ASSERT_FALSE(HandleLeaderMoves(&placeholder, &placeholder, &placeholder));
   }
 
+  void TestBalancingByTabletSize() {
+    LOG(INFO) << "Testing balancing replicas by tablet size";
+    cluster_placement_.set_num_replicas(kNumReplicas);
+
+    // Make the last tablet ten times larger than the others on every tablet server.
+    const uint64_t kSmallTabletSize = 100_MB;
+    const uint64_t kLargeTabletSize = 1000_MB;
+    TServerMetricsPB metrics;
+    for (int i = 0; i < tablets_.size(); ++i) {
+      auto* tablet_metrics = metrics.add_tablet_metrics();
+      tablet_metrics->set_tablet_id(tablets_[i]->tablet_id());
+      tablet_metrics->set_sst_file_size(
+          i + 1 == tablets_.size() ? kLargeTabletSize : kSmallTabletSize);
+    }
+    for (const auto& ts_desc : ts_descs_) {
+      ts_desc->UpdateTabletMetrics(metrics);
+    }
+
+    // Add an empty tablet server.
+    ts_descs_.push_back(SetupTS("3333", "a"));
+    AnalyzeTablets();
+
+    // The large tablet alone evens out the load best, even though the replica counts would favor
+    // moving any of the small ones.
+    string expected_tablet_id = tablets_.back()->tablet_id();
+    string expected_from_ts = ts_descs_[2]->permanent_uuid();
+    string expected_to_ts = ts_descs_[3]->permanent_uuid();
+    TestAddLoad(expected_tablet_id, expected_from_ts, expected_to_ts);
+
+    for (const auto& ts_desc : ts_descs_) {
+      ts_desc->UpdateTabletMetrics(TServerMetricsPB());
+    }
+  }
+
   // Methods to prepare the state of the current test.
   void PrepareTestState(const TSDescriptorVector& ts_descs) {
     // Clear old state.
@@ -4462,14 +4462,85 @@ Status CatalogManager::IsLoadBalanced(const IsLoadBalancedRequestPB* req,
     return s;
   }
 
-  for (const auto ts_desc : ts_descs) {
-    load.push_back(ts_desc->num_live_replicas());
+  // Weigh the replicas and leaders the same way the load balancer does (see
+  // ClusterLoadState::ComputeLoadWeights): a tablet's size and request rate are the largest ones
+  // reported by any of its replicas, and every replica of the tablet weighs that size, and its
+  // leader that request rate, relative to the average tablet of its table. Otherwise we could
+  // report a balanced cluster while the balancer still moves replicas or leaders around.
+  struct TabletLoad {
+    TabletInfo::ReplicaMap replicas;
+    double size_bytes = 0;
+    double ops_per_sec = 0;
+  };
+  unordered_map<TableId, vector<TabletLoad>> table_tablets;
+  {
+    boost::shared_lock<LockType> l(lock_);
+    for (const auto& entry : tablet_map_) {
+      const auto& tablet = entry.second;
+      if (!tablet->table()) {
+        continue;
+      }
+      {
+        auto tablet_lock = tablet->LockForRead();
+        if (tablet_lock->data().is_deleted()) {
+          continue;
+        }
+      }
+      TabletLoad tablet_load;
+      tablet->GetReplicaLocations(&tablet_load.replicas);
+      for (const auto& replica : tablet_load.replicas) {
+        TSDescriptor::TabletMetrics metrics;
+        if (replica.second.ts_desc &&
+            replica.second.ts_desc->GetTabletMetrics(tablet->id(), &metrics)) {
+          tablet_load.size_bytes = std::max<double>(tablet_load.size_bytes, metrics.total_size());
+          tablet_load.ops_per_sec = std::max(tablet_load.ops_per_sec, metrics.total_ops_per_sec());
+        }
+      }
+      table_tablets[tablet->table()->id()].push_back(std::move(tablet_load));
+    }
+  }
+
+  unordered_map<TabletServerId, double> ts_loads;
+  unordered_map<TabletServerId, double> ts_leader_loads;
+  for (const auto& table_entry : table_tablets) {
+    const auto& tablets = table_entry.second;
+    double total_size_bytes = 0;
+    double total_ops_per_sec = 0;
+    for (const auto& tablet_load : tablets) {
+      total_size_bytes += tablet_load.size_bytes;
+      total_ops_per_sec += tablet_load.ops_per_sec;
+    }
+    const double avg_size_bytes = total_size_bytes / tablets.size();
+    const double avg_ops_per_sec = total_ops_per_sec / tablets.size();
+    for (const auto& tablet_load : tablets) {
+      const double weight = ReplicaSizeWeight(tablet_load.size_bytes, avg_size_bytes);
+      const double leader_weight = LeaderOpsWeight(tablet_load.ops_per_sec, avg_ops_per_sec);
+      for (const auto& replica : tablet_load.replicas) {
+        // Like the balancer, only count the replicas that are running or on their way to running.
+        const auto state = replica.second.state;
+        if (state == tablet::RUNNING || state == tablet::BOOTSTRAPPING ||
+            state == tablet::NOT_STARTED) {
+          ts_loads[replica.first] += weight;
+        }
+        if (replica.second.role == consensus::RaftPeerPB::LEADER) {
+          ts_leader_loads[replica.first] += leader_weight;
+        }
+      }
+    }
+  }
+  vector<double> leader_load;
+  for (const auto& ts_desc : ts_descs) {
+    load.push_back(ts_loads[ts_desc->permanent_uuid()]);
+    leader_load.push_back(ts_leader_loads[ts_desc->permanent_uuid()]);
   }
   double std_dev = yb::standard_deviation(load);
-  LOG(INFO) << "Load standard deviation is " << std_dev << " for "
-            << ts_descs.size() << " tservers.";
-  if (std_dev >= 2.0) {
-    Status s = STATUS(IllegalState, Substitute("Load not balanced: deviation=$0.", std_dev));
+  double leader_std_dev = yb::standard_deviation(leader_load);
+  LOG(INFO) << "Load standard deviation is " << std_dev << ", leader load standard deviation is "
+            << leader_std_dev << " for " << ts_descs.size() << " tservers.";
+  if (std_dev >= 2.0 || leader_std_dev >= 2.0) {
+    Status s = STATUS(IllegalState,
+                      Substitute("Load not balanced: deviation=$0 leader_deviation=$1.",
+                                 std_dev, leader_std_dev));
     SetupError(resp->mutable_error(), MasterErrorPB::CAN_RETRY_LOAD_BALANCE_CHECK, s);
     return s;
   }
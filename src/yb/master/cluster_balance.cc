@@ -14,12 +14,14 @@
 #include "yb/master/cluster_balance.h"
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 
 #include <boost/thread/locks.hpp>
 
 #include "yb/consensus/quorum_util.h"
 #include "yb/master/master.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/random_util.h"
 
 DEFINE_bool(enable_load_balancing,
@@ -41,6 +43,32 @@ DEFINE_int32(load_balancer_max_concurrent_moves,
              1,
              "Maximum number of concurrent LeaderMoves/Adds/Removals.");
 
+DEFINE_double(load_balancer_tablet_size_weight,
+              1.0,
+              "How much the on-disk and memtable size of a tablet, relative to the average tablet "
+                  "of its table, counts towards the load of the tablet servers hosting it. Set to "
+                  "0 to balance replica counts only.");
+TAG_FLAG(load_balancer_tablet_size_weight, advanced);
+
+DEFINE_double(load_balancer_leader_ops_weight,
+              1.0,
+              "How much the read and write rate of a tablet, relative to the average tablet of its "
+                  "table, counts towards the leader load of the tablet server hosting its leader. "
+                  "Set to 0 to balance leader counts only.");
+TAG_FLAG(load_balancer_leader_ops_weight, advanced);
+
+DEFINE_int32(load_balancer_min_avg_tablet_size_mb,
+             64,
+             "Tablet sizes are not taken into account by the load balancer while the average "
+                 "tablet of a table is smaller than this.");
+TAG_FLAG(load_balancer_min_avg_tablet_size_mb, advanced);
+
+DEFINE_double(load_balancer_min_avg_tablet_ops_per_sec,
+              10.0,
+              "Tablet request rates are not taken into account by the load balancer while the "
+                  "average tablet of a table serves fewer requests per second than this.");
+TAG_FLAG(load_balancer_min_avg_tablet_ops_per_sec, advanced);
+
 DECLARE_int32(min_leader_stepdown_retry_interval_ms);
 
 namespace yb {
@@ -262,6 +290,9 @@ bool ClusterLoadBalancer::AnalyzeTablets(const TableId& table_uuid) {
   // low for the given configuration.
   state_->AdjustLeaderBalanceThreshold();
 
+  // Weigh the tablets by their size and request rate before sorting the load.
+  state_->ComputeLoadWeights();
+
   // Once we've analyzed both the tablet server information as well as the tablets, we can sort the
   // load and are ready to apply the load balancing rules.
   state_->SortLoad();
@@ -404,7 +435,7 @@ void ClusterLoadBalancer::DumpSortedLoad() const {
   out << "Table load: ";
   for (int left = 0; left <= last_pos; ++left) {
     const TabletServerId& uuid = state_->sorted_load_[left];
-    int load = state_->GetLoad(uuid);
+    double load = state_->GetLoad(uuid);
     out << uuid << ":" << load << " ";
   }
   VLOG(1) << out.str();
@@ -441,7 +472,7 @@ bool ClusterLoadBalancer::GetLoadToMove(
     for (int right = last_pos; right >= 0; --right) {
       const TabletServerId& low_load_uuid = state_->sorted_load_[left];
       const TabletServerId& high_load_uuid = state_->sorted_load_[right];
-      int load_variance = state_->GetLoad(high_load_uuid) - state_->GetLoad(low_load_uuid);
+      double load_variance = state_->GetLoad(high_load_uuid) - state_->GetLoad(low_load_uuid);
 
       // Check for state change or end conditions.
       if (left == right || load_variance < options_.kMinLoadVarianceToBalance) {
@@ -518,6 +549,9 @@ bool ClusterLoadBalancer::GetTabletToMove(
 
   bool same_placement = state_->per_ts_meta_[from_ts].descriptor->placement_id() ==
                         state_->per_ts_meta_[to_ts].descriptor->placement_id();
+  const double load_variance = state_->GetLoad(from_ts) - state_->GetLoad(to_ts);
+  bool found = false;
+  double best_distance = 0;
   for (const auto& tablet_id : non_over_replicated_tablets) {
     const auto& placement_info = GetPlacementByTablet(tablet_id);
     // TODO(bogdan): this should be augmented as well to allow dropping by one replica, if still
@@ -535,13 +569,22 @@ bool ClusterLoadBalancer::GetTabletToMove(
       continue;
     }
     // If we got here, it means we either have no placement, in which case we can pick any TS, or
-    // we have placement and it's valid to move across these two tablet servers, so set the tablet
-    // and leave.
-    *moving_tablet_id = tablet_id;
-    return true;
+    // we have placement and it's valid to move across these two tablet servers. Among those, pick
+    // the tablet that evens out the load of the two tablet servers the most. Moving a tablet that
+    // weighs as much as the difference in load would only swap which of them is overloaded.
+    const double weight = state_->GetReplicaWeight(tablet_id);
+    if (weight >= load_variance) {
+      continue;
+    }
+    const double distance = std::abs(load_variance / 2 - weight);
+    if (!found || distance < best_distance) {
+      found = true;
+      best_distance = distance;
+      *moving_tablet_id = tablet_id;
+    }
   }
   // If we couldn't select a tablet above, we have to return failure.
-  return false;
+  return found;
 }
 
 bool ClusterLoadBalancer::GetLeaderToMove(
@@ -578,7 +621,7 @@ bool ClusterLoadBalancer::GetLeaderToMove(
     for (int right = last_pos; right >= 0; --right) {
       const TabletServerId& low_load_uuid = state_->sorted_leader_load_[left];
       const TabletServerId& high_load_uuid = state_->sorted_leader_load_[right];
-      int load_variance =
+      double load_variance =
           state_->GetLeaderLoad(high_load_uuid) - state_->GetLeaderLoad(low_load_uuid);
 
       // Check for state change or end conditions.
@@ -600,10 +643,18 @@ bool ClusterLoadBalancer::GetLeaderToMove(
       const auto& itr = std::inserter(intersection, intersection.begin());
       std::set_intersection(leaders.begin(), leaders.end(), peers.begin(), peers.end(), itr);
 
+      // Pick the leader that evens out the leader load of the two tablet servers the most.
+      bool found = false;
+      double best_distance = 0;
       for (const auto& tablet_id : intersection) {
-        *moving_tablet_id = tablet_id;
-        *from_ts = high_load_uuid;
-        *to_ts = low_load_uuid;
+        const double weight = state_->GetLeaderWeight(tablet_id);
+        if (weight >= load_variance) {
+          continue;
+        }
+        const double distance = std::abs(load_variance / 2 - weight);
+        if (found && distance >= best_distance) {
+          continue;
+        }
 
         const auto& per_tablet_meta = state_->per_tablet_meta_;
         const auto tablet_meta_iter = per_tablet_meta.find(tablet_id);
@@ -615,16 +666,24 @@ bool ClusterLoadBalancer::GetLeaderToMove(
             const auto time_since_failure = current_time - stepdown_failure_iter->second;
             if (time_since_failure.ToMilliseconds() < FLAGS_min_leader_stepdown_retry_interval_ms) {
               LOG(INFO) << "Cannot move tablet " << tablet_id << " leader from TS "
-                        << *from_ts << " to TS " << *to_ts << " yet: previous attempt with the same"
-                        << " intended leader failed only " << ToString(time_since_failure)
+                        << high_load_uuid << " to TS " << low_load_uuid << " yet: previous attempt"
+                        << " with the same intended leader failed only "
+                        << ToString(time_since_failure)
                         << " ago (less " << "than " << FLAGS_min_leader_stepdown_retry_interval_ms
                         << "ms).";
             }
             continue;
           }
         } else {
-          LOG(WARNING) << "Did not find load balancer metadata for tablet " << *moving_tablet_id;
+          LOG(WARNING) << "Did not find load balancer metadata for tablet " << tablet_id;
         }
+        found = true;
+        best_distance = distance;
+        *moving_tablet_id = tablet_id;
+        *from_ts = high_load_uuid;
+        *to_ts = low_load_uuid;
+      }
+      if (found) {
         return true;
       }
     }
@@ -16,6 +16,7 @@
 
 #include <unordered_set>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <set>
@@ -38,6 +39,14 @@ DECLARE_int32(leader_balance_unresponsive_timeout_ms);
 
 DECLARE_int32(load_balancer_max_concurrent_moves);
 
+DECLARE_double(load_balancer_tablet_size_weight);
+
+DECLARE_double(load_balancer_leader_ops_weight);
+
+DECLARE_int32(load_balancer_min_avg_tablet_size_mb);
+
+DECLARE_double(load_balancer_min_avg_tablet_ops_per_sec);
+
 namespace yb {
 namespace master {
 
@@ -57,6 +66,30 @@ struct cloud_hash {
 
 using AffinitizedZonesSet = unordered_set<CloudInfoPB, cloud_hash, cloud_equal_to>;
 
+// Returns how much a tablet weighs towards the load of a tablet server, given the value of some
+// metric for this tablet and the average value across the tablets being balanced. A tablet at the
+// average weighs 1.0, so balancing the weighted load degrades to balancing replica counts when the
+// metric is disabled, or when the average is too small for the differences to matter.
+inline double RelativeLoadWeight(
+    double value, double average, double min_average, double metric_weight) {
+  if (metric_weight <= 0 || average <= 0 || average < min_average) {
+    return 1.0;
+  }
+  return (1.0 + metric_weight * value / average) / (1.0 + metric_weight);
+}
+
+inline double ReplicaSizeWeight(double size_bytes, double avg_size_bytes) {
+  return RelativeLoadWeight(
+      size_bytes, avg_size_bytes, FLAGS_load_balancer_min_avg_tablet_size_mb * 1024.0 * 1024.0,
+      FLAGS_load_balancer_tablet_size_weight);
+}
+
+inline double LeaderOpsWeight(double ops_per_sec, double avg_ops_per_sec) {
+  return RelativeLoadWeight(
+      ops_per_sec, avg_ops_per_sec, FLAGS_load_balancer_min_avg_tablet_ops_per_sec,
+      FLAGS_load_balancer_leader_ops_weight);
+}
+
 struct CBTabletMetadata {
   bool is_missing_replicas() { return is_under_replicated || !under_replicated_placements.empty(); }
 
@@ -106,6 +139,20 @@ struct CBTabletMetadata {
   // Leader stepdown failures. We use this to prevent retrying the same leader stepdown too soon.
   LeaderStepDownFailureTimes leader_stepdown_failures;
 
+  // Largest on-disk plus memtable size reported by any replica of this tablet.
+  uint64_t size_bytes = 0;
+
+  // Largest read plus write rate reported by any replica of this tablet, which is normally the
+  // rate served by the leader.
+  double ops_per_sec = 0;
+
+  // How much a replica of this tablet weighs towards the load of its tablet server, relative to
+  // the other tablets of the table. See ClusterLoadState::ComputeLoadWeights.
+  double replica_weight = 1.0;
+
+  // How much the leader of this tablet weighs towards the leader load of its tablet server.
+  double leader_weight = 1.0;
+
 };
 
 struct CBTabletServerMetadata {
@@ -120,6 +167,11 @@ struct CBTabletServerMetadata {
 
   // The set of tablet leader ids that this tablet server is currently running.
   std::set<TabletId> leaders;
+
+  // Weighted load of the starting and running tablets, and of the leaders. These are computed
+  // before sorting, so that the comparators do not have to go over all the tablets.
+  double load = 0;
+  double leader_load = 0;
 };
 
 class ClusterLoadState {
@@ -131,8 +183,8 @@ class ClusterLoadState {
 
   // Comparators used for sorting by load.
   bool CompareByUuid(const TabletServerId& a, const TabletServerId& b) {
-    int load_a = GetLoad(a);
-    int load_b = GetLoad(b);
+    double load_a = GetLoad(a);
+    double load_b = GetLoad(b);
     if (load_a == load_b) {
       return a < b;
     } else {
@@ -168,15 +220,49 @@ class ClusterLoadState {
     ClusterLoadState* state_;
   };
 
-  // Get the load for a certain TS.
-  int GetLoad(const TabletServerId& ts_uuid) const {
-    const auto& ts_meta = per_ts_meta_.at(ts_uuid);
-    return ts_meta.starting_tablets.size() + ts_meta.running_tablets.size();
+  // Get the load for a certain TS, as of the last time the load was sorted. Each replica counts
+  // for its weight, which is 1.0 unless the tablet is larger or smaller than the average tablet of
+  // the table.
+  double GetLoad(const TabletServerId& ts_uuid) const {
+    return per_ts_meta_.at(ts_uuid).load;
+  }
+
+  // Get the leader load for a certain TS, as of the last time the leader load was sorted. Each
+  // leader counts for its weight, which is 1.0 unless the tablet serves more or fewer requests
+  // than the average tablet of the table.
+  double GetLeaderLoad(const TabletServerId& ts_uuid) const {
+    return per_ts_meta_.at(ts_uuid).leader_load;
   }
 
-  // Get the load for a certain TS.
-  int GetLeaderLoad(const TabletServerId& ts_uuid) const {
-    return per_ts_meta_.at(ts_uuid).leaders.size();
+  double GetReplicaWeight(const TabletId& tablet_id) const {
+    auto it = per_tablet_meta_.find(tablet_id);
+    return it == per_tablet_meta_.end() ? 1.0 : it->second.replica_weight;
+  }
+
+  double GetLeaderWeight(const TabletId& tablet_id) const {
+    auto it = per_tablet_meta_.find(tablet_id);
+    return it == per_tablet_meta_.end() ? 1.0 : it->second.leader_weight;
+  }
+
+  // Weigh every tablet by its size and request rate relative to the average tablet, using the
+  // metrics the tablet servers report in their heartbeats. Must be called after all the tablets
+  // have been updated and before sorting the load.
+  void ComputeLoadWeights() {
+    if (per_tablet_meta_.empty()) {
+      return;
+    }
+    double total_size_bytes = 0;
+    double total_ops_per_sec = 0;
+    for (const auto& entry : per_tablet_meta_) {
+      total_size_bytes += entry.second.size_bytes;
+      total_ops_per_sec += entry.second.ops_per_sec;
+    }
+    const double avg_size_bytes = total_size_bytes / per_tablet_meta_.size();
+    const double avg_ops_per_sec = total_ops_per_sec / per_tablet_meta_.size();
+    for (auto& entry : per_tablet_meta_) {
+      entry.second.replica_weight = ReplicaSizeWeight(entry.second.size_bytes, avg_size_bytes);
+      entry.second.leader_weight = LeaderOpsWeight(entry.second.ops_per_sec, avg_ops_per_sec);
+    }
   }
 
   void SetBlacklist(const BlacklistPB& blacklist) { blacklist_ = blacklist; }
@@ -210,6 +296,14 @@ class ClusterLoadState {
         return false;
       }
 
+      // Keep track of the tablet size and request rate, to weigh the tablet against the others.
+      TSDescriptor::TabletMetrics metrics;
+      if (ts_meta_it->second.descriptor &&
+          ts_meta_it->second.descriptor->GetTabletMetrics(tablet_id, &metrics)) {
+        tablet_meta.size_bytes = std::max(tablet_meta.size_bytes, metrics.total_size());
+        tablet_meta.ops_per_sec = std::max(tablet_meta.ops_per_sec, metrics.total_ops_per_sec());
+      }
+
       // Fill leader info.
       if (replica.second.role == consensus::RaftPeerPB::LEADER) {
         tablet_meta.leader_uuid = ts_uuid;
@@ -488,6 +582,16 @@ class ClusterLoadState {
   }
 
   void SortLoad() {
+    for (auto& entry : per_ts_meta_) {
+      auto& ts_meta = entry.second;
+      ts_meta.load = 0;
+      for (const auto& tablet_id : ts_meta.starting_tablets) {
+        ts_meta.load += GetReplicaWeight(tablet_id);
+      }
+      for (const auto& tablet_id : ts_meta.running_tablets) {
+        ts_meta.load += GetReplicaWeight(tablet_id);
+      }
+    }
     auto comparator = Comparator(this);
     sort(sorted_load_.begin(), sorted_load_.end(), comparator);
   }
@@ -504,13 +608,21 @@ class ClusterLoadState {
   }
 
   virtual void SortLeaderLoad() {
+    for (auto& entry : per_ts_meta_) {
+      auto& ts_meta = entry.second;
+      ts_meta.leader_load = 0;
+      for (const auto& tablet_id : ts_meta.leaders) {
+        ts_meta.leader_load += GetLeaderWeight(tablet_id);
+      }
+    }
     auto leader_count_comparator = LeaderLoadComparator(this);
     sort(sorted_leader_load_.begin(), sorted_leader_load_.end(), leader_count_comparator);
   }
 
+  // The threshold is expressed in number of leaders, regardless of how much they weigh.
   inline bool IsLeaderLoadBelowThreshold(const TabletServerId& ts_uuid) {
-    return ((leader_balance_threshold_ > 0) &&
-            (GetLeaderLoad(ts_uuid) <= leader_balance_threshold_));
+    const int num_leaders = per_ts_meta_.at(ts_uuid).leaders.size();
+    return ((leader_balance_threshold_ > 0) && (num_leaders <= leader_balance_threshold_));
   }
 
   void AdjustLeaderBalanceThreshold() {
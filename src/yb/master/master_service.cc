@@ -173,6 +173,7 @@ void MasterServiceImpl::TSHeartbeat(const TSHeartbeatRequestPB* req,
     ts_desc->set_total_sst_file_size(req->metrics().total_sst_file_size());
     ts_desc->set_write_ops_per_sec(req->metrics().write_ops_per_sec());
     ts_desc->set_read_ops_per_sec(req->metrics().read_ops_per_sec());
+    ts_desc->UpdateTabletMetrics(req->metrics());
   }
 
   if (req->has_tablet_report()) {
@@ -49,7 +49,8 @@ bool MasterTabletServiceImpl::GetTabletOrRespond(
     const tserver::ReadRequestPB* req,
     tserver::ReadResponsePB* resp,
     rpc::RpcContext* context,
-    std::shared_ptr<tablet::AbstractTablet>* tablet) {
+    std::shared_ptr<tablet::AbstractTablet>* tablet,
+    HybridTime* read_time) {
   // Don't need to check for leader since we perform that check earlier in Read().
   Status s = master_->catalog_manager()->RetrieveSystemTablet(req->tablet_id(), tablet);
   if (PREDICT_FALSE(!s.ok())) {
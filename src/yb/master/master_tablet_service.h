@@ -69,7 +69,8 @@ class MasterTabletServiceImpl : public yb::tserver::TabletServiceImpl {
       const tserver::ReadRequestPB* req,
       tserver::ReadResponsePB* resp,
       rpc::RpcContext* context,
-      std::shared_ptr<tablet::AbstractTablet>* tablet) override;
+      std::shared_ptr<tablet::AbstractTablet>* tablet,
+      HybridTime* read_time) override;
 
   Master *const master_;
   DISALLOW_COPY_AND_ASSIGN(MasterTabletServiceImpl);
@@ -111,6 +111,8 @@ SysCatalogTable::SysCatalogTable(Master* master, MetricRegistry* metrics,
       master_(master),
       leader_cb_(std::move(leader_cb)) {
   CHECK_OK(ThreadPoolBuilder("apply").Build(&apply_pool_));
+  CHECK_OK(ThreadPoolBuilder("log-cache-read-ahead").set_max_threads(1)
+           .Build(&log_cache_read_ahead_pool_));
 }
 
 SysCatalogTable::~SysCatalogTable() {
@@ -121,6 +123,7 @@ void SysCatalogTable::Shutdown() {
     tablet_peer_->Shutdown();
   }
   apply_pool_->Shutdown();
+  log_cache_read_ahead_pool_->Shutdown();
 }
 
 Status SysCatalogTable::ConvertConfigToMasterAddresses(
@@ -420,6 +423,7 @@ Status SysCatalogTable::GoIntoShellMode() {
 
   tablet_peer_.reset();
   apply_pool_.reset();
+  log_cache_read_ahead_pool_.reset();
 
   return Status::OK();
 }
@@ -433,6 +437,7 @@ void SysCatalogTable::SetupTabletPeer(const scoped_refptr<tablet::TabletMetadata
     new TabletPeerClass(metadata,
                         local_peer_pb_,
                         apply_pool_.get(),
+                        log_cache_read_ahead_pool_.get(),
                         Bind(&SysCatalogTable::SysCatalogStateChanged,
                              Unretained(this),
                              metadata->tablet_id())));
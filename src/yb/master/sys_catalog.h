@@ -213,6 +213,8 @@ class SysCatalogTable {
 
   gscoped_ptr<ThreadPool> apply_pool_;
 
+  gscoped_ptr<ThreadPool> log_cache_read_ahead_pool_;
+
   scoped_refptr<tablet::TabletPeer> tablet_peer_;
 
   Master* master_;
@@ -255,5 +255,28 @@ void TSDescriptor::ClearPendingTabletDelete(const std::string& tablet_id) {
   tablets_pending_delete_.erase(tablet_id);
 }
 
+void TSDescriptor::UpdateTabletMetrics(const TServerMetricsPB& metrics) {
+  std::unordered_map<std::string, TabletMetrics> tablet_metrics;
+  for (const auto& tablet_pb : metrics.tablet_metrics()) {
+    auto& entry = tablet_metrics[tablet_pb.tablet_id()];
+    entry.sst_file_size = tablet_pb.sst_file_size();
+    entry.memtable_size = tablet_pb.memtable_size();
+    entry.read_ops_per_sec = tablet_pb.read_ops_per_sec();
+    entry.write_ops_per_sec = tablet_pb.write_ops_per_sec();
+  }
+  std::lock_guard<simple_spinlock> l(lock_);
+  tablet_metrics_.swap(tablet_metrics);
+}
+
+bool TSDescriptor::GetTabletMetrics(const std::string& tablet_id, TabletMetrics* metrics) const {
+  std::lock_guard<simple_spinlock> l(lock_);
+  auto it = tablet_metrics_.find(tablet_id);
+  if (it == tablet_metrics_.end()) {
+    return false;
+  }
+  *metrics = it->second;
+  return true;
+}
+
 } // namespace master
 } // namespace yb
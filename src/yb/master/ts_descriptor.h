@@ -35,6 +35,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/tserver/tserver_service.proxy.h"
@@ -60,6 +61,7 @@ namespace master {
 
 class TSRegistrationPB;
 class TSInformationPB;
+class TServerMetricsPB;
 
 typedef util::SharedPtrTuple<tserver::TabletServerAdminServiceProxy,
                              tserver::TabletServerServiceProxy,
@@ -187,6 +189,28 @@ class TSDescriptor {
     return write_ops_per_sec_;
   }
 
+  // Resource usage of a single tablet replica, as last reported by this tablet server.
+  struct TabletMetrics {
+    uint64_t sst_file_size = 0;
+    uint64_t memtable_size = 0;
+    double read_ops_per_sec = 0;
+    double write_ops_per_sec = 0;
+
+    uint64_t total_size() const { return sst_file_size + memtable_size; }
+    double total_ops_per_sec() const { return read_ops_per_sec + write_ops_per_sec; }
+  };
+
+  // Replace the per-tablet metrics with the ones sent in the latest heartbeat.
+  void UpdateTabletMetrics(const TServerMetricsPB& metrics);
+
+  // Returns false if this tablet server has not reported metrics for the given tablet yet.
+  bool GetTabletMetrics(const std::string& tablet_id, TabletMetrics* metrics) const;
+
+  std::unordered_map<std::string, TabletMetrics> tablet_metrics() const {
+    std::lock_guard<simple_spinlock> l(lock_);
+    return tablet_metrics_;
+  }
+
   // Set of methods to keep track of pending tablet deletes for a tablet server. We use them to
   // avoid assigning more tablets to a tserver that might be potentially unresponsive.
   bool HasTabletDeletePending() const;
@@ -247,6 +271,9 @@ class TSDescriptor {
   // Set of tablet uuids for which a delete is pending on this tablet server.
   std::set<std::string> tablets_pending_delete_;
 
+  // Per-tablet resource usage from the last heartbeat that carried metrics, keyed by tablet id.
+  std::unordered_map<std::string, TabletMetrics> tablet_metrics_;
+
   DISALLOW_COPY_AND_ASSIGN(TSDescriptor);
 };
 
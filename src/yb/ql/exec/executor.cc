@@ -18,6 +18,13 @@
 #include "yb/client/callbacks.h"
 #include "yb/ql/ql_processor.h"
 #include "yb/util/decimal.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(ycql_consistent_prefix_max_staleness_ms, 0,
+             "Maximum staleness in milliseconds of rows returned by a follower for a YCQL read at "
+             "consistency level ONE. 0 means unbounded.");
+TAG_FLAG(ycql_consistent_prefix_max_staleness_ms, advanced);
+TAG_FLAG(ycql_consistent_prefix_max_staleness_ms, runtime);
 
 namespace yb {
 namespace ql {
@@ -434,7 +441,7 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode) {
     QLRowBlock empty_row_block(tnode->table()->InternalSchema(), {});
     faststring buffer;
     empty_row_block.Serialize(select_op->request().client(), &buffer);
-    *select_op->mutable_rows_data() = buffer.ToString();
+    *select_op->mutable_rows_data() = RefCntBuffer(buffer);
     result_ = std::make_shared<RowsResult>(select_op.get());
     return Status::OK();
   }
@@ -517,6 +524,10 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode) {
     select_op->set_yb_consistency_level(YBConsistencyLevel::STRONG);
   } else {
     select_op->set_yb_consistency_level(params.yb_consistency_level());
+    if (FLAGS_ycql_consistent_prefix_max_staleness_ms > 0) {
+      select_op->set_max_staleness(
+          MonoDelta::FromMilliseconds(FLAGS_ycql_consistent_prefix_max_staleness_ms));
+    }
   }
 
   // If we have several hash partitions (i.e. IN condition on hash columns) we initialize the
@@ -547,7 +558,7 @@ Status Executor::FetchMoreRowsIfNeeded() {
   RowsResult::SharedPtr current_result = std::static_pointer_cast<RowsResult>(result_);
   size_t current_fetch_row_count = 0;
   RETURN_NOT_OK(QLRowBlock::GetRowCount(current_result->client(),
-                                        current_result->rows_data(),
+                                        current_result->rows_data().AsSlice(),
                                         &current_fetch_row_count));
 
   size_t previous_fetches_row_count = exec_context_->params()->total_num_rows_read();
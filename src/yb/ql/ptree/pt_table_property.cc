@@ -28,9 +28,12 @@ using client::YBColumnSchema;
 // scanner phase and as a result if we're doing string matching everything should be lowercase.
 const std::map<std::string, PTTableProperty::KVProperty> PTTableProperty::kPropertyDataTypes
     = {
+    {"block_cache_priority", KVProperty::kBlockCachePriority},
+    {"block_cache_reserved_bytes", KVProperty::kBlockCacheReservedBytes},
     {"bloom_filter_fp_chance", KVProperty::kBloomFilterFpChance},
     {"caching", KVProperty::kCaching},
     {"comment", KVProperty::kComment},
+    {"compact_doc_key", KVProperty::kCompactDocKey},
     {"compaction", KVProperty::kCompaction},
     {"compression", KVProperty::kCompression},
     {"crc_check_chance", KVProperty::kCrcCheckChance},
@@ -41,6 +44,7 @@ const std::map<std::string, PTTableProperty::KVProperty> PTTableProperty::kPrope
     {"memtable_flush_period_in_ms", KVProperty::kMemtableFlushPeriodInMs},
     {"min_index_interval", KVProperty::kMinIndexInterval},
     {"max_index_interval", KVProperty::kMaxIndexInterval},
+    {"range_aware_bloom_filter", KVProperty::kRangeAwareBloomFilter},
     {"read_repair_chance", KVProperty::kReadRepairChance},
     {"speculative_retry", KVProperty::kSpeculativeRetry}
 };
@@ -68,6 +72,23 @@ PTTableProperty::PTTableProperty(MemoryContext *memctx,
 PTTableProperty::~PTTableProperty() {
 }
 
+namespace {
+
+bool ParseBlockCachePriority(const string& val, BlockCachePriority* priority) {
+  string lower_case_val;
+  ToLowerCase(val, &lower_case_val);
+  if (lower_case_val == "normal") {
+    *priority = NORMAL_BLOCK_CACHE_PRIORITY;
+    return true;
+  }
+  if (lower_case_val == "low") {
+    *priority = LOW_BLOCK_CACHE_PRIORITY;
+    return true;
+  }
+  return false;
+}
+
+} // namespace
 
 Status PTTableProperty::AnalyzeSpeculativeRetry(const string &val) {
   string generic_error = Substitute("Invalid value $0 for option 'speculative_retry'", val);
@@ -111,6 +132,7 @@ CHECKED_STATUS PTTableProperty::Analyze(SemContext *sem_context) {
 
   long double double_val;
   int64_t int_val;
+  bool bool_val;
   string str_val;
 
   switch (iterator->second) {
@@ -174,6 +196,59 @@ CHECKED_STATUS PTTableProperty::Analyze(SemContext *sem_context) {
                                                              &str_val));
       RETURN_SEM_CONTEXT_ERROR_NOT_OK(AnalyzeSpeculativeRetry(str_val));
       break;
+    case KVProperty::kRangeAwareBloomFilter:
+      if (sem_context->current_alter_table() != nullptr) {
+        return sem_context->Error(this,
+                                  Substitute("$0 can only be set when creating a table",
+                                             table_property_name).c_str(),
+                                  ErrorCode::INVALID_TABLE_PROPERTY);
+      }
+      RETURN_SEM_CONTEXT_ERROR_NOT_OK(GetBoolValueFromExpr(rhs_, table_property_name,
+                                                           &bool_val));
+      break;
+    case KVProperty::kCompactDocKey:
+      if (sem_context->current_alter_table() != nullptr) {
+        return sem_context->Error(this,
+                                  Substitute("$0 can only be set when creating a table",
+                                             table_property_name).c_str(),
+                                  ErrorCode::INVALID_TABLE_PROPERTY);
+      }
+      RETURN_SEM_CONTEXT_ERROR_NOT_OK(GetBoolValueFromExpr(rhs_, table_property_name,
+                                                           &bool_val));
+      break;
+    case KVProperty::kBlockCacheReservedBytes:
+      if (sem_context->current_alter_table() != nullptr) {
+        return sem_context->Error(this,
+                                  Substitute("$0 can only be set when creating a table",
+                                             table_property_name).c_str(),
+                                  ErrorCode::INVALID_TABLE_PROPERTY);
+      }
+      RETURN_SEM_CONTEXT_ERROR_NOT_OK(GetIntValueFromExpr(rhs_, table_property_name, &int_val));
+      if (int_val < 0) {
+        return sem_context->Error(this,
+                                  Substitute("$0 must be greater than or equal to 0 (got $1)",
+                                             table_property_name, std::to_string(int_val)).c_str(),
+                                  ErrorCode::INVALID_ARGUMENTS);
+      }
+      break;
+    case KVProperty::kBlockCachePriority: {
+      if (sem_context->current_alter_table() != nullptr) {
+        return sem_context->Error(this,
+                                  Substitute("$0 can only be set when creating a table",
+                                             table_property_name).c_str(),
+                                  ErrorCode::INVALID_TABLE_PROPERTY);
+      }
+      RETURN_SEM_CONTEXT_ERROR_NOT_OK(GetStringValueFromExpr(rhs_, true, table_property_name,
+                                                             &str_val));
+      BlockCachePriority priority;
+      if (!ParseBlockCachePriority(str_val, &priority)) {
+        return sem_context->Error(this,
+                                  Substitute("$0 must be 'normal' or 'low' (got '$1')",
+                                             table_property_name, str_val).c_str(),
+                                  ErrorCode::INVALID_ARGUMENTS);
+      }
+      break;
+    }
     case KVProperty::kComment:
       RETURN_SEM_CONTEXT_ERROR_NOT_OK(GetStringValueFromExpr(rhs_, true, table_property_name,
                                                              &str_val));
@@ -227,7 +302,8 @@ CHECKED_STATUS PTTablePropertyListNode::Analyze(SemContext *sem_context) {
     switch(tnode->property_type()) {
       case PropertyType::kTableProperty: FALLTHROUGH_INTENDED;
       case PropertyType::kTablePropertyMap: {
-        string table_property_name = tnode->lhs()->c_str();
+        string table_property_name;
+        ToLowerCase(tnode->lhs()->c_str(), &table_property_name);
         if (table_properties.find(table_property_name) != table_properties.end()) {
           return sem_context->Error(this, ErrorCode::DUPLICATE_TABLE_PROPERTY);
         }
@@ -253,6 +329,16 @@ CHECKED_STATUS PTTablePropertyListNode::Analyze(SemContext *sem_context) {
     }
   }
 
+  // A table with reserved block cache does not use the shared block caches, so its priority in
+  // them would be ignored.
+  if (table_properties.count("block_cache_reserved_bytes") &&
+      table_properties.count("block_cache_priority")) {
+    return sem_context->Error(this,
+                              "block_cache_reserved_bytes and block_cache_priority cannot be set "
+                              "together",
+                              ErrorCode::INVALID_TABLE_PROPERTY);
+  }
+
   auto order_column_iter = order_columns.begin();
   for (auto &pc : sem_context->current_create_table_stmt()->primary_columns()) {
     if (order_column_iter == order_columns.end()) {
@@ -312,6 +398,40 @@ Status PTTableProperty::SetTableProperty(yb::TableProperties *table_property) co
       table_property->SetDefaultTimeToLive(val * MonoTime::kMillisecondsPerSecond);
       break;
     }
+    case KVProperty::kRangeAwareBloomFilter: {
+      bool val;
+      if (!GetBoolValueFromExpr(rhs_, table_property_name, &val).ok()) {
+        return STATUS(InvalidArgument, Substitute("Invalid value for range_aware_bloom_filter"));
+      }
+      table_property->SetRangeAwareBloomFilter(val);
+      break;
+    }
+    case KVProperty::kCompactDocKey: {
+      bool val;
+      if (!GetBoolValueFromExpr(rhs_, table_property_name, &val).ok()) {
+        return STATUS(InvalidArgument, Substitute("Invalid value for compact_doc_key"));
+      }
+      table_property->SetCompactDocKey(val);
+      break;
+    }
+    case KVProperty::kBlockCacheReservedBytes: {
+      int64_t val;
+      if (!GetIntValueFromExpr(rhs_, table_property_name, &val).ok() || val < 0) {
+        return STATUS(InvalidArgument, Substitute("Invalid value for block_cache_reserved_bytes"));
+      }
+      table_property->SetBlockCacheReservedBytes(val);
+      break;
+    }
+    case KVProperty::kBlockCachePriority: {
+      string val;
+      BlockCachePriority priority;
+      if (!GetStringValueFromExpr(rhs_, true, table_property_name, &val).ok() ||
+          !ParseBlockCachePriority(val, &priority)) {
+        return STATUS(InvalidArgument, Substitute("Invalid value for block_cache_priority"));
+      }
+      table_property->SetBlockCachePriority(priority);
+      break;
+    }
     case KVProperty::kBloomFilterFpChance: FALLTHROUGH_INTENDED;
     case KVProperty::kCaching: FALLTHROUGH_INTENDED;
     case KVProperty::kComment: FALLTHROUGH_INTENDED;
@@ -36,9 +36,12 @@ enum class PropertyType : int {
 class PTTableProperty : public PTProperty {
  public:
   enum class KVProperty : int {
+    kBlockCachePriority,
+    kBlockCacheReservedBytes,
     kBloomFilterFpChance,
     kCaching,
     kComment,
+    kCompactDocKey,
     kCompaction,
     kCompression,
     kCrcCheckChance,
@@ -49,6 +52,7 @@ class PTTableProperty : public PTProperty {
     kMemtableFlushPeriodInMs,
     kMinIndexInterval,
     kMaxIndexInterval,
+    kRangeAwareBloomFilter,
     kReadRepairChance,
     kSpeculativeRetry
   };
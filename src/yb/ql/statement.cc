@@ -24,6 +24,7 @@ using std::list;
 using std::shared_ptr;
 using std::string;
 using std::unique_ptr;
+using std::vector;
 
 Statement::Statement(const string& keyspace, const string& text)
     : keyspace_(keyspace), text_(text) {
@@ -91,5 +92,32 @@ Status Statement::ExecuteBatch(QLProcessor* processor, const StatementParameters
   return Status::OK();
 }
 
+Status Statement::GetBindVariableTypes(vector<shared_ptr<QLType>>* types) const {
+  RETURN_NOT_OK(Validate());
+  types->clear();
+  const TreeNode* root = parse_tree_->root().get();
+  if (root == nullptr) {
+    return Status::OK();
+  }
+  switch (root->opcode()) {
+    case TreeNodeOpcode::kPTSelectStmt: FALLTHROUGH_INTENDED;
+    case TreeNodeOpcode::kPTInsertStmt: FALLTHROUGH_INTENDED;
+    case TreeNodeOpcode::kPTUpdateStmt: FALLTHROUGH_INTENDED;
+    case TreeNodeOpcode::kPTDeleteStmt:
+      break;
+    default:
+      return Status::OK();
+  }
+  const auto& bind_variables = static_cast<const PTDmlStmt*>(root)->bind_variables();
+  types->resize(bind_variables.size());
+  for (const PTBindVar* var : bind_variables) {
+    if (var->pos() < 0 || var->pos() >= types->size()) {
+      return STATUS_SUBSTITUTE(IllegalState, "Unexpected bind variable position $0", var->pos());
+    }
+    (*types)[var->pos()] = var->ql_type();
+  }
+  return Status::OK();
+}
+
 }  // namespace ql
 }  // namespace yb
@@ -58,6 +58,9 @@ class Statement {
   // Execute the prepared statement in a batch
   CHECKED_STATUS ExecuteBatch(QLProcessor* processor, const StatementParameters& params) const;
 
+  // Return the datatypes of the bind variables of the prepared statement by their positions.
+  CHECKED_STATUS GetBindVariableTypes(std::vector<std::shared_ptr<QLType>>* types) const;
+
   // Is this statement unprepared?
   bool unprepared() const {
     return !prepared_.load(std::memory_order_acquire);
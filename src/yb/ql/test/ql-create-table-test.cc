@@ -181,6 +181,53 @@ TEST_F(TestQLCreateTable, TestQLCreateTableWithTTL) {
   EXPECT_EQ(1000, properties_pb.default_time_to_live());
 }
 
+TEST_F(TestQLCreateTable, TestQLCreateTableWithBlockCacheProperties) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get an available processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  EXEC_VALID_STMT("CREATE TABLE reserved_cache_table (c1 int, c2 int, PRIMARY KEY(c1)) WITH "
+                      "block_cache_reserved_bytes = 1048576;");
+  EXEC_VALID_STMT("CREATE TABLE low_priority_table (c1 int, c2 int, PRIMARY KEY(c1)) WITH "
+                      "block_cache_priority = 'LOW';");
+
+  EXEC_INVALID_TABLE_CREATE_STMT(
+      "CREATE TABLE invalid_table (c1 int, PRIMARY KEY(c1)) WITH "
+          "block_cache_reserved_bytes = -1;",
+      "block_cache_reserved_bytes must be greater than or equal to 0 (got -1)");
+  EXEC_INVALID_TABLE_CREATE_STMT(
+      "CREATE TABLE invalid_table (c1 int, PRIMARY KEY(c1)) WITH "
+          "block_cache_priority = 'high';",
+      "block_cache_priority must be 'normal' or 'low' (got 'high')");
+  EXEC_INVALID_TABLE_CREATE_STMT(
+      "CREATE TABLE invalid_table (c1 int, PRIMARY KEY(c1)) WITH "
+          "block_cache_reserved_bytes = 1048576 AND block_cache_priority = 'low';",
+      "block_cache_reserved_bytes and block_cache_priority cannot be set together");
+  EXEC_INVALID_TABLE_CREATE_STMT(
+      "ALTER TABLE low_priority_table WITH block_cache_priority = 'normal';",
+      "block_cache_priority can only be set when creating a table");
+
+  // Verify the properties were stored in syscatalog table.
+  master::CatalogManager *catalog_manager = cluster_->mini_master()->master()->catalog_manager();
+  master::GetTableSchemaRequestPB request_pb;
+  master::GetTableSchemaResponsePB response_pb;
+  request_pb.mutable_table()->mutable_namespace_()->set_name(kDefaultKeyspaceName);
+  request_pb.mutable_table()->set_table_name("reserved_cache_table");
+  CHECK_OK(catalog_manager->GetTableSchema(&request_pb, &response_pb));
+  EXPECT_EQ(1048576U, response_pb.schema().table_properties().block_cache_reserved_bytes());
+  EXPECT_EQ(NORMAL_BLOCK_CACHE_PRIORITY,
+            response_pb.schema().table_properties().block_cache_priority());
+
+  request_pb.mutable_table()->set_table_name("low_priority_table");
+  response_pb.Clear();
+  CHECK_OK(catalog_manager->GetTableSchema(&request_pb, &response_pb));
+  EXPECT_EQ(0U, response_pb.schema().table_properties().block_cache_reserved_bytes());
+  EXPECT_EQ(LOW_BLOCK_CACHE_PRIORITY,
+            response_pb.schema().table_properties().block_cache_priority());
+}
+
 TEST_F(TestQLCreateTable, TestQLCreateTableWithClusteringOrderBy) {
   // Init the simulated cluster.
   ASSERT_NO_FATALS(CreateSimulatedCluster());
@@ -157,7 +157,7 @@ RowsResult::RowsResult(const client::YBTableName& table_name,
     : table_name_(table_name),
       column_schemas_(column_schemas),
       client_(QLClient::YQL_CLIENT_CQL),
-      rows_data_(rows_data) {
+      rows_data_(RefCntBuffer(rows_data)) {
 }
 
 RowsResult::~RowsResult() {
@@ -167,7 +167,10 @@ Status RowsResult::Append(const RowsResult& other) {
   if (rows_data_.empty()) {
     rows_data_ = other.rows_data_;
   } else {
-    RETURN_NOT_OK(QLRowBlock::AppendRowsData(other.client_, other.rows_data_, &rows_data_));
+    std::string rows_data = rows_data_.ToBuffer();
+    RETURN_NOT_OK(QLRowBlock::AppendRowsData(
+        other.client_, other.rows_data_.AsSlice(), &rows_data));
+    rows_data_ = RefCntBuffer(rows_data);
   }
   paging_state_ = other.paging_state_;
   return Status::OK();
@@ -176,7 +179,7 @@ Status RowsResult::Append(const RowsResult& other) {
 std::unique_ptr<QLRowBlock> RowsResult::GetRowBlock() const {
   Schema schema(*column_schemas_, 0);
   unique_ptr<QLRowBlock> rowblock(new QLRowBlock(schema));
-  Slice data(rows_data_);
+  Slice data = rows_data_.AsSlice();
   if (!data.empty()) {
     // TODO: a better way to handle errors here?
     CHECK_OK(rowblock->Deserialize(client_, &data));
@@ -128,7 +128,8 @@ class RowsResult : public ExecutedResult {
   // Accessor functions.
   const client::YBTableName& table_name() const { return table_name_; }
   const std::vector<ColumnSchema>& column_schemas() const { return *column_schemas_; }
-  const std::string& rows_data() const { return rows_data_; }
+  // The rows in the wire format of client(). Shared with the read op the rows were received by.
+  const RefCntSlice& rows_data() const { return rows_data_; }
   const std::string& paging_state() const { return paging_state_; }
   QLClient client() const { return client_; }
 
@@ -146,7 +147,7 @@ class RowsResult : public ExecutedResult {
   const client::YBTableName table_name_;
   std::shared_ptr<std::vector<ColumnSchema>> column_schemas_;
   const QLClient client_;
-  std::string rows_data_;
+  RefCntSlice rows_data_;
   std::string paging_state_;
 };
 
@@ -255,7 +255,7 @@ RefCntBuffer SerializeResponses(const Collection& responses) {
   return result;
 }
 
-void RedisInboundCall::Serialize(std::deque<RefCntBuffer>* output) const {
+void RedisInboundCall::Serialize(std::deque<RefCntSlice>* output) const {
   output->push_back(SerializeResponses(responses_));
 }
 
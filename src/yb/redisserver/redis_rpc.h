@@ -60,7 +60,7 @@ class RedisInboundCall : public rpc::QueueableInboundCall {
 
   // Serialize the response packet for the finished call.
   // The resulting slices refer to memory in this object.
-  void Serialize(std::deque<RefCntBuffer>* output) const override;
+  void Serialize(std::deque<RefCntSlice>* output) const override;
 
   void LogTrace() const override;
   std::string ToString() const override;
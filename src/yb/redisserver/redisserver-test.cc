@@ -585,6 +585,59 @@ TEST_F_EX(TestRedisService, Pipeline, TestRedisServicePipelined) {
   LOG(INFO) << yb::Format("Unsafe set: $0ms, get: $1ms", set_time.count(), get_time.count());
 }
 
+namespace {
+
+const size_t kPipelineMembers = 10;
+
+// Adds kPipelineMembers members to every set, members start from first_member.
+std::string PipelineSAddCommand(size_t first_member) {
+  std::string command;
+  for (size_t i = 0; i != kPipelineKeys; ++i) {
+    command += yb::Format("sadd set$0", i);
+    for (size_t j = 0; j != kPipelineMembers; ++j) {
+      command += yb::Format(" $0", first_member + j);
+    }
+    command += "\r\n";
+  }
+  return command;
+}
+
+std::string PipelineHSetCommand() {
+  std::string command;
+  for (size_t i = 0; i != kPipelineKeys; ++i) {
+    command += yb::Format("hset map$0 f $1\r\n", i, ValueForKey(i));
+  }
+  return command;
+}
+
+std::string PipelineIntResponse(size_t value) {
+  std::string response;
+  for (size_t i = 0; i != kPipelineKeys; ++i) {
+    response += yb::Format(":$0\r\n", value);
+  }
+  return response;
+}
+
+} // namespace
+
+// Writes with type checks for the key and for each of the subkeys.
+TEST_F_EX(TestRedisService, PipelineTypeChecks, TestRedisServicePipelined) {
+  auto start = std::chrono::steady_clock::now();
+  SendCommandAndExpectResponse(
+      __LINE__, PipelineSAddCommand(0), PipelineIntResponse(kPipelineMembers));
+  // Half of the members are already in the sets.
+  SendCommandAndExpectResponse(__LINE__,
+                               PipelineSAddCommand(kPipelineMembers / 2),
+                               PipelineIntResponse(kPipelineMembers / 2));
+  auto mid = std::chrono::steady_clock::now();
+  SendCommandAndExpectResponse(__LINE__, PipelineHSetCommand(), PipelineIntResponse(1));
+  SendCommandAndExpectResponse(__LINE__, PipelineHSetCommand(), PipelineIntResponse(0));
+  auto end = std::chrono::steady_clock::now();
+  auto sadd_time = std::chrono::duration_cast<std::chrono::milliseconds>(mid - start);
+  auto hset_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - mid);
+  LOG(INFO) << yb::Format("Unsafe sadd: $0ms, hset: $1ms", sadd_time.count(), hset_time.count());
+}
+
 TEST_F_EX(TestRedisService, PipelinePartial, TestRedisServicePipelined) {
   SendCommandAndExpectResponse(__LINE__,
                                PipelineSetCommand(),
@@ -1552,6 +1605,25 @@ TEST_F(TestRedisService, TestSADDBatch) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestTypeChecksInBatch) {
+  DoRedisTestInt(__LINE__, {"SADD", "set1", "a", "b", "c"}, 3);
+  DoRedisTestInt(__LINE__, {"HSET", "map1", "f", "1"}, 1);
+  DoRedisTestOk(__LINE__, {"SET", "str1", "v"});
+  SyncClient();
+  DoRedisTestInt(__LINE__, {"SADD", "set1", "d", "a", "e"}, 2);
+  DoRedisTestInt(__LINE__, {"HSET", "map1", "f", "2"}, 0);
+  DoRedisTestInt(__LINE__, {"HSET", "map1", "g", "3"}, 1);
+  DoRedisTestExpectError(__LINE__, {"SADD", "str1", "a"});
+  DoRedisTestExpectError(__LINE__, {"HSET", "set1", "f", "1"});
+  DoRedisTestInt(__LINE__, {"SADD", "set1", "e", "f"}, 1);
+  SyncClient();
+  DoRedisTestInt(__LINE__, {"SISMEMBER", "set1", "e"}, 1);
+  DoRedisTestInt(__LINE__, {"SISMEMBER", "set1", "f"}, 1);
+  DoRedisTestBulkString(__LINE__, {"HGET", "map1", "g"}, "3");
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestSRem) {
   // The default value is true, but we explicitly set this here for clarity.
   FLAGS_emulate_redis_responses = true;
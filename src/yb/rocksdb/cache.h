@@ -188,7 +188,8 @@ class Cache {
   virtual void ApplyToAllCacheEntries(void (*callback)(void*, size_t),
                                       bool thread_safe) = 0;
 
-  virtual void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) = 0;
+  // Reports the metrics of this cache as the given block cache tier.
+  virtual void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity, yb::CacheTier tier) = 0;
 
  private:
   void LRU_Remove(Handle* e);
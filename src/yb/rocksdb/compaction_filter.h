@@ -33,6 +33,7 @@
 namespace rocksdb {
 
 class SliceTransform;
+struct FileMetaData;
 
 // Context information of a compaction run
 struct CompactionFilterContext {
@@ -137,6 +138,15 @@ class CompactionFilter {
 
 // Each compaction will create a new CompactionFilter allowing the
 // application to know about different compactions
+// Decides whether a file could be deleted as a whole, without reading it through compaction.
+class CompactionFileFilter {
+ public:
+  virtual ~CompactionFileFilter() {}
+
+  // Returns true if the file does not contain any data that could be visible to reads anymore.
+  virtual bool CanDropFile(const FileMetaData& file) const = 0;
+};
+
 class CompactionFilterFactory {
  public:
   virtual ~CompactionFilterFactory() { }
@@ -144,6 +154,14 @@ class CompactionFilterFactory {
   virtual std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) = 0;
 
+  // Creates a filter used by universal compaction to delete whole files without compacting them.
+  // 'files' are all live files of the column family. Returns nullptr if files should never be
+  // dropped this way.
+  virtual std::unique_ptr<CompactionFileFilter> CreateCompactionFileFilter(
+      const std::vector<FileMetaData*>& files) {
+    return nullptr;
+  }
+
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
 };
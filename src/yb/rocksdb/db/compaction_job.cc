@@ -234,7 +234,7 @@ CompactionJob::CompactionJob(
     SequenceNumber earliest_write_conflict_snapshot,
     std::shared_ptr<Cache> table_cache, EventLogger* event_logger,
     bool paranoid_file_checks, bool measure_io_stats, const std::string& dbname,
-    CompactionJobStats* compaction_job_stats)
+    CompactionJobStats* compaction_job_stats, std::atomic<bool>* canceled)
     : job_id_(job_id),
       compact_(new CompactionState(compaction)),
       compaction_job_stats_(compaction_job_stats),
@@ -245,6 +245,7 @@ CompactionJob::CompactionJob(
       env_(db_options.env),
       versions_(versions),
       shutting_down_(shutting_down),
+      canceled_(canceled),
       log_buffer_(log_buffer),
       db_directory_(db_directory),
       output_directory_(output_directory),
@@ -677,7 +678,7 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
   // TODO(noetzli): check whether we could check !shutting_down_->... only
   // only occasionally (see diff D42687)
   while (status.ok() && !shutting_down_->load(std::memory_order_acquire) &&
-         !cfd->IsDropped() && c_iter->Valid()) {
+         !IsCanceled() && !cfd->IsDropped() && c_iter->Valid()) {
     // Invariant: c_iter.status() is guaranteed to be OK if c_iter->Valid()
     // returns true.
     const Slice& key = c_iter->key();
@@ -758,6 +759,9 @@ void CompactionJob::ProcessKeyValueCompaction(SubcompactionState* sub_compact) {
     status = STATUS(ShutdownInProgress,
         "Database shutdown or Column family drop during compaction");
   }
+  if (status.ok() && IsCanceled()) {
+    status = STATUS(ShutdownInProgress, "Manual compaction canceled");
+  }
   if (status.ok() && sub_compact->builder != nullptr) {
     status = FinishCompactionOutputFile(input->status(), sub_compact);
   }
@@ -77,7 +77,8 @@ class CompactionJob {
                 std::shared_ptr<Cache> table_cache, EventLogger* event_logger,
                 bool paranoid_file_checks, bool measure_io_stats,
                 const std::string& dbname,
-                CompactionJobStats* compaction_job_stats);
+                CompactionJobStats* compaction_job_stats,
+                std::atomic<bool>* canceled = nullptr);
 
   ~CompactionJob();
 
@@ -100,6 +101,10 @@ class CompactionJob {
   void AggregateStatistics();
   void GenSubcompactionBoundaries();
 
+  bool IsCanceled() const {
+    return canceled_ != nullptr && canceled_->load(std::memory_order_acquire);
+  }
+
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
   void AllocateCompactionOutputFileNumbers();
@@ -144,6 +149,8 @@ class CompactionJob {
   Env* env_;
   VersionSet* versions_;
   std::atomic<bool>* shutting_down_;
+  // Set by the requester of a manual compaction to stop it, nullptr if it cannot be canceled.
+  std::atomic<bool>* canceled_;
   LogBuffer* log_buffer_;
   Directory* db_directory_;
   Directory* output_directory_;
@@ -1146,7 +1146,20 @@ bool LevelCompactionPicker::PickCompactionBySize(VersionStorageInfo* vstorage,
 bool UniversalCompactionPicker::NeedsCompaction(
     const VersionStorageInfo* vstorage) const {
   const int kLevel0 = 0;
-  return vstorage->CompactionScore(kLevel0) >= 1;
+  if (vstorage->CompactionScore(kLevel0) >= 1) {
+    return true;
+  }
+  // Files that expired as a whole are dropped regardless of the size ratio trigger.
+  auto file_filter = CreateDropFilesFilter(vstorage);
+  if (!file_filter) {
+    return false;
+  }
+  for (auto* f : vstorage->LevelFiles(kLevel0)) {
+    if (!f->being_compacted && file_filter->CanDropFile(*f)) {
+      return true;
+    }
+  }
+  return false;
 }
 
 struct UniversalCompactionPicker::SortedRun {
@@ -1351,6 +1364,12 @@ Compaction* UniversalCompactionPicker::PickCompaction(
     const MutableCFOptions& mutable_cf_options,
     VersionStorageInfo* vstorage,
     LogBuffer* log_buffer) {
+  Compaction* drop_files_compaction = PickCompactionUniversalDropFiles(
+      cf_name, mutable_cf_options, vstorage, log_buffer);
+  if (drop_files_compaction != nullptr) {
+    return drop_files_compaction;
+  }
+
   std::vector<std::vector<SortedRun>> sorted_runs = CalculateSortedRuns(
       *vstorage,
       ioptions_,
@@ -1492,6 +1511,56 @@ Compaction* UniversalCompactionPicker::DoPickCompaction(
   return c;
 }
 
+std::unique_ptr<CompactionFileFilter> UniversalCompactionPicker::CreateDropFilesFilter(
+    const VersionStorageInfo* vstorage) const {
+  if (ioptions_.compaction_filter_factory == nullptr || vstorage->LevelFiles(0).empty()) {
+    return nullptr;
+  }
+  std::vector<FileMetaData*> all_files;
+  for (int level = 0; level < vstorage->num_levels(); ++level) {
+    const auto& files = vstorage->LevelFiles(level);
+    all_files.insert(all_files.end(), files.begin(), files.end());
+  }
+  return ioptions_.compaction_filter_factory->CreateCompactionFileFilter(all_files);
+}
+
+Compaction* UniversalCompactionPicker::PickCompactionUniversalDropFiles(
+    const std::string& cf_name,
+    const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage,
+    LogBuffer* log_buffer) {
+  const int kLevel0 = 0;
+  auto file_filter = CreateDropFilesFilter(vstorage);
+  if (!file_filter) {
+    return nullptr;
+  }
+  const std::vector<FileMetaData*>& level_files = vstorage->LevelFiles(kLevel0);
+
+  std::vector<CompactionInputFiles> inputs(1);
+  inputs[0].level = kLevel0;
+  for (auto* f : level_files) {
+    if (f->being_compacted || !file_filter->CanDropFile(*f)) {
+      continue;
+    }
+    inputs[0].files.push_back(f);
+    char tmp_fsize[16];
+    AppendHumanBytes(f->fd.GetTotalFileSize(), tmp_fsize, sizeof(tmp_fsize));
+    LOG_TO_BUFFER(log_buffer, "[%s] Universal: picking file %" PRIu64
+                              " with size %s for deletion",
+                  cf_name.c_str(), f->fd.GetNumber(), tmp_fsize);
+  }
+  if (inputs[0].files.empty()) {
+    return nullptr;
+  }
+
+  Compaction* c = new Compaction(
+      vstorage, mutable_cf_options, std::move(inputs), kLevel0, 0, 0, 0,
+      kNoCompression, {}, /* is manual */ false, vstorage->CompactionScore(kLevel0),
+      /* is deletion compaction */ true, CompactionReason::kUniversalDropFiles);
+  level0_compactions_in_progress_.insert(c);
+  return c;
+}
+
 uint32_t UniversalCompactionPicker::GetPathId(
     const ImmutableCFOptions& ioptions, uint64_t file_size) {
   // Two conditions need to be satisfied:
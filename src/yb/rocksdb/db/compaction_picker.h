@@ -32,6 +32,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/env.h"
@@ -273,6 +274,16 @@ class UniversalCompactionPicker : public CompactionPicker {
       unsigned int num_files, const std::vector<SortedRun>& sorted_runs,
       LogBuffer* log_buffer);
 
+  // Returns the filter deciding which level 0 files could be deleted without compaction, or nullptr
+  // if none could.
+  std::unique_ptr<CompactionFileFilter> CreateDropFilesFilter(
+      const VersionStorageInfo* vstorage) const;
+
+  // Pick files that could be deleted without compaction according to the compaction file filter.
+  Compaction* PickCompactionUniversalDropFiles(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage, LogBuffer* log_buffer);
+
   // Pick Universal compaction to limit space amplification.
   Compaction* PickCompactionUniversalSizeAmp(
       const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
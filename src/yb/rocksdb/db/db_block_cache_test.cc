@@ -26,6 +26,8 @@
 #include "yb/rocksdb/port/stack_trace.h"
 
 DECLARE_double(cache_single_touch_ratio);
+DECLARE_bool(use_io_uring);
+DECLARE_bool(simulate_io_uring_unsupported);
 
 namespace rocksdb {
 
@@ -185,6 +187,50 @@ TEST_F(DBBlockCacheTest, TestWithoutCompressedBlockCache) {
   }
 }
 
+TEST_F(DBBlockCacheTest, ScanReadAhead) {
+  const size_t kNumKeys = 100;
+  auto table_options = GetTableOptions();
+  auto options = GetOptions(table_options);
+  std::string value(kValueSize, 'a');
+  for (size_t i = 0; i < kNumKeys; i++) {
+    ASSERT_OK(Put(ToString(i), value));
+  }
+  ASSERT_OK(Flush());
+
+  google::FlagSaver flag_saver;
+  // Batched blocking reads, batched reads through io_uring when the system supports it, and the
+  // fallback to blocking reads when it does not.
+  for (int mode = 0; mode < 6; mode++) {
+    const bool in_background = mode % 2 != 0;
+    FLAGS_use_io_uring = mode >= 2;
+    FLAGS_simulate_io_uring_unsupported = mode >= 4;
+    table_options.block_cache = NewLRUCache(1 << 20, 0, false);
+    options.table_factory.reset(new BlockBasedTableFactory(table_options));
+    Reopen(options);
+
+    ReadOptions read_options;
+    read_options.readahead_size = 1024;
+    read_options.readahead_in_background = in_background;
+    read_options.readahead_stats = std::make_shared<ReadAheadStats>();
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    size_t num_keys = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(value, iter->value().ToString());
+      ++num_keys;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(kNumKeys, num_keys);
+    iter.reset();
+
+    // Each key has its own data block, which is read either when the scan needs it or ahead of
+    // the scan. Once the scan is sequential most of them are read ahead.
+    const uint64_t blocks_read = read_options.readahead_stats->data_blocks_read;
+    const uint64_t blocks_prefetched = read_options.readahead_stats->data_blocks_prefetched;
+    ASSERT_EQ(kNumKeys, blocks_read + blocks_prefetched);
+    ASSERT_GT(blocks_prefetched, blocks_read);
+  }
+}
+
 #ifdef SNAPPY
 TEST_F(DBBlockCacheTest, TestWithCompressedBlockCache) {
   ReadOptions read_options;
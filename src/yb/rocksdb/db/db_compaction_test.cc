@@ -2196,6 +2196,46 @@ TEST_F(DBCompactionTest, FilesDeletedAfterCompaction) {
   } while (ChangeCompactOptions());
 }
 
+TEST_F(DBCompactionTest, CanceledManualCompaction) {
+  std::atomic<bool> canceled(false);
+  rocksdb::SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::BackgroundCompaction:NonTrivial",
+      [&](void* arg) { canceled.store(true); });
+
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+  for (int i = 0; i < 2; i++) {
+    ASSERT_OK(Put("a", "v" + std::to_string(i)));
+    ASSERT_OK(Put("z", "v" + std::to_string(i)));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ("2", FilesPerLevel(0));
+
+  CompactRangeOptions compact_options;
+  compact_options.canceled = &canceled;
+
+  // Canceled before it is scheduled.
+  canceled.store(true);
+  ASSERT_TRUE(db_->CompactRange(compact_options, nullptr, nullptr).IsShutdownInProgress());
+  ASSERT_EQ("2", FilesPerLevel(0));
+
+  // Canceled while running.
+  canceled.store(false);
+  rocksdb::SyncPoint::GetInstance()->EnableProcessing();
+  ASSERT_TRUE(db_->CompactRange(compact_options, nullptr, nullptr).IsShutdownInProgress());
+  rocksdb::SyncPoint::GetInstance()->DisableProcessing();
+  ASSERT_EQ("2", FilesPerLevel(0));
+  ASSERT_EQ("v1", Get("a"));
+
+  // The DB itself keeps working.
+  canceled.store(false);
+  ASSERT_OK(db_->CompactRange(compact_options, nullptr, nullptr));
+  ASSERT_EQ("0,1", FilesPerLevel(0));
+  ASSERT_EQ("v1", Get("z"));
+  rocksdb::SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 // Check level comapction with compact files
 TEST_P(DBCompactionTestWithParam, DISABLED_CompactFilesOnLevelCompaction) {
   const int kTestKeySize = 16;
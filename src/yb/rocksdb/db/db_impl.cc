@@ -83,6 +83,7 @@
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/merge_operator.h"
+#include "yb/rocksdb/persistent_cache.h"
 #include "yb/rocksdb/sst_file_writer.h"
 #include "yb/rocksdb/statistics.h"
 #include "yb/rocksdb/status.h"
@@ -125,6 +126,10 @@ namespace rocksdb {
 
 const char kDefaultColumnFamilyName[] = "default";
 
+// How often a canceled manual compaction that waits for other compactions notices that it was
+// canceled.
+constexpr uint64_t kManualCompactionCancelCheckIntervalUs = 100000;
+
 void DumpRocksDBBuildVersion(Logger* log);
 
 struct DBImpl::WriteContext {
@@ -836,6 +841,9 @@ void DBImpl::PurgeObsoleteFiles(const JobContext& state) {
       // evict from cache
       TableCache::Evict(table_cache_.get(), number);
       fname = TableFileName(db_options_.db_paths, number, path_id);
+      if (db_options_.persistent_cache) {
+        db_options_.persistent_cache->Erase(TableBaseToDataFileName(fname));
+      }
     } else {
       fname = ((type == kLogFile) ?
           db_options_.wal_dir : dbname_) + "/" + to_delete;
@@ -1717,7 +1725,8 @@ Status DBImpl::CompactRange(const CompactRangeOptions& options,
     // Always compact all files together.
     s = RunManualCompaction(cfd, ColumnFamilyData::kCompactAllLevels,
                             cfd->NumberLevels() - 1, options.target_path_id,
-                            begin, end, exclusive);
+                            begin, end, exclusive, false /* disallow_trivial_move */,
+                            options.canceled);
     final_output_level = cfd->NumberLevels() - 1;
   } else {
     for (int level = 0; level <= max_level_with_files; level++) {
@@ -1752,7 +1761,8 @@ Status DBImpl::CompactRange(const CompactRangeOptions& options,
         }
       }
       s = RunManualCompaction(cfd, level, output_level, options.target_path_id,
-                              begin, end, exclusive);
+                              begin, end, exclusive, false /* disallow_trivial_move */,
+                              options.canceled);
       if (!s.ok()) {
         break;
       }
@@ -2370,7 +2380,8 @@ SequenceNumber DBImpl::GetLatestSequenceNumber() const {
 Status DBImpl::RunManualCompaction(ColumnFamilyData* cfd, int input_level,
                                    int output_level, uint32_t output_path_id,
                                    const Slice* begin, const Slice* end,
-                                   bool exclusive, bool disallow_trivial_move) {
+                                   bool exclusive, bool disallow_trivial_move,
+                                   std::atomic<bool>* canceled) {
   assert(input_level == ColumnFamilyData::kCompactAllLevels ||
          input_level >= 0);
 
@@ -2389,6 +2400,18 @@ Status DBImpl::RunManualCompaction(ColumnFamilyData* cfd, int input_level,
   manual.incomplete = false;
   manual.exclusive = exclusive;
   manual.disallow_trivial_move = disallow_trivial_move;
+  manual.canceled = canceled;
+  // Nothing signals bg_cv_ when canceled is set, so wake up periodically to check it.
+  auto wait = [this, canceled] {
+    if (canceled == nullptr) {
+      bg_cv_.Wait();
+    } else {
+      bg_cv_.TimedWait(env_->NowMicros() + kManualCompactionCancelCheckIntervalUs);
+    }
+  };
+  auto is_canceled = [canceled] {
+    return canceled != nullptr && canceled->load(std::memory_order_acquire);
+  };
   // For universal compaction, we enforce every manual compaction to compact
   // all files.
   if (begin == nullptr ||
@@ -2429,15 +2452,15 @@ Status DBImpl::RunManualCompaction(ColumnFamilyData* cfd, int input_level,
   AddManualCompaction(&manual);
   TEST_SYNC_POINT_CALLBACK("DBImpl::RunManualCompaction:NotScheduled", &mutex_);
   if (exclusive) {
-    while (unscheduled_compactions_ + bg_compaction_scheduled_ > 0) {
+    while (unscheduled_compactions_ + bg_compaction_scheduled_ > 0 && !is_canceled()) {
       TEST_SYNC_POINT("DBImpl::RunManualCompaction()::Conflict");
       MaybeScheduleFlushOrCompaction();
-      while (bg_compaction_scheduled_ > 0) {
+      while (bg_compaction_scheduled_ > 0 && !is_canceled()) {
         RLOG(InfoLogLevel::INFO_LEVEL, db_options_.info_log,
              "[%s] Manual compaction waiting for all other scheduled background "
                  "compactions to finish",
              cfd->GetName().c_str());
-        bg_cv_.Wait();
+        wait();
       }
     }
   }
@@ -2451,6 +2474,12 @@ Status DBImpl::RunManualCompaction(ColumnFamilyData* cfd, int input_level,
   // true.
   while (!manual.done) {
     assert(HasPendingManualCompaction());
+    // Nothing of ours is queued or running at this point, so just give up.
+    if (!scheduled && !manual.in_progress && is_canceled()) {
+      manual.status = STATUS(ShutdownInProgress, "Manual compaction canceled");
+      manual.done = true;
+      break;
+    }
     manual_conflict = false;
     if (ShouldntRunManualCompaction(&manual) || (manual.in_progress == true) ||
         scheduled ||
@@ -2468,7 +2497,7 @@ Status DBImpl::RunManualCompaction(ColumnFamilyData* cfd, int input_level,
         TEST_SYNC_POINT("DBImpl::RunManualCompaction()::Conflict");
       }
       // Running either this or some other manual compaction
-      bg_cv_.Wait();
+      wait();
       if (scheduled && manual.incomplete == true) {
         assert(!manual.in_progress);
         scheduled = false;
@@ -3085,8 +3114,9 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
     // file if there is alive snapshot pointing to it
     assert(c->num_input_files(1) == 0);
     assert(c->level() == 0);
-    assert(c->column_family_data()->ioptions()->compaction_style ==
-           kCompactionStyleFIFO);
+    assert(c->column_family_data()->ioptions()->compaction_style == kCompactionStyleFIFO ||
+           c->column_family_data()->ioptions()->compaction_style ==
+               kCompactionStyleUniversal);
 
     compaction_job_stats.num_input_files = c->num_input_files(0);
 
@@ -3179,7 +3209,7 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
         table_cache_, &event_logger_,
         c->mutable_cf_options()->paranoid_file_checks,
         c->mutable_cf_options()->compaction_measure_io_stats, dbname_,
-        &compaction_job_stats);
+        &compaction_job_stats, is_manual ? manual_compaction->canceled : nullptr);
     compaction_job.Prepare();
 
     mutex_.Unlock();
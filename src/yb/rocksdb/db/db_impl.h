@@ -297,7 +297,8 @@ class DBImpl : public DB {
                              int output_level, uint32_t output_path_id,
                              const Slice* begin, const Slice* end,
                              bool exclusive,
-                             bool disallow_trivial_move = false);
+                             bool disallow_trivial_move = false,
+                             std::atomic<bool>* canceled = nullptr);
 
   // Return an internal iterator over the current state of the database.
   // The keys of this iterator are internal keys (see format.h).
@@ -847,6 +848,7 @@ class DBImpl : public DB {
     bool incomplete;              // only part of requested range compacted
     bool exclusive;               // current behavior of only one manual
     bool disallow_trivial_move;   // Force actual compaction to run
+    std::atomic<bool>* canceled;  // nullptr means not cancelable
     const InternalKey* begin;     // nullptr means beginning of key range
     const InternalKey* end;       // nullptr means end of key range
     InternalKey* manual_end;      // how far we are compacting
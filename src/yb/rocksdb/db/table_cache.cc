@@ -104,7 +104,8 @@ namespace {
 
 Status NewFileReader(const ImmutableCFOptions& ioptions, const EnvOptions& env_options,
     const std::string& fname, bool sequential_mode, bool record_read_stats,
-    HistogramImpl* file_read_hist, std::unique_ptr<RandomAccessFileReader>* file_reader) {
+    HistogramImpl* file_read_hist, std::unique_ptr<RandomAccessFileReader>* file_reader,
+    bool data_file = false) {
   unique_ptr<RandomAccessFile> file;
 
   Status s = ioptions.env->NewRandomAccessFile(fname, &file, env_options);
@@ -116,6 +117,11 @@ Status NewFileReader(const ImmutableCFOptions& ioptions, const EnvOptions& env_o
   if (sequential_mode && ioptions.compaction_readahead_size > 0) {
     file = NewReadaheadRandomAccessFile(std::move(file), ioptions.compaction_readahead_size);
   }
+  // Compaction inputs are read once, so don't let them push user reads out of the cache.
+  if (!sequential_mode && data_file && ioptions.persistent_cache) {
+    file = NewPersistentCacheRandomAccessFile(
+        std::move(file), ioptions.env, fname, ioptions.persistent_cache);
+  }
   if (!sequential_mode && ioptions.advise_random_on_open) {
     file->Hint(RandomAccessFile::RANDOM);
   }
@@ -159,7 +165,7 @@ Status TableCache::GetTableReader(
     const std::string data_fname = TableBaseToDataFileName(base_fname);
     std::unique_ptr<RandomAccessFileReader> data_file_reader;
     s = NewFileReader(ioptions_, env_options, data_fname, sequential_mode, record_read_stats,
-        file_read_hist, &data_file_reader);
+        file_read_hist, &data_file_reader, true /* data_file */);
     if (!s.ok()) {
       return s;
     }
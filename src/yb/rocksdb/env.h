@@ -449,6 +449,16 @@ class SequentialFile {
   }
 };
 
+// A request to read "n" bytes at "offset" into "scratch", for RandomAccessFile::MultiRead().
+// "result" and "status" are set like RandomAccessFile::Read() sets them.
+struct ReadRequest {
+  uint64_t offset = 0;
+  size_t n = 0;
+  char* scratch = nullptr;
+  Slice result;
+  Status status;
+};
+
 // A file abstraction for randomly reading the contents of a file.
 class RandomAccessFile : public File {
  public:
@@ -467,6 +477,13 @@ class RandomAccessFile : public File {
   virtual Status Read(uint64_t offset, size_t n, Slice* result,
                       char* scratch) const = 0;
 
+  // Performs each of the "num_requests" reads, like Read() does. Implementations may issue them
+  // concurrently, e.g. in one batched submission to the kernel. Returns the status of the first
+  // failed request, if any.
+  //
+  // Safe for concurrent use by multiple threads.
+  virtual Status MultiRead(ReadRequest* requests, size_t num_requests) const;
+
   // Used by the file_reader_writer to decide if the ReadAhead wrapper
   // should simply forward the call and do not enact buffering or locking.
   virtual bool ShouldForwardRawRequest() const {
@@ -119,6 +119,8 @@ struct ImmutableCFOptions {
   std::vector<std::shared_ptr<EventListener>> listeners;
 
   std::shared_ptr<Cache> row_cache;
+
+  std::shared_ptr<PersistentCache> persistent_cache;
 };
 
 }  // namespace rocksdb
@@ -26,6 +26,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <atomic>
 #include <string>
 #include <memory>
 #include <vector>
@@ -65,6 +66,7 @@ class Statistics;
 class InternalKeyComparator;
 class WalFilter;
 class MemoryMonitor;
+class PersistentCache;
 
 // DB contents are stored in a set of blocks, each of which holds a
 // sequence of key,value pairs.  Each block may be compressed before
@@ -1281,6 +1283,11 @@ struct DBOptions {
   // Not supported in ROCKSDB_LITE mode!
   std::shared_ptr<Cache> row_cache;
 
+  // A cache of SST data blocks on local persistent storage, consulted before reading a data block
+  // from the SST file. May be shared by several DBs.
+  // Default: nullptr (disabled)
+  std::shared_ptr<PersistentCache> persistent_cache;
+
 #ifndef ROCKSDB_LITE
   // A filter object supplied to be invoked while processing write-ahead-logs
   // (WALs) during recovery. The filter provides a way to inspect log
@@ -1367,6 +1374,14 @@ class TableAwareReadFileFilter {
   virtual ~TableAwareReadFileFilter() {}
 };
 
+// Numbers of data blocks read from disk by the iterators created with some ReadOptions.
+struct ReadAheadStats {
+  // Data blocks read because the iterator needed them.
+  std::atomic<uint64_t> data_blocks_read{0};
+  // Data blocks read ahead of the iterator.
+  std::atomic<uint64_t> data_blocks_prefetched{0};
+};
+
 // Options that control read operations
 struct ReadOptions {
   // If true, all data read from underlying storage will be
@@ -1466,6 +1481,22 @@ struct ReadOptions {
   // Query id designated for the read.
   QueryId query_id = kDefaultQueryId;
 
+  // If non-zero, a scan that moves sequentially through the data blocks of an SST file and has
+  // to read one of them from disk also reads the following data blocks, in one batched read
+  // (RandomAccessFile::MultiRead), and adds them to the block cache. The read-ahead window starts
+  // at two blocks and doubles with each read-ahead, up to this many bytes. Only used when the
+  // table has a block cache and fill_cache is set.
+  // Default: 0
+  size_t readahead_size = 0;
+
+  // With readahead_size, also prefetch the next read-ahead window on a background thread pool
+  // while the scan is reading the current one, instead of reading it when the scan gets there.
+  // Default: false
+  bool readahead_in_background = false;
+
+  // If set, counts the data blocks the iterators created with these options read from disk.
+  std::shared_ptr<ReadAheadStats> readahead_stats;
+
   // Filter for pruning SST files. RocksDB user can provide its own implementation to exclude SST
   // files from being added to MergeIterator. By default doesn't filter files.
   std::shared_ptr<TableAwareReadFileFilter> table_aware_file_filter;
@@ -1587,6 +1618,10 @@ struct CompactRangeOptions {
   // if there is a compaction filter
   BottommostLevelCompaction bottommost_level_compaction =
       BottommostLevelCompaction::kIfHaveCompactionFilter;
+  // If set, the compaction stops with ShutdownInProgress as soon as it notices
+  // the flag is true, whether it is still waiting to be scheduled or already
+  // running. Must outlive the CompactRange() call.
+  std::atomic<bool>* canceled = nullptr;
 };
 }  // namespace rocksdb
 
@@ -0,0 +1,79 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+#ifndef ROCKSDB_INCLUDE_ROCKSDB_PERSISTENT_CACHE_H
+#define ROCKSDB_INCLUDE_ROCKSDB_PERSISTENT_CACHE_H
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "yb/rocksdb/status.h"
+#include "yb/util/slice.h"
+
+namespace rocksdb {
+
+class Env;
+class RandomAccessFile;
+
+// A cache of SST data blocks kept on local persistent storage, e.g. a local SSD in front of data
+// directories on network attached storage. A block is identified by the name of the SST data file
+// it was read from, which contains the DB directory and the file number, and by its offset in that
+// file, so one cache may be shared by several DBs. Blocks are only served for the same file id,
+// see PersistentCacheFileId(), so a file written again under the same name, e.g. when a tablet
+// is deleted and remote bootstrapped again, does not get blocks of the old one. It is safe for
+// concurrent use.
+class PersistentCache {
+ public:
+  virtual ~PersistentCache() {}
+
+  // Copies the n bytes cached at offset of file_name to scratch. Returns false if they are not
+  // cached for file_id.
+  virtual bool Lookup(const std::string& file_name, const std::string& file_id, uint64_t offset,
+                      size_t n, char* scratch) = 0;
+
+  // Caches data that was read at offset of file_name. The data is written to the cache in the
+  // background, or dropped if too much of it is waiting to be written.
+  virtual void Insert(const std::string& file_name, const std::string& file_id, uint64_t offset,
+                      const Slice& data) = 0;
+
+  // Waits until the data passed to Insert() before is written to the cache or dropped.
+  virtual void WaitForInserts() = 0;
+
+  // Drops everything cached for file_name. Invoked when the file is deleted.
+  virtual void Erase(const std::string& file_name) = 0;
+
+  // Drops everything cached for the files in dir. Invoked when a whole DB directory is deleted.
+  virtual void EraseDirectory(const std::string& dir) = 0;
+
+  // Returns the number of bytes the cache currently uses on disk.
+  virtual size_t GetUsage() const = 0;
+
+  virtual size_t GetCapacity() const = 0;
+};
+
+// Returns the id of the contents of file_name opened as file: its inode, as returned by
+// RandomAccessFile::GetUniqueId(), size and modification time. Returns an empty string if the file
+// can't be identified, blocks of such files are not cached.
+std::string PersistentCacheFileId(Env* env, const std::string& file_name,
+                                  const RandomAccessFile& file);
+
+// Creates a persistent cache that keeps blocks in files under dir and uses at most capacity bytes
+// there. Blocks cached in dir by a previous instance are reused, except those of SST files that
+// no longer exist or have a different file id now.
+Status NewFilePersistentCache(Env* env, const std::string& dir, size_t capacity,
+                              std::shared_ptr<PersistentCache>* cache);
+
+}  // namespace rocksdb
+
+#endif // ROCKSDB_INCLUDE_ROCKSDB_PERSISTENT_CACHE_H
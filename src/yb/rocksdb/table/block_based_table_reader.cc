@@ -23,10 +23,16 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <condition_variable>
+#include <limits>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 #include <cinttypes>
 
+#include <gflags/gflags.h>
+
 #include "yb/rocksdb/db/dbformat.h"
 
 #include "yb/rocksdb/cache.h"
@@ -58,11 +64,16 @@
 #include "yb/rocksdb/util/perf_context_imp.h"
 #include "yb/rocksdb/util/stop_watch.h"
 #include "yb/rocksdb/util/string_util.h"
+#include "yb/rocksdb/util/thread_posix.h"
 
 #include "yb/gutil/macros.h"
 #include "yb/util/logging.h"
 #include "yb/util/atomic.h"
 
+DEFINE_int32(rocksdb_prefetch_threads, 2,
+             "Number of threads that prefetch data blocks ahead of scans reading with "
+             "ReadOptions::readahead_in_background.");
+
 namespace rocksdb {
 
 extern const uint64_t kBlockBasedTableMagicNumber;
@@ -81,6 +92,17 @@ namespace {
 const size_t kMaxCacheKeyPrefixSize __attribute__((unused)) =
     kMaxVarint64Length * 3 + 1;
 
+// Thread pool the data blocks read ahead of scans in the background are read on.
+ThreadPool* PrefetchThreadPool() {
+  static ThreadPool* pool = [] {
+    auto result = new ThreadPool();
+    result->SetHostEnv(Env::Default());
+    result->SetBackgroundThreads(FLAGS_rocksdb_prefetch_threads);
+    return result;
+  }();
+  return pool;
+}
+
 // Read the block identified by "handle" from "file".
 // The only relevant option is options.verify_checksums for now.
 // On failure return non-OK.
@@ -1286,6 +1308,9 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(
             rep->footer, ro, handle, &raw_block, rep->ioptions.env,
             block_cache_compressed == nullptr);
       }
+      if (ro.readahead_stats) {
+        ro.readahead_stats->data_blocks_read.fetch_add(1, std::memory_order_relaxed);
+      }
 
       if (s.ok()) {
         s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
@@ -1309,6 +1334,9 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(
     std::unique_ptr<Block> block_value;
     s = ReadBlockFromFile(rep->data_reader_with_cache_prefix->reader.get(), rep->footer, ro, handle,
                           &block_value, rep->ioptions.env);
+    if (ro.readahead_stats) {
+      ro.readahead_stats->data_blocks_read.fetch_add(1, std::memory_order_relaxed);
+    }
     if (s.ok()) {
       block.value = block_value.release();
     }
@@ -1344,10 +1372,39 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         read_options_(read_options),
         skip_filters_(skip_filters) {}
 
+  ~BlockEntryIteratorState() {
+    if (read_options_.readahead_in_background) {
+      // The prefetch refers to this state, so it has to finish or be unscheduled first.
+      PrefetchThreadPool()->UnSchedule(this);
+      WaitForPrefetch();
+    }
+  }
+
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
+    last_block_end_ = std::numeric_limits<uint64_t>::max();
     return NewDataBlockIterator(table_->rep_, read_options_, index_value);
   }
 
+  InternalIterator* NewForwardSecondaryIterator(InternalIterator* index_iter) override {
+    if (read_options_.readahead_size > 0) {
+      BlockHandle handle;
+      Slice input = index_iter->value();
+      if (handle.DecodeFrom(&input).ok()) {
+        // The access is sequential when the block follows the one read before it.
+        const bool sequential = handle.offset() == last_block_end_;
+        last_block_end_ = handle.offset() + handle.size() + kBlockTrailerSize;
+        if (sequential) {
+          MaybeReadAhead(index_iter->key(), handle);
+        } else {
+          readahead_window_ = 0;
+          readahead_end_ = 0;
+          next_readahead_key_.clear();
+        }
+      }
+    }
+    return NewDataBlockIterator(table_->rep_, read_options_, index_iter->value());
+  }
+
   bool PrefixMayMatch(const Slice& internal_key) override {
     if (read_options_.total_order_seek || skip_filters_) {
       return true;
@@ -1356,10 +1413,228 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   }
 
  private:
+  bool InBlockCache(Cache* block_cache, const BlockHandle& handle) {
+    char cache_key[kMaxCacheKeyPrefixSize + kMaxVarint64Length];
+    auto key = GetCacheKey(
+        table_->rep_->data_reader_with_cache_prefix->cache_key_prefix, handle, cache_key);
+    auto cache_handle = block_cache->Lookup(key, read_options_.query_id);
+    if (cache_handle == nullptr) {
+      return false;
+    }
+    block_cache->Release(cache_handle);
+    return true;
+  }
+
+  // Called when a scan sequentially moves on to the data block at "handle". When the block is not
+  // cached, reads it together with the following uncached data blocks in one batched read and adds
+  // them to the block cache. The read-ahead window starts at two blocks and doubles each time,
+  // up to read_options_.readahead_size bytes. With readahead_in_background, the next window is
+  // prefetched on the prefetch thread pool as soon as the scan enters the current one.
+  void MaybeReadAhead(const Slice& index_key, const BlockHandle& handle) {
+    Cache* block_cache = table_->rep_->table_options.block_cache.get();
+    if (block_cache == nullptr || !read_options_.fill_cache ||
+        read_options_.read_tier == kBlockCacheTier) {
+      return;
+    }
+
+    if (handle.offset() < readahead_end_) {
+      if (!read_options_.readahead_in_background) {
+        return;
+      }
+      std::unique_lock<std::mutex> lock(prefetch_mutex_);
+      if (prefetch_pending_) {
+        if (handle.offset() >= prefetch_begin_) {
+          lock.unlock();
+          // Reached the blocks being prefetched. When the prefetch is still queued behind the ones
+          // of other scans, take it back and read the blocks here instead of waiting for a prefetch
+          // thread. Otherwise wait for it instead of reading the blocks again.
+          if (PrefetchThreadPool()->UnSchedule(this) > 0) {
+            if (ReadAndCacheBlocks(prefetch_handles_.data(), prefetch_handles_.size()).ok()) {
+              CountReadAhead(prefetch_handles_.size());
+            }
+          } else {
+            WaitForPrefetch();
+          }
+        }
+        return;
+      }
+      lock.unlock();
+      if (handle.offset() >= window_begin_ && !next_readahead_key_.empty()) {
+        const std::string start_key = next_readahead_key_;
+        Prefetch(start_key);
+      }
+      return;
+    }
+
+    if (InBlockCache(block_cache, handle)) {
+      return;
+    }
+    std::vector<BlockHandle> handles;
+    CollectHandles(index_key, NextWindow(handle.size() + kBlockTrailerSize), &handles);
+    if (handles.size() < 2 || handles.front().offset() != handle.offset()) {
+      // Nothing to batch, the block is read by the regular path.
+      return;
+    }
+    if (!ReadAndCacheBlocks(handles.data(), handles.size()).ok()) {
+      // The regular read of the block reports the error.
+      return;
+    }
+    CountReadAhead(handles.size());
+  }
+
+  // Counts the blocks read by the scan itself in one batch. The first block is the one the scan
+  // needs, only the others are read ahead.
+  void CountReadAhead(size_t num_blocks) {
+    if (read_options_.readahead_stats) {
+      read_options_.readahead_stats->data_blocks_read.fetch_add(1, std::memory_order_relaxed);
+      read_options_.readahead_stats->data_blocks_prefetched.fetch_add(
+          num_blocks - 1, std::memory_order_relaxed);
+    }
+  }
+
+  size_t NextWindow(size_t block_size) {
+    readahead_window_ = std::min(
+        std::max(readahead_window_ * 2, block_size * 2), read_options_.readahead_size);
+    return readahead_window_;
+  }
+
+  // Collects the handles of the data blocks starting at the index entry for "start_key" and
+  // following it, up to "window" bytes in total, skipping the following blocks that are already
+  // cached.
+  void CollectHandles(const Slice& start_key, size_t window, std::vector<BlockHandle>* handles) {
+    // Walk the index with a separate index iterator, so the one of the scan is not moved.
+    if (!readahead_index_iter_) {
+      readahead_index_iter_.reset(table_->NewIndexIterator(read_options_));
+    }
+    Cache* block_cache = table_->rep_->table_options.block_cache.get();
+    size_t total_size = 0;
+    for (readahead_index_iter_->Seek(start_key);
+         readahead_index_iter_->Valid() && total_size < window;
+         readahead_index_iter_->Next()) {
+      BlockHandle next;
+      Slice input = readahead_index_iter_->value();
+      if (!next.DecodeFrom(&input).ok()) {
+        break;
+      }
+      if (!handles->empty() && InBlockCache(block_cache, next)) {
+        continue;
+      }
+      handles->push_back(next);
+      total_size += next.size() + kBlockTrailerSize;
+    }
+    if (readahead_index_iter_->Valid() && total_size >= window) {
+      next_readahead_key_.assign(
+          readahead_index_iter_->key().cdata(), readahead_index_iter_->key().size());
+    } else {
+      next_readahead_key_.clear();
+    }
+    if (!handles->empty()) {
+      window_begin_ = handles->front().offset();
+      readahead_end_ = handles->back().offset() + handles->back().size() + kBlockTrailerSize;
+    }
+  }
+
+  // Schedules a prefetch of the next read-ahead window, starting at the index entry for
+  // "start_key", on the prefetch thread pool.
+  void Prefetch(const Slice& start_key) {
+    prefetch_handles_.clear();
+    CollectHandles(start_key, NextWindow(0), &prefetch_handles_);
+    if (prefetch_handles_.empty()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(prefetch_mutex_);
+      prefetch_pending_ = true;
+      prefetch_begin_ = prefetch_handles_.front().offset();
+    }
+    PrefetchThreadPool()->Schedule(&BlockEntryIteratorState::RunPrefetch, this, this,
+                                   &BlockEntryIteratorState::PrefetchDone);
+  }
+
+  static void RunPrefetch(void* arg) {
+    auto state = static_cast<BlockEntryIteratorState*>(arg);
+    if (state->ReadAndCacheBlocks(
+            state->prefetch_handles_.data(), state->prefetch_handles_.size()).ok() &&
+        state->read_options_.readahead_stats) {
+      state->read_options_.readahead_stats->data_blocks_prefetched.fetch_add(
+          state->prefetch_handles_.size(), std::memory_order_relaxed);
+    }
+    PrefetchDone(arg);
+  }
+
+  static void PrefetchDone(void* arg) {
+    auto state = static_cast<BlockEntryIteratorState*>(arg);
+    std::lock_guard<std::mutex> lock(state->prefetch_mutex_);
+    state->prefetch_pending_ = false;
+    state->prefetch_cond_.notify_all();
+  }
+
+  void WaitForPrefetch() {
+    std::unique_lock<std::mutex> lock(prefetch_mutex_);
+    prefetch_cond_.wait(lock, [this] { return !prefetch_pending_; });
+  }
+
+  // Reads the given data blocks with one batched read and adds them to the block cache.
+  Status ReadAndCacheBlocks(const BlockHandle* handles, size_t num_blocks) {
+    Rep* rep = table_->rep_;
+    Cache* block_cache = rep->table_options.block_cache.get();
+    Cache* block_cache_compressed = rep->table_options.block_cache_compressed.get();
+    std::vector<BlockContents> contents(num_blocks);
+    {
+      StopWatch sw(rep->ioptions.env, rep->ioptions.statistics, READ_BLOCK_GET_MICROS);
+      RETURN_NOT_OK(ReadBlockContentsBatch(
+          rep->data_reader_with_cache_prefix->reader.get(), rep->footer, read_options_,
+          handles, num_blocks, contents.data(), block_cache_compressed == nullptr));
+    }
+    for (size_t i = 0; i < num_blocks; ++i) {
+      char cache_key[kMaxCacheKeyPrefixSize + kMaxVarint64Length];
+      char compressed_cache_key[kMaxCacheKeyPrefixSize + kMaxVarint64Length];
+      Slice key = GetCacheKey(
+          rep->data_reader_with_cache_prefix->cache_key_prefix, handles[i], cache_key);
+      Slice ckey;
+      if (block_cache_compressed != nullptr) {
+        ckey = GetCacheKey(rep->data_reader_with_cache_prefix->compressed_cache_key_prefix,
+                           handles[i], compressed_cache_key);
+      }
+      CachableEntry<Block> block;
+      Status s = PutDataBlockToCache(
+          key, ckey, block_cache, block_cache_compressed, read_options_, rep->ioptions.statistics,
+          &block, new Block(std::move(contents[i])), rep->table_options.format_version);
+      if (block.cache_handle != nullptr) {
+        block_cache->Release(block.cache_handle);
+      } else {
+        delete block.value;
+      }
+      RETURN_NOT_OK(s);
+    }
+    return Status::OK();
+  }
+
   // Don't own table_
   BlockBasedTable* table_;
   const ReadOptions read_options_;
   bool skip_filters_;
+
+  // End offset of the data block the iterator moved to last, used to detect sequential access.
+  uint64_t last_block_end_ = std::numeric_limits<uint64_t>::max();
+  // Size of the last read-ahead window, 0 when the access is not sequential.
+  size_t readahead_window_ = 0;
+  // Index iterator used to find the blocks to read ahead, created on the first read-ahead.
+  std::unique_ptr<InternalIterator> readahead_index_iter_;
+  // Offsets of the first block and of the end of the last read-ahead window.
+  uint64_t window_begin_ = 0;
+  uint64_t readahead_end_ = 0;
+  // Index key of the first block after the last read-ahead window, empty if the window reached
+  // the end of the table.
+  std::string next_readahead_key_;
+
+  // Blocks of the prefetch scheduled on the prefetch thread pool.
+  std::vector<BlockHandle> prefetch_handles_;
+  std::mutex prefetch_mutex_;
+  std::condition_variable prefetch_cond_;
+  bool prefetch_pending_ = false;
+  // Offset of the first block the pending prefetch reads.
+  uint64_t prefetch_begin_ = 0;
 };
 
 // This will be broken if the user specifies an unusual implementation
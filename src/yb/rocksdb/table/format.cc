@@ -26,6 +26,7 @@
 #include <inttypes.h>
 
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/table/block.h"
@@ -261,6 +262,32 @@ Status ReadFooterFromFile(RandomAccessFileReader* file, uint64_t file_size,
 // Without anonymous namespace here, we fail the warning -Wmissing-prototypes
 namespace {
 
+// Check the crc of the type and the block contents of a block of n bytes read into data.
+Status VerifyBlockChecksum(const Footer& footer, const ReadOptions& options, const char* data,
+                           size_t n) {
+  Status s;
+  if (options.verify_checksums) {
+    PERF_TIMER_GUARD(block_checksum_time);
+    uint32_t value = DecodeFixed32(data + n + 1);
+    uint32_t actual = 0;
+    switch (footer.checksum()) {
+      case kCRC32c:
+        value = crc32c::Unmask(value);
+        actual = crc32c::Value(data, n + 1);
+        break;
+      case kxxHash:
+        actual = XXH32(data, static_cast<int>(n) + 1, 0);
+        break;
+      default:
+        s = STATUS(Corruption, "unknown checksum type");
+    }
+    if (s.ok() && actual != value) {
+      s = STATUS(Corruption, "block checksum mismatch");
+    }
+  }
+  return s;
+}
+
 // Read a block and check its CRC
 // contents is the result of reading.
 // According to the implementation of file->Read, contents may not point to buf
@@ -285,31 +312,7 @@ Status ReadBlock(RandomAccessFileReader* file, const Footer& footer,
     return STATUS(Corruption, "truncated block read");
   }
 
-  // Check the crc of the type and the block contents
-  const char* data = contents->cdata();  // Pointer to where Read put the data
-  if (options.verify_checksums) {
-    PERF_TIMER_GUARD(block_checksum_time);
-    uint32_t value = DecodeFixed32(data + n + 1);
-    uint32_t actual = 0;
-    switch (footer.checksum()) {
-      case kCRC32c:
-        value = crc32c::Unmask(value);
-        actual = crc32c::Value(data, n + 1);
-        break;
-      case kxxHash:
-        actual = XXH32(data, static_cast<int>(n) + 1, 0);
-        break;
-      default:
-        s = STATUS(Corruption, "unknown checksum type");
-    }
-    if (s.ok() && actual != value) {
-      s = STATUS(Corruption, "block checksum mismatch");
-    }
-    if (!s.ok()) {
-      return s;
-    }
-  }
-  return s;
+  return VerifyBlockChecksum(footer, options, contents->cdata(), n);
 }
 
 }  // namespace
@@ -364,6 +367,49 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
   return status;
 }
 
+Status ReadBlockContentsBatch(RandomAccessFileReader* file, const Footer& footer,
+                              const ReadOptions& options, const BlockHandle* handles,
+                              size_t num_blocks, BlockContents* contents,
+                              bool decompression_requested) {
+  std::vector<std::unique_ptr<char[]>> bufs(num_blocks);
+  std::vector<ReadRequest> requests(num_blocks);
+  for (size_t i = 0; i < num_blocks; ++i) {
+    const size_t n = static_cast<size_t>(handles[i].size());
+    bufs[i].reset(new char[n + kBlockTrailerSize]);
+    requests[i].offset = handles[i].offset();
+    requests[i].n = n + kBlockTrailerSize;
+    requests[i].scratch = bufs[i].get();
+  }
+
+  {
+    PERF_TIMER_GUARD(block_read_time);
+    RETURN_NOT_OK(file->MultiRead(requests.data(), num_blocks));
+  }
+
+  for (size_t i = 0; i < num_blocks; ++i) {
+    const size_t n = static_cast<size_t>(handles[i].size());
+    const Slice& slice = requests[i].result;
+    PERF_COUNTER_ADD(block_read_count, 1);
+    PERF_COUNTER_ADD(block_read_byte, n + kBlockTrailerSize);
+    if (slice.size() != n + kBlockTrailerSize) {
+      return STATUS(Corruption, "truncated block read");
+    }
+    RETURN_NOT_OK(VerifyBlockChecksum(footer, options, slice.cdata(), n));
+
+    PERF_TIMER_GUARD(block_decompress_time);
+    const auto compression_type = static_cast<rocksdb::CompressionType>(slice.data()[n]);
+    if (decompression_requested && compression_type != kNoCompression) {
+      RETURN_NOT_OK(UncompressBlockContents(slice.cdata(), n, &contents[i], footer.version()));
+      continue;
+    }
+    if (slice.cdata() != bufs[i].get()) {
+      memcpy(bufs[i].get(), slice.cdata(), n);
+    }
+    contents[i] = BlockContents(std::move(bufs[i]), n, true, compression_type);
+  }
+  return Status::OK();
+}
+
 //
 // The 'data' points to the raw block contents that was read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -226,6 +226,17 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
                                 BlockContents* contents, Env* env,
                                 bool do_uncompress);
 
+// Read the blocks identified by "handles" from "file" with one batched read
+// (RandomAccessFile::MultiRead) and fill contents[i] for each of them. On failure
+// return non-OK.
+extern Status ReadBlockContentsBatch(RandomAccessFileReader* file,
+                                     const Footer& footer,
+                                     const ReadOptions& options,
+                                     const BlockHandle* handles,
+                                     size_t num_blocks,
+                                     BlockContents* contents,
+                                     bool do_uncompress);
+
 // The 'data' points to the raw block contents read in from file.
 // This method allocates a new heap buffer and the raw block
 // contents are uncompresed into this buffer. This buffer is
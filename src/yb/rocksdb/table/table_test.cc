@@ -55,7 +55,10 @@
 #include "yb/rocksdb/table/meta_blocks.h"
 #include "yb/rocksdb/table/plain_table_factory.h"
 #include "yb/rocksdb/table/scoped_arena_iterator.h"
+#include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/compression.h"
+#include "yb/rocksdb/util/crc32c.h"
+#include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/random.h"
 #include "yb/rocksdb/util/statistics.h"
 #include "yb/rocksdb/util/string_util.h"
@@ -63,6 +66,8 @@
 #include "yb/rocksdb/util/testutil.h"
 
 DECLARE_double(cache_single_touch_ratio);
+DECLARE_bool(use_io_uring);
+DECLARE_bool(simulate_io_uring_unsupported);
 
 namespace rocksdb {
 
@@ -1199,6 +1204,64 @@ TEST_F(BlockBasedTableTest, PrefetchTest) {
                 STATUS(InvalidArgument, Slice("k06 "), Slice("k07")));
 }
 
+TEST_F(BlockBasedTableTest, ReadBlockContentsBatch) {
+  // Write uncompressed blocks of different sizes, each followed by its trailer.
+  Env* env = Env::Default();
+  const std::string fname = test::TmpDir() + "/read_block_contents_batch";
+  std::vector<std::string> blocks;
+  std::vector<BlockHandle> handles;
+  std::string file_data;
+  for (size_t i = 0; i < 10; i++) {
+    blocks.push_back(std::string(100 + i * 1000, 'a' + i));
+    handles.emplace_back(file_data.size(), blocks.back().size());
+    file_data += blocks.back();
+    file_data.push_back(kNoCompression);
+    char trailer[4];
+    EncodeFixed32(trailer, crc32c::Mask(crc32c::Value(
+        file_data.data() + handles.back().offset(), blocks.back().size() + 1)));
+    file_data.append(trailer, sizeof(trailer));
+  }
+  {
+    unique_ptr<WritableFile> file;
+    ASSERT_OK(env->NewWritableFile(fname, &file, EnvOptions()));
+    ASSERT_OK(file->Append(file_data));
+    ASSERT_OK(file->Close());
+  }
+
+  google::FlagSaver flag_saver;
+  Footer footer(kBlockBasedTableMagicNumber, 0);
+  ReadOptions read_options;
+  // Blocking reads, reads through io_uring when the system supports it, and the fallback to
+  // blocking reads when it does not.
+  for (int mode = 0; mode < 3; mode++) {
+    FLAGS_use_io_uring = mode != 0;
+    FLAGS_simulate_io_uring_unsupported = mode == 2;
+    unique_ptr<RandomAccessFile> file;
+    ASSERT_OK(env->NewRandomAccessFile(fname, &file, EnvOptions()));
+    RandomAccessFileReader reader(std::move(file));
+
+    std::vector<BlockContents> contents(handles.size());
+    ASSERT_OK(ReadBlockContentsBatch(&reader, footer, read_options, handles.data(),
+                                     handles.size(), contents.data(), true /* do_uncompress */));
+    for (size_t i = 0; i < handles.size(); i++) {
+      ASSERT_EQ(blocks[i], contents[i].data.ToString()) << i;
+      ASSERT_EQ(kNoCompression, contents[i].compression_type);
+    }
+
+    // A block whose checksum does not match.
+    BlockHandle shifted(handles[1].offset() + 1, handles[1].size());
+    ASSERT_TRUE(ReadBlockContentsBatch(&reader, footer, read_options, &shifted, 1,
+                                       contents.data(), true).IsCorruption());
+
+    // A block past the end of the file.
+    BlockHandle truncated(file_data.size() - 10, handles[0].size());
+    BlockHandle batch[] = {handles[0], truncated};
+    ASSERT_TRUE(ReadBlockContentsBatch(&reader, footer, read_options, batch, 2,
+                                       contents.data(), true).IsCorruption());
+  }
+  ASSERT_OK(env->DeleteFile(fname));
+}
+
 TEST_F(BlockBasedTableTest, TotalOrderSeekOnHashIndex) {
   BlockBasedTableOptions table_options;
   for (int i = 0; i < 5; ++i) {
@@ -92,7 +92,8 @@ class TwoLevelIterator : public InternalIterator {
   void SkipEmptyDataBlocksForward();
   void SkipEmptyDataBlocksBackward();
   void SetSecondLevelIterator(InternalIterator* iter);
-  void InitDataBlock();
+  // forward is true when the iterator moves forward to the block.
+  void InitDataBlock(bool forward = false);
 
   TwoLevelIteratorState* state_;
   IteratorWrapper first_level_iter_;
@@ -119,7 +120,7 @@ void TwoLevelIterator::Seek(const Slice& target) {
   }
   first_level_iter_.Seek(target);
 
-  InitDataBlock();
+  InitDataBlock(true /* forward */);
   if (second_level_iter_.iter() != nullptr) {
     second_level_iter_.Seek(target);
   }
@@ -128,7 +129,7 @@ void TwoLevelIterator::Seek(const Slice& target) {
 
 void TwoLevelIterator::SeekToFirst() {
   first_level_iter_.SeekToFirst();
-  InitDataBlock();
+  InitDataBlock(true /* forward */);
   if (second_level_iter_.iter() != nullptr) {
     second_level_iter_.SeekToFirst();
   }
@@ -167,7 +168,7 @@ void TwoLevelIterator::SkipEmptyDataBlocksForward() {
       return;
     }
     first_level_iter_.Next();
-    InitDataBlock();
+    InitDataBlock(true /* forward */);
     if (second_level_iter_.iter() != nullptr) {
       second_level_iter_.SeekToFirst();
     }
@@ -198,7 +199,7 @@ void TwoLevelIterator::SetSecondLevelIterator(InternalIterator* iter) {
   second_level_iter_.Set(iter);
 }
 
-void TwoLevelIterator::InitDataBlock() {
+void TwoLevelIterator::InitDataBlock(bool forward) {
   if (!first_level_iter_.Valid()) {
     SetSecondLevelIterator(nullptr);
   } else {
@@ -209,7 +210,9 @@ void TwoLevelIterator::InitDataBlock() {
       // second_level_iter is already constructed with this iterator, so
       // no need to change anything
     } else {
-      InternalIterator* iter = state_->NewSecondaryIterator(handle);
+      InternalIterator* iter = forward
+          ? state_->NewForwardSecondaryIterator(first_level_iter_.iter())
+          : state_->NewSecondaryIterator(handle);
       data_block_handle_.assign(handle.cdata(), handle.size());
       SetSecondLevelIterator(iter);
     }
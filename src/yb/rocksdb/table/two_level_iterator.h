@@ -38,6 +38,14 @@ struct TwoLevelIteratorState {
 
   virtual ~TwoLevelIteratorState() {}
   virtual InternalIterator* NewSecondaryIterator(const Slice& handle) = 0;
+
+  // Called instead of NewSecondaryIterator when the iterator moves forward to a block (Seek,
+  // SeekToFirst or Next), with first_level_iter positioned at the index entry of that block. Lets
+  // the state detect sequential scans and read ahead the blocks that follow.
+  virtual InternalIterator* NewForwardSecondaryIterator(InternalIterator* first_level_iter) {
+    return NewSecondaryIterator(first_level_iter->value());
+  }
+
   virtual bool PrefixMayMatch(const Slice& internal_key) = 0;
 
   // If call PrefixMayMatch()
@@ -382,6 +382,9 @@ DEFINE_int32(new_table_reader_for_compaction_inputs, true,
 
 DEFINE_int32(compaction_readahead_size, 0, "Compaction readahead size");
 
+DEFINE_int32(scan_readahead_size, 0, "Number of bytes of data blocks a sequential read reads "
+             "ahead in one batched read (see also --use_io_uring)");
+
 DEFINE_int32(random_access_max_buffer_size, 1024 * 1024,
              "Maximum windows randomaccess buffer size");
 
@@ -2907,6 +2910,7 @@ class Benchmark {
   void ReadSequential(ThreadState* thread, DB* db) {
     ReadOptions options(FLAGS_verify_checksum, true);
     options.tailing = FLAGS_use_tailing_iterator;
+    options.readahead_size = FLAGS_scan_readahead_size;
 
     Iterator* iter = db->NewIterator(options);
     int64_t i = 0;
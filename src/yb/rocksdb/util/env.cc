@@ -84,6 +84,18 @@ SequentialFile::~SequentialFile() {
 RandomAccessFile::~RandomAccessFile() {
 }
 
+Status RandomAccessFile::MultiRead(ReadRequest* requests, size_t num_requests) const {
+  Status result;
+  for (size_t i = 0; i < num_requests; ++i) {
+    ReadRequest& request = requests[i];
+    request.status = Read(request.offset, request.n, &request.result, request.scratch);
+    if (result.ok() && !request.status.ok()) {
+      result = request.status;
+    }
+  }
+  return result;
+}
+
 WritableFile::~WritableFile() {
 }
 
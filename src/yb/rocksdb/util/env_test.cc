@@ -26,10 +26,14 @@
 #endif
 #include <sys/types.h>
 
+#include <algorithm>
 #include <iostream>
 #include <unordered_set>
 #include <atomic>
 #include <list>
+#include <vector>
+
+#include <gflags/gflags.h>
 
 #ifdef OS_LINUX
 #include <fcntl.h>
@@ -52,6 +56,9 @@
 #include "yb/rocksdb/util/testharness.h"
 #include "yb/rocksdb/util/testutil.h"
 
+DECLARE_bool(use_io_uring);
+DECLARE_bool(simulate_io_uring_unsupported);
+
 namespace rocksdb {
 
 namespace {
@@ -811,6 +818,53 @@ TEST_F(EnvPosixTest, InvalidateCache) {
 #endif  // not TRAVIS
 #endif  // OS_LINUX
 
+TEST_F(EnvPosixTest, MultiRead) {
+  const EnvOptions soptions;
+  const std::string fname = test::TmpDir() + "/multi_read_file";
+  std::string data;
+  for (int i = 0; data.size() < 100000; i++) {
+    data += ToString(i);
+  }
+  {
+    unique_ptr<WritableFile> wfile;
+    ASSERT_OK(env_->NewWritableFile(fname, &wfile, soptions));
+    ASSERT_OK(wfile->Append(data));
+    ASSERT_OK(wfile->Close());
+  }
+
+  google::FlagSaver flag_saver;
+  // Blocking reads, reads through io_uring when the system supports it, and the fallback to
+  // blocking reads when it does not.
+  for (int mode = 0; mode < 3; mode++) {
+    FLAGS_use_io_uring = mode != 0;
+    FLAGS_simulate_io_uring_unsupported = mode == 2;
+    unique_ptr<RandomAccessFile> file;
+    ASSERT_OK(env_->NewRandomAccessFile(fname, &file, soptions));
+
+    // More reads than an io_uring ring holds, including one at the end of the file and one past
+    // it.
+    const size_t kNumRequests = 200;
+    const size_t kReadSize = 1000;
+    std::vector<std::string> buffers(kNumRequests, std::string(kReadSize, '\0'));
+    std::vector<ReadRequest> requests(kNumRequests);
+    for (size_t i = 0; i < kNumRequests; i++) {
+      requests[i].offset = (i * 7919) % (data.size() - kReadSize);
+      requests[i].n = kReadSize;
+      requests[i].scratch = &buffers[i][0];
+    }
+    requests[kNumRequests - 2].offset = data.size() - kReadSize / 2;
+    requests[kNumRequests - 1].offset = data.size() + kReadSize;
+    ASSERT_OK(file->MultiRead(requests.data(), requests.size()));
+
+    for (size_t i = 0; i < kNumRequests; i++) {
+      ASSERT_OK(requests[i].status);
+      const size_t offset = std::min<size_t>(requests[i].offset, data.size());
+      ASSERT_EQ(data.substr(offset, kReadSize), requests[i].result.ToString()) << i;
+    }
+  }
+  ASSERT_OK(env_->DeleteFile(fname));
+}
+
 class TestLogger : public Logger {
  public:
   using Logger::Logv;
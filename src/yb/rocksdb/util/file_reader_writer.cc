@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <mutex>
 
+#include "yb/rocksdb/persistent_cache.h"
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/util/histogram.h"
 #include "yb/rocksdb/util/iostats_context_imp.h"
@@ -60,6 +61,24 @@ Status RandomAccessFileReader::Read(uint64_t offset, size_t n, Slice* result,
   return s;
 }
 
+Status RandomAccessFileReader::MultiRead(ReadRequest* requests, size_t num_requests) const {
+  Status s;
+  uint64_t elapsed = 0;
+  {
+    StopWatch sw(env_, stats_, hist_type_,
+                 (stats_ != nullptr) ? &elapsed : nullptr);
+    IOSTATS_TIMER_GUARD(read_nanos);
+    s = file_->MultiRead(requests, num_requests);
+    for (size_t i = 0; i < num_requests; ++i) {
+      IOSTATS_ADD_IF_POSITIVE(bytes_read, requests[i].result.size());
+    }
+  }
+  if (stats_ != nullptr && file_read_hist_ != nullptr) {
+    file_read_hist_->Add(elapsed);
+  }
+  return s;
+}
+
 Status WritableFileWriter::Append(const Slice& data) {
   const char* src = data.cdata();
   size_t left = data.size();
@@ -487,6 +506,69 @@ std::unique_ptr<RandomAccessFile> NewReadaheadRandomAccessFile(
   return result;
 }
 
+namespace {
+
+class PersistentCacheRandomAccessFile : public RandomAccessFile {
+ public:
+  PersistentCacheRandomAccessFile(std::unique_ptr<RandomAccessFile>&& file,
+                                  Env* env,
+                                  const std::string& fname,
+                                  std::shared_ptr<PersistentCache> persistent_cache)
+      : file_(std::move(file)),
+        fname_(fname),
+        file_id_(PersistentCacheFileId(env, fname, *file_)),
+        persistent_cache_(std::move(persistent_cache)) {}
+
+  PersistentCacheRandomAccessFile(const PersistentCacheRandomAccessFile&) = delete;
+
+  PersistentCacheRandomAccessFile& operator=(const PersistentCacheRandomAccessFile&) = delete;
+
+  virtual Status Read(uint64_t offset, size_t n, Slice* result,
+                      char* scratch) const override {
+    if (persistent_cache_->Lookup(fname_, file_id_, offset, n, scratch)) {
+      *result = Slice(scratch, n);
+      return Status::OK();
+    }
+
+    Status s = file_->Read(offset, n, result, scratch);
+    // Only cache complete reads, a short read means we are at the end of the file.
+    if (s.ok() && result->size() == n) {
+      persistent_cache_->Insert(fname_, file_id_, offset, *result);
+    }
+    return s;
+  }
+
+  bool ShouldForwardRawRequest() const override { return file_->ShouldForwardRawRequest(); }
+
+  void EnableReadAhead() override { file_->EnableReadAhead(); }
+
+  size_t GetUniqueId(char* id, size_t max_size) const override {
+    return file_->GetUniqueId(id, max_size);
+  }
+
+  void Hint(AccessPattern pattern) override { file_->Hint(pattern); }
+
+  Status InvalidateCache(size_t offset, size_t length) override {
+    return file_->InvalidateCache(offset, length);
+  }
+
+ private:
+  std::unique_ptr<RandomAccessFile> file_;
+  const std::string fname_;
+  const std::string file_id_;
+  const std::shared_ptr<PersistentCache> persistent_cache_;
+};
+
+}  // namespace
+
+std::unique_ptr<RandomAccessFile> NewPersistentCacheRandomAccessFile(
+    std::unique_ptr<RandomAccessFile>&& file, Env* env, const std::string& fname,
+    std::shared_ptr<PersistentCache> persistent_cache) {
+  std::unique_ptr<RandomAccessFile> result(new PersistentCacheRandomAccessFile(
+      std::move(file), env, fname, std::move(persistent_cache)));
+  return result;
+}
+
 Status NewWritableFile(Env* env, const std::string& fname,
                        unique_ptr<WritableFile>* result,
                        const EnvOptions& options) {
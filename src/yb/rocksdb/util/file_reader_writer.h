@@ -34,10 +34,18 @@ namespace rocksdb {
 
 class Statistics;
 class HistogramImpl;
+class PersistentCache;
 
 std::unique_ptr<RandomAccessFile> NewReadaheadRandomAccessFile(
   std::unique_ptr<RandomAccessFile>&& file, size_t readahead_size);
 
+// Returns a file that serves reads of fname from the persistent cache when it can, and stores
+// the data it reads from file in the cache otherwise. The blocks are cached for the current
+// version of fname, see PersistentCacheFileId().
+std::unique_ptr<RandomAccessFile> NewPersistentCacheRandomAccessFile(
+  std::unique_ptr<RandomAccessFile>&& file, Env* env, const std::string& fname,
+  std::shared_ptr<PersistentCache> persistent_cache);
+
 class SequentialFileReader {
  private:
   std::unique_ptr<SequentialFile> file_;
@@ -103,6 +111,9 @@ class RandomAccessFileReader {
 
   Status Read(uint64_t offset, size_t n, Slice* result, char* scratch) const;
 
+  // Performs the reads with one RandomAccessFile::MultiRead() call.
+  Status MultiRead(ReadRequest* requests, size_t num_requests) const;
+
   RandomAccessFile* file() { return file_.get(); }
 };
 
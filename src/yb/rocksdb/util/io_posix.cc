@@ -36,6 +36,7 @@
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #ifdef OS_LINUX
 #include <sys/statfs.h>
 #include <sys/syscall.h>
@@ -48,6 +49,9 @@
 #include "yb/rocksdb/util/string_util.h"
 #include "yb/rocksdb/util/sync_point.h"
 
+#include "yb/util/io_uring.h"
+#include "yb/util/logging.h"
+
 namespace rocksdb {
 
 // A wrapper for fadvise, if the platform doesn't support fadvise,
@@ -194,6 +198,71 @@ Status PosixRandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
   return s;
 }
 
+Status PosixRandomAccessFile::MultiRead(ReadRequest* requests, size_t num_requests) const {
+  yb::IoUring* ring = num_requests > 1 ? yb::IoUring::ForCurrentThread() : nullptr;
+  if (ring == nullptr) {
+    return RandomAccessFile::MultiRead(requests, num_requests);
+  }
+  DCHECK_EQ(ring->in_flight(), 0U);
+
+  // The iovecs have to stay valid until their reads complete.
+  std::vector<struct iovec> iovs(num_requests);
+  Status result;
+  size_t next = 0;
+  size_t completed = 0;
+  while (completed < num_requests) {
+    // Queue as many of the remaining reads as the ring holds, and wait for at least one of them.
+    while (next < num_requests) {
+      ReadRequest& request = requests[next];
+      iovs[next].iov_base = request.scratch;
+      iovs[next].iov_len = request.n;
+      if (!ring->PrepareReadv(fd_, &iovs[next], 1, request.offset, next)) {
+        break;
+      }
+      ++next;
+    }
+    Status s = ring->Submit(1 /* wait_nr */);
+    if (!s.ok()) {
+      LOG(WARNING) << "Falling back to blocking reads of " << filename_ << ": " << s.ToString();
+      // The blocking reads reuse the scratch buffers, so wait for the reads the kernel took first.
+      // Their completions are discarded and do not leak into the next batch of the thread.
+      WARN_NOT_OK(ring->Drain(), "Failed to wait for io_uring reads");
+      DCHECK_EQ(ring->in_flight(), 0U);
+      return RandomAccessFile::MultiRead(requests, num_requests);
+    }
+
+    uint64_t index = 0;
+    int32_t res = 0;
+    while (ring->PopCompletion(&index, &res)) {
+      DCHECK_LT(index, num_requests);
+      ReadRequest& request = requests[index];
+      if (res < 0) {
+        request.result = Slice(request.scratch, static_cast<size_t>(0));
+        request.status = IOError(filename_, -res);
+      } else if (static_cast<size_t>(res) < request.n) {
+        // A short read, at the end of the file or interrupted. Finish it like Read() does.
+        Slice rest;
+        request.status = Read(request.offset + res, request.n - res, &rest, request.scratch + res);
+        request.result = Slice(request.scratch, res + rest.size());
+      } else {
+        request.result = Slice(request.scratch, request.n);
+        request.status = Status::OK();
+      }
+      if (result.ok() && !request.status.ok()) {
+        result = request.status;
+      }
+      ++completed;
+    }
+  }
+
+  if (!use_os_buffer_) {
+    // we need to fadvise away the entire range of pages because
+    // we do not want readahead pages to be cached.
+    Fadvise(fd_, 0, 0, POSIX_FADV_DONTNEED);  // free OS pages
+  }
+  return result;
+}
+
 #ifdef OS_LINUX
 size_t PosixRandomAccessFile::GetUniqueId(char* id, size_t max_size) const {
   return GetUniqueIdFromFile(fd_, id, max_size);
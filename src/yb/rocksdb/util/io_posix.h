@@ -73,6 +73,8 @@ class PosixRandomAccessFile : public RandomAccessFile {
 
   virtual Status Read(uint64_t offset, size_t n, Slice* result,
                       char* scratch) const override;
+  // Submits the reads through the io_uring of the calling thread when --use_io_uring is set.
+  virtual Status MultiRead(ReadRequest* requests, size_t num_requests) const override;
 #ifdef OS_LINUX
   virtual size_t GetUniqueId(char* id, size_t max_size) const override;
 #endif
@@ -40,6 +40,7 @@
 #include "yb/rocksdb/sst_file_manager.h"
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/merge_operator.h"
+#include "yb/rocksdb/persistent_cache.h"
 #include "yb/util/slice.h"
 #include "yb/rocksdb/slice_transform.h"
 #include "yb/rocksdb/table.h"
@@ -95,7 +96,8 @@ ImmutableCFOptions::ImmutableCFOptions(const Options& options)
       num_levels(options.num_levels),
       optimize_filters_for_hits(options.optimize_filters_for_hits),
       listeners(options.listeners),
-      row_cache(options.row_cache) {}
+      row_cache(options.row_cache),
+      persistent_cache(options.persistent_cache) {}
 
 ColumnFamilyOptions::ColumnFamilyOptions()
     : comparator(BytewiseComparator()),
@@ -290,6 +292,7 @@ DBOptions::DBOptions()
       skip_stats_update_on_db_open(false),
       wal_recovery_mode(WALRecoveryMode::kTolerateCorruptedTailRecords),
       row_cache(nullptr),
+      persistent_cache(nullptr),
 #ifndef ROCKSDB_LITE
       wal_filter(nullptr),
 #endif  // ROCKSDB_LITE
@@ -414,6 +417,12 @@ void DBOptions::Dump(Logger* log) const {
     } else {
       RHEADER(log, "                               Options.row_cache: None");
     }
+    if (persistent_cache) {
+      RHEADER(log, "                        Options.persistent_cache: %" ROCKSDB_PRIszt,
+          persistent_cache->GetCapacity());
+    } else {
+      RHEADER(log, "                        Options.persistent_cache: None");
+    }
   RHEADER(log, "                           Options.initial_seqno: %" PRIu64, initial_seqno);
 #ifndef ROCKSDB_LITE
   RHEADER(log, "       Options.wal_filter: %s",
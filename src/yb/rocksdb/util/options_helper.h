@@ -166,6 +166,7 @@ static std::unordered_map<std::string, OptionTypeInfo> db_options_type_info = {
      // not yet supported
       Env* env;
       std::shared_ptr<Cache> row_cache;
+      std::shared_ptr<PersistentCache> persistent_cache;
       std::shared_ptr<DeleteScheduler> delete_scheduler;
       std::shared_ptr<Logger> info_log;
       std::shared_ptr<RateLimiter> rate_limiter;
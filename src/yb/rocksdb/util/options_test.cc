@@ -1918,6 +1918,7 @@ TEST_F(OptionsParserTest, DBOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(DBOptions, memory_monitor),
       BLACKLIST_ENTRY(DBOptions, listeners),
       BLACKLIST_ENTRY(DBOptions, row_cache),
+      BLACKLIST_ENTRY(DBOptions, persistent_cache),
       BLACKLIST_ENTRY(DBOptions, wal_filter),
       BLACKLIST_ENTRY(DBOptions, boundary_extractor),
   };
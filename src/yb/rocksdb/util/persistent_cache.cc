@@ -0,0 +1,541 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/persistent_cache.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/crc32c.h"
+
+#include "yb/util/logging.h"
+
+namespace rocksdb {
+
+namespace {
+
+// Blocks are appended to cache files, each of which holds blocks of a single SST file:
+//   header: varint32 length of the SST file name, SST file name,
+//           varint32 length of the SST file id, SST file id
+//   record: fixed64 offset in the SST file, fixed32 size, fixed32 crc32c of data, data
+// A record that is cut short by a crash is ignored when the cache file is loaded.
+const std::string kCacheFileSuffix = ".blocks";
+constexpr size_t kRecordHeaderSize = 16;
+
+// Inserted blocks waiting to be written by the background writer take at most this much memory,
+// blocks inserted when it is exceeded are not cached.
+constexpr size_t kMaxPendingBytes = 32 * 1024 * 1024;
+
+struct CacheFile {
+  std::string path;
+  std::unique_ptr<RandomAccessFile> reader;
+  // Null once the file is no longer appended to, e.g. when it was loaded on startup. Only used by
+  // the background writer.
+  std::unique_ptr<WritableFile> writer;
+  uint64_t size = 0;
+};
+
+struct BlockLocation {
+  std::shared_ptr<CacheFile> file;
+  uint64_t position;
+  uint32_t size;
+  uint32_t checksum;
+};
+
+struct PendingBlock {
+  std::string file_name;
+  std::string file_id;
+  uint64_t offset;
+  std::string data;
+};
+
+Status ReadLengthPrefixed(RandomAccessFile* file, uint64_t file_size, uint64_t* position,
+                          std::string* out) {
+  char buffer[kMaxVarint32Length];
+  Slice slice;
+  RETURN_NOT_OK(file->Read(
+      *position, std::min<uint64_t>(file_size - *position, kMaxVarint32Length), &slice, buffer));
+  uint32_t size = 0;
+  const char* start = GetVarint32Ptr(slice.cdata(), slice.cdata() + slice.size(), &size);
+  if (start == nullptr) {
+    return STATUS(Corruption, "Bad persistent cache file header");
+  }
+  *position += start - slice.cdata();
+  if (*position + size > file_size) {
+    return STATUS(Corruption, "Truncated persistent cache file header");
+  }
+  std::unique_ptr<char[]> data(new char[size]);
+  RETURN_NOT_OK(file->Read(*position, size, &slice, data.get()));
+  *out = slice.ToBuffer();
+  *position += size;
+  return Status::OK();
+}
+
+class FilePersistentCache : public PersistentCache {
+ public:
+  FilePersistentCache(Env* env, std::string dir, size_t capacity)
+      : env_(env), dir_(std::move(dir)), capacity_(capacity) {}
+
+  ~FilePersistentCache() {
+    {
+      std::lock_guard<std::mutex> lock(pending_mutex_);
+      stop_ = true;
+    }
+    pending_cond_.notify_all();
+    if (writer_thread_.joinable()) {
+      writer_thread_.join();
+    }
+  }
+
+  Status Load() {
+    RETURN_NOT_OK(env_->CreateDirIfMissing(dir_));
+    std::vector<std::string> children;
+    RETURN_NOT_OK(env_->GetChildren(dir_, &children));
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& child : children) {
+        if (child.size() <= kCacheFileSuffix.size() ||
+            child.compare(child.size() - kCacheFileSuffix.size(), kCacheFileSuffix.size(),
+                          kCacheFileSuffix) != 0) {
+          continue;
+        }
+        const auto id = std::strtoull(child.c_str(), nullptr, 10);
+        next_file_id_ = std::max<uint64_t>(next_file_id_, id + 1);
+        const auto path = dir_ + "/" + child;
+        auto status = LoadCacheFileUnlocked(path);
+        if (!status.ok()) {
+          LOG(WARNING) << "Dropping persistent cache file " << path << ": " << status.ToString();
+          WARN_NOT_OK(env_->DeleteFile(path), "Failed to delete persistent cache file");
+        }
+      }
+      std::vector<std::string> to_delete;
+      EvictUnlocked(nullptr /* keep */, &to_delete);
+      DeleteCacheFiles(to_delete);
+      LOG(INFO) << "Loaded persistent block cache from " << dir_ << ": " << files_.size()
+                << " SST files, " << usage_ << " bytes";
+    }
+
+    writer_thread_ = std::thread(&FilePersistentCache::WriterThread, this);
+    return Status::OK();
+  }
+
+  bool Lookup(const std::string& file_name, const std::string& file_id, uint64_t offset, size_t n,
+              char* scratch) override {
+    if (file_id.empty()) {
+      return false;
+    }
+    BlockLocation location;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = files_.find(file_name);
+      if (it == files_.end() || it->second.file_id != file_id) {
+        return false;
+      }
+      auto block_it = it->second.blocks.find(offset);
+      if (block_it == it->second.blocks.end() || block_it->second.size != n) {
+        return false;
+      }
+      location = block_it->second;
+      lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+    }
+
+    // The cache file stays readable even if the block is evicted meanwhile, because we hold a
+    // reference to it.
+    Slice result;
+    auto status = location.file->reader->Read(location.position, n, &result, scratch);
+    if (!status.ok() || result.size() != n ||
+        crc32c::Value(result.cdata(), n) != location.checksum) {
+      LOG(WARNING) << "Failed to read block at " << offset << " of " << file_name
+                   << " from persistent cache file " << location.file->path << ": "
+                   << (status.ok() ? "checksum mismatch" : status.ToString());
+      return false;
+    }
+    if (result.cdata() != scratch) {
+      memcpy(scratch, result.cdata(), n);
+    }
+    return true;
+  }
+
+  void Insert(const std::string& file_name, const std::string& file_id, uint64_t offset,
+              const Slice& data) override {
+    if (file_id.empty() || kRecordHeaderSize + data.size() > capacity_) {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(pending_mutex_);
+      if (stop_ || pending_bytes_ + data.size() > kMaxPendingBytes) {
+        return;
+      }
+      pending_bytes_ += data.size();
+      pending_.push_back(PendingBlock{file_name, file_id, offset, data.ToBuffer()});
+    }
+    pending_cond_.notify_all();
+  }
+
+  void WaitForInserts() override {
+    std::unique_lock<std::mutex> lock(pending_mutex_);
+    pending_cond_.wait(lock, [this] { return stop_ || (pending_.empty() && !writing_); });
+  }
+
+  void Erase(const std::string& file_name) override {
+    std::vector<std::string> to_delete;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = files_.find(file_name);
+      if (it != files_.end()) {
+        RemoveUnlocked(it, &to_delete);
+      }
+    }
+    DeleteCacheFiles(to_delete);
+  }
+
+  void EraseDirectory(const std::string& dir) override {
+    const std::string prefix = dir.empty() || dir.back() == '/' ? dir : dir + "/";
+    std::vector<std::string> to_delete;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto it = files_.begin(); it != files_.end();) {
+        auto current = it++;
+        if (current->first.compare(0, prefix.size(), prefix) == 0) {
+          RemoveUnlocked(current, &to_delete);
+        }
+      }
+    }
+    DeleteCacheFiles(to_delete);
+  }
+
+  size_t GetUsage() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usage_;
+  }
+
+  size_t GetCapacity() const override {
+    return capacity_;
+  }
+
+ private:
+  struct CachedSstFile {
+    std::string file_id;
+    std::vector<std::shared_ptr<CacheFile>> cache_files;
+    std::unordered_map<uint64_t, BlockLocation> blocks;
+    std::list<std::string>::iterator lru_position;
+    uint64_t size = 0;
+  };
+
+  typedef std::unordered_map<std::string, CachedSstFile> Files;
+
+  void WriterThread() {
+    std::unique_lock<std::mutex> lock(pending_mutex_);
+    for (;;) {
+      pending_cond_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+      if (stop_) {
+        // Blocks that were not written yet are just not cached.
+        pending_.clear();
+        pending_bytes_ = 0;
+        break;
+      }
+      auto block = std::move(pending_.front());
+      pending_.pop_front();
+      writing_ = true;
+      lock.unlock();
+
+      WriteBlock(block);
+
+      lock.lock();
+      pending_bytes_ -= block.data.size();
+      writing_ = false;
+      if (pending_.empty()) {
+        pending_cond_.notify_all();
+      }
+    }
+  }
+
+  // Appends the block to the cache file of its SST file. The cache files are only appended to and
+  // created by the writer thread, so the I/O is done without holding mutex_.
+  void WriteBlock(const PendingBlock& block) {
+    std::vector<std::string> to_delete;
+    std::shared_ptr<CacheFile> cache_file;
+    bool fits = true;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = files_.find(block.file_name);
+      if (it != files_.end() && it->second.file_id != block.file_id) {
+        // The SST file was written again under the same name.
+        RemoveUnlocked(it, &to_delete);
+        it = files_.end();
+      }
+      uint64_t sst_size = 0;
+      if (it != files_.end()) {
+        if (it->second.blocks.count(block.offset)) {
+          return;
+        }
+        auto& cache_files = it->second.cache_files;
+        if (!cache_files.empty() && cache_files.back()->writer) {
+          cache_file = cache_files.back();
+        }
+        sst_size = it->second.size;
+      }
+      // Eviction never removes the SST file the block is written for, so the blocks of one SST
+      // file have to fit into the capacity on their own. Once they don't, the following blocks of
+      // the file are not cached.
+      auto record_size = kRecordHeaderSize + block.data.size();
+      if (!cache_file) {
+        record_size += block.file_name.size() + block.file_id.size() + 2 * kMaxVarint32Length;
+      }
+      fits = sst_size + record_size <= capacity_;
+    }
+    DeleteCacheFiles(to_delete);
+    if (!fits) {
+      return;
+    }
+
+    const bool new_cache_file = !cache_file;
+    if (new_cache_file) {
+      auto status = NewCacheFile(block.file_name, block.file_id, &cache_file);
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to create persistent cache file: " << status.ToString();
+        return;
+      }
+    }
+
+    BlockLocation location = {
+        cache_file, cache_file->size + kRecordHeaderSize, static_cast<uint32_t>(block.data.size()),
+        crc32c::Value(block.data.data(), block.data.size()) };
+    char header[kRecordHeaderSize];
+    EncodeFixed64(header, block.offset);
+    EncodeFixed32(header + 8, location.size);
+    EncodeFixed32(header + 12, location.checksum);
+    auto status = cache_file->writer->Append(Slice(header, kRecordHeaderSize));
+    if (status.ok()) {
+      status = cache_file->writer->Append(block.data);
+    }
+    if (status.ok()) {
+      status = cache_file->writer->Flush();
+    }
+    if (!status.ok()) {
+      // Stop appending to the file, the next block of this SST file starts a new one.
+      LOG(WARNING) << "Failed to write to persistent cache file " << cache_file->path << ": "
+                   << status.ToString();
+      cache_file->writer.reset();
+      if (new_cache_file) {
+        WARN_NOT_OK(env_->DeleteFile(cache_file->path), "Failed to delete persistent cache file");
+      }
+      return;
+    }
+    const auto record_size = kRecordHeaderSize + block.data.size();
+    cache_file->size += record_size;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = files_.find(block.file_name);
+      if (new_cache_file) {
+        if (it != files_.end() && it->second.file_id != block.file_id) {
+          RemoveUnlocked(it, &to_delete);
+          it = files_.end();
+        }
+        if (it == files_.end()) {
+          it = files_.emplace(block.file_name, CachedSstFile()).first;
+          it->second.file_id = block.file_id;
+          it->second.lru_position = lru_.insert(lru_.begin(), block.file_name);
+        }
+        it->second.cache_files.push_back(cache_file);
+        it->second.size += cache_file->size;
+        usage_ += cache_file->size;
+      } else if (it == files_.end() || it->second.cache_files.empty() ||
+                 it->second.cache_files.back() != cache_file) {
+        // The SST file was erased meanwhile, together with the cache file.
+        return;
+      } else {
+        it->second.size += record_size;
+        usage_ += record_size;
+      }
+      it->second.blocks.emplace(block.offset, std::move(location));
+      EvictUnlocked(&block.file_name, &to_delete);
+    }
+    DeleteCacheFiles(to_delete);
+  }
+
+  Status NewCacheFile(const std::string& file_name, const std::string& file_id,
+                      std::shared_ptr<CacheFile>* result) {
+    auto cache_file = std::make_shared<CacheFile>();
+    cache_file->path = dir_ + "/" + std::to_string(next_file_id_++) + kCacheFileSuffix;
+    RETURN_NOT_OK(env_->NewWritableFile(cache_file->path, &cache_file->writer, EnvOptions()));
+    std::string header;
+    PutLengthPrefixedSlice(&header, file_name);
+    PutLengthPrefixedSlice(&header, file_id);
+    auto status = cache_file->writer->Append(header);
+    if (status.ok()) {
+      status = cache_file->writer->Flush();
+    }
+    if (status.ok()) {
+      status = env_->NewRandomAccessFile(cache_file->path, &cache_file->reader, EnvOptions());
+    }
+    if (!status.ok()) {
+      WARN_NOT_OK(env_->DeleteFile(cache_file->path), "Failed to delete persistent cache file");
+      return status;
+    }
+    cache_file->size = header.size();
+    *result = std::move(cache_file);
+    return Status::OK();
+  }
+
+  Status LoadCacheFileUnlocked(const std::string& path) {
+    auto cache_file = std::make_shared<CacheFile>();
+    cache_file->path = path;
+    RETURN_NOT_OK(env_->GetFileSize(path, &cache_file->size));
+    RETURN_NOT_OK(env_->NewRandomAccessFile(path, &cache_file->reader, EnvOptions()));
+
+    uint64_t position = 0;
+    std::string file_name;
+    std::string file_id;
+    RETURN_NOT_OK(ReadLengthPrefixed(
+        cache_file->reader.get(), cache_file->size, &position, &file_name));
+    RETURN_NOT_OK(ReadLengthPrefixed(
+        cache_file->reader.get(), cache_file->size, &position, &file_id));
+
+    // Blocks of SST files deleted, or written again under the same name, while we were not
+    // running are of no use anymore.
+    std::unique_ptr<RandomAccessFile> sst_file;
+    auto status = env_->NewRandomAccessFile(file_name, &sst_file, EnvOptions());
+    if (!status.ok()) {
+      return STATUS(NotFound, "SST file no longer exists", file_name);
+    }
+    if (file_id.empty() || PersistentCacheFileId(env_, file_name, *sst_file) != file_id) {
+      return STATUS(NotFound, "SST file was replaced", file_name);
+    }
+
+    std::vector<std::pair<uint64_t, BlockLocation>> blocks;
+    char buffer[kRecordHeaderSize];
+    Slice slice;
+    while (position + kRecordHeaderSize <= cache_file->size) {
+      RETURN_NOT_OK(cache_file->reader->Read(position, kRecordHeaderSize, &slice, buffer));
+      const uint64_t offset = DecodeFixed64(slice.cdata());
+      const uint32_t size = DecodeFixed32(slice.cdata() + 8);
+      const uint32_t checksum = DecodeFixed32(slice.cdata() + 12);
+      if (position + kRecordHeaderSize + size > cache_file->size) {
+        break;
+      }
+      blocks.emplace_back(
+          offset, BlockLocation{cache_file, position + kRecordHeaderSize, size, checksum});
+      position += kRecordHeaderSize + size;
+    }
+
+    auto it = files_.find(file_name);
+    if (it != files_.end() && it->second.file_id != file_id) {
+      return STATUS(NotFound, "Blocks of another version of the SST file", file_name);
+    }
+    if (it == files_.end()) {
+      it = files_.emplace(file_name, CachedSstFile()).first;
+      it->second.file_id = file_id;
+      it->second.lru_position = lru_.insert(lru_.begin(), file_name);
+    }
+    auto& sst = it->second;
+    sst.blocks.insert(blocks.begin(), blocks.end());
+    sst.size += cache_file->size;
+    usage_ += cache_file->size;
+    sst.cache_files.push_back(std::move(cache_file));
+    return Status::OK();
+  }
+
+  // Evicts least recently used SST files, except keep, until the usage fits into capacity. Paths of
+  // the cache files to delete are added to to_delete.
+  void EvictUnlocked(const std::string* keep, std::vector<std::string>* to_delete) {
+    auto lru_it = lru_.end();
+    while (usage_ > capacity_ && lru_it != lru_.begin()) {
+      --lru_it;
+      if (keep != nullptr && *lru_it == *keep) {
+        continue;
+      }
+      auto it = files_.find(*lru_it);
+      ++lru_it;
+      RemoveUnlocked(it, to_delete);
+    }
+  }
+
+  void RemoveUnlocked(Files::iterator it, std::vector<std::string>* to_delete) {
+    for (const auto& cache_file : it->second.cache_files) {
+      to_delete->push_back(cache_file->path);
+    }
+    usage_ -= it->second.size;
+    lru_.erase(it->second.lru_position);
+    files_.erase(it);
+  }
+
+  // Deletes cache files removed from files_, without holding mutex_. Readers that still reference
+  // a deleted file can finish reading it.
+  void DeleteCacheFiles(const std::vector<std::string>& paths) {
+    for (const auto& path : paths) {
+      WARN_NOT_OK(env_->DeleteFile(path), "Failed to delete persistent cache file");
+    }
+  }
+
+  Env* const env_;
+  const std::string dir_;
+  const size_t capacity_;
+
+  mutable std::mutex mutex_;
+  Files files_;
+  // SST file names, most recently used first.
+  std::list<std::string> lru_;
+  size_t usage_ = 0;
+  // Only used by Load() and then by the writer thread.
+  uint64_t next_file_id_ = 0;
+
+  // Blocks passed to Insert() that the writer thread did not write yet.
+  std::mutex pending_mutex_;
+  std::condition_variable pending_cond_;
+  std::deque<PendingBlock> pending_;
+  size_t pending_bytes_ = 0;
+  bool writing_ = false;
+  bool stop_ = false;
+  std::thread writer_thread_;
+};
+
+} // namespace
+
+std::string PersistentCacheFileId(Env* env, const std::string& file_name,
+                                  const RandomAccessFile& file) {
+  uint64_t size = 0;
+  uint64_t modification_time = 0;
+  if (!env->GetFileSize(file_name, &size).ok() ||
+      !env->GetFileModificationTime(file_name, &modification_time).ok()) {
+    return std::string();
+  }
+  char unique_id[kMaxVarint64Length * 3];
+  const auto unique_id_size = file.GetUniqueId(unique_id, sizeof(unique_id));
+  std::string result(unique_id, unique_id_size);
+  PutFixed64(&result, size);
+  PutFixed64(&result, modification_time);
+  return result;
+}
+
+Status NewFilePersistentCache(Env* env, const std::string& dir, size_t capacity,
+                              std::shared_ptr<PersistentCache>* cache) {
+  auto result = std::make_shared<FilePersistentCache>(env, dir, capacity);
+  RETURN_NOT_OK(result->Load());
+  *cache = std::move(result);
+  return Status::OK();
+}
+
+}  // namespace rocksdb
@@ -0,0 +1,213 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/persistent_cache.h"
+
+#include <string>
+#include <vector>
+
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/util/testharness.h"
+
+namespace rocksdb {
+
+class PersistentCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    env_ = Env::Default();
+    dir_ = test::TmpDir(env_) + "/persistent_cache_test";
+    cache_dir_ = dir_ + "/cache";
+    ClearDir(cache_dir_);
+    ClearDir(dir_);
+    ASSERT_OK(env_->CreateDirIfMissing(dir_));
+    sst_file_ = dir_ + "/000001.sst.sblock.0";
+    ASSERT_OK(WriteStringToFile(env_, "data", sst_file_));
+  }
+
+  void ClearDir(const std::string& dir) {
+    std::vector<std::string> children;
+    if (env_->GetChildren(dir, &children).ok()) {
+      for (const auto& child : children) {
+        env_->DeleteFile(dir + "/" + child);
+      }
+      env_->DeleteDir(dir);
+    }
+  }
+
+  void OpenCache(size_t capacity) {
+    cache_.reset();
+    ASSERT_OK(NewFilePersistentCache(env_, cache_dir_, capacity, &cache_));
+  }
+
+  std::string FileId(const std::string& file_name) {
+    std::unique_ptr<RandomAccessFile> file;
+    EXPECT_OK(env_->NewRandomAccessFile(file_name, &file, EnvOptions()));
+    return file ? PersistentCacheFileId(env_, file_name, *file) : std::string();
+  }
+
+  void Insert(const std::string& file_name, uint64_t offset, const std::string& data) {
+    cache_->Insert(file_name, FileId(file_name), offset, data);
+    cache_->WaitForInserts();
+  }
+
+  bool Lookup(const std::string& file_name, uint64_t offset, const std::string& expected) {
+    std::string buffer(expected.size(), '\0');
+    if (!cache_->Lookup(file_name, FileId(file_name), offset, expected.size(), &buffer[0])) {
+      return false;
+    }
+    EXPECT_EQ(expected, buffer);
+    return true;
+  }
+
+  Env* env_;
+  std::string dir_;
+  std::string cache_dir_;
+  std::string sst_file_;
+  std::shared_ptr<PersistentCache> cache_;
+};
+
+TEST_F(PersistentCacheTest, InsertAndLookup) {
+  OpenCache(1 << 20);
+  ASSERT_FALSE(Lookup(sst_file_, 0, "block0"));
+  Insert(sst_file_, 0, "block0");
+  Insert(sst_file_, 100, "block100");
+  ASSERT_TRUE(Lookup(sst_file_, 0, "block0"));
+  ASSERT_TRUE(Lookup(sst_file_, 100, "block100"));
+  // The size has to match as well.
+  ASSERT_FALSE(Lookup(sst_file_, 100, "block"));
+  const std::string other_sst_file = dir_ + "/000002.sst.sblock.0";
+  ASSERT_OK(WriteStringToFile(env_, "data", other_sst_file));
+  ASSERT_FALSE(Lookup(other_sst_file, 0, "block0"));
+  ASSERT_GT(cache_->GetUsage(), 0U);
+
+  cache_->Erase(sst_file_);
+  ASSERT_FALSE(Lookup(sst_file_, 0, "block0"));
+  ASSERT_EQ(0U, cache_->GetUsage());
+}
+
+TEST_F(PersistentCacheTest, Restart) {
+  OpenCache(1 << 20);
+  Insert(sst_file_, 0, "block0");
+  const auto usage = cache_->GetUsage();
+
+  OpenCache(1 << 20);
+  ASSERT_EQ(usage, cache_->GetUsage());
+  ASSERT_TRUE(Lookup(sst_file_, 0, "block0"));
+
+  // Blocks inserted after the restart go to a new cache file.
+  Insert(sst_file_, 10, "block10");
+  ASSERT_TRUE(Lookup(sst_file_, 0, "block0"));
+  ASSERT_TRUE(Lookup(sst_file_, 10, "block10"));
+
+  // Blocks of SST files deleted while the cache was closed are dropped.
+  cache_.reset();
+  ASSERT_OK(env_->DeleteFile(sst_file_));
+  OpenCache(1 << 20);
+  ASSERT_EQ(0U, cache_->GetUsage());
+  ASSERT_FALSE(Lookup(sst_file_, 0, "block0"));
+}
+
+// An SST file written again under the same name, e.g. when a tablet is deleted and remote
+// bootstrapped again, does not get the blocks of the old file.
+TEST_F(PersistentCacheTest, ReplacedFile) {
+  OpenCache(1 << 20);
+  Insert(sst_file_, 0, "block0");
+  ASSERT_TRUE(Lookup(sst_file_, 0, "block0"));
+
+  ASSERT_OK(env_->DeleteFile(sst_file_));
+  ASSERT_OK(WriteStringToFile(env_, "new data", sst_file_));
+  ASSERT_FALSE(Lookup(sst_file_, 0, "block0"));
+
+  // Blocks of the new file replace the ones of the old file.
+  Insert(sst_file_, 0, "BLOCK0");
+  ASSERT_TRUE(Lookup(sst_file_, 0, "BLOCK0"));
+
+  // The same when the file is replaced while the cache is closed.
+  cache_.reset();
+  ASSERT_OK(env_->DeleteFile(sst_file_));
+  ASSERT_OK(WriteStringToFile(env_, "newer data", sst_file_));
+  OpenCache(1 << 20);
+  ASSERT_EQ(0U, cache_->GetUsage());
+  ASSERT_FALSE(Lookup(sst_file_, 0, "BLOCK0"));
+}
+
+TEST_F(PersistentCacheTest, EraseDirectory) {
+  const std::string other_dir = dir_ + "/other";
+  ClearDir(other_dir);
+  ASSERT_OK(env_->CreateDirIfMissing(other_dir));
+  const std::string other_sst_file = other_dir + "/000001.sst.sblock.0";
+  ASSERT_OK(WriteStringToFile(env_, "data", other_sst_file));
+
+  OpenCache(1 << 20);
+  Insert(sst_file_, 0, "block0");
+  Insert(other_sst_file, 0, "block0");
+
+  cache_->EraseDirectory(other_dir);
+  ASSERT_FALSE(Lookup(other_sst_file, 0, "block0"));
+  ASSERT_TRUE(Lookup(sst_file_, 0, "block0"));
+
+  cache_->EraseDirectory(dir_);
+  ASSERT_FALSE(Lookup(sst_file_, 0, "block0"));
+  ASSERT_EQ(0U, cache_->GetUsage());
+  ClearDir(other_dir);
+}
+
+TEST_F(PersistentCacheTest, Eviction) {
+  const std::string block(1000, 'x');
+  std::vector<std::string> sst_files;
+  for (int i = 2; i != 12; ++i) {
+    sst_files.push_back(dir_ + "/00000" + std::to_string(i) + ".sst.sblock.0");
+    ASSERT_OK(WriteStringToFile(env_, "data", sst_files.back()));
+  }
+
+  OpenCache(5000);
+  for (const auto& sst_file : sst_files) {
+    Insert(sst_file, 0, block);
+    ASSERT_TRUE(Lookup(sst_files.front(), 0, block));
+    ASSERT_LE(cache_->GetUsage(), cache_->GetCapacity());
+  }
+  // The first file is kept because it was looked up after each insert, the least recently used
+  // ones are evicted.
+  ASSERT_TRUE(Lookup(sst_files.front(), 0, block));
+  ASSERT_TRUE(Lookup(sst_files.back(), 0, block));
+  ASSERT_FALSE(Lookup(sst_files[1], 0, block));
+}
+
+// The blocks of an SST file that does not fit into the capacity are cached only up to it.
+TEST_F(PersistentCacheTest, SstFileLargerThanCapacity) {
+  const std::string block(1000, 'x');
+  OpenCache(5000);
+  for (uint64_t offset = 0; offset != 10 * block.size(); offset += block.size()) {
+    Insert(sst_file_, offset, block);
+    ASSERT_LE(cache_->GetUsage(), cache_->GetCapacity());
+  }
+  ASSERT_TRUE(Lookup(sst_file_, 0, block));
+  ASSERT_FALSE(Lookup(sst_file_, 9 * block.size(), block));
+
+  // Blocks of other files still evict it.
+  const std::string other_sst_file = dir_ + "/000002.sst.sblock.0";
+  ASSERT_OK(WriteStringToFile(env_, "data", other_sst_file));
+  for (uint64_t offset = 0; offset != 4 * block.size(); offset += block.size()) {
+    Insert(other_sst_file, offset, block);
+    ASSERT_LE(cache_->GetUsage(), cache_->GetCapacity());
+  }
+  ASSERT_FALSE(Lookup(sst_file_, 0, block));
+  ASSERT_TRUE(Lookup(other_sst_file, 0, block));
+}
+
+}  // namespace rocksdb
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -37,9 +37,10 @@ class LocalOutboundCall : public OutboundCall {
   const std::shared_ptr<LocalYBInboundCall>& CreateLocalInboundCall();
 
  protected:
-  void Serialize(std::deque<RefCntBuffer> *output) const override;
+  void Serialize(std::deque<RefCntSlice> *output) const override;
 
   CHECKED_STATUS GetSidecar(int idx, Slice* sidecar) const override;
+  CHECKED_STATUS GetSidecarBuffer(int idx, RefCntSlice* sidecar) const override;
 
  private:
   friend class LocalYBInboundCall;
@@ -177,7 +177,7 @@ void OutboundCall::NotifyTransferred(const Status& status, Connection* conn) {
   }
 }
 
-void OutboundCall::Serialize(std::deque<RefCntBuffer>* output) const {
+void OutboundCall::Serialize(std::deque<RefCntSlice>* output) const {
   output->push_back(buffer_);
 }
 
@@ -430,6 +430,10 @@ Status OutboundCall::GetSidecar(int idx, Slice* sidecar) const {
   return call_response_.GetSidecar(idx, sidecar);
 }
 
+Status OutboundCall::GetSidecarBuffer(int idx, RefCntSlice* sidecar) const {
+  return call_response_.GetSidecarBuffer(idx, sidecar);
+}
+
 string OutboundCall::ToString() const {
   return Format("RPC call $0 -> $1 , state=$2.",
                 remote_method_.ToString(), conn_id_, StateName(state_));
@@ -514,12 +518,24 @@ Status CallResponse::GetSidecar(int idx, Slice* sidecar) const {
   return Status::OK();
 }
 
+Status CallResponse::GetSidecarBuffer(int idx, RefCntSlice* sidecar) const {
+  DCHECK(parsed_);
+  if (idx < 0 || idx >= header_.sidecar_offsets_size()) {
+    return STATUS(InvalidArgument, strings::Substitute(
+        "Index $0 does not reference a valid sidecar", idx));
+  }
+  *sidecar = RefCntSlice(response_data_, sidecar_slices_[idx]);
+  return Status::OK();
+}
+
 Status CallResponse::ParseFrom(Slice source) {
   CHECK(!parsed_);
   Slice entire_message;
 
-  response_data_.assign(source.data(), source.end());
-  source = Slice(response_data_.data(), response_data_.size());
+  // 'source' points into the connection's read buffer and is only valid during this call, so
+  // the call is copied once. The response protobuf and the sidecars are slices of that copy.
+  response_data_ = RefCntBuffer(source.data(), source.size());
+  source = Slice(response_data_.udata(), response_data_.size());
   RETURN_NOT_OK(serialization::ParseYBMessage(source, &header_, &entire_message));
 
   // Use information from header to extract the payload slices.
@@ -161,6 +161,9 @@ class CallResponse {
   // See RpcController::GetSidecar()
   CHECKED_STATUS GetSidecar(int idx, Slice* sidecar) const;
 
+  // See RpcController::GetSidecarBuffer()
+  CHECKED_STATUS GetSidecarBuffer(int idx, RefCntSlice* sidecar) const;
+
  private:
   // True once ParseFrom() is called.
   bool parsed_;
@@ -169,16 +172,16 @@ class CallResponse {
   ResponseHeader header_;
 
   // The slice of data for the encoded protobuf response.
-  // This slice refers to memory allocated by transfer_
+  // This slice refers to memory owned by response_data_.
   Slice serialized_response_;
 
-  // Slices of data for rpc sidecars. They point into memory owned by transfer_.
+  // Slices of data for rpc sidecars. They point into memory owned by response_data_.
   // Number of sidecars chould be obtained from header_.
   std::array<Slice, kMaxSidecarSlices> sidecar_slices_;
 
-  // The incoming transfer data - retained because serialized_response_
-  // and sidecar_slices_ refer into its data.
-  std::vector<uint8_t> response_data_;
+  // The incoming call data - retained because serialized_response_ and sidecar_slices_ refer into
+  // it. Reference counted, so that a sidecar could be handed over and outlive this response.
+  RefCntBuffer response_data_;
 
   DISALLOW_COPY_AND_ASSIGN(CallResponse);
 };
@@ -208,7 +211,7 @@ class OutboundCall : public RpcCall {
 
   // Serialize the call for the wire. Requires that SetRequestParam()
   // is called first. This is called from the Reactor thread.
-  void Serialize(std::deque<RefCntBuffer>* output) const override;
+  void Serialize(std::deque<RefCntSlice>* output) const override;
 
   // Callback after the call has been put on the outbound connection queue.
   void SetQueued();
@@ -264,6 +267,7 @@ class OutboundCall : public RpcCall {
   friend class RpcController;
 
   virtual CHECKED_STATUS GetSidecar(int idx, Slice* sidecar) const;
+  virtual CHECKED_STATUS GetSidecarBuffer(int idx, RefCntSlice* sidecar) const;
 
   const ConnectionId conn_id_;
   MonoTime start_;
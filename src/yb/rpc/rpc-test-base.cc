@@ -18,6 +18,7 @@
 #include <thread>
 
 #include "yb/util/random_util.h"
+#include "yb/util/ref_cnt_buffer.h"
 
 using namespace std::chrono_literals;
 
@@ -395,6 +396,14 @@ void RpcTestBase::DoTestSidecar(const Proxy& p,
     Slice sidecar = GetSidecarPointer(controller, resp.sidecars(i), size);
     RandomString(expected.data(), size, &rng);
     ASSERT_EQ(0, sidecar.compare(expected)) << "Invalid sidecar at " << i << " position";
+
+    RefCntSlice buffer;
+    ASSERT_OK(controller.GetSidecarBuffer(resp.sidecars(i), &buffer));
+    ASSERT_EQ(size, buffer.size());
+    ASSERT_EQ(0, buffer.AsSlice().compare(expected))
+        << "Invalid sidecar buffer at " << i << " position";
+    // The sidecar is not copied out of the received call.
+    ASSERT_EQ(sidecar.data(), buffer.udata());
   }
 }
 
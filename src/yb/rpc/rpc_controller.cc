@@ -103,6 +103,10 @@ Status RpcController::GetSidecar(int idx, Slice* sidecar) const {
   return call_->GetSidecar(idx, sidecar);
 }
 
+Status RpcController::GetSidecarBuffer(int idx, RefCntSlice* sidecar) const {
+  return call_->GetSidecarBuffer(idx, sidecar);
+}
+
 void RpcController::set_timeout(const MonoDelta& timeout) {
   std::lock_guard<simple_spinlock> l(lock_);
   DCHECK(!call_ || call_->state() == OutboundCall::READY);
@@ -44,6 +44,8 @@
 
 namespace yb {
 
+class RefCntSlice;
+
 namespace rpc {
 
 class ErrorStatusPB;
@@ -133,6 +135,11 @@ class RpcController {
   // May fail if index is invalid.
   CHECKED_STATUS GetSidecar(int idx, Slice* sidecar) const;
 
+  // Same as GetSidecar(), but shares the buffer holding the i-th sidecar, i.e. the received call,
+  // so that the sidecar could be kept or passed on without copying it, after this controller is
+  // reset.
+  CHECKED_STATUS GetSidecarBuffer(int idx, RefCntSlice* sidecar) const;
+
  private:
   friend class OutboundCall;
   friend class Proxy;
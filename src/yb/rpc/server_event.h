@@ -26,7 +26,7 @@ class ServerEvent {
  public:
   virtual ~ServerEvent() {}
   // Serializes the data to be sent out via the RPC framework.
-  virtual void Serialize(std::deque<RefCntBuffer> *output) const = 0;
+  virtual void Serialize(std::deque<RefCntSlice> *output) const = 0;
   virtual std::string ToString() const = 0;
 };
 
@@ -67,7 +67,7 @@ class ConnectionHeader : public OutboundData {
     return false;
   }
 
-  void Serialize(std::deque<RefCntBuffer> *output) const override {
+  void Serialize(std::deque<RefCntSlice> *output) const override {
     output->push_back(buffer_);
   }
 
@@ -346,7 +346,7 @@ void YBInboundCall::LogTrace() const {
   }
 }
 
-void YBInboundCall::Serialize(std::deque<RefCntBuffer>* output) const {
+void YBInboundCall::Serialize(std::deque<RefCntSlice>* output) const {
   TRACE_EVENT0("rpc", "YBInboundCall::Serialize");
   CHECK_GT(response_buf_.size(), 0);
   output->push_back(response_buf_);
@@ -18,6 +18,16 @@
 namespace yb {
 namespace tablet {
 
+CHECKED_STATUS AbstractTablet::HandleRedisReadRequests(
+    HybridTime timestamp, const std::vector<const RedisReadRequestPB*>& redis_read_requests,
+    const std::vector<RedisResponsePB*>& responses) {
+  DCHECK_EQ(redis_read_requests.size(), responses.size());
+  for (size_t i = 0; i < redis_read_requests.size(); ++i) {
+    RETURN_NOT_OK(HandleRedisReadRequest(timestamp, *redis_read_requests[i], responses[i]));
+  }
+  return Status::OK();
+}
+
 CHECKED_STATUS AbstractTablet::HandleQLReadRequest(
     HybridTime timestamp, const QLReadRequestPB& ql_read_request,
     const TransactionOperationContextOpt& txn_op_context, QLResponsePB* response,
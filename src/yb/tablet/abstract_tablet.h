@@ -14,6 +14,8 @@
 #ifndef YB_TABLET_ABSTRACT_TABLET_H
 #define YB_TABLET_ABSTRACT_TABLET_H
 
+#include <vector>
+
 #include "yb/common/redis_protocol.pb.h"
 #include "yb/common/schema.h"
 #include "yb/common/ql_storage_interface.h"
@@ -37,6 +39,12 @@ class AbstractTablet {
       HybridTime timestamp, const RedisReadRequestPB& redis_read_request,
       RedisResponsePB* response) = 0;
 
+  // Handles several Redis read requests at the same read time, in the given order, filling the
+  // response at the same position. The default implementation handles them one by one.
+  virtual CHECKED_STATUS HandleRedisReadRequests(
+      HybridTime timestamp, const std::vector<const RedisReadRequestPB*>& redis_read_requests,
+      const std::vector<RedisResponsePB*>& responses);
+
   virtual CHECKED_STATUS HandleQLReadRequest(
       HybridTime timestamp, const QLReadRequestPB& ql_read_request,
       const TransactionMetadataPB& transaction_metadata, QLResponsePB* response,
@@ -0,0 +1,209 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "yb/common/row_operations.h"
+#include "yb/gutil/singleton.h"
+#include "yb/gutil/strings/substitute.h"
+#include "yb/tablet/local_tablet_writer.h"
+#include "yb/tablet/tablet-test-util.h"
+#include "yb/tablet/tablet_metrics.h"
+#include "yb/util/test_macros.h"
+
+DECLARE_int32(max_group_apply_operations);
+
+namespace yb {
+namespace tablet {
+
+class GroupApplyTest : public YBTabletTest {
+ public:
+  static constexpr int kMaxGroupApplyOperations = 4;
+
+  GroupApplyTest()
+      : YBTabletTest(Schema({ ColumnSchema("key", INT32), ColumnSchema("c1", INT32) }, 1),
+                     YQL_TABLE_TYPE) {
+  }
+
+  void SetUp() override {
+    FLAGS_max_group_apply_operations = kMaxGroupApplyOperations;
+    YBTabletTest::SetUp();
+  }
+
+ protected:
+  struct Write {
+    tserver::WriteRequestPB req;
+    std::unique_ptr<WriteOperationState> state;
+  };
+
+  // Applies the insert of (key, value) the way OperationDriver does: a group applied write is
+  // finished by the group apply callback, any other write flushes the group first and is finished
+  // right away. Finished writes are recorded in finished_.
+  void Apply(int32_t key, int32_t value) {
+    writes_.emplace_back();
+    auto& write = writes_.back();
+
+    YBPartialRow row(&client_schema_);
+    ASSERT_OK(row.SetInt32(0, key));
+    ASSERT_OK(row.SetInt32(1, value));
+    ASSERT_OK(SchemaToPB(client_schema_, write.req.mutable_schema()));
+    RowOperationsPBEncoder encoder(write.req.mutable_row_operations());
+    encoder.Add(RowOperationsPB::INSERT, row);
+
+    write.state.reset(new WriteOperationState(nullptr, &write.req, nullptr));
+    auto* state = write.state.get();
+    ASSERT_OK(tablet()->AcquireLocksAndPerformDocOperations(state));
+    ASSERT_OK(tablet()->DecodeWriteOperations(&client_schema_, state));
+    tablet()->StartOperation(state);
+    state->mutable_op_id()->set_term(0);
+    state->mutable_op_id()->set_index(Singleton<AutoIncrementingCounter>::get()->GetAndIncrement());
+
+    bool group_applied = tablet()->IsGroupApplied(state);
+    if (!group_applied) {
+      tablet()->FlushGroupApply();
+    }
+    tablet()->ApplyRowOperations(state);
+    if (group_applied) {
+      tablet()->AfterGroupApplied([this, state, key] { Finish(state, key); });
+    } else {
+      Finish(state, key);
+    }
+  }
+
+  void Finish(WriteOperationState* state, int32_t key) {
+    TxResultPB result;
+    state->ReleaseTxResultPB(&result);
+    state->Commit();
+    state->ReleaseDocDbLocks(tablet().get());
+    state->ReleaseSchemaLock();
+
+    std::lock_guard<std::mutex> lock(finished_mutex_);
+    finished_.push_back(key);
+  }
+
+  std::vector<int32_t> Finished() {
+    std::lock_guard<std::mutex> lock(finished_mutex_);
+    return finished_;
+  }
+
+  std::vector<std::string> Rows() {
+    std::vector<std::string> rows;
+    CHECK_OK(DumpTablet(*tablet(), client_schema_, &rows));
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  }
+
+  static std::string Row(int32_t key, int32_t value) {
+    return strings::Substitute("(int32 key=$0, int32 c1=$1)", key, value);
+  }
+
+  uint64_t GroupWrites() {
+    return tablet()->metrics()->operations_per_rocksdb_write->TotalCount();
+  }
+
+  std::deque<Write> writes_;
+  std::mutex finished_mutex_;
+  std::vector<int32_t> finished_;
+};
+
+TEST_F(GroupApplyTest, FinishInOrder) {
+  const auto writes_before = GroupWrites();
+
+  tablet()->StartGroupApply();
+  for (int32_t key = 1; key <= 3; ++key) {
+    Apply(key, key * 10);
+  }
+  // Nothing is written or finished until the group is flushed.
+  ASSERT_TRUE(Finished().empty());
+  ASSERT_EQ(writes_before, GroupWrites());
+
+  tablet()->FinishGroupApply();
+  ASSERT_EQ(std::vector<int32_t>({1, 2, 3}), Finished());
+  ASSERT_EQ(writes_before + 1, GroupWrites());
+  ASSERT_EQ(std::vector<std::string>({Row(1, 10), Row(2, 20), Row(3, 30)}), Rows());
+}
+
+TEST_F(GroupApplyTest, FlushFullGroup) {
+  const auto writes_before = GroupWrites();
+
+  tablet()->StartGroupApply();
+  for (int32_t key = 1; key <= kMaxGroupApplyOperations + 1; ++key) {
+    Apply(key, key);
+  }
+  // The full group is written as soon as its last operation is applied.
+  ASSERT_EQ(std::vector<int32_t>({1, 2, 3, 4}), Finished());
+  ASSERT_EQ(writes_before + 1, GroupWrites());
+
+  tablet()->FinishGroupApply();
+  ASSERT_EQ(std::vector<int32_t>({1, 2, 3, 4, 5}), Finished());
+  ASSERT_EQ(writes_before + 2, GroupWrites());
+}
+
+// An operation that is not part of the group, applied by another thread in the middle of the
+// group, has to see the operations grouped before it written and finished, and must not wait for
+// the group to finish.
+TEST_F(GroupApplyTest, WriteOutsideOfGroup) {
+  tablet()->StartGroupApply();
+  Apply(1, 10);
+  Apply(2, 20);
+
+  std::thread thread([this] { Apply(3, 30); });
+  thread.join();
+  ASSERT_EQ(std::vector<int32_t>({1, 2, 3}), Finished());
+  ASSERT_EQ(std::vector<std::string>({Row(1, 10), Row(2, 20), Row(3, 30)}), Rows());
+
+  Apply(4, 40);
+  tablet()->FinishGroupApply();
+  ASSERT_EQ(std::vector<int32_t>({1, 2, 3, 4}), Finished());
+  ASSERT_EQ(Row(4, 40), Rows().back());
+}
+
+// The group could be flushed by another thread while it is still open.
+TEST_F(GroupApplyTest, FlushFromAnotherThread) {
+  tablet()->StartGroupApply();
+  Apply(1, 10);
+  Apply(2, 20);
+
+  std::thread thread([this] { tablet()->FlushGroupApply(); });
+  thread.join();
+  ASSERT_EQ(std::vector<int32_t>({1, 2}), Finished());
+
+  Apply(3, 30);
+  ASSERT_EQ(std::vector<int32_t>({1, 2}), Finished());
+  tablet()->FinishGroupApply();
+  ASSERT_EQ(std::vector<int32_t>({1, 2, 3}), Finished());
+  ASSERT_EQ(std::vector<std::string>({Row(1, 10), Row(2, 20), Row(3, 30)}), Rows());
+}
+
+// If the group apply is interrupted before it is finished, the grouped operations are written and
+// finished on shutdown.
+TEST_F(GroupApplyTest, FlushOnShutdown) {
+  const auto writes_before = GroupWrites();
+
+  tablet()->StartGroupApply();
+  Apply(1, 10);
+  Apply(2, 20);
+  ASSERT_TRUE(Finished().empty());
+
+  tablet()->Shutdown();
+  ASSERT_EQ(std::vector<int32_t>({1, 2}), Finished());
+  ASSERT_EQ(writes_before + 1, GroupWrites());
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,173 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "yb/tablet/local_tablet_writer.h"
+#include "yb/tablet/maintenance_manager.h"
+#include "yb/tablet/tablet-test-util.h"
+#include "yb/tablet/tablet.pb.h"
+#include "yb/tablet/tablet_mm_ops.h"
+#include "yb/util/countdown_latch.h"
+#include "yb/util/test_macros.h"
+
+DECLARE_double(history_gc_full_compaction_garbage_ratio);
+DECLARE_int32(history_gc_full_compaction_min_reclaimable_mb);
+DECLARE_int32(history_gc_full_compaction_server_interval_secs);
+DECLARE_int32(history_gc_estimate_interval_secs);
+DECLARE_int32(timestamp_history_retention_interval_sec);
+
+namespace yb {
+namespace tablet {
+
+class HistoryGCCompactionsTest : public YBTest {
+};
+
+TEST_F(HistoryGCCompactionsTest, OneAtATimeAndServerInterval) {
+  FLAGS_history_gc_full_compaction_server_interval_secs = 60;
+  HistoryGCCompactions compactions;
+  const MonoTime start = MonoTime::Now(MonoTime::FINE);
+  const MonoTime after_interval = start + MonoDelta::FromSeconds(61);
+  ASSERT_TRUE(compactions.CanStart(start));
+  ASSERT_TRUE(compactions.TryReserve(start));
+
+  // Nothing else starts while the compaction runs, even once the interval has passed.
+  CountDownLatch release(1);
+  ASSERT_OK(compactions.Run([&release] { release.Wait(); }));
+  ASSERT_FALSE(compactions.CanStart(after_interval));
+  ASSERT_FALSE(compactions.TryReserve(after_interval));
+  release.CountDown();
+  compactions.Wait();
+
+  ASSERT_FALSE(compactions.CanStart(start + MonoDelta::FromSeconds(59)));
+  ASSERT_FALSE(compactions.TryReserve(start + MonoDelta::FromSeconds(59)));
+  ASSERT_TRUE(compactions.TryReserve(after_interval));
+  ASSERT_OK(compactions.Run([] {}));
+  compactions.Wait();
+}
+
+class HistoryGCCompactionOpTest : public YBTabletTest {
+ public:
+  HistoryGCCompactionOpTest()
+      : YBTabletTest(Schema({ ColumnSchema("key", INT32), ColumnSchema("c1", INT32) }, 1),
+                     YQL_TABLE_TYPE) {
+  }
+
+  void SetUp() override {
+    // Overwritten versions become garbage right away.
+    FLAGS_timestamp_history_retention_interval_sec = 0;
+    FLAGS_history_gc_full_compaction_garbage_ratio = 0.1;
+    FLAGS_history_gc_full_compaction_min_reclaimable_mb = 0;
+    FLAGS_history_gc_estimate_interval_secs = 0;
+    compactions_ = std::make_shared<HistoryGCCompactions>();
+    tablet_options_.history_gc_compactions = compactions_;
+    YBTabletTest::SetUp();
+  }
+
+ protected:
+  // Overwrites the same row a few times and flushes it, so that most of the new SST file is
+  // garbage. The write of another row at the end moves the history cutoff past the last overwrite.
+  void WriteGarbage() {
+    LocalTabletWriter writer(tablet().get(), &client_schema_);
+    YBPartialRow row(&client_schema_);
+    for (int32_t i = 0; i <= 10; ++i) {
+      ASSERT_OK(row.SetInt32(0, i < 10 ? 1 : 2));
+      ASSERT_OK(row.SetInt32(1, i));
+      ASSERT_OK(writer.Insert(row));
+    }
+    ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+  }
+
+  int NumRegisteredHistoryGCOps(MaintenanceManager* manager) {
+    MaintenanceManagerStatusPB status;
+    manager->GetMaintenanceManagerStatusDump(&status);
+    int result = 0;
+    for (const auto& op : status.registered_operations()) {
+      if (op.name().find("HistoryGCCompactionOp") == 0) {
+        ++result;
+      }
+    }
+    return result;
+  }
+
+  std::shared_ptr<HistoryGCCompactions> compactions_;
+};
+
+TEST_F(HistoryGCCompactionOpTest, Scheduling) {
+  FLAGS_history_gc_full_compaction_server_interval_secs = 0;
+  ASSERT_NO_FATALS(WriteGarbage());
+
+  // Two ops of the same tablet stand in for the ops of two tablets of the server.
+  HistoryGCCompactionOp op(tablet().get(), compactions_);
+  HistoryGCCompactionOp other_op(tablet().get(), compactions_);
+  MaintenanceOpStats stats;
+  op.UpdateStats(&stats);
+  ASSERT_TRUE(stats.runnable());
+  ASSERT_GT(stats.perf_improvement(), 0);
+
+  // Once one of them is about to compact, the other one has to wait.
+  ASSERT_TRUE(op.Prepare());
+  other_op.UpdateStats(&stats);
+  ASSERT_FALSE(stats.runnable());
+  ASSERT_FALSE(other_op.Prepare());
+  op.Perform();
+  compactions_->Wait();
+  ASSERT_EQ(1U, tablet()->metrics()->history_gc_compact_duration->TotalCount());
+
+  // The compaction collected the garbage, so there is nothing left to compact.
+  op.UpdateStats(&stats);
+  ASSERT_FALSE(stats.runnable());
+  ASSERT_EQ(0U, tablet()->ReclaimableBytesEstimate());
+
+  // New garbage is not compacted before the server interval passes.
+  FLAGS_history_gc_full_compaction_server_interval_secs = 3600;
+  ASSERT_NO_FATALS(WriteGarbage());
+  other_op.UpdateStats(&stats);
+  ASSERT_GT(tablet()->ReclaimableBytesEstimate(), 0U);
+  ASSERT_FALSE(stats.runnable());
+  ASSERT_FALSE(other_op.Prepare());
+
+  // Nor by the op that compacted the tablet last, before the tablet interval passes.
+  FLAGS_history_gc_full_compaction_server_interval_secs = 0;
+  op.UpdateStats(&stats);
+  ASSERT_FALSE(stats.runnable());
+  other_op.UpdateStats(&stats);
+  ASSERT_TRUE(stats.runnable());
+}
+
+TEST_F(HistoryGCCompactionOpTest, NotRegisteredWithoutHistoryGCCompactions) {
+  MaintenanceManager::Options options;
+  options.num_threads = 1;
+  options.polling_interval_ms = 1000;
+  options.history_size = 4;
+  auto manager = std::make_shared<MaintenanceManager>(options);
+  ASSERT_OK(manager->Init());
+
+  tablet()->RegisterMaintenanceOps(manager.get());
+  ASSERT_EQ(1, NumRegisteredHistoryGCOps(manager.get()));
+  tablet()->UnregisterMaintenanceOps();
+
+  // Like the master's sys catalog tablet.
+  tablet_options_.history_gc_compactions.reset();
+  TabletReOpen();
+  tablet()->RegisterMaintenanceOps(manager.get());
+  ASSERT_EQ(0, NumRegisteredHistoryGCOps(manager.get()));
+  tablet()->UnregisterMaintenanceOps();
+
+  manager->Shutdown();
+}
+
+} // namespace tablet
+} // namespace yb
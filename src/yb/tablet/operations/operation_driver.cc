@@ -37,8 +37,10 @@
 #include "yb/client/client.h"
 #include "yb/consensus/consensus.h"
 #include "yb/gutil/strings/strcat.h"
+#include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/operations/operation_tracker.h"
+#include "yb/tablet/operations/write_operation.h"
 #include "yb/util/debug-util.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/logging.h"
@@ -428,38 +430,73 @@ void OperationDriver::ApplyTask() {
   // and end up calling Finalize() while we're still in this code.
   scoped_refptr<OperationDriver> ref(this);
 
-  {
-    gscoped_ptr<CommitMsg> commit_msg;
-    CHECK_OK(operation_->Apply(&commit_msg));
-    if (commit_msg) {
-      commit_msg->mutable_commited_op_id()->CopyFrom(op_id_copy_);
+  // Consecutive committed non-transactional writes of key-value tables could be written to RocksDB
+  // together, see Tablet::StartGroupApply(). Any other operation is applied after the writes
+  // before it.
+  auto* tablet_peer = mutable_state()->tablet_peer();
+  Tablet* tablet = table_type_ != TableType::KUDU_COLUMNAR_TABLE_TYPE && tablet_peer != nullptr
+      ? tablet_peer->tablet() : nullptr;
+  bool group_applied = false;
+  if (tablet != nullptr) {
+    group_applied = operation_->operation_type() == Operation::WRITE_TXN &&
+                    tablet->IsGroupApplied(down_cast<WriteOperationState*>(mutable_state()));
+    if (!group_applied) {
+      tablet->FlushGroupApply();
     }
+  }
 
-    // If the client requested COMMIT_WAIT as the external consistency mode
-    // calculate the latest that the prepare hybrid_time could be and wait
-    // until now.earliest > prepare_latest. Only after this are the locks
-    // released.
-    if (mutable_state()->external_consistency_mode() == COMMIT_WAIT) {
-      // TODO: only do this on the leader side
-      TRACE("APPLY: Commit Wait.");
-      // If we can't commit wait and have already applied we might have consistency
-      // issues if we still reply to the client that the operation was a success.
-      // On the other hand we don't have rollbacks as of yet thus we can't undo the
-      // the apply either, so we just CHECK_OK for now.
-      CHECK_OK(CommitWait());
-    }
+  gscoped_ptr<CommitMsg> commit_msg;
+  CHECK_OK(operation_->Apply(&commit_msg));
+  if (commit_msg) {
+    commit_msg->mutable_commited_op_id()->CopyFrom(op_id_copy_);
+  }
 
-    operation_->PreCommit();
+  if (group_applied) {
+    // We only write the "commit" records for legacy Kudu tables, so there is no commit message to
+    // pass.
+    tablet->AfterGroupApplied([ref]() {
+      ref->FinishApplyTask(gscoped_ptr<CommitMsg>());
+    });
+  } else {
+    FinishApplyTask(commit_msg.Pass());
+  }
+}
 
-    // We only write the "commit" records to the local log for legacy Kudu tables. We are not
-    // writing these records for RocksDB-based tables.
-    if (table_type_ == TableType::KUDU_COLUMNAR_TABLE_TYPE) {
-      TRACE_EVENT1("operation", "AsyncAppendCommit", "operation", this);
-      CHECK_OK(log_->AsyncAppendCommit(commit_msg.Pass(), Bind(DoNothingStatusCB)));
-    }
+void OperationDriver::FinishApplyTask(gscoped_ptr<CommitMsg> commit_msg) {
+  ADOPT_TRACE(trace());
+
+  // If the client requested COMMIT_WAIT as the external consistency mode
+  // calculate the latest that the prepare hybrid_time could be and wait
+  // until now.earliest > prepare_latest. Only after this are the locks
+  // released.
+  if (mutable_state()->external_consistency_mode() == COMMIT_WAIT) {
+    // TODO: only do this on the leader side
+    TRACE("APPLY: Commit Wait.");
+    // If we can't commit wait and have already applied we might have consistency
+    // issues if we still reply to the client that the operation was a success.
+    // On the other hand we don't have rollbacks as of yet thus we can't undo the
+    // the apply either, so we just CHECK_OK for now.
+    CHECK_OK(CommitWait());
+  }
+
+  operation_->PreCommit();
 
-    Finalize();
+  // Operations of key-value tables are applied in index order, so every operation up to this one
+  // is applied now, which may let a follower serve reads at a newer propagated safe time.
+  auto* tablet_peer = mutable_state()->tablet_peer();
+  if (table_type_ != TableType::KUDU_COLUMNAR_TABLE_TYPE && tablet_peer != nullptr &&
+      tablet_peer->tablet() != nullptr) {
+    tablet_peer->tablet()->propagated_safe_time()->Applied(op_id_copy_.index());
   }
+
+  // We only write the "commit" records to the local log for legacy Kudu tables. We are not
+  // writing these records for RocksDB-based tables.
+  if (table_type_ == TableType::KUDU_COLUMNAR_TABLE_TYPE) {
+    TRACE_EVENT1("operation", "AsyncAppendCommit", "operation", this);
+    CHECK_OK(log_->AsyncAppendCommit(commit_msg.Pass(), Bind(DoNothingStatusCB)));
+  }
+
+  Finalize();
 }
 
 Status OperationDriver::CommitWait() {
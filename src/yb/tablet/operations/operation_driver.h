@@ -234,6 +234,10 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
   // results from the Apply().
   void ApplyTask();
 
+  // The part of ApplyTask() after Operation::Apply(). For operations added to the group apply of
+  // the tablet, it is deferred until the group is written to RocksDB.
+  void FinishApplyTask(gscoped_ptr<consensus::CommitMsg> commit_msg);
+
   // Sleeps until the operation is allowed to commit based on the
   // requested consistency mode.
   CHECKED_STATUS CommitWait();
@@ -0,0 +1,80 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "yb/tablet/propagated_safe_time.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace tablet {
+
+class PropagatedSafeTimeTest : public YBTest {
+};
+
+TEST_F(PropagatedSafeTimeTest, AdvancesWhenApplied) {
+  PropagatedSafeTime safe_time;
+  ASSERT_FALSE(safe_time.Get().is_valid());
+
+  safe_time.Update(10, HybridTime(100));
+  safe_time.Update(20, HybridTime(200));
+  ASSERT_FALSE(safe_time.Get().is_valid());
+
+  safe_time.Applied(9);
+  ASSERT_FALSE(safe_time.Get().is_valid());
+  safe_time.Applied(15);
+  ASSERT_EQ(HybridTime(100), safe_time.Get());
+  safe_time.Applied(20);
+  ASSERT_EQ(HybridTime(200), safe_time.Get());
+
+  // Already applied, so the safe time advances immediately. Stale updates are ignored.
+  safe_time.Update(20, HybridTime(250));
+  ASSERT_EQ(HybridTime(250), safe_time.Get());
+  safe_time.Update(21, HybridTime(150));
+  safe_time.Applied(30);
+  ASSERT_EQ(HybridTime(250), safe_time.Get());
+}
+
+TEST_F(PropagatedSafeTimeTest, BoundedPending) {
+  PropagatedSafeTime safe_time;
+  constexpr int kUpdates = 10000;
+  for (int i = 1; i <= kUpdates; ++i) {
+    safe_time.Update(i, HybridTime(i * 10));
+  }
+  safe_time.Applied(kUpdates / 2);
+  ASSERT_TRUE(safe_time.Get().is_valid());
+  ASSERT_LE(safe_time.Get(), HybridTime(kUpdates / 2 * 10));
+  safe_time.Applied(kUpdates);
+  ASSERT_EQ(HybridTime(kUpdates * 10), safe_time.Get());
+}
+
+TEST_F(PropagatedSafeTimeTest, WaitFor) {
+  PropagatedSafeTime safe_time;
+  safe_time.Update(5, HybridTime(100));
+
+  auto deadline = MonoTime::FineNow() + MonoDelta::FromMilliseconds(50);
+  ASSERT_FALSE(safe_time.WaitFor(HybridTime(100), deadline).is_valid());
+
+  std::thread applier([&safe_time] {
+    SleepFor(MonoDelta::FromMilliseconds(100));
+    safe_time.Applied(5);
+  });
+  deadline = MonoTime::FineNow() + MonoDelta::FromSeconds(30);
+  ASSERT_EQ(HybridTime(100), safe_time.WaitFor(HybridTime(100), deadline));
+  applier.join();
+}
+
+}  // namespace tablet
+}  // namespace yb
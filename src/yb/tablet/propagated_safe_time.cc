@@ -0,0 +1,85 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/propagated_safe_time.h"
+
+#include <algorithm>
+
+namespace yb {
+namespace tablet {
+
+void PropagatedSafeTime::Update(int64_t op_index, HybridTime safe_time) {
+  if (!safe_time.is_valid()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (safe_time_.is_valid() && safe_time <= safe_time_) {
+    return;
+  }
+  if (!pending_.empty()) {
+    auto& last = pending_.back();
+    if (safe_time <= last.second) {
+      return;
+    }
+    if (op_index <= last.first || pending_.size() >= kMaxPending) {
+      last = std::make_pair(std::max(op_index, last.first), safe_time);
+      AdvanceUnlocked();
+      return;
+    }
+  }
+  pending_.emplace_back(op_index, safe_time);
+  AdvanceUnlocked();
+}
+
+void PropagatedSafeTime::Applied(int64_t op_index) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (op_index <= applied_index_) {
+    return;
+  }
+  applied_index_ = op_index;
+  AdvanceUnlocked();
+}
+
+void PropagatedSafeTime::AdvanceUnlocked() {
+  bool advanced = false;
+  while (!pending_.empty() && pending_.front().first <= applied_index_) {
+    safe_time_ = pending_.front().second;
+    pending_.pop_front();
+    advanced = true;
+  }
+  if (advanced) {
+    cond_.notify_all();
+  }
+}
+
+HybridTime PropagatedSafeTime::Get() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return safe_time_;
+}
+
+HybridTime PropagatedSafeTime::WaitFor(HybridTime min_safe_time, const MonoTime& deadline) const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    if (safe_time_.is_valid() && safe_time_ >= min_safe_time) {
+      return safe_time_;
+    }
+    const MonoDelta left = deadline.GetDeltaSince(MonoTime::FineNow());
+    if (left.ToNanoseconds() <= 0) {
+      return safe_time_;
+    }
+    cond_.wait_for(lock, std::chrono::nanoseconds(left.ToNanoseconds()));
+  }
+}
+
+}  // namespace tablet
+}  // namespace yb
@@ -0,0 +1,76 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_PROPAGATED_SAFE_TIME_H
+#define YB_TABLET_PROPAGATED_SAFE_TIME_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+#include "yb/common/hybrid_time.h"
+#include "yb/gutil/macros.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace tablet {
+
+// Tracks the hybrid time a follower is able to serve reads at, based on the safe time propagated
+// by the leader with Raft requests.
+//
+// The leader sends the safe time of its tablet along with its committed index, reading the safe
+// time first. Every operation with a hybrid time at or below that safe time was already applied
+// on the leader, so its index is at or before the committed index. Once this replica has applied
+// all operations up to that index, reading at the propagated safe time observes all of them.
+class PropagatedSafeTime {
+ public:
+  PropagatedSafeTime() {}
+
+  // Records that reading at 'safe_time' becomes safe once operations up to 'op_index' are applied.
+  void Update(int64_t op_index, HybridTime safe_time);
+
+  // Notifies that all operations up to 'op_index' have been applied on this replica.
+  void Applied(int64_t op_index);
+
+  // Returns the latest safe time whose operations have all been applied, or an invalid hybrid time
+  // if none is known yet.
+  HybridTime Get() const;
+
+  // Waits until the safe time is at least 'min_safe_time' or until 'deadline', and returns the safe
+  // time at that point.
+  HybridTime WaitFor(HybridTime min_safe_time, const MonoTime& deadline) const;
+
+ private:
+  // Maximum number of safe times waiting for their operations to be applied. When a lagging
+  // follower reaches it, the newest entry is overwritten, which only delays the safe time.
+  static constexpr size_t kMaxPending = 256;
+
+  void AdvanceUnlocked();
+
+  mutable std::mutex mutex_;
+  mutable std::condition_variable cond_;
+
+  int64_t applied_index_ = 0;
+  HybridTime safe_time_;
+
+  // Pairs of (op index, safe time), both increasing.
+  std::deque<std::pair<int64_t, HybridTime>> pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(PropagatedSafeTime);
+};
+
+}  // namespace tablet
+}  // namespace yb
+
+#endif  // YB_TABLET_PROPAGATED_SAFE_TIME_H
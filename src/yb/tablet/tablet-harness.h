@@ -90,6 +90,7 @@ class TabletHarness {
     string root_dir;
     TableType table_type;
     bool enable_metrics;
+    TabletOptions tablet_options;
   };
 
   TabletHarness(const Schema& schema, Options options)
@@ -123,13 +124,12 @@ class TabletHarness {
     }
 
     clock_ = server::LogicalClock::CreateStartingAt(HybridTime::kInitialHybridTime);
-    TabletOptions tablet_options;
     tablet_.reset(new TabletClass(metadata,
                                   clock_,
                                   std::shared_ptr<MemTracker>(),
                                   metrics_registry_.get(),
                                   new log::LogAnchorRegistry(),
-                                  tablet_options,
+                                  options_.tablet_options,
                                   nullptr /* transaction_participant_context */,
                                   nullptr /* transaction_coordinator_context */));
     return Status::OK();
@@ -82,6 +82,7 @@ class YBTabletTest : public YBTest {
     TabletHarness::Options opts(dir);
     opts.enable_metrics = true;
     opts.table_type = table_type_;
+    opts.tablet_options = tablet_options_;
     bool first_time = harness_ == NULL;
     harness_.reset(new TabletHarness(schema_, opts));
     CHECK_OK(harness_->Create(first_time));
@@ -134,6 +135,8 @@ class YBTabletTest : public YBTest {
   const Schema schema_;
   const Schema client_schema_;
   TableType table_type_;
+  // Options the test tablet is created with.
+  TabletOptions tablet_options_;
 
   gscoped_ptr<TabletHarness> harness_;
 };
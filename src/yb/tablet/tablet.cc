@@ -113,6 +113,7 @@
 #include "yb/util/slice.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/string_packer.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/trace.h"
 #include "yb/util/url-coding.h"
 
@@ -136,6 +137,41 @@ DEFINE_double(tablet_bloom_target_fp_rate, 0.01f,
               "required for bloom filters.");
 TAG_FLAG(tablet_bloom_target_fp_rate, advanced);
 
+DEFINE_int32(max_group_apply_operations, 128,
+             "The maximum number of consecutive committed non-transactional write operations "
+             "applied to RocksDB with a single write. 1 disables group apply.");
+TAG_FLAG(max_group_apply_operations, advanced);
+
+DEFINE_double(history_gc_full_compaction_garbage_ratio, 0.3,
+              "Schedule a full compaction of a key-value tablet once the estimated fraction of its "
+              "SST file bytes that could be garbage-collected reaches this ratio. A value of 0 or "
+              "less disables these compactions.");
+TAG_FLAG(history_gc_full_compaction_garbage_ratio, advanced);
+TAG_FLAG(history_gc_full_compaction_garbage_ratio, runtime);
+
+DEFINE_int32(history_gc_full_compaction_min_reclaimable_mb, 64,
+             "Only schedule a full compaction for history garbage collection if it is estimated "
+             "to reclaim at least this many megabytes.");
+TAG_FLAG(history_gc_full_compaction_min_reclaimable_mb, advanced);
+TAG_FLAG(history_gc_full_compaction_min_reclaimable_mb, runtime);
+
+DEFINE_int32(history_gc_full_compaction_tablet_interval_secs, 3600,
+             "Minimum time between two full compactions of the same tablet scheduled for history "
+             "garbage collection.");
+TAG_FLAG(history_gc_full_compaction_tablet_interval_secs, advanced);
+TAG_FLAG(history_gc_full_compaction_tablet_interval_secs, runtime);
+
+DEFINE_int32(history_gc_full_compaction_server_interval_secs, 60,
+             "Minimum time between the starts of two full compactions scheduled for history "
+             "garbage collection on this server, across all tablets. Only one of them runs at a "
+             "time.");
+TAG_FLAG(history_gc_full_compaction_server_interval_secs, advanced);
+TAG_FLAG(history_gc_full_compaction_server_interval_secs, runtime);
+
+DEFINE_int32(history_gc_estimate_interval_secs, 60,
+             "How often the estimate of the garbage in the SST files of a tablet is refreshed.");
+TAG_FLAG(history_gc_estimate_interval_secs, advanced);
+
 METRIC_DEFINE_entity(tablet);
 METRIC_DEFINE_gauge_size(tablet, memrowset_size, "MemRowSet Memory Usage",
                          yb::MetricUnit::kBytes,
@@ -143,6 +179,14 @@ METRIC_DEFINE_gauge_size(tablet, memrowset_size, "MemRowSet Memory Usage",
 METRIC_DEFINE_gauge_size(tablet, on_disk_size, "Tablet Size On Disk",
                          yb::MetricUnit::kBytes,
                          "Size of this tablet on disk.");
+METRIC_DEFINE_gauge_size(tablet, reserved_block_cache_usage, "Reserved Block Cache Memory Usage",
+                         yb::MetricUnit::kBytes,
+                         "Memory used by the block cache reserved for the table of this tablet, "
+                         "shared by the tablets of the table on this server.");
+METRIC_DEFINE_gauge_size(tablet, docdb_reclaimable_bytes, "DocDB Reclaimable Bytes",
+                         yb::MetricUnit::kBytes,
+                         "Estimated key/value bytes in the SST files of this tablet that a full "
+                         "compaction could garbage-collect.");
 
 using namespace std::placeholders;
 
@@ -354,6 +398,17 @@ Tablet::Tablet(
     METRIC_on_disk_size.InstantiateFunctionGauge(
             metric_entity_, Bind(&Tablet::EstimateOnDiskSize, Unretained(this)))
         ->AutoDetach(&metric_detacher_);
+    // Block cache hits and misses of the tablet are reported with the RocksDB statistics.
+    if (tablet_options_.block_cache_reserved) {
+      METRIC_reserved_block_cache_usage.InstantiateFunctionGauge(
+              metric_entity_, Bind(&Tablet::ReservedBlockCacheUsage, Unretained(this)))
+          ->AutoDetach(&metric_detacher_);
+    }
+    if (table_type_ != TableType::KUDU_COLUMNAR_TABLE_TYPE) {
+      METRIC_docdb_reclaimable_bytes.InstantiateFunctionGauge(
+              metric_entity_, Bind(&Tablet::ReclaimableBytesEstimate, Unretained(this)))
+          ->AutoDetach(&metric_detacher_);
+    }
   }
 
   if (transaction_participant_context) {
@@ -402,7 +457,8 @@ Status Tablet::Open() {
 
 Status Tablet::OpenKeyValueTablet() {
   rocksdb::Options rocksdb_options;
-  docdb::InitRocksDBOptions(&rocksdb_options, tablet_id(), rocksdb_statistics_, tablet_options_);
+  docdb::InitRocksDBOptions(&rocksdb_options, tablet_id(), rocksdb_statistics_, tablet_options_,
+                            &schema()->table_properties());
 
   // Install the history cleanup handler. Note that TabletRetentionPolicy is going to hold a raw ptr
   // to this tablet. So, we ensure that rocksdb_ is reset before this tablet gets destroyed.
@@ -491,6 +547,11 @@ void Tablet::Shutdown() {
     transaction_coordinator_->Shutdown();
   }
 
+  // Write the operations that were applied as part of a group, but not written yet.
+  if (rocksdb_) {
+    FlushGroupApply();
+  }
+
   std::lock_guard<rw_spinlock> lock(component_lock_);
   components_ = nullptr;
   // Shutdown the RocksDB instance for this table, if present.
@@ -813,7 +874,26 @@ void Tablet::StartApplying(WriteOperationState* operation_state) {
   }
 }
 
+namespace {
+
+const KeyValueWriteBatchPB& GetPutBatch(WriteOperationState* operation_state) {
+  return operation_state->consensus_round() && operation_state->consensus_round()->replicate_msg()
+      // Online case.
+      ? operation_state->consensus_round()->replicate_msg()->write_request().write_batch()
+      // Bootstrap case.
+      : operation_state->request()->write_batch();
+}
+
+} // namespace
+
 void Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
+  if (IsGroupApplied(operation_state)) {
+    std::lock_guard<std::mutex> lock(group_apply_mutex_);
+    AddRowOperationsToWriteBatch(operation_state, group_apply_batch_.get());
+    ++group_apply_operations_;
+    return;
+  }
+
   last_committed_write_index_.store(operation_state->op_id().index(), std::memory_order_release);
   StartApplying(operation_state);
   switch (table_type_) {
@@ -825,12 +905,7 @@ void Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
     }
     case TableType::YQL_TABLE_TYPE:
     case TableType::REDIS_TABLE_TYPE: {
-      const KeyValueWriteBatchPB& put_batch =
-          operation_state->consensus_round() && operation_state->consensus_round()->replicate_msg()
-              // Online case.
-              ? operation_state->consensus_round()->replicate_msg()->write_request().write_batch()
-              // Bootstrap case.
-              : operation_state->request()->write_batch();
+      const KeyValueWriteBatchPB& put_batch = GetPutBatch(operation_state);
 
       ApplyKeyValueRowOperations(put_batch,
                                  operation_state->op_id(),
@@ -934,12 +1009,43 @@ void Tablet::ApplyKeyValueRowOperations(const KeyValueWriteBatchPB& put_batch,
     PrepareNonTransactionWriteBatch(put_batch, hybrid_time, rocksdb_write_batch);
   }
 
+  flush_stats_->AboutToWriteToDb(hybrid_time);
+  WriteToRocksDB(rocksdb_write_batch);
+  if (metrics_) {
+    metrics_->operations_per_rocksdb_write->Increment(1);
+  }
+}
+
+void Tablet::AddRowOperationsToWriteBatch(WriteOperationState* operation_state,
+                                          rocksdb::WriteBatch* rocksdb_write_batch) {
+  DCHECK_NE(table_type_, TableType::KUDU_COLUMNAR_TABLE_TYPE);
+  last_committed_write_index_.store(operation_state->op_id().index(), std::memory_order_release);
+  StartApplying(operation_state);
+
+  const KeyValueWriteBatchPB& put_batch = GetPutBatch(operation_state);
+  DCHECK(!put_batch.has_transaction());
+  if (put_batch.kv_pairs_size() == 0) {
+    return;
+  }
+
+  // The batch ends up with the OpId of the last operation added to it, just like the batches
+  // merged by RocksDB in a write group.
+  const auto& op_id = operation_state->op_id();
+  rocksdb_write_batch->SetUserOpId(rocksdb::OpId(op_id.term(), op_id.index()));
+  PrepareNonTransactionWriteBatch(put_batch, operation_state->hybrid_time(), rocksdb_write_batch);
+  flush_stats_->AboutToWriteToDb(operation_state->hybrid_time());
+}
+
+void Tablet::WriteToRocksDB(rocksdb::WriteBatch* rocksdb_write_batch) {
+  if (rocksdb_write_batch->Count() == 0) {
+    return;
+  }
+
   // We are using Raft replication index for the RocksDB sequence number for
   // all members of this write batch.
   rocksdb::WriteOptions write_options;
   InitRocksDBWriteOptions(&write_options);
 
-  flush_stats_->AboutToWriteToDb(hybrid_time);
   auto rocksdb_write_status = rocksdb_->Write(write_options, rocksdb_write_batch);
   if (!rocksdb_write_status.ok()) {
     LOG(FATAL) << "Failed to write a batch with " << rocksdb_write_batch->Count() << " operations"
@@ -947,6 +1053,74 @@ void Tablet::ApplyKeyValueRowOperations(const KeyValueWriteBatchPB& put_batch,
   }
 }
 
+void Tablet::StartGroupApply() {
+  if (table_type_ == TableType::KUDU_COLUMNAR_TABLE_TYPE || FLAGS_max_group_apply_operations <= 1) {
+    return;
+  }
+  // Committed operations are applied by one thread at a time.
+  DCHECK(group_apply_thread_.load(std::memory_order_acquire) == std::thread::id());
+  group_apply_thread_.store(std::this_thread::get_id(), std::memory_order_release);
+}
+
+void Tablet::FinishGroupApply() {
+  if (group_apply_thread_.load(std::memory_order_acquire) != std::this_thread::get_id()) {
+    return;
+  }
+  FlushGroupApply();
+  group_apply_thread_.store(std::thread::id(), std::memory_order_release);
+}
+
+bool Tablet::IsGroupApplied(WriteOperationState* operation_state) const {
+  return group_apply_thread_.load(std::memory_order_acquire) == std::this_thread::get_id() &&
+         !GetPutBatch(operation_state).has_transaction();
+}
+
+void Tablet::AfterGroupApplied(std::function<void()> callback) {
+  DCHECK(group_apply_thread_.load(std::memory_order_acquire) == std::this_thread::get_id());
+  bool full;
+  {
+    std::lock_guard<std::mutex> lock(group_apply_mutex_);
+    group_apply_callbacks_.push_back(std::move(callback));
+    full = group_apply_operations_ >= static_cast<size_t>(FLAGS_max_group_apply_operations);
+  }
+  if (full) {
+    FlushGroupApply();
+  }
+}
+
+void Tablet::FlushGroupApply() {
+  // Waits for the batch swapped out by another thread, if any, to be written.
+  std::lock_guard<std::mutex> write_lock(group_apply_write_mutex_);
+
+  auto batch = std::make_unique<rocksdb::WriteBatch>();
+  size_t operations;
+  std::vector<std::function<void()>> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(group_apply_mutex_);
+    if (group_apply_operations_ == 0 && group_apply_callbacks_.empty()) {
+      return;
+    }
+    batch.swap(group_apply_batch_);
+    operations = group_apply_operations_;
+    group_apply_operations_ = 0;
+    callbacks.swap(group_apply_callbacks_);
+  }
+
+  if (operations > 0) {
+    // The batch has the OpId of the last operation added to it, like the batches of consecutive
+    // operations written by bootstrap.
+    WriteToRocksDB(batch.get());
+    if (metrics_) {
+      metrics_->operations_per_rocksdb_write->Increment(operations);
+    }
+  }
+
+  // Finish the apply of the operations in the group in order.
+  for (auto& callback : callbacks) {
+    callback();
+  }
+}
+
 namespace {
 
 // Separate Redis / QL / row operations write batches from write_request in preparation for the
@@ -1002,6 +1176,30 @@ Status Tablet::HandleRedisReadRequest(HybridTime timestamp,
   return Status::OK();
 }
 
+Status Tablet::HandleRedisReadRequests(
+    HybridTime timestamp, const std::vector<const RedisReadRequestPB*>& redis_read_requests,
+    const std::vector<RedisResponsePB*>& responses) {
+  GUARD_AGAINST_ROCKSDB_SHUTDOWN;
+  DCHECK_EQ(redis_read_requests.size(), responses.size());
+  if (redis_read_requests.size() <= 1) {
+    return AbstractTablet::HandleRedisReadRequests(timestamp, redis_read_requests, responses);
+  }
+
+  // The keys differ, so the bloom filter cannot be used to skip files for all of them.
+  // TODO(dtxn) - pass correct transaction context when we implement cross-shard transactions
+  // support for Redis.
+  auto iter = docdb::CreateIntentAwareIterator(
+      rocksdb_.get(), docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none,
+      rocksdb::kDefaultQueryId, boost::none, timestamp);
+  for (size_t i = 0; i < redis_read_requests.size(); ++i) {
+    ScopedTabletMetricsTracker metrics_tracker(metrics_->redis_read_latency);
+    docdb::RedisReadOperation doc_op(*redis_read_requests[i], iter.get());
+    RETURN_NOT_OK(doc_op.Execute(rocksdb_.get(), timestamp));
+    *responses[i] = std::move(doc_op.response());
+  }
+  return Status::OK();
+}
+
 Status Tablet::HandleQLReadRequest(
     HybridTime timestamp, const QLReadRequestPB& ql_read_request,
     const TransactionMetadataPB& transaction_metadata, QLResponsePB* response,
@@ -1918,6 +2116,173 @@ scoped_refptr<AtomicGauge<uint32_t> > MajorDeltaCompactionOp::RunningGauge() con
   return tablet_->metrics()->delta_major_compact_rs_running;
 }
 
+////////////////////////////////////////////////////////////
+// HistoryGCCompactionOp
+////////////////////////////////////////////////////////////
+
+HistoryGCCompactions::HistoryGCCompactions() {
+  CHECK_OK(ThreadPoolBuilder("history-gc-compact").set_max_threads(1).Build(&pool_));
+}
+
+HistoryGCCompactions::~HistoryGCCompactions() {
+  pool_->Shutdown();
+}
+
+bool HistoryGCCompactions::CanStartUnlocked(const MonoTime& now) const {
+  return !running_ &&
+         (!last_start_.Initialized() ||
+          now.GetDeltaSince(last_start_).ToSeconds() >=
+              FLAGS_history_gc_full_compaction_server_interval_secs);
+}
+
+bool HistoryGCCompactions::CanStart(const MonoTime& now) const {
+  std::lock_guard<simple_spinlock> l(lock_);
+  return CanStartUnlocked(now);
+}
+
+bool HistoryGCCompactions::TryReserve(const MonoTime& now) {
+  std::lock_guard<simple_spinlock> l(lock_);
+  if (!CanStartUnlocked(now)) {
+    return false;
+  }
+  running_ = true;
+  last_start_ = now;
+  return true;
+}
+
+Status HistoryGCCompactions::Run(std::function<void()> compaction) {
+  Status s = pool_->SubmitFunc([this, compaction] {
+    compaction();
+    Finished();
+  });
+  if (!s.ok()) {
+    Finished();
+  }
+  return s;
+}
+
+void HistoryGCCompactions::Finished() {
+  std::lock_guard<simple_spinlock> l(lock_);
+  DCHECK(running_);
+  running_ = false;
+}
+
+void HistoryGCCompactions::Wait() {
+  pool_->Wait();
+}
+
+HistoryGCCompactionOp::HistoryGCCompactionOp(Tablet* tablet,
+                                             std::shared_ptr<HistoryGCCompactions> compactions)
+    : MaintenanceOp(Substitute("HistoryGCCompactionOp($0)", tablet->tablet_id()),
+                    MaintenanceOp::HIGH_IO_USAGE),
+      total_bytes_(0),
+      reclaimable_bytes_(0),
+      tablet_(tablet),
+      compactions_(std::move(compactions)) {
+}
+
+HistoryGCCompactionOp::~HistoryGCCompactionOp() {
+  // The tablet is shutting down by now, which cancels the compaction.
+  std::unique_lock<std::mutex> l(compaction_mutex_);
+  compaction_cond_.wait(l, [this] { return !compaction_running_; });
+}
+
+void HistoryGCCompactionOp::UpdateStats(MaintenanceOpStats* stats) {
+  std::lock_guard<simple_spinlock> l(lock_);
+
+  // Reading the properties of all the SST files is too expensive to do on every scheduler run.
+  const MonoTime now = MonoTime::Now(MonoTime::COARSE);
+  if (!last_estimate_time_.Initialized() ||
+      now.GetDeltaSince(last_estimate_time_).ToSeconds() >=
+          FLAGS_history_gc_estimate_interval_secs) {
+    Status s = tablet_->EstimateHistoryGarbage(&total_bytes_, &reclaimable_bytes_);
+    if (!s.ok()) {
+      VLOG(1) << "Failed to estimate the history garbage of " << tablet_->tablet_id() << ": " << s;
+      prev_stats_.set_runnable(false);
+      prev_stats_.set_perf_improvement(0);
+      *stats = prev_stats_;
+      return;
+    }
+    last_estimate_time_ = now;
+  }
+
+  const double garbage_ratio =
+      total_bytes_ == 0 ? 0 : static_cast<double>(reclaimable_bytes_) / total_bytes_;
+  bool runnable = FLAGS_history_gc_full_compaction_garbage_ratio > 0 &&
+                  garbage_ratio >= FLAGS_history_gc_full_compaction_garbage_ratio &&
+                  reclaimable_bytes_ >=
+                      FLAGS_history_gc_full_compaction_min_reclaimable_mb * 1024ULL * 1024 &&
+                  (!last_compaction_time_.Initialized() ||
+                   now.GetDeltaSince(last_compaction_time_).ToSeconds() >=
+                       FLAGS_history_gc_full_compaction_tablet_interval_secs);
+  if (runnable) {
+    std::lock_guard<std::mutex> compaction_lock(compaction_mutex_);
+    runnable = !compaction_running_ && compactions_->CanStart(now);
+  }
+  prev_stats_.set_perf_improvement(runnable ? garbage_ratio : 0);
+  prev_stats_.set_runnable(runnable);
+  *stats = prev_stats_;
+}
+
+bool HistoryGCCompactionOp::Prepare() {
+  // Another tablet could have started a full compaction since UpdateStats().
+  return compactions_->TryReserve(MonoTime::Now(MonoTime::COARSE));
+}
+
+void HistoryGCCompactionOp::Perform() {
+  {
+    std::lock_guard<std::mutex> l(compaction_mutex_);
+    compaction_running_ = true;
+  }
+  Status s = compactions_->Run(std::bind(&HistoryGCCompactionOp::Compact, this));
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to start the full compaction of " << tablet_->tablet_id()
+                 << " for history garbage collection: " << s;
+    std::lock_guard<std::mutex> l(compaction_mutex_);
+    compaction_running_ = false;
+    compaction_cond_.notify_all();
+  }
+}
+
+void HistoryGCCompactionOp::Compact() {
+  uint64_t reclaimable_bytes;
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    reclaimable_bytes = reclaimable_bytes_;
+  }
+  LOG(INFO) << "Running a full compaction of " << tablet_->tablet_id()
+            << " for history garbage collection, estimated to reclaim " << reclaimable_bytes
+            << " bytes";
+  const MonoTime start_time = MonoTime::Now(MonoTime::FINE);
+  tablet_->metrics()->history_gc_compact_running->Increment();
+  WARN_NOT_OK(tablet_->ForceFullRocksDBCompaction(),
+              Substitute("Full compaction for history garbage collection failed on $0",
+                         tablet_->tablet_id()));
+  tablet_->metrics()->history_gc_compact_running->Decrement();
+  tablet_->metrics()->history_gc_compact_duration->Increment(
+      MonoTime::Now(MonoTime::FINE).GetDeltaSince(start_time).ToMilliseconds());
+
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    last_compaction_time_ = MonoTime::Now(MonoTime::COARSE);
+    // Refresh the estimate on the next UpdateStats(), now that the files were rewritten.
+    last_estimate_time_ = MonoTime();
+  }
+
+  // The op can be destroyed as soon as this is reset, so it has to be the last thing we do.
+  std::lock_guard<std::mutex> l(compaction_mutex_);
+  compaction_running_ = false;
+  compaction_cond_.notify_all();
+}
+
+scoped_refptr<Histogram> HistoryGCCompactionOp::DurationHistogram() const {
+  return tablet_->metrics()->history_gc_schedule_duration;
+}
+
+scoped_refptr<AtomicGauge<uint32_t> > HistoryGCCompactionOp::RunningGauge() const {
+  return tablet_->metrics()->history_gc_schedule_running;
+}
+
 ////////////////////////////////////////////////////////////
 // Tablet
 ////////////////////////////////////////////////////////////
@@ -2004,13 +2369,21 @@ void Tablet::GetRowSetsForTests(RowSetVector* out) {
 }
 
 void Tablet::RegisterMaintenanceOps(MaintenanceManager* maint_mgr) {
+  CHECK_EQ(state_, kOpen);
+  DCHECK(maintenance_ops_.empty());
+
   if (table_type_ != TableType::KUDU_COLUMNAR_TABLE_TYPE) {
+    // Only the tablet servers set up history GC compactions, the master's sys catalog tablet is
+    // left alone.
+    if (tablet_options_.history_gc_compactions) {
+      gscoped_ptr<MaintenanceOp> history_gc_compact_op(
+          new HistoryGCCompactionOp(this, tablet_options_.history_gc_compactions));
+      maint_mgr->RegisterOp(history_gc_compact_op.get());
+      maintenance_ops_.push_back(history_gc_compact_op.release());
+    }
     return;
   }
 
-  CHECK_EQ(state_, kOpen);
-  DCHECK(maintenance_ops_.empty());
-
   gscoped_ptr<MaintenanceOp> rs_compact_op(new CompactRowSetsOp(this));
   maint_mgr->RegisterOp(rs_compact_op.get());
   maintenance_ops_.push_back(rs_compact_op.release());
@@ -2549,6 +2922,10 @@ size_t Tablet::MemRowSetLogRetentionSize(const MaxIdxToSegmentMap& max_idx_to_se
                                      max_idx_to_segment_size);
 }
 
+size_t Tablet::ReservedBlockCacheUsage() const {
+  return tablet_options_.block_cache_reserved ? tablet_options_.block_cache->GetUsage() : 0;
+}
+
 size_t Tablet::EstimateOnDiskSize() const {
   scoped_refptr<TabletComponents> comps;
   GetComponents(&comps);
@@ -2906,6 +3283,25 @@ void Tablet::ForceRocksDBCompactInTest() {
   }
 }
 
+Status Tablet::EstimateHistoryGarbage(uint64_t* total_bytes, uint64_t* reclaimable_bytes) {
+  DCHECK_NE(table_type_, TableType::KUDU_COLUMNAR_TABLE_TYPE);
+  GUARD_AGAINST_ROCKSDB_SHUTDOWN;
+  RETURN_NOT_OK(docdb::EstimateReclaimableBytes(
+      rocksdb_.get(), retention_policy_->GetHistoryCutoff(), total_bytes, reclaimable_bytes));
+  reclaimable_bytes_estimate_.store(*reclaimable_bytes);
+  return Status::OK();
+}
+
+Status Tablet::ForceFullRocksDBCompaction() {
+  DCHECK_NE(table_type_, TableType::KUDU_COLUMNAR_TABLE_TYPE);
+  GUARD_AGAINST_ROCKSDB_SHUTDOWN;
+  rocksdb::CompactRangeOptions options;
+  options.canceled = &shutdown_requested_;
+  return rocksdb_->CompactRange(options,
+      /* begin = */ nullptr,
+      /* end = */ nullptr);
+}
+
 std::string Tablet::DocDBDumpStrInTest() {
   return docdb::DocDBDebugDumpToStr(rocksdb_.get());
 }
@@ -2924,6 +3320,15 @@ uint64_t Tablet::GetTotalSSTFileSizes() const {
   return rocksdb_->GetTotalSSTFileSize();
 }
 
+uint64_t Tablet::GetMemTableSize() const {
+  std::lock_guard<rw_spinlock> lock(component_lock_);
+  uint64_t result = 0;
+  if (rocksdb_) {
+    rocksdb_->GetIntProperty(rocksdb::DB::Properties::kCurSizeAllMemTables, &result);
+  }
+  return result;
+}
+
 Result<TransactionOperationContextOpt> Tablet::CreateTransactionOperationContext(
     const TransactionMetadataPB& transaction_metadata) const {
   if (metadata_->schema().table_properties().is_transactional()) {
@@ -2959,8 +3364,9 @@ TransactionOperationContextOpt Tablet::CreateTransactionOperationContext(
   }
 }
 
-ScopedReadOperation::ScopedReadOperation(AbstractTablet* tablet)
-    : tablet_(tablet), timestamp_(tablet_->SafeTimestampToRead()) {
+ScopedReadOperation::ScopedReadOperation(AbstractTablet* tablet, HybridTime read_time)
+    : tablet_(tablet),
+      timestamp_(read_time.is_valid() ? read_time : tablet_->SafeTimestampToRead()) {
   tablet_->RegisterReaderTimestamp(timestamp_);
 }
 
@@ -32,11 +32,13 @@
 #ifndef YB_TABLET_TABLET_H_
 #define YB_TABLET_TABLET_H_
 
+#include <functional>
 #include <iosfwd>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "yb/rocksdb/cache.h"
@@ -69,6 +71,7 @@
 #include "yb/tablet/lock_manager.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/mvcc.h"
+#include "yb/tablet/propagated_safe_time.h"
 #include "yb/tablet/rowset.h"
 #include "yb/tablet/rowset_metadata.h"
 #include "yb/tablet/tablet_metadata.h"
@@ -279,6 +282,39 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Apply all of the row operations associated with this transaction.
   void ApplyRowOperations(WriteOperationState* operation_state);
 
+  // Same as ApplyRowOperations for key-value tables, but only adds the row operations to
+  // 'rocksdb_write_batch' instead of writing them, so that the caller could write the operations
+  // of several consecutive non-transactional writes to RocksDB at once using WriteToRocksDB.
+  void AddRowOperationsToWriteBatch(WriteOperationState* operation_state,
+                                    rocksdb::WriteBatch* rocksdb_write_batch);
+
+  // Writes the given batch to RocksDB, crashing on failure just like ApplyKeyValueRowOperations.
+  void WriteToRocksDB(rocksdb::WriteBatch* rocksdb_write_batch);
+
+  // Starts a group apply: until FinishGroupApply() is called, ApplyRowOperations adds the
+  // non-transactional writes applied by the current thread to one RocksDB write batch instead of
+  // writing each of them separately. Operations applied by other threads meanwhile have to call
+  // FlushGroupApply() first, so that operations are still written in order.
+  void StartGroupApply();
+
+  // Writes the group batch and finishes the group apply started by StartGroupApply().
+  void FinishGroupApply();
+
+  // Returns true if the write operation would be added to the group batch by ApplyRowOperations.
+  // Such an operation is only written when FlushGroupApply() is called, so the rest of its apply
+  // has to be deferred with AfterGroupApplied().
+  bool IsGroupApplied(WriteOperationState* operation_state) const;
+
+  // Registers a callback to be invoked once the group batch is written to RocksDB. Callbacks are
+  // invoked in the order of registration. Writes the group batch if it reached
+  // --max_group_apply_operations.
+  void AfterGroupApplied(std::function<void()> callback);
+
+  // Makes sure every operation applied before is written to RocksDB: writes the operations added
+  // to the group batch so far and finishes their apply, or waits for another thread doing so. Could
+  // be called by any thread, and does not wait for the group apply in progress to finish.
+  void FlushGroupApply();
+
   // Apply a single row operation, which must already be prepared.
   // The result is set back into row_op->result
   void ApplyKuduRowOperation(WriteOperationState* operation_state,
@@ -307,6 +343,12 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       HybridTime timestamp, const RedisReadRequestPB& redis_read_request,
       RedisResponsePB* response) override;
 
+  // Sorted by key, the requests share a single RocksDB iterator, so that reads of neighbouring
+  // keys do not have to set up an iterator and re-read the same blocks each.
+  CHECKED_STATUS HandleRedisReadRequests(
+      HybridTime timestamp, const std::vector<const RedisReadRequestPB*>& redis_read_requests,
+      const std::vector<RedisResponsePB*>& responses) override;
+
   CHECKED_STATUS HandleQLReadRequest(
       HybridTime timestamp, const QLReadRequestPB& ql_read_request,
       const TransactionMetadataPB& transaction_metadata, QLResponsePB* response,
@@ -424,6 +466,23 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Estimate the total on-disk size of this tablet, in bytes.
   size_t EstimateOnDiskSize() const;
 
+  // Returns the memory used by the block cache reserved for the table of this tablet, which is
+  // shared with the other tablets of the table on this server.
+  size_t ReservedBlockCacheUsage() const;
+
+  // Returns the number of bytes that a full compaction could garbage-collect, as last estimated by
+  // EstimateHistoryGarbage().
+  size_t ReclaimableBytesEstimate() const { return reclaimable_bytes_estimate_.load(); }
+
+  // Estimates the total key/value bytes in the SST files of a key-value tablet, and how many of
+  // them a full compaction could garbage-collect at the current history cutoff.
+  CHECKED_STATUS EstimateHistoryGarbage(uint64_t* total_bytes, uint64_t* reclaimable_bytes);
+
+  // Compacts all the SST files of a key-value tablet, which garbage-collects the DocDB history
+  // below the history cutoff. Blocks until the compaction is done, or until shutdown is requested,
+  // which cancels it.
+  CHECKED_STATUS ForceFullRocksDBCompaction();
+
   // Get the total size of all the DMS
   size_t DeltaMemStoresSize() const;
 
@@ -550,6 +609,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // This is used to figure out what can be garbage collected during a compaction.
   HybridTime OldestReadPoint() const;
 
+  // Safe time propagated by the leader, which bounds the staleness of reads served by a follower.
+  PropagatedSafeTime* propagated_safe_time() { return &propagated_safe_time_; }
+
   // The HybridTime of the oldest write that is still not scheduled to be flushed in RocksDB.
   TabletFlushStats* flush_stats() const { return flush_stats_.get(); }
 
@@ -593,6 +655,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   uint64_t GetTotalSSTFileSizes() const;
 
+  // Approximate size of the active and not yet flushed immutable memtables.
+  uint64_t GetMemTableSize() const;
+
  protected:
   friend class Iterator;
   friend class TabletPeerTest;
@@ -794,6 +859,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   MvccManager mvcc_;
 
+  PropagatedSafeTime propagated_safe_time_;
+
   // Maps a timestamp to the number active readers with that timestamp.
   // TODO(ENG-961): Check if this is a point of contention. If so, shard it as suggested in D1219.
   std::map<HybridTime, int64_t> active_readers_cnt_;
@@ -874,10 +941,26 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::atomic<int64_t> last_committed_write_index_{0};
 
+  // Last estimate of the bytes a full compaction could garbage-collect.
+  std::atomic<size_t> reclaimable_bytes_estimate_{0};
+
   // Remembers he HybridTime of the oldest write that is still not scheduled to
   // be flushed in RocksDB.
   std::shared_ptr<TabletFlushStats> flush_stats_;
 
+  // Group apply, see StartGroupApply(). The thread applying the group is stored in
+  // group_apply_thread_. group_apply_mutex_ protects the pending batch and callbacks, and is only
+  // held to add to them or to swap them out, so that the batch is written without blocking the
+  // thread adding to the next one. group_apply_write_mutex_ is held while writing a swapped out
+  // batch and running its callbacks, so that the batches are written and finished in order.
+  // group_apply_write_mutex_ has to be acquired before group_apply_mutex_.
+  std::mutex group_apply_write_mutex_;
+  std::mutex group_apply_mutex_;
+  std::atomic<std::thread::id> group_apply_thread_{std::thread::id()};
+  std::unique_ptr<rocksdb::WriteBatch> group_apply_batch_ = std::make_unique<rocksdb::WriteBatch>();
+  size_t group_apply_operations_ = 0;
+  std::vector<std::function<void()>> group_apply_callbacks_;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(Tablet);
 };
@@ -885,10 +968,12 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 typedef std::shared_ptr<Tablet> TabletPtr;
 
 // A helper class to manage read transactions. Grabs and registers a read point with the tablet
-// when created, and deregisters the read point when this object is destructed.
+// when created, and deregisters the read point when this object is destructed. The read point is
+// 'read_time' if it is valid, and the tablet's safe time to read otherwise.
 class ScopedReadOperation {
  public:
-  explicit ScopedReadOperation(AbstractTablet* tablet);
+  explicit ScopedReadOperation(
+      AbstractTablet* tablet, HybridTime read_time = HybridTime::kInvalidHybridTime);
 
   ~ScopedReadOperation();
 
@@ -44,6 +44,7 @@
 #include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/tablet/tablet-test-util.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/tostring.h"
 #include "yb/tablet/tablet_options.h"
 
@@ -51,6 +52,8 @@ using std::shared_ptr;
 using std::string;
 using std::vector;
 
+DECLARE_int32(log_segment_size_mb);
+
 namespace yb {
 
 namespace log {
@@ -341,5 +344,72 @@ TEST_F(BootstrapTest, TestConsensusOnlyOperationOutOfOrderHybridTime) {
   ASSERT_EQ(1, results.size());
 }
 
+// Tests that a tablet whose log mostly consists of entries already flushed to RocksDB does not
+// replay those segments again, and reports bootstrap timings for both bootstraps.
+TEST_F(BootstrapTest, TestSkipFlushedSegments) {
+  FLAGS_log_segment_size_mb = 1;
+  constexpr int kNumOps = 500;
+  const string kValue(10 * 1024, 'x');
+
+  BuildLog();
+  for (int i = 1; i <= kNumOps; ++i) {
+    const auto op_id = MakeOpId(1, i);
+    AppendReplicateBatch(op_id, op_id, {TupleForAppend(i, i, kValue)});
+  }
+  ASSERT_OK(log_->Close());
+
+  shared_ptr<TabletClass> tablet;
+  ConsensusBootstrapInfo boot_info;
+  Stopwatch sw(Stopwatch::ALL_THREADS);
+  sw.start();
+  ASSERT_OK(BootstrapTestTablet(-1, -1, &tablet, &boot_info));
+  sw.stop();
+  LOG(INFO) << "Bootstrap of " << kNumOps << " operations: " << sw.elapsed().ToString();
+  ASSERT_OPID_EQ(MakeOpId(1, kNumOps), boot_info.last_committed_id);
+
+  vector<string> results;
+  IterateTabletRows(tablet.get(), &results);
+  ASSERT_EQ(kNumOps, results.size());
+
+  // The rebuilt log has several segments, flush everything it contains and bootstrap again.
+  ASSERT_OK(tablet->Flush(FlushMode::kSync));
+  tablet->Shutdown();
+  tablet.reset();
+  ASSERT_OK(log_->Close());
+
+  scoped_refptr<TabletMetadata> meta;
+  ASSERT_OK(LoadTestTabletMetadata(-1, -1, &meta));
+  ConsensusBootstrapInfo second_boot_info;
+  Stopwatch second_sw(Stopwatch::ALL_THREADS);
+  second_sw.start();
+  ASSERT_OK(RunBootstrapOnTestTablet(meta, &tablet, &second_boot_info));
+  second_sw.stop();
+  LOG(INFO) << "Bootstrap after flush: " << second_sw.elapsed().ToString();
+  ASSERT_OPID_EQ(MakeOpId(1, kNumOps), second_boot_info.last_committed_id);
+  ASSERT_EQ(0, second_boot_info.orphaned_replicates.size());
+
+  results.clear();
+  IterateTabletRows(tablet.get(), &results);
+  ASSERT_EQ(kNumOps, results.size());
+
+  // Flushed segments were not replayed, but their entries are still readable from the new log.
+  ASSERT_OK(log_->Close());
+  log::SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  ASSERT_FALSE(segments.empty());
+  int64_t expected_index = 1;
+  for (const auto& segment : segments) {
+    log::LogEntries entries;
+    ASSERT_OK(segment->ReadEntries(&entries));
+    for (const auto& entry : entries) {
+      if (entry->type() == log::REPLICATE) {
+        ASSERT_EQ(expected_index, entry->replicate().id().index());
+        ++expected_index;
+      }
+    }
+  }
+  ASSERT_EQ(kNumOps + 1, expected_index);
+}
+
 } // namespace tablet
 } // namespace yb
@@ -51,6 +51,18 @@ DEFINE_bool(skip_remove_old_recovery_dir, false,
             "Skip removing WAL recovery dir after startup. (useful for debugging)");
 TAG_FLAG(skip_remove_old_recovery_dir, hidden);
 
+DEFINE_bool(skip_flushed_log_segments_on_bootstrap, true,
+            "Do not replay log segments that only contain entries already flushed to RocksDB "
+            "during tablet bootstrap. Their entries are still carried over to the new log "
+            "without being applied, so that they remain available to lagging peers.");
+TAG_FLAG(skip_flushed_log_segments_on_bootstrap, advanced);
+
+DEFINE_int32(tablet_bootstrap_write_batch_size_bytes, 1024 * 1024,
+             "Replayed non-transactional writes are written to RocksDB in batches of about this "
+             "size during tablet bootstrap. Non-positive value means writing each operation "
+             "separately.");
+TAG_FLAG(tablet_bootstrap_write_batch_size_bytes, advanced);
+
 DEFINE_test_flag(double, fault_crash_during_log_replay, 0.0,
                  "Fraction of the time when the tablet will crash immediately "
                  "after processing a log entry during log replay.");
@@ -285,7 +297,10 @@ Status TabletBootstrap::Bootstrap(shared_ptr<TabletClass>* rebuilt_tablet,
   // Before playing any segments we set the safe and clean times to 'kMin' so that
   // the MvccManager will accept all transactions that we replay as uncommitted.
   tablet_->mvcc_manager()->OfflineAdjustSafeTime(HybridTime::kMin);
-  RETURN_NOT_OK_PREPEND(PlaySegments(consensus_info), "Failed log replay. Reason");
+  LOG_TIMING_PREFIX(INFO, LogPrefix(), "replaying log") {
+    RETURN_NOT_OK_PREPEND(PlaySegments(consensus_info), "Failed log replay. Reason");
+  }
+  LOG_WITH_PREFIX(INFO) << "Log replay stats: " << stats_.ToString();
 
   // Flush the consensus metadata once at the end to persist our changes, if any.
   RETURN_NOT_OK(cmeta_->Flush());
@@ -721,6 +736,12 @@ Status TabletBootstrap::ApplyCommitMessage(ReplayState* state, const LogEntryPB&
 Status TabletBootstrap::HandleOperation(OperationType op_type,
                                         ReplicateMsg* replicate,
                                         const CommitMsg* commit) {
+  if (op_type != consensus::WRITE_OP) {
+    // Other operations could read the tablet data, e.g. when applying transactions, so they
+    // should see all the writes replayed before them.
+    FlushReplayedWrites();
+  }
+
   switch (op_type) {
     case consensus::WRITE_OP:
       return PlayWriteRequest(replicate, commit);
@@ -824,6 +845,77 @@ void TabletBootstrap::DumpReplayStateToLog(const ReplayState& state) {
   }
 }
 
+size_t TabletBootstrap::NumFlushedSegmentsToSkip(const log::SegmentSequence& segments,
+                                                 int64_t flushed_index) {
+  log::SegmentSequence flushed_segments;
+  const auto s = log_reader_->GetSegmentPrefixNotIncluding(flushed_index, &flushed_segments);
+  if (!s.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to find log segments flushed up to " << flushed_index
+                             << ", replaying all segments: " << s.ToString();
+    return 0;
+  }
+  // The prefix is computed from the current state of the reader, so make sure it matches the
+  // snapshot we are replaying. We also always replay at least one segment, as we need the entry
+  // with the last flushed index to restore the committed OpId and the safe time.
+  size_t result = 0;
+  while (result < flushed_segments.size() && result + 1 < segments.size() &&
+         flushed_segments[result] == segments[result]) {
+    ++result;
+  }
+  return result;
+}
+
+Status TabletBootstrap::CopyFlushedSegment(ReplayState* state,
+                                           const scoped_refptr<ReadableLogSegment>& segment) {
+  int entry_idx = 0;
+  Status copy_status;
+  Status read_status = segment->ReadEntries(
+      [this, state, &segment, &entry_idx, &copy_status](log::LogEntries* batch_entries) {
+    for (auto& entry : *batch_entries) {
+      // Only no-op COMMIT entries could appear here, and they are dropped on replay anyway.
+      if (entry->type() == log::REPLICATE) {
+        const ReplicateMsg& replicate = entry->replicate();
+        Status s = state->CheckSequentialReplicateId(replicate);
+        if (s.ok()) {
+          UpdateClock(replicate.hybrid_time());
+          tablet_->UpdateMonotonicCounter(replicate.monotonic_counter());
+          s = log_->Append(entry.get());
+        }
+        if (!s.ok()) {
+          copy_status = s.CloneAndPrepend(DebugInfo(tablet_->tablet_id(),
+                                                    segment->header().sequence_number(),
+                                                    entry_idx, segment->path(),
+                                                    *entry));
+          return copy_status;
+        }
+        stats_.ops_copied++;
+      }
+      ++entry_idx;
+    }
+    return Status::OK();
+  });
+  RETURN_NOT_OK(copy_status);
+  if (PREDICT_FALSE(!read_status.ok())) {
+    return STATUS(Corruption, Substitute("Error reading Log Segment of tablet $0: $1 "
+                                         "(Read up to entry $2 of segment $3, in path $4)",
+                                         tablet_->tablet_id(),
+                                         read_status.ToString(),
+                                         entry_idx,
+                                         segment->header().sequence_number(),
+                                         segment->path()));
+  }
+  return Status::OK();
+}
+
+void TabletBootstrap::FlushReplayedWrites() {
+  if (replay_write_batch_.Count() == 0) {
+    return;
+  }
+  tablet_->WriteToRocksDB(&replay_write_batch_);
+  replay_write_batch_.Clear();
+  stats_.rocksdb_write_batches++;
+}
+
 Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
   // We initialize state->rocksdb_applied_index with MaxPersistentSequenceNumber(), and only apply
   // a log entry with index equal to state->rocksdb_applied_index, before incrementing that
@@ -872,34 +964,61 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
   // writing.
   RETURN_NOT_OK_PREPEND(OpenNewLog(), "Failed to open new log");
 
-  int segment_count = 0;
-  for (const scoped_refptr<ReadableLogSegment>& segment : segments) {
-    log::LogEntries entries;
-    // TODO: Optimize this to not read the whole thing into memory?
-    Status read_status = segment->ReadEntries(&entries);
-    for (int entry_idx = 0; entry_idx < entries.size(); ++entry_idx) {
-      Status s = HandleEntry(&state, &entries[entry_idx]);
-      if (!s.ok()) {
-        LOG(INFO) << "Dumping replay state to log";
-        DumpReplayStateToLog(state);
-        RETURN_NOT_OK_PREPEND(s, DebugInfo(tablet_->tablet_id(),
-                                           segment->header().sequence_number(),
-                                           entry_idx, segment->path(),
-                                           *entries[entry_idx]));
-      }
+  // Raft indexes of the entries in a segment could be lower than in the previous segments only
+  // because of overwritten uncommitted entries, so when all the entries of a segment are already
+  // flushed to RocksDB, the same holds for all the preceding segments. Such a prefix of the log
+  // can be skipped entirely. Note that we use segment footers for that rather than the log
+  // index, as the latter is not fsynced and is not available when replaying from the recovery dir.
+  // The entries of skipped segments are still copied to the new log, as the recovery dir is
+  // removed after bootstrap and lagging peers could still need them.
+  size_t first_segment_idx = 0;
+  if (non_kudu && FLAGS_skip_flushed_log_segments_on_bootstrap) {
+    first_segment_idx = NumFlushedSegmentsToSkip(segments, state.last_stored_op_id.index());
+    stats_.segments_skipped = first_segment_idx;
+    if (first_segment_idx != 0) {
+      LOG_WITH_PREFIX(INFO) << "Skipping replay of " << first_segment_idx << " log segments "
+                            << "with all entries flushed to RocksDB, starting replay from segment "
+                            << segments[first_segment_idx]->header().sequence_number();
     }
+  }
+
+  for (size_t segment_idx = 0; segment_idx < first_segment_idx; ++segment_idx) {
+    RETURN_NOT_OK(CopyFlushedSegment(&state, segments[segment_idx]));
+  }
+
+  for (size_t segment_idx = first_segment_idx; segment_idx < segments.size(); ++segment_idx) {
+    const scoped_refptr<ReadableLogSegment>& segment = segments[segment_idx];
+    // Entries are handled as soon as their batch is read, so we never keep the whole segment in
+    // memory.
+    int entry_idx = 0;
+    Status handle_status;
+    Status read_status = segment->ReadEntries(
+        [this, &state, &segment, &entry_idx, &handle_status](log::LogEntries* batch_entries) {
+      for (auto& entry : *batch_entries) {
+        Status s = HandleEntry(&state, &entry);
+        if (!s.ok()) {
+          LOG(INFO) << "Dumping replay state to log";
+          DumpReplayStateToLog(state);
+          handle_status = s.CloneAndPrepend(DebugInfo(tablet_->tablet_id(),
+                                                      segment->header().sequence_number(),
+                                                      entry_idx, segment->path(),
+                                                      *entry));
+          return handle_status;
+        }
+        ++entry_idx;
+      }
+      return Status::OK();
+    });
+    RETURN_NOT_OK(handle_status);
 
     // If the LogReader failed to read for some reason, we'll still try to
     // replay as many entries as possible, and then fail with Corruption.
-    // TODO: this is sort of scary -- why doesn't LogReader expose an
-    // entry-by-entry iterator-like API instead? Seems better to avoid
-    // exposing the idea of segments to callers.
     if (PREDICT_FALSE(!read_status.ok())) {
       return STATUS(Corruption, Substitute("Error reading Log Segment of tablet $0: $1 "
                                            "(Read up to entry $2 of segment $3, in path $4)",
                                            tablet_->tablet_id(),
                                            read_status.ToString(),
-                                           entries.size(),
+                                           entry_idx,
                                            segment->header().sequence_number(),
                                            segment->path()));
     }
@@ -909,12 +1028,14 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
     // nothing.
     listener_->StatusMessage(Substitute("Bootstrap replayed $0/$1 log segments. "
                                         "Stats: $2. Pending: $3 replicates",
-                                        segment_count + 1, log_reader_->num_segments(),
+                                        segment_idx + 1, segments.size(),
                                         stats_.ToString(),
                                         state.pending_replicates.size()));
-    segment_count++;
   }
 
+  // Write whatever is left from the last batch of replayed writes.
+  FlushReplayedWrites();
+
   // If we have non-applied commits they all must belong to pending operations and
   // they should only pertain to unflushed stores. This is specific to Kudu tables, because we don't
   // use local COMMIT messages in YB tables.
@@ -1171,7 +1292,7 @@ Status TabletBootstrap::PlayRowOperations(WriteOperationState* operation_state,
       break;
     case TableType::YQL_TABLE_TYPE: FALLTHROUGH_INTENDED;
     case TableType::REDIS_TABLE_TYPE:
-      tablet_->ApplyRowOperations(operation_state);
+      ApplyKeyValueRowOperations(operation_state);
       break;
     default:
       LOG(FATAL) << "Invalid table type: " << tablet_->table_type();
@@ -1180,6 +1301,23 @@ Status TabletBootstrap::PlayRowOperations(WriteOperationState* operation_state,
   return Status::OK();
 }
 
+void TabletBootstrap::ApplyKeyValueRowOperations(WriteOperationState* operation_state) {
+  if (FLAGS_tablet_bootstrap_write_batch_size_bytes <= 0 ||
+      operation_state->request()->write_batch().has_transaction()) {
+    // Transactional writes depend on the state of the transaction participant, so we keep them
+    // ordered with the preceding writes by writing those first.
+    FlushReplayedWrites();
+    tablet_->ApplyRowOperations(operation_state);
+    return;
+  }
+
+  tablet_->AddRowOperationsToWriteBatch(operation_state, &replay_write_batch_);
+  if (replay_write_batch_.GetDataSize() >=
+          static_cast<size_t>(FLAGS_tablet_bootstrap_write_batch_size_bytes)) {
+    FlushReplayedWrites();
+  }
+}
+
 Status TabletBootstrap::FilterAndApplyOperations(WriteOperationState* operation_state,
                                                  const TxResultPB* orig_result) {
   int32_t op_idx = 0;
@@ -1393,11 +1531,12 @@ string TabletBootstrap::Stats::ToString() const {
   return Substitute("ops{read=$0 overwritten=$1 applied=$2} "
                     "inserts{seen=$3 ignored=$4} "
                     "mutations{seen=$5 ignored=$6} "
-                    "orphaned_commits=$7",
+                    "orphaned_commits=$7 segments_skipped=$8 rocksdb_write_batches=$9",
                     ops_read, ops_overwritten, ops_committed,
                     inserts_seen, inserts_ignored,
                     mutations_seen, mutations_ignored,
-                    orphaned_commits);
+                    orphaned_commits, segments_skipped, rocksdb_write_batches) +
+         Substitute(" ops_copied=$0", ops_copied);
 }
 
 } // namespace tablet
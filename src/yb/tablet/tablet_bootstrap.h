@@ -36,6 +36,7 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/rocksdb/write_batch.h"
 
 namespace yb {
 namespace tablet {
@@ -206,6 +207,18 @@ class TabletBootstrap {
   // later on when then tablet is rebuilt and starts accepting writes from clients.
   Status PlaySegments(consensus::ConsensusBootstrapInfo* results);
 
+  // Returns the number of leading segments that only contain entries already flushed to RocksDB,
+  // i.e. entries with an index lower than 'flushed_index', so that replay could start right
+  // from the segment containing the first entry that has to be applied.
+  size_t NumFlushedSegmentsToSkip(const log::SegmentSequence& segments, int64_t flushed_index);
+
+  // Appends the REPLICATE entries of a skipped segment to the new log without applying them.
+  CHECKED_STATUS CopyFlushedSegment(ReplayState* state,
+                                    const scoped_refptr<log::ReadableLogSegment>& segment);
+
+  // Writes RocksDB operations accumulated in replay_write_batch_, if any.
+  void FlushReplayedWrites();
+
   // Append the given commit message to the log.
   // Does not support writing a TxResult.
   Status AppendCommitMsg(const consensus::CommitMsg& commit_msg);
@@ -229,6 +242,10 @@ class TabletBootstrap {
   Status PlayRowOperations(WriteOperationState* operation_state,
                            const TxResultPB* result);
 
+  // Applies operations of a key-value write. Non-transactional writes are accumulated in
+  // replay_write_batch_ and written to RocksDB in large batches.
+  void ApplyKeyValueRowOperations(WriteOperationState* operation_state);
+
   // Pass through all of the decoded operations in operation_state. For
   // each op:
   // - if it was previously failed, mark as failed
@@ -309,7 +326,10 @@ class TabletBootstrap {
         inserts_ignored(0),
         mutations_seen(0),
         mutations_ignored(0),
-        orphaned_commits(0) {
+        orphaned_commits(0),
+        segments_skipped(0),
+        ops_copied(0),
+        rocksdb_write_batches(0) {
     }
 
     std::string ToString() const;
@@ -327,8 +347,18 @@ class TabletBootstrap {
 
     // Number of COMMIT messages for which a corresponding REPLICATE was not found.
     int orphaned_commits;
+
+    // Number of log segments that were not replayed because all their entries were flushed.
+    int segments_skipped;
+    // Number of REPLICATE messages of skipped segments copied to the new log as is.
+    int ops_copied;
+    // Number of batches replayed writes were written to RocksDB with.
+    int rocksdb_write_batches;
   } stats_;
 
+  // Replayed non-transactional writes that have not been written to RocksDB yet.
+  rocksdb::WriteBatch replay_write_batch_;
+
   // Snapshot of which stores were flushed prior to restart.
   FlushedStoresSnapshot flushed_stores_;
 
@@ -140,6 +140,11 @@ METRIC_DEFINE_histogram(tablet, delta_file_lookups_per_op, "Delta File Lookups p
                         "lookups if the tablet is not fully compacted. High frequency of "
                         "high values may indicate that compaction is falling behind.", 20, 2);
 
+METRIC_DEFINE_histogram(tablet, operations_per_rocksdb_write, "Operations per RocksDB Write",
+                        yb::MetricUnit::kOperations,
+                        "Number of committed write operations applied to RocksDB with a single "
+                        "write.", 1024, 2);
+
 METRIC_DEFINE_histogram(tablet, write_op_duration_client_propagated_consistency,
   "Write Op Duration with Propagated Consistency",
   yb::MetricUnit::kMicroseconds,
@@ -201,6 +206,18 @@ METRIC_DEFINE_gauge_uint32(tablet, delta_major_compact_rs_running,
   yb::MetricUnit::kMaintenanceOperations,
   "Number of delta major compactions currently running.");
 
+METRIC_DEFINE_gauge_uint32(tablet, history_gc_compact_running,
+  "History GC Compactions Running",
+  yb::MetricUnit::kMaintenanceOperations,
+  "Number of full compactions scheduled for DocDB history garbage collection currently "
+  "running.");
+
+METRIC_DEFINE_gauge_uint32(tablet, history_gc_schedule_running,
+  "History GC Compaction Schedulings Running",
+  yb::MetricUnit::kMaintenanceOperations,
+  "Number of maintenance operations currently handing a full compaction for DocDB history "
+  "garbage collection over to its thread.");
+
 METRIC_DEFINE_histogram(tablet, flush_dms_duration,
   "DeltaMemStore Flush Duration",
   yb::MetricUnit::kMilliseconds,
@@ -226,11 +243,41 @@ METRIC_DEFINE_histogram(tablet, delta_major_compact_rs_duration,
   yb::MetricUnit::kSeconds,
   "Seconds spent major delta compacting.", 60000000LU, 2);
 
+METRIC_DEFINE_histogram(tablet, history_gc_compact_duration,
+  "History GC Compaction Duration",
+  yb::MetricUnit::kMilliseconds,
+  "Time spent in full compactions scheduled for DocDB history garbage collection.",
+  3600000LU, 2);
+
+METRIC_DEFINE_histogram(tablet, history_gc_schedule_duration,
+  "History GC Compaction Scheduling Duration",
+  yb::MetricUnit::kMilliseconds,
+  "Time spent by maintenance operations handing a full compaction for DocDB history garbage "
+  "collection over to its thread.", 60000LU, 1);
+
 METRIC_DEFINE_counter(tablet, leader_memory_pressure_rejections,
   "Leader Memory Pressure Rejections",
   yb::MetricUnit::kRequests,
   "Number of RPC requests rejected due to memory pressure while LEADER.");
 
+METRIC_DEFINE_counter(tablet, leader_lease_expired_read_rejections,
+  "Leader Lease Expired Read Rejections",
+  yb::MetricUnit::kRequests,
+  "Number of strong read requests rejected by the LEADER because its hybrid time lease did not "
+  "cover the read time.");
+
+METRIC_DEFINE_counter(tablet, follower_reads,
+  "Follower Reads",
+  yb::MetricUnit::kRequests,
+  "Number of bounded staleness read requests served by a FOLLOWER at the safe time propagated by "
+  "the leader.");
+
+METRIC_DEFINE_counter(tablet, stale_follower_read_rejections,
+  "Stale Follower Read Rejections",
+  yb::MetricUnit::kRequests,
+  "Number of bounded staleness read requests a FOLLOWER redirected to the leader because its "
+  "propagated safe time was older than the staleness bound.");
+
 using strings::Substitute;
 
 namespace yb {
@@ -258,6 +305,7 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(bloom_lookups_per_op),
     MINIT(key_file_lookups_per_op),
     MINIT(delta_file_lookups_per_op),
+    MINIT(operations_per_rocksdb_write),
     MINIT(commit_wait_duration),
     MINIT(snapshot_read_inflight_wait_duration),
     MINIT(redis_read_latency),
@@ -270,12 +318,19 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& entity)
     GINIT(compact_rs_running),
     GINIT(delta_minor_compact_rs_running),
     GINIT(delta_major_compact_rs_running),
+    GINIT(history_gc_compact_running),
+    GINIT(history_gc_schedule_running),
     MINIT(flush_dms_duration),
     MINIT(flush_mrs_duration),
     MINIT(compact_rs_duration),
     MINIT(delta_minor_compact_rs_duration),
     MINIT(delta_major_compact_rs_duration),
-    MINIT(leader_memory_pressure_rejections) {
+    MINIT(history_gc_compact_duration),
+    MINIT(history_gc_schedule_duration),
+    MINIT(leader_memory_pressure_rejections),
+    MINIT(leader_lease_expired_read_rejections),
+    MINIT(follower_reads),
+    MINIT(stale_follower_read_rejections) {
 }
 #undef MINIT
 #undef GINIT
@@ -76,6 +76,7 @@ struct TabletMetrics {
   scoped_refptr<Histogram> bloom_lookups_per_op;
   scoped_refptr<Histogram> key_file_lookups_per_op;
   scoped_refptr<Histogram> delta_file_lookups_per_op;
+  scoped_refptr<Histogram> operations_per_rocksdb_write;
 
   scoped_refptr<Histogram> commit_wait_duration;
   scoped_refptr<Histogram> snapshot_read_inflight_wait_duration;
@@ -90,14 +91,21 @@ struct TabletMetrics {
   scoped_refptr<AtomicGauge<uint32_t> > compact_rs_running;
   scoped_refptr<AtomicGauge<uint32_t> > delta_minor_compact_rs_running;
   scoped_refptr<AtomicGauge<uint32_t> > delta_major_compact_rs_running;
+  scoped_refptr<AtomicGauge<uint32_t> > history_gc_compact_running;
+  scoped_refptr<AtomicGauge<uint32_t> > history_gc_schedule_running;
 
   scoped_refptr<Histogram> flush_dms_duration;
   scoped_refptr<Histogram> flush_mrs_duration;
   scoped_refptr<Histogram> compact_rs_duration;
   scoped_refptr<Histogram> delta_minor_compact_rs_duration;
   scoped_refptr<Histogram> delta_major_compact_rs_duration;
+  scoped_refptr<Histogram> history_gc_compact_duration;
+  scoped_refptr<Histogram> history_gc_schedule_duration;
 
   scoped_refptr<Counter> leader_memory_pressure_rejections;
+  scoped_refptr<Counter> leader_lease_expired_read_rejections;
+  scoped_refptr<Counter> follower_reads;
+  scoped_refptr<Counter> stale_follower_read_rejections;
 };
 
 class ProbeStatsSubmitter {
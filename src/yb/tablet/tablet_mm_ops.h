@@ -33,11 +33,19 @@
 #ifndef YB_TABLET_TABLET_MM_OPS_H_
 #define YB_TABLET_TABLET_MM_OPS_H_
 
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "yb/gutil/gscoped_ptr.h"
 #include "yb/tablet/maintenance_manager.h"
+#include "yb/util/monotime.h"
 
 namespace yb {
 
 class Histogram;
+class ThreadPool;
 template<class T>
 class AtomicGauge;
 
@@ -129,6 +137,85 @@ class MajorDeltaCompactionOp : public MaintenanceOp {
   Tablet* const tablet_;
 };
 
+// Runs the full compactions that the HistoryGCCompactionOps of a server's tablets schedule. They
+// run on a thread of their own, so that they do not hold up the maintenance manager threads, one at
+// a time, and at least --history_gc_full_compaction_server_interval_secs apart.
+class HistoryGCCompactions {
+ public:
+  HistoryGCCompactions();
+  ~HistoryGCCompactions();
+
+  // Returns whether a compaction could start at the given time.
+  bool CanStart(const MonoTime& now) const;
+
+  // Reserves the right to start the next compaction at the given time. Returns false if a
+  // compaction is running or the server interval has not passed yet. A successful reservation
+  // must be followed by Run().
+  bool TryReserve(const MonoTime& now);
+
+  // Runs the compaction the reservation was made for in the background, and releases the
+  // reservation once it is done. The reservation is released right away if it cannot be run.
+  CHECKED_STATUS Run(std::function<void()> compaction);
+
+  // Waits for the running compaction, if any, to finish.
+  void Wait();
+
+ private:
+  bool CanStartUnlocked(const MonoTime& now) const;
+  void Finished();
+
+  mutable simple_spinlock lock_;
+  bool running_ = false;
+  MonoTime last_start_;
+  gscoped_ptr<ThreadPool> pool_;
+};
+
+// MaintenanceOp to schedule full compactions of key-value tablets for DocDB history garbage
+// collection.
+//
+// Tombstones, and versions that are only shadowed by entries in other SST files, are only removed
+// by full compactions, which RocksDB does not schedule on its own while the tablet keeps growing.
+// This op reports the estimated fraction of the SST file bytes that could be garbage-collected at
+// the current history cutoff as its perf_improvement, and becomes runnable once it exceeds
+// --history_gc_full_compaction_garbage_ratio. Performing the op hands the compaction over to
+// HistoryGCCompactions, which also rate-limits them across the server. The compaction is canceled
+// when the tablet shuts down.
+class HistoryGCCompactionOp : public MaintenanceOp {
+ public:
+  HistoryGCCompactionOp(Tablet* tablet, std::shared_ptr<HistoryGCCompactions> compactions);
+
+  // Waits for the compaction of the tablet to finish, if it is running.
+  virtual ~HistoryGCCompactionOp();
+
+  virtual void UpdateStats(MaintenanceOpStats* stats) override;
+
+  virtual bool Prepare() override;
+
+  virtual void Perform() override;
+
+  virtual scoped_refptr<Histogram> DurationHistogram() const override;
+
+  virtual scoped_refptr<AtomicGauge<uint32_t> > RunningGauge() const override;
+
+ private:
+  void Compact();
+
+  mutable simple_spinlock lock_;
+  MaintenanceOpStats prev_stats_;
+  // When the garbage estimate was last refreshed, and when this op last compacted the tablet.
+  MonoTime last_estimate_time_;
+  MonoTime last_compaction_time_;
+  uint64_t total_bytes_;
+  uint64_t reclaimable_bytes_;
+  Tablet* const tablet_;
+  const std::shared_ptr<HistoryGCCompactions> compactions_;
+
+  // Whether the compaction handed over by Perform() has not finished yet.
+  std::mutex compaction_mutex_;
+  std::condition_variable compaction_cond_;
+  bool compaction_running_ = false;
+};
+
 } // namespace tablet
 } // namespace yb
 
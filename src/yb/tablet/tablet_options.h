@@ -15,15 +15,28 @@
 
 namespace rocksdb {
 class EventListener;
+class PersistentCache;
 }
 
 namespace yb {
 namespace tablet {
 
+class HistoryGCCompactions;
+
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
+  // Whether block_cache is the cache reserved for the table of the tablet.
+  bool block_cache_reserved = false;
+  // Optional cache of compressed blocks, consulted on block_cache misses before reading from disk.
+  std::shared_ptr<rocksdb::Cache> compressed_block_cache;
+  // Optional cache of data blocks on local persistent storage, consulted before reading a data
+  // block from its SST file.
+  std::shared_ptr<rocksdb::PersistentCache> persistent_block_cache;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
+  // Runs the full compactions scheduled for DocDB history garbage collection of the tablets of the
+  // server. Tablets without it do not schedule them.
+  std::shared_ptr<HistoryGCCompactions> history_gc_compactions;
 };
 
 } // namespace tablet
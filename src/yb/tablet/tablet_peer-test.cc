@@ -128,6 +128,7 @@ class TabletPeerTest : public YBTabletTest,
       new TabletPeerClass(make_scoped_refptr(tablet()->metadata()),
                           config_peer,
                           apply_pool_.get(),
+                          nullptr /* log_cache_read_ahead_pool */,
                           Bind(&TabletPeerTest::TabletPeerStateChangedCallback,
                                Unretained(this),
                                tablet()->tablet_id())));
@@ -125,6 +125,7 @@ TabletPeer::TabletPeer(
     const scoped_refptr<TabletMetadata>& meta,
     const consensus::RaftPeerPB& local_peer_pb,
     ThreadPool* apply_pool,
+    ThreadPool* log_cache_read_ahead_pool,
     Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk)
   : meta_(meta),
     tablet_id_(meta->tablet_id()),
@@ -132,6 +133,7 @@ TabletPeer::TabletPeer(
     state_(NOT_STARTED),
     status_listener_(new TabletStatusListener(meta)),
     apply_pool_(apply_pool),
+    log_cache_read_ahead_pool_(log_cache_read_ahead_pool),
     log_anchor_registry_(new LogAnchorRegistry()),
     mark_dirty_clbk_(std::move(mark_dirty_clbk)) {}
 
@@ -180,11 +182,17 @@ Status TabletPeer::InitTabletPeer(const shared_ptr<TabletClass> &tablet,
                                        this,
                                        messenger_,
                                        log_.get(),
+                                       log_cache_read_ahead_pool_,
                                        tablet_->mem_tracker(),
                                        mark_dirty_clbk_,
                                        tablet_->table_type(),
                                        std::bind(&Tablet::LostLeadership, tablet.get()));
 
+    consensus_->SetPropagatedSafeTimeCallbacks(
+        std::bind(&Tablet::SafeTimestampToRead, tablet.get()),
+        std::bind(&PropagatedSafeTime::Update, tablet->propagated_safe_time(),
+                  std::placeholders::_1, std::placeholders::_2));
+
     prepare_thread_ = std::make_unique<PrepareThread>(consensus_.get());
   }
 
@@ -213,6 +221,9 @@ Status TabletPeer::Start(const ConsensusBootstrapInfo& bootstrap_info) {
 
   VLOG(2) << "RaftConfig before starting: " << consensus_->CommittedConfig().DebugString();
 
+  // Operations up to the last committed one were applied during bootstrap.
+  tablet_->propagated_safe_time()->Applied(bootstrap_info.last_committed_id.index());
+
   RETURN_NOT_OK(consensus_->Start(bootstrap_info));
   {
     std::lock_guard<simple_spinlock> lock(lock_);
@@ -635,6 +646,20 @@ Status TabletPeer::StartReplicaOperation(const scoped_refptr<ConsensusRound>& ro
   return Status::OK();
 }
 
+void TabletPeer::StartApplyingCommittedRounds() {
+  auto tablet = shared_tablet();
+  if (tablet) {
+    tablet->StartGroupApply();
+  }
+}
+
+void TabletPeer::FinishApplyingCommittedRounds() {
+  auto tablet = shared_tablet();
+  if (tablet) {
+    tablet->FinishGroupApply();
+  }
+}
+
 string TabletPeer::permanent_uuid() const {
   if (cached_permanent_uuid_initialized_.load(std::memory_order_acquire)) {
     return cached_permanent_uuid_;
@@ -96,6 +96,7 @@ class TabletPeer : public RefCountedThreadSafe<TabletPeer>,
 
   TabletPeer(const scoped_refptr<TabletMetadata>& meta,
              const consensus::RaftPeerPB& local_peer_pb, ThreadPool* apply_pool,
+             ThreadPool* log_cache_read_ahead_pool,
              Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk);
 
   // Initializes the TabletPeer, namely creating the Log and initializing
@@ -150,6 +151,10 @@ class TabletPeer : public RefCountedThreadSafe<TabletPeer>,
   virtual CHECKED_STATUS StartReplicaOperation(
       const scoped_refptr<consensus::ConsensusRound>& round) override;
 
+  // Used by consensus to group the RocksDB writes of the committed rounds it applies together.
+  void StartApplyingCommittedRounds() override;
+  void FinishApplyingCommittedRounds() override;
+
   consensus::Consensus* consensus() const {
     std::lock_guard<simple_spinlock> lock(lock_);
     return consensus_.get();
@@ -353,6 +358,10 @@ class TabletPeer : public RefCountedThreadSafe<TabletPeer>,
   // the Tablet server.
   ThreadPool* apply_pool_;
 
+  // Pool that reads WAL entries ahead into the log cache for lagging peers, shared the same way
+  // as apply_pool_.
+  ThreadPool* log_cache_read_ahead_pool_;
+
   scoped_refptr<server::Clock> clock_;
 
   scoped_refptr<log::LogAnchorRegistry> log_anchor_registry_;
@@ -33,6 +33,7 @@
 #include "yb/tserver/heartbeater.h"
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <mutex>
 
@@ -47,6 +48,7 @@
 #include "yb/master/master_rpc.h"
 #include "yb/server/server_base.proxy.h"
 #include "yb/server/webserver.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/tablet_server_options.h"
 #include "yb/tserver/ts_tablet_manager.h"
@@ -196,6 +198,9 @@ class Heartbeater::Thread {
   uint64_t prev_reads_;
   uint64_t prev_writes_;
 
+  // Stores the per-tablet read and write ops for computing per-tablet iops, keyed by tablet id.
+  std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> prev_tablet_ops_;
+
   DISALLOW_COPY_AND_ASSIGN(Thread);
 };
 
@@ -392,17 +397,48 @@ Status Heartbeater::Thread::TryHeartbeat() {
       req.mutable_metrics()->set_total_ram_usage(ru.ru_maxrss);
       VLOG(4) << "Total Memory Usage: " << ru.ru_maxrss;
     }
-    // Get the Total SST file sizes and set it in the proto buf
+    MonoDelta diff = MonoTime::FineNow() - prev_tserver_metrics_submission_;
+    double_t div = diff.ToSeconds();
+
+    // Get the Total SST file sizes and set it in the proto buf, along with the per-tablet sizes
+    // and request rates used by the master to balance load across tablet servers.
     std::vector<scoped_refptr<yb::tablet::TabletPeer> > tablet_peers;
     uint64_t total_file_sizes = 0;
+    std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> tablet_ops;
     server_->tablet_manager()->GetTabletPeers(&tablet_peers);
     for (auto it = tablet_peers.begin(); it != tablet_peers.end(); it++) {
       scoped_refptr<yb::tablet::TabletPeer> tablet_peer = *it;
-      if (tablet_peer) {
-        shared_ptr<yb::tablet::TabletClass> tablet_class = tablet_peer->shared_tablet();
-        total_file_sizes += (tablet_class) ? tablet_class->GetTotalSSTFileSizes() : 0;
+      if (!tablet_peer) {
+        continue;
+      }
+      shared_ptr<yb::tablet::TabletClass> tablet_class = tablet_peer->shared_tablet();
+      if (!tablet_class) {
+        continue;
+      }
+      auto* tablet_metrics = req.mutable_metrics()->add_tablet_metrics();
+      tablet_metrics->set_tablet_id(tablet_peer->tablet_id());
+      tablet_metrics->set_sst_file_size(tablet_class->GetTotalSSTFileSizes());
+      tablet_metrics->set_memtable_size(tablet_class->GetMemTableSize());
+      total_file_sizes += tablet_metrics->sst_file_size();
+
+      const tablet::TabletMetrics* metrics = tablet_class->metrics();
+      if (metrics) {
+        const uint64_t tablet_reads = metrics->ql_read_latency->TotalCount() +
+                                      metrics->redis_read_latency->TotalCount();
+        const uint64_t tablet_writes =
+            metrics->write_op_duration_client_propagated_consistency->TotalCount() +
+            metrics->write_op_duration_commit_wait_consistency->TotalCount();
+        tablet_ops[tablet_peer->tablet_id()] = std::make_pair(tablet_reads, tablet_writes);
+        auto prev = prev_tablet_ops_.find(tablet_peer->tablet_id());
+        if (div > 0 && prev != prev_tablet_ops_.end()) {
+          tablet_metrics->set_read_ops_per_sec(
+              static_cast<double>(tablet_reads - prev->second.first) / div);
+          tablet_metrics->set_write_ops_per_sec(
+              static_cast<double>(tablet_writes - prev->second.second) / div);
+        }
       }
     }
+    prev_tablet_ops_.swap(tablet_ops);
     req.mutable_metrics()->set_total_sst_file_size(total_file_sizes);
 
     // Get the total number of read and write operations.
@@ -415,9 +451,6 @@ Status Heartbeater::Thread::TryHeartbeat() {
     uint64_t num_writes = (writes_hist != nullptr) ? writes_hist->TotalCount() : 0;
 
     // Calculate the read and write ops per second.
-    MonoDelta diff = MonoTime::FineNow() - prev_tserver_metrics_submission_;
-    double_t div = diff.ToSeconds();
-
     double rops_per_sec = (div > 0 && num_reads > 0) ?
         (static_cast<double>(num_reads - prev_reads_) / div) : 0;
 
@@ -32,6 +32,12 @@
 
 #include "yb/tserver/remote_bootstrap_client.h"
 
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <deque>
+#include <mutex>
+
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
@@ -45,6 +51,8 @@
 #include "yb/gutil/strings/util.h"
 #include "yb/gutil/walltime.h"
 #include "yb/rpc/messenger.h"
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/rate_limiter.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/tablet/tablet.pb.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
@@ -53,13 +61,17 @@
 #include "yb/tserver/remote_bootstrap.proxy.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/async_util.h"
 #include "yb/util/crc.h"
 #include "yb/util/env.h"
 #include "yb/util/env_util.h"
+#include "yb/util/errno.h"
 #include "yb/util/fault_injection.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/threadpool.h"
 
 DEFINE_int32(remote_bootstrap_begin_session_timeout_ms, 3000,
              "Tablet server RPC client timeout for BeginRemoteBootstrapSession calls.");
@@ -83,6 +95,24 @@ DEFINE_int32(committed_config_change_role_timeout_sec, 30,
              "timing out. ");
 TAG_FLAG(committed_config_change_role_timeout_sec, hidden);
 
+DEFINE_int32(remote_bootstrap_max_concurrent_files, 4,
+             "Number of RocksDB files or WAL segments a remote bootstrap client downloads at the "
+             "same time.");
+TAG_FLAG(remote_bootstrap_max_concurrent_files, advanced);
+
+DEFINE_int32(remote_bootstrap_max_chunks_in_flight, 2,
+             "Number of chunks of the same file a remote bootstrap client requests ahead of the "
+             "one it is writing. Each chunk is up to rpc_max_message_size bytes.");
+TAG_FLAG(remote_bootstrap_max_chunks_in_flight, advanced);
+
+DEFINE_bool(remote_bootstrap_use_local_hard_links, true,
+            "When the RocksDB checkpoint of the remote peer is readable on the local host "
+            "(e.g. a co-located tablet server, or another data directory of this one), hard-link "
+            "its files instead of downloading them. Falls back to a local copy across "
+            "filesystems.");
+TAG_FLAG(remote_bootstrap_use_local_hard_links, advanced);
+TAG_FLAG(remote_bootstrap_use_local_hard_links, runtime);
+
 DECLARE_int32(rpc_max_message_size);
 
 DEFINE_test_flag(double, fault_crash_bootstrap_client_before_changing_role, 0.0,
@@ -98,6 +128,55 @@ DEFINE_test_flag(double, fault_crash_bootstrap_client_before_changing_role, 0.0,
 namespace yb {
 namespace tserver {
 
+namespace {
+
+// State of a single asynchronous FetchData call.
+struct ChunkFetch {
+  FetchDataRequestPB req;
+  FetchDataResponsePB resp;
+  rpc::RpcController controller;
+  Synchronizer sync;
+};
+
+// Fetches of consecutive chunks of a remote file, in the order they were requested. The fetches
+// still in flight are waited for on destruction, since their callbacks refer to their state.
+class ChunkFetchQueue {
+ public:
+  ChunkFetchQueue() {}
+
+  ~ChunkFetchQueue() {
+    Clear();
+  }
+
+  bool empty() const { return fetches_.empty(); }
+  size_t size() const { return fetches_.size(); }
+
+  void Push(std::unique_ptr<ChunkFetch> fetch) {
+    fetches_.push_back(std::move(fetch));
+  }
+
+  std::unique_ptr<ChunkFetch> Pop() {
+    auto result = std::move(fetches_.front());
+    fetches_.pop_front();
+    return result;
+  }
+
+  // Wait for all the fetches in flight and drop their results.
+  void Clear() {
+    for (const auto& fetch : fetches_) {
+      WARN_NOT_OK(fetch->sync.Wait(), "Dropped remote bootstrap chunk fetch failed");
+    }
+    fetches_.clear();
+  }
+
+ private:
+  std::deque<std::unique_ptr<ChunkFetch>> fetches_;
+
+  DISALLOW_COPY_AND_ASSIGN(ChunkFetchQueue);
+};
+
+} // namespace
+
 using consensus::ConsensusMetadata;
 using consensus::ConsensusStatePB;
 using consensus::OpId;
@@ -190,6 +269,9 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
                                     TSTabletManager* ts_manager) {
   CHECK(!started_);
   start_time_micros_ = GetCurrentTimeMicros();
+  if (ts_manager != nullptr) {
+    rate_limiter_ = ts_manager->remote_bootstrap_rate_limiter();
+  }
 
   Endpoint addr;
   RETURN_NOT_OK(EndpointFromHostPort(bootstrap_peer_addr, &addr));
@@ -242,6 +324,7 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
 
   session_idle_timeout_millis_ = resp.session_idle_timeout_millis();
   superblock_.reset(resp.release_superblock());
+  remote_checkpoint_dir_ = resp.rocksdb_checkpoint_dir();
 
   // Clear fields rocksdb_dir and wal_dir so we get an error if we try to use them without setting
   // them to the right path.
@@ -359,6 +442,13 @@ Status RemoteBootstrapClient::FetchAll(TabletStatusListener* status_listener) {
   }
 
   RETURN_NOT_OK(DownloadWALs());
+
+  const uint64_t downloaded_bytes = downloaded_bytes_.load();
+  const double elapsed_secs = (GetCurrentTimeMicros() - start_time_micros_) / 1e6;
+  LOG_WITH_PREFIX(INFO) << "Downloaded " << downloaded_bytes << " bytes in " << elapsed_secs
+                        << " seconds ("
+                        << (elapsed_secs > 0 ? downloaded_bytes / elapsed_secs / 1_MB : 0)
+                        << " MB/s)";
   return Status::OK();
 }
 
@@ -526,15 +616,11 @@ Status RemoteBootstrapClient::DownloadWALs() {
                         Substitute("Failed to sync WAL table directory $0", wal_table_top_dir));
 
   // Download the WAL segments.
-  int num_segments = wal_seqnos_.size();
-  LOG_WITH_PREFIX(INFO) << "Starting download of " << num_segments << " WAL segments...";
-  uint64_t counter = 0;
+  vector<std::function<Status()>> downloads;
   for (uint64_t seg_seqno : wal_seqnos_) {
-    UpdateStatusMessage(Substitute("Downloading WAL segment with seq. number $0 ($1/$2)",
-                                   seg_seqno, counter + 1, num_segments));
-    RETURN_NOT_OK(DownloadWAL(seg_seqno));
-    ++counter;
+    downloads.push_back([this, seg_seqno] { return DownloadWAL(seg_seqno); });
   }
+  RETURN_NOT_OK(RunDownloads(Substitute("$0 WAL segments", downloads.size()), downloads));
 
   downloaded_wal_ = true;
   return Status::OK();
@@ -556,26 +642,115 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
                         Substitute("Failed to create RocksDB tablet directory $0",
                                    rocksdb_dir));
 
+  vector<std::function<Status()>> downloads;
   for (auto const& file_pb : new_sb->rocksdb_files()) {
-    WritableFileOptions opts;
-    opts.sync_on_close = true;
-    gscoped_ptr<WritableFile> rocksdb_file;
-    auto file_path = JoinPathSegments(rocksdb_dir, file_pb.name());
-    RETURN_NOT_OK(fs_manager_->env()->NewWritableFile(opts, file_path, &rocksdb_file));
-
-    DataIdPB data_id;
-    data_id.set_type(DataIdPB::ROCKSDB_FILE);
-    data_id.set_file_name(file_pb.name());
-    RETURN_NOT_OK_PREPEND(DownloadFile(data_id, rocksdb_file.get()),
-                          Substitute("Unable to download rocksdb file $0",
-                                     file_path));
-    VLOG(2) << "Downloading file " << file_path;
+    downloads.push_back([this, rocksdb_dir, file_pb]() -> Status {
+      const auto& file_name = file_pb.name();
+      auto file_path = JoinPathSegments(rocksdb_dir, file_name);
+      bool copied_locally = false;
+      RETURN_NOT_OK(CopyLocalRocksDBFile(file_pb, file_path, &copied_locally));
+      if (copied_locally) {
+        return Status::OK();
+      }
+
+      WritableFileOptions opts;
+      opts.sync_on_close = true;
+      gscoped_ptr<WritableFile> rocksdb_file;
+      RETURN_NOT_OK(fs_manager_->env()->NewWritableFile(opts, file_path, &rocksdb_file));
+
+      VLOG(2) << "Downloading file " << file_path;
+      DataIdPB data_id;
+      data_id.set_type(DataIdPB::ROCKSDB_FILE);
+      data_id.set_file_name(file_name);
+      RETURN_NOT_OK_PREPEND(DownloadFile(data_id, rocksdb_file.get()),
+                            Substitute("Unable to download rocksdb file $0",
+                                       file_path));
+      return Status::OK();
+    });
+  }
+  RETURN_NOT_OK(RunDownloads(Substitute("$0 RocksDB files", downloads.size()), downloads));
+  if (local_rocksdb_files_ > 0) {
+    LOG_WITH_PREFIX(INFO) << "Copied " << local_rocksdb_files_ << " of "
+                          << new_sb->rocksdb_files_size() << " RocksDB files from local checkpoint "
+                          << remote_checkpoint_dir_;
   }
   new_superblock_.swap(new_sb);
   downloaded_rocksdb_files_ = true;
   return Status::OK();
 }
 
+bool RemoteBootstrapClient::GetLocalSourceFile(const std::string& src_path,
+                                               const std::string& dest_dir,
+                                               uint64_t expected_size,
+                                               bool* same_filesystem) {
+  // The checkpoint of a co-located peer could live under the data directories of another tablet
+  // server, so we accept any readable regular file of the expected size, and hard-link it when it
+  // is on the same filesystem as our own RocksDB directory.
+  struct stat src_stat;
+  if (stat(src_path.c_str(), &src_stat) != 0 || !S_ISREG(src_stat.st_mode) ||
+      static_cast<uint64_t>(src_stat.st_size) != expected_size ||
+      access(src_path.c_str(), R_OK) != 0) {
+    return false;
+  }
+  struct stat dest_stat;
+  if (stat(dest_dir.c_str(), &dest_stat) != 0) {
+    VLOG_WITH_PREFIX(1) << "Unable to stat " << dest_dir << ": " << ErrnoToString(errno);
+    return false;
+  }
+  *same_filesystem = src_stat.st_dev == dest_stat.st_dev;
+  return true;
+}
+
+Status RemoteBootstrapClient::CopyLocalRocksDBFile(const tablet::RocksDBFilePB& file_pb,
+                                                   const std::string& dest_path,
+                                                   bool* done) {
+  *done = false;
+  if (!FLAGS_remote_bootstrap_use_local_hard_links || remote_checkpoint_dir_.empty()) {
+    return Status::OK();
+  }
+
+  // The checkpoint directory name is unique to the remote session (it contains the tablet id, the
+  // last logged op id and a timestamp), so finding a file of the expected size under it means we
+  // are looking at the remote peer's own checkpoint.
+  Env* env = fs_manager_->env();
+  auto src_path = JoinPathSegments(remote_checkpoint_dir_, file_pb.name());
+  bool same_filesystem = false;
+  if (!GetLocalSourceFile(src_path, DirName(dest_path), file_pb.size_bytes(), &same_filesystem)) {
+    return Status::OK();
+  }
+
+  if (env->FileExists(dest_path)) {
+    RETURN_NOT_OK(env->DeleteFile(dest_path));
+  }
+
+  // RocksDB files are immutable, so sharing the inode with the remote checkpoint is safe. This is
+  // the same mechanism Tablet::CreateCheckpoint uses. Two mount points of the same filesystem
+  // still refuse to link across them, which LinkFile reports as NotSupported (EXDEV).
+  bool linked = false;
+  if (same_filesystem) {
+    Status s = rocksdb::Env::Default()->LinkFile(src_path, dest_path);
+    if (s.ok()) {
+      linked = true;
+    } else if (!s.IsNotSupported()) {
+      VLOG_WITH_PREFIX(1) << "Unable to hard-link " << src_path << ": " << s.ToString()
+                          << ", downloading it instead";
+      return Status::OK();
+    }
+  }
+  if (!linked) {
+    ThrottleDownload(file_pb.size_bytes());
+    WritableFileOptions opts;
+    opts.sync_on_close = true;
+    RETURN_NOT_OK_PREPEND(CopyFile(env, src_path, dest_path, opts),
+                          Substitute("Unable to copy local rocksdb file $0", src_path));
+  }
+
+  VLOG_WITH_PREFIX(2) << (linked ? "Hard-linked " : "Copied ") << src_path << " to " << dest_path;
+  ++local_rocksdb_files_;
+  *done = true;
+  return Status::OK();
+}
+
 Status RemoteBootstrapClient::DownloadBlocks() {
   CHECK(started_);
 
@@ -710,39 +885,128 @@ Status RemoteBootstrapClient::DownloadBlock(const BlockId& old_block_id,
   return Status::OK();
 }
 
+Status RemoteBootstrapClient::RunDownloads(const string& description,
+                                           const vector<std::function<Status()>>& downloads) {
+  if (downloads.empty()) {
+    return Status::OK();
+  }
+  const int num_threads = std::min<int>(std::max(FLAGS_remote_bootstrap_max_concurrent_files, 1),
+                                        downloads.size());
+  UpdateStatusMessage(Substitute("Downloading $0", description));
+  LOG_WITH_PREFIX(INFO) << "Starting download of " << description << " using " << num_threads
+                        << " threads...";
+
+  if (num_threads == 1) {
+    for (const auto& download : downloads) {
+      RETURN_NOT_OK(download());
+    }
+    return Status::OK();
+  }
+
+  std::mutex mutex;
+  Status result;
+  std::atomic<bool> failed(false);
+  gscoped_ptr<ThreadPool> pool;
+  RETURN_NOT_OK(ThreadPoolBuilder("rb-download").set_max_threads(num_threads).Build(&pool));
+  for (const auto& download : downloads) {
+    Status s = pool->SubmitFunc([&download, &mutex, &result, &failed] {
+      if (failed.load(std::memory_order_acquire)) {
+        return;
+      }
+      Status download_status = download();
+      if (!download_status.ok()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (result.ok()) {
+          result = download_status;
+        }
+        failed.store(true, std::memory_order_release);
+      }
+    });
+    if (!s.ok()) {
+      pool->Wait();
+      return s;
+    }
+  }
+  pool->Wait();
+  return result;
+}
+
+void RemoteBootstrapClient::ThrottleDownload(int64_t bytes) {
+  if (!rate_limiter_) {
+    return;
+  }
+  const int64_t max_request = rate_limiter_->GetSingleBurstBytes();
+  while (bytes > 0) {
+    const int64_t request = std::min(bytes, max_request);
+    rate_limiter_->Request(request, rocksdb::Env::IO_HIGH);
+    bytes -= request;
+  }
+}
+
 template<class Appendable>
 Status RemoteBootstrapClient::DownloadFile(const DataIdPB& data_id,
                                            Appendable* appendable) {
+  const int32_t max_length = FLAGS_rpc_max_message_size - 1024; // Leave 1K for message headers.
+  const size_t max_chunks_in_flight = std::max(FLAGS_remote_bootstrap_max_chunks_in_flight, 1);
+
+  ChunkFetchQueue queue;
+  auto start_fetch = [this, &data_id, &queue](uint64_t offset, int64_t length) {
+    std::unique_ptr<ChunkFetch> fetch(new ChunkFetch());
+    fetch->req.set_session_id(session_id_);
+    fetch->req.mutable_data_id()->CopyFrom(data_id);
+    fetch->req.set_offset(offset);
+    fetch->req.set_max_length(length);
+    fetch->controller.set_timeout(MonoDelta::FromMilliseconds(session_idle_timeout_millis_));
+    ChunkFetch* raw_fetch = fetch.get();
+    queue.Push(std::move(fetch));
+    proxy_->FetchDataAsync(raw_fetch->req, &raw_fetch->resp, &raw_fetch->controller,
+                           [raw_fetch] {
+      raw_fetch->sync.StatusCB(raw_fetch->controller.status());
+    });
+  };
+
+  // The first response tells us the size of the file and the largest chunk the remote is willing
+  // to send. Further chunks are requested with that size, ahead of the one being written.
   uint64_t offset = 0;
-  int32_t max_length = FLAGS_rpc_max_message_size - 1024; // Leave 1K for message headers.
-
-  rpc::RpcController controller;
-  controller.set_timeout(MonoDelta::FromMilliseconds(session_idle_timeout_millis_));
-  FetchDataRequestPB req;
-
-  bool done = false;
-  while (!done) {
-    controller.Reset();
-    req.set_session_id(session_id_);
-    req.mutable_data_id()->CopyFrom(data_id);
-    req.set_offset(offset);
-    req.set_max_length(max_length);
-
-    FetchDataResponsePB resp;
-    RETURN_NOT_OK_UNWIND_PREPEND(proxy_->FetchData(req, &resp, &controller),
-                                controller,
-                                "Unable to fetch data from remote");
+  uint64_t next_fetch_offset = 0;
+  uint64_t total_length = 0;
+  int64_t chunk_length = 0;
+  start_fetch(0, max_length);
+  while (!queue.empty()) {
+    auto fetch = queue.Pop();
+    RETURN_NOT_OK_UNWIND_PREPEND(fetch->sync.Wait(),
+                                 fetch->controller,
+                                 "Unable to fetch data from remote");
+    const DataChunkPB& chunk = fetch->resp.chunk();
     // Sanity-check for corruption.
-    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk()),
+    RETURN_NOT_OK_PREPEND(VerifyData(offset, chunk),
                           Substitute("Error validating data item $0", data_id.ShortDebugString()));
 
     // Write the data.
-    RETURN_NOT_OK(appendable->Append(resp.chunk().data()));
+    RETURN_NOT_OK(appendable->Append(chunk.data()));
+    offset += chunk.data().size();
+    downloaded_bytes_ += chunk.data().size();
+    // Charge what was actually received: the remote may send less than was asked for, and the
+    // chunks dropped below are never charged. Waiting here also holds back the next fetches.
+    ThrottleDownload(chunk.data().size());
+
+    if (chunk_length == 0) {
+      total_length = chunk.total_data_length();
+      chunk_length = std::max<int64_t>(chunk.data().size(), 1);
+      next_fetch_offset = offset;
+    } else if (static_cast<int64_t>(chunk.data().size()) < fetch->req.max_length() &&
+               offset < total_length) {
+      // The remote sent less than we asked for, so the chunks requested after this one do not
+      // start where this one ends. Drop them and carry on from here.
+      queue.Clear();
+      next_fetch_offset = offset;
+    }
 
-    if (offset + resp.chunk().data().size() == resp.chunk().total_data_length()) {
-      done = true;
+    while (queue.size() < max_chunks_in_flight && next_fetch_offset < total_length) {
+      const int64_t length = std::min<uint64_t>(chunk_length, total_length - next_fetch_offset);
+      start_fetch(next_fetch_offset, length);
+      next_fetch_offset += length;
     }
-    offset += resp.chunk().data().size();
   }
 
   return Status::OK();
@@ -32,6 +32,8 @@
 #ifndef YB_TSERVER_REMOTE_BOOTSTRAP_CLIENT_H
 #define YB_TSERVER_REMOTE_BOOTSTRAP_CLIENT_H
 
+#include <atomic>
+#include <functional>
 #include <string>
 #include <memory>
 #include <vector>
@@ -45,6 +47,10 @@
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/util/status.h"
 
+namespace rocksdb {
+class RateLimiter;
+} // namespace rocksdb
+
 namespace yb {
 
 class BlockId;
@@ -61,6 +67,7 @@ class RaftPeerPB;
 
 namespace tablet {
 class TabletMetadata;
+class RocksDBFilePB;
 class TabletPeer;
 class TabletStatusListener;
 class TabletSuperBlockPB;
@@ -73,10 +80,16 @@ class RemoteBootstrapServiceProxy;
 class TSTabletManager;
 
 // Client class for using remote bootstrap to copy a tablet from another host.
-// This class is not thread-safe.
+// The public interface is not thread-safe and must be driven by a single thread.
+//
+// RocksDB files and WAL segments are downloaded several at a time, and several chunks of each
+// file are kept in flight, subject to the tablet server wide remote bootstrap bandwidth budget.
+// The concurrent downloads only share the proxy, the rate limiter and the status listener, which
+// are thread-safe, and the atomic counters below; everything else is only touched by the thread
+// driving the session, before or after the downloads.
 //
 // TODO:
-// * Parallelize download of blocks and WAL segments.
+// * Parallelize download of blocks.
 //
 class RemoteBootstrapClient {
  public:
@@ -132,6 +145,10 @@ class RemoteBootstrapClient {
  private:
   FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestBeginEndSession);
   FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles);
+  FRIEND_TEST(RemoteBootstrapRocksDBClientTest, BenchmarkDownloadThroughput);
+  FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestHardLinkLocalRocksDBFiles);
+  FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestHardLinkCoLocatedPeerRocksDBFiles);
+  FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestDownloadMissingLocalRocksDBFiles);
 
   // Extract the embedded Status message from the given ErrorStatusPB.
   // The given ErrorStatusPB must extend RemoteBootstrapErrorPB.
@@ -147,7 +164,7 @@ class RemoteBootstrapClient {
   // End the remote bootstrap session.
   CHECKED_STATUS EndRemoteSession();
 
-  // Download all WAL files sequentially.
+  // Download all WAL files, several at a time.
   CHECKED_STATUS DownloadWALs();
 
   // Download a single WAL file.
@@ -180,7 +197,8 @@ class RemoteBootstrapClient {
   CHECKED_STATUS DownloadBlock(const BlockId& old_block_id, BlockId* new_block_id);
 
   // Download a single remote file. The block and WAL implementations delegate
-  // to this method when downloading files.
+  // to this method when downloading files. Up to remote_bootstrap_max_chunks_in_flight chunks of
+  // the file are requested ahead of the one being appended.
   //
   // An Appendable is typically a WritableBlock (block) or WritableFile (WAL).
   //
@@ -189,8 +207,32 @@ class RemoteBootstrapClient {
   template<class Appendable>
   CHECKED_STATUS DownloadFile(const DataIdPB& data_id, Appendable* appendable);
 
+  // Download all RocksDB files, several at a time.
   CHECKED_STATUS DownloadRocksDBFiles();
 
+  // Try to materialize a RocksDB file of the remote checkpoint directly from the local filesystem,
+  // by hard-linking it (or copying it, when the checkpoint is on another local filesystem). Sets
+  // *done to false when the checkpoint is not readable from this host, so the caller falls back to
+  // fetching the file over RPC.
+  CHECKED_STATUS CopyLocalRocksDBFile(const tablet::RocksDBFilePB& file_pb,
+                                      const std::string& dest_path,
+                                      bool* done);
+
+  // Whether src_path is a readable regular file of the expected size. If so, sets
+  // *same_filesystem to whether it could be hard-linked into dest_dir.
+  bool GetLocalSourceFile(const std::string& src_path,
+                          const std::string& dest_dir,
+                          uint64_t expected_size,
+                          bool* same_filesystem);
+
+  // Run the given downloads on up to remote_bootstrap_max_concurrent_files threads. Returns the
+  // first failure, after which the downloads that have not started yet are skipped.
+  CHECKED_STATUS RunDownloads(const std::string& description,
+                              const std::vector<std::function<Status()>>& downloads);
+
+  // Block until the tablet server bandwidth budget allows fetching this many more bytes.
+  void ThrottleDownload(int64_t bytes);
+
   CHECKED_STATUS VerifyData(uint64_t offset, const DataChunkPB& resp);
 
   // Return standard log prefix.
@@ -227,8 +269,21 @@ class RemoteBootstrapClient {
   gscoped_ptr<consensus::ConsensusStatePB> remote_committed_cstate_;
   std::vector<uint64_t> wal_seqnos_;
 
+  // RocksDB checkpoint directory of the session on the remote peer, used for local copies.
+  std::string remote_checkpoint_dir_;
+
+  // Number of RocksDB files that were hard-linked or copied locally instead of downloaded.
+  std::atomic<int> local_rocksdb_files_{0};
+
   int64_t start_time_micros_;
 
+  // Shared by all the remote bootstrap sessions of this tablet server, owned by TSTabletManager.
+  // Null if the bandwidth is not limited.
+  rocksdb::RateLimiter* rate_limiter_ = nullptr;
+
+  // Number of bytes of files, blocks and WAL segments downloaded so far.
+  std::atomic<uint64_t> downloaded_bytes_{0};
+
   // We track whether this session succeeded and send this information as part of the
   // EndRemoteBootstrapSessionRequestPB request.
   bool succeeded_;
@@ -11,10 +11,19 @@
 // under the License.
 //
 
+#include <sys/stat.h>
+
 #include <algorithm>
 
 #include "yb/tserver/remote_bootstrap_client-test.h"
+#include "yb/rocksdb/env.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/stopwatch.h"
 
+DECLARE_int32(rpc_max_message_size);
+DECLARE_int32(remote_bootstrap_max_concurrent_files);
+DECLARE_int32(remote_bootstrap_max_chunks_in_flight);
+DECLARE_bool(remote_bootstrap_use_local_hard_links);
 
 using std::shared_ptr;
 
@@ -44,6 +53,8 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestBeginEndSession) {
 
 // Basic RocksDB files download unit test.
 TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
+  // The tablet server is co-located, so force the files through FetchData.
+  FLAGS_remote_bootstrap_use_local_hard_links = false;
   TabletStatusListener listener(meta_);
   ASSERT_OK(client_->DownloadRocksDBFiles());
   auto tablet_peer_checkpoint_dir = tablet_peer_->tablet()->GetLastRocksDBCheckpointDirForTest();
@@ -78,5 +89,101 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
   }
 }
 
+// Compares remote bootstrap throughput when files and chunks are downloaded one at a time with
+// the parallel, pipelined download. Chunks are made small so that every file takes many round
+// trips.
+TEST_F(RemoteBootstrapRocksDBClientTest, BenchmarkDownloadThroughput) {
+  FLAGS_rpc_max_message_size = 64_KB;
+  FLAGS_remote_bootstrap_use_local_hard_links = false;
+  const int kIterations = 5;
+
+  for (bool pipelined : {false, true}) {
+    FLAGS_remote_bootstrap_max_concurrent_files = pipelined ? 4 : 1;
+    FLAGS_remote_bootstrap_max_chunks_in_flight = pipelined ? 4 : 1;
+
+    const uint64_t bytes_before = client_->downloaded_bytes_;
+    Stopwatch sw(Stopwatch::ALL_THREADS);
+    sw.start();
+    for (int i = 0; i < kIterations; ++i) {
+      ASSERT_OK(client_->DownloadRocksDBFiles());
+      ASSERT_OK(client_->DownloadWALs());
+    }
+    sw.stop();
+
+    const uint64_t bytes = client_->downloaded_bytes_ - bytes_before;
+    const double seconds = sw.elapsed().wall_seconds();
+    ASSERT_GT(bytes, 0);
+    LOG(INFO) << (pipelined ? "Pipelined" : "Sequential") << " remote bootstrap: " << bytes
+              << " bytes in " << sw.elapsed().ToString() << ", "
+              << (seconds > 0 ? bytes / seconds / 1_MB : 0) << " MB/s";
+  }
+}
+
+// The remote checkpoint belongs to another tablet server on the same host, outside of the data
+// directories of the client, so its RocksDB files should be hard-linked rather than downloaded.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestHardLinkCoLocatedPeerRocksDBFiles) {
+  FLAGS_remote_bootstrap_use_local_hard_links = true;
+  auto tablet_peer_checkpoint_dir = tablet_peer_->tablet()->GetLastRocksDBCheckpointDirForTest();
+  ASSERT_EQ(tablet_peer_checkpoint_dir, client_->remote_checkpoint_dir_);
+
+  const uint64_t bytes_before = client_->downloaded_bytes_;
+  ASSERT_OK(client_->DownloadRocksDBFiles());
+  ASSERT_EQ(bytes_before, client_->downloaded_bytes_);
+  ASSERT_EQ(client_->new_superblock_->rocksdb_files_size(), client_->local_rocksdb_files_);
+
+  ASSERT_OK(client_->DownloadWALs());
+  ASSERT_OK(client_->Finish());
+}
+
+// When the remote checkpoint is under one of the data directories of the client, as when a tablet
+// moves between data directories, the RocksDB files should be hard-linked rather than downloaded.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestHardLinkLocalRocksDBFiles) {
+  FLAGS_remote_bootstrap_use_local_hard_links = true;
+  auto tablet_peer_checkpoint_dir = tablet_peer_->tablet()->GetLastRocksDBCheckpointDirForTest();
+  ASSERT_EQ(tablet_peer_checkpoint_dir, client_->remote_checkpoint_dir_);
+
+  // Expose the checkpoint under our own data directory.
+  auto env = fs_manager_->env();
+  auto local_checkpoint_dir = JoinPathSegments(fs_manager_->GetDataRootDirs()[0], "checkpoint");
+  ASSERT_OK(env->CreateDir(local_checkpoint_dir));
+  for (const auto& file_pb : client_->superblock_->rocksdb_files()) {
+    ASSERT_OK(rocksdb::Env::Default()->LinkFile(
+        JoinPathSegments(tablet_peer_checkpoint_dir, file_pb.name()),
+        JoinPathSegments(local_checkpoint_dir, file_pb.name())));
+  }
+  client_->remote_checkpoint_dir_ = local_checkpoint_dir;
+
+  const uint64_t bytes_before = client_->downloaded_bytes_;
+  ASSERT_OK(client_->DownloadRocksDBFiles());
+  ASSERT_EQ(bytes_before, client_->downloaded_bytes_);
+  ASSERT_EQ(client_->new_superblock_->rocksdb_files_size(), client_->local_rocksdb_files_);
+
+  for (const auto& file_pb : client_->new_superblock_->rocksdb_files()) {
+    auto local_path = JoinPathSegments(meta_->rocksdb_dir(), file_pb.name());
+    auto remote_path = JoinPathSegments(tablet_peer_checkpoint_dir, file_pb.name());
+    struct stat local_stat, remote_stat;
+    ASSERT_EQ(0, stat(local_path.c_str(), &local_stat)) << local_path;
+    ASSERT_EQ(0, stat(remote_path.c_str(), &remote_stat)) << remote_path;
+    ASSERT_EQ(remote_stat.st_ino, local_stat.st_ino) << local_path;
+    ASSERT_EQ(file_pb.size_bytes(), local_stat.st_size);
+  }
+
+  // The bootstrapped tablet must still end up with a complete copy of the data.
+  ASSERT_OK(client_->DownloadWALs());
+  ASSERT_OK(client_->Finish());
+}
+
+// Files of the remote checkpoint that are not readable locally are downloaded over RPC.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadMissingLocalRocksDBFiles) {
+  FLAGS_remote_bootstrap_use_local_hard_links = true;
+  client_->remote_checkpoint_dir_ =
+      JoinPathSegments(fs_manager_->GetDataRootDirs()[0], "missing_checkpoint");
+
+  const uint64_t bytes_before = client_->downloaded_bytes_;
+  ASSERT_OK(client_->DownloadRocksDBFiles());
+  ASSERT_EQ(0, client_->local_rocksdb_files_);
+  ASSERT_GT(client_->downloaded_bytes_, bytes_before);
+}
+
 } // namespace tserver
 } // namespace yb
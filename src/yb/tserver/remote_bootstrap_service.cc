@@ -182,6 +182,9 @@ void RemoteBootstrapServiceImpl::BeginRemoteBootstrapSession(
   resp->set_session_idle_timeout_millis(FLAGS_remote_bootstrap_idle_timeout_ms);
   resp->mutable_superblock()->CopyFrom(session->tablet_superblock());
   resp->mutable_initial_committed_cstate()->CopyFrom(session->initial_committed_cstate());
+  if (!session->checkpoint_dir().empty()) {
+    resp->set_rocksdb_checkpoint_dir(session->checkpoint_dir());
+  }
 
   for (const scoped_refptr<log::ReadableLogSegment>& segment : session->log_segments()) {
     resp->add_wal_segment_seqnos(segment->header().sequence_number());
@@ -132,6 +132,7 @@ class RemoteBootstrapTest : public YBTabletTest {
         new TabletPeerClass(tablet()->metadata(),
                             config_peer,
                             apply_pool_.get(),
+                            nullptr /* log_cache_read_ahead_pool */,
                             Bind(&RemoteBootstrapTest::TabletPeerStateChangedCallback,
                                  Unretained(this),
                                  tablet()->tablet_id())));
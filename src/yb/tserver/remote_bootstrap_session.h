@@ -146,6 +146,9 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
 
   const tablet::TabletSuperBlockPB& tablet_superblock() const { return tablet_superblock_; }
 
+  // Directory holding the RocksDB checkpoint for this session. Empty for Kudu columnar tablets.
+  const std::string& checkpoint_dir() const { return checkpoint_dir_; }
+
   const consensus::ConsensusStatePB& initial_committed_cstate() const {
     return initial_committed_cstate_;
   }
@@ -33,7 +33,9 @@
 #include "yb/tserver/tablet_service.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -64,14 +66,17 @@
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver.pb.h"
+#include "yb/util/countdown_latch.h"
 #include "yb/util/crc.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/faststring.h"
+#include "yb/util/metrics.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/monotime.h"
 #include "yb/util/status.h"
 #include "yb/util/status_callback.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/trace.h"
 #include "yb/consensus/consensus.pb.h"
 #include "yb/tserver/service_util.h"
@@ -109,6 +114,33 @@ DEFINE_bool(tserver_noop_read_write, false, "Respond NOOP to read/write.");
 TAG_FLAG(tserver_noop_read_write, unsafe);
 TAG_FLAG(tserver_noop_read_write, hidden);
 
+DEFINE_int32(tserver_read_batch_parallel_threshold, 64,
+             "Batched read requests with at least this many entries are split into chunks that "
+             "are executed concurrently. 0 disables concurrent execution of batched reads.");
+TAG_FLAG(tserver_read_batch_parallel_threshold, advanced);
+TAG_FLAG(tserver_read_batch_parallel_threshold, runtime);
+
+DEFINE_int32(tserver_read_batch_max_parallelism, 4,
+             "Maximum number of chunks a single batched read request is split into.");
+TAG_FLAG(tserver_read_batch_max_parallelism, advanced);
+TAG_FLAG(tserver_read_batch_max_parallelism, runtime);
+
+DEFINE_test_flag(int32, read_batch_chunk_delay_ms, 0,
+                 "Sleep this many milliseconds before processing each chunk of a batched read "
+                 "that is executed concurrently.");
+
+DEFINE_int32(follower_read_max_wait_ms, 50,
+             "Maximum time in milliseconds a follower waits for its propagated safe time to catch "
+             "up with the staleness bound of a read before redirecting the client to the leader.");
+TAG_FLAG(follower_read_max_wait_ms, advanced);
+TAG_FLAG(follower_read_max_wait_ms, runtime);
+
+METRIC_DEFINE_counter(server, concurrent_read_batches,
+                      "Concurrent Read Batches",
+                      yb::MetricUnit::kRequests,
+                      "Number of batched read requests that had several of their chunks "
+                      "processed at the same time");
+
 namespace yb {
 namespace tserver {
 
@@ -483,7 +515,13 @@ static size_t GetMaxBatchSizeBytesHint(const ScanRequestPB* req) {
 
 TabletServiceImpl::TabletServiceImpl(TabletServerIf* server)
     : TabletServerServiceIf(server->MetricEnt()),
-      server_(server) {
+      server_(server),
+      concurrent_read_batches_(METRIC_concurrent_read_batches.Instantiate(server->MetricEnt())) {
+  CHECK_OK(ThreadPoolBuilder("read-batch").Build(&read_batch_pool_));
+}
+
+TabletServiceImpl::~TabletServiceImpl() {
+  Shutdown();
 }
 
 TabletServiceAdminImpl::TabletServiceAdminImpl(TabletServer* server)
@@ -858,16 +896,10 @@ Status TabletServiceImpl::CheckPeerIsReady(const TabletPeer& tablet_peer,
   return Status::OK();
 }
 
-Status TabletServiceImpl::CheckPeerIsLeader(const TabletPeer& tablet_peer,
-                                            TabletServerErrorPB::Code* error_code) {
-  scoped_refptr<consensus::Consensus> consensus = tablet_peer.shared_consensus();
-  const Consensus::LeaderStatus leader_status = consensus->leader_status();
-
-  VLOG(1) << "Check for " << Format(
-      "tablet $0 peer $1. Peer role is $2. Leader status is $3.",
-      tablet_peer.tablet_id(), tablet_peer.permanent_uuid(),
-      consensus->role(), static_cast<int>(leader_status));
+namespace {
 
+Status LeaderStatusToStatus(Consensus::LeaderStatus leader_status,
+                            TabletServerErrorPB::Code* error_code) {
   switch (leader_status) {
     case Consensus::LeaderStatus::NOT_LEADER:
       *error_code = TabletServerErrorPB::NOT_THE_LEADER;
@@ -883,6 +915,37 @@ Status TabletServiceImpl::CheckPeerIsLeader(const TabletPeer& tablet_peer,
   FATAL_INVALID_ENUM_VALUE(consensus::Consensus::LeaderStatus, leader_status);
 }
 
+} // namespace
+
+Status TabletServiceImpl::CheckPeerIsLeader(const TabletPeer& tablet_peer,
+                                            TabletServerErrorPB::Code* error_code) {
+  scoped_refptr<consensus::Consensus> consensus = tablet_peer.shared_consensus();
+  const Consensus::LeaderStatus leader_status = consensus->leader_status();
+
+  VLOG(1) << "Check for " << Format(
+      "tablet $0 peer $1. Peer role is $2. Leader status is $3.",
+      tablet_peer.tablet_id(), tablet_peer.permanent_uuid(),
+      consensus->role(), static_cast<int>(leader_status));
+
+  return LeaderStatusToStatus(leader_status, error_code);
+}
+
+Status TabletServiceImpl::CheckPeerIsLeaderForRead(const TabletPeer& tablet_peer,
+                                                   HybridTime read_ht,
+                                                   TabletServerErrorPB::Code* error_code,
+                                                   LeaderLeaseStatus* leader_lease_status) {
+  scoped_refptr<consensus::Consensus> consensus = tablet_peer.shared_consensus();
+  const Consensus::LeaderStatus leader_status =
+      consensus->LeaderStatusForRead(read_ht, leader_lease_status);
+
+  VLOG(1) << "Check for read at " << read_ht << " " << Format(
+      "tablet $0 peer $1. Leader status is $2. Lease status is $3.",
+      tablet_peer.tablet_id(), tablet_peer.permanent_uuid(),
+      static_cast<int>(leader_status), LeaderLeaseStatus_Name(*leader_lease_status));
+
+  return LeaderStatusToStatus(leader_status, error_code);
+}
+
 Status TabletServiceImpl::CheckPeerIsLeaderAndReady(const TabletPeer& tablet_peer,
                                                     TabletServerErrorPB::Code* error_code) {
   RETURN_NOT_OK(CheckPeerIsReady(tablet_peer, error_code));
@@ -893,7 +956,8 @@ Status TabletServiceImpl::CheckPeerIsLeaderAndReady(const TabletPeer& tablet_pee
 bool TabletServiceImpl::GetTabletOrRespond(const ReadRequestPB* req,
                                            ReadResponsePB* resp,
                                            rpc::RpcContext* context,
-                                           shared_ptr<tablet::AbstractTablet>* tablet) {
+                                           shared_ptr<tablet::AbstractTablet>* tablet,
+                                           HybridTime* read_time) {
   scoped_refptr<TabletPeer> tablet_peer;
   if (!LookupTabletPeerOrRespond(server_->tablet_manager(), req->tablet_id(), resp, context,
                                  &tablet_peer)) {
@@ -907,21 +971,58 @@ bool TabletServiceImpl::GetTabletOrRespond(const ReadRequestPB* req,
     return false;
   }
 
-  // Check for leader only in strong consistency level.
+  shared_ptr<tablet::Tablet> ptr;
+  s = GetTabletRef(tablet_peer, &ptr, &error_code);
+  if (PREDICT_FALSE(!s.ok())) {
+    SetupErrorAndRespond(resp->mutable_error(), s, error_code, context);
+    return false;
+  }
+
+  // Check for leader only in strong consistency level. The leader serves the read locally without
+  // a round trip to the followers, so its hybrid time lease has to cover any read time it could
+  // pick, i.e. the latest possible current time given the clock error.
   if (req->consistency_level() == YBConsistencyLevel::STRONG) {
-    s = CheckPeerIsLeader(*tablet_peer.get(), &error_code);
+    LeaderLeaseStatus leader_lease_status = LeaderLeaseStatus::HAS_LEASE;
+    s = CheckPeerIsLeaderForRead(
+        *tablet_peer.get(), server_->Clock()->NowLatest(), &error_code, &leader_lease_status);
     if (PREDICT_FALSE(!s.ok())) {
+      if (leader_lease_status != LeaderLeaseStatus::HAS_LEASE &&
+          error_code == TabletServerErrorPB::LEADER_NOT_READY_TO_SERVE) {
+        ptr->metrics()->leader_lease_expired_read_rejections->Increment();
+      }
       SetupErrorAndRespond(resp->mutable_error(), s, error_code, context);
       return false;
     }
   }
 
-  shared_ptr<tablet::Tablet> ptr;
-  s = GetTabletRef(tablet_peer, &ptr, &error_code);
-  if (PREDICT_FALSE(!s.ok())) {
-    SetupErrorAndRespond(resp->mutable_error(), s, error_code, context);
-    return false;
+  // A follower bounds the staleness of the read by reading at the safe time propagated by the
+  // leader. If that lags too far behind, wait for it briefly and then redirect to the leader.
+  if (req->consistency_level() == YBConsistencyLevel::CONSISTENT_PREFIX &&
+      req->has_max_staleness_ms() &&
+      tablet_peer->consensus()->leader_status() !=
+          Consensus::LeaderStatus::LEADER_AND_READY) {
+    const MicrosTime now = server_->Clock()->Now().GetPhysicalValueMicros();
+    const MicrosTime max_staleness = req->max_staleness_ms() * 1000ULL;
+    const HybridTime min_safe_time =
+        HybridTime::FromMicros(now > max_staleness ? now - max_staleness : 0);
+    const MonoTime deadline = std::min(
+        context->GetClientDeadline(),
+        MonoTime::FineNow() + MonoDelta::FromMilliseconds(FLAGS_follower_read_max_wait_ms));
+    const HybridTime safe_time = ptr->propagated_safe_time()->WaitFor(min_safe_time, deadline);
+    if (!safe_time.is_valid() || safe_time < min_safe_time) {
+      ptr->metrics()->stale_follower_read_rejections->Increment();
+      SetupErrorAndRespond(
+          resp->mutable_error(),
+          STATUS_FORMAT(IllegalState, "Follower safe time $0 is older than $1 ms",
+                        safe_time, req->max_staleness_ms()),
+          TabletServerErrorPB::STALE_FOLLOWER, context);
+      return false;
+    }
+    TRACE("Reading on follower at $0", safe_time.ToString());
+    ptr->metrics()->follower_reads->Increment();
+    *read_time = safe_time;
   }
+
   *tablet = ptr;
   return true;
 }
@@ -939,46 +1040,93 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   DVLOG(3) << "Received Read RPC: " << req->DebugString();
 
   shared_ptr<tablet::AbstractTablet> tablet;
-  if (!GetTabletOrRespond(req, resp, &context, &tablet)) {
+  HybridTime read_time;
+  if (!GetTabletOrRespond(req, resp, &context, &tablet, &read_time)) {
     return;
   }
 
   Status s;
-  tablet::ScopedReadOperation read_tx(tablet.get());
+  tablet::ScopedReadOperation read_tx(tablet.get(), read_time);
+  read_time = read_tx.GetReadTimestamp();
   switch (tablet->table_type()) {
     case TableType::REDIS_TABLE_TYPE: {
-      for (const RedisReadRequestPB& redis_read_req : req->redis_batch()) {
-        RedisResponsePB redis_response;
-        s = tablet->HandleRedisReadRequest(
-            read_tx.GetReadTimestamp(), redis_read_req, &redis_response);
-        RETURN_UNKNOWN_ERROR_IF_NOT_OK(s, resp, &context);
-        *(resp->add_redis_batch()) = redis_response;
+      const auto& batch = req->redis_batch();
+      // Visit the keys in sorted order so that neighbouring reads hit the same data blocks.
+      std::vector<int> order(batch.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(), [&batch](int lhs, int rhs) {
+        const auto& lhs_kv = batch.Get(lhs).key_value();
+        const auto& rhs_kv = batch.Get(rhs).key_value();
+        if (lhs_kv.hash_code() != rhs_kv.hash_code()) {
+          return lhs_kv.hash_code() < rhs_kv.hash_code();
+        }
+        return lhs_kv.key() < rhs_kv.key();
+      });
+
+      // Responses are preallocated so that each entry is written in place by whichever thread
+      // executes it.
+      resp->mutable_redis_batch()->Reserve(batch.size());
+      for (int i = 0; i < batch.size(); ++i) {
+        resp->add_redis_batch();
       }
+      // Every chunk of the sorted batch is read with a single iterator.
+      s = ProcessReadBatch(order, [&](const int* begin, const int* end) {
+        std::vector<const RedisReadRequestPB*> requests;
+        std::vector<RedisResponsePB*> responses;
+        requests.reserve(end - begin);
+        responses.reserve(end - begin);
+        for (auto it = begin; it != end; ++it) {
+          requests.push_back(&batch.Get(*it));
+          responses.push_back(resp->mutable_redis_batch(*it));
+        }
+        return tablet->HandleRedisReadRequests(read_time, requests, responses);
+      });
+      RETURN_UNKNOWN_ERROR_IF_NOT_OK(s, resp, &context);
       break;
     }
     case TableType::YQL_TABLE_TYPE: {
-      for (const QLReadRequestPB& ql_read_req : req->ql_batch()) {
-        // Update the remote endpoint.
-        const auto& remote_address = context.remote_address();
+      const auto& batch = req->ql_batch();
+      // Update the remote endpoint.
+      const auto& remote_address = context.remote_address();
+      const std::string remote_host = remote_address.address().to_string();
+      for (const QLReadRequestPB& ql_read_req : batch) {
         HostPortPB *hostPortPB =
             const_cast<QLReadRequestPB&>(ql_read_req).mutable_remote_endpoint();
-        hostPortPB->set_host(remote_address.address().to_string());
+        hostPortPB->set_host(remote_host);
         hostPortPB->set_port(remote_address.port());
+      }
 
-        QLResponsePB ql_response;
-        gscoped_ptr<faststring> rows_data;
-        int rows_data_sidecar_idx = 0;
-        TRACE("Start HandleQLReadRequest");
-        s = tablet->HandleQLReadRequest(
-            read_tx.GetReadTimestamp(), ql_read_req, req->transaction(), &ql_response, &rows_data);
-        TRACE("Done HandleQLReadRequest");
-        RETURN_UNKNOWN_ERROR_IF_NOT_OK(s, resp, &context);
-        if (rows_data.get() != nullptr) {
-          s = context.AddRpcSidecar(RefCntBuffer(*rows_data), &rows_data_sidecar_idx);
+      std::vector<int> order(batch.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&batch](int lhs, int rhs) {
+        return batch.Get(lhs).hash_code() < batch.Get(rhs).hash_code();
+      });
+
+      resp->mutable_ql_batch()->Reserve(batch.size());
+      for (int i = 0; i < batch.size(); ++i) {
+        resp->add_ql_batch();
+      }
+      std::vector<gscoped_ptr<faststring>> rows_data(batch.size());
+      TRACE("Start HandleQLReadRequest");
+      s = ProcessReadBatch(order, [&](const int* begin, const int* end) {
+        for (auto it = begin; it != end; ++it) {
+          RETURN_NOT_OK(tablet->HandleQLReadRequest(
+              read_time, batch.Get(*it), req->transaction(), resp->mutable_ql_batch(*it),
+              &rows_data[*it]));
+        }
+        return Status::OK();
+      });
+      TRACE("Done HandleQLReadRequest");
+      RETURN_UNKNOWN_ERROR_IF_NOT_OK(s, resp, &context);
+
+      // Sidecars are attached on this thread, in batch order, once all entries are done.
+      for (int i = 0; i < batch.size(); ++i) {
+        if (rows_data[i].get() != nullptr) {
+          int rows_data_sidecar_idx = 0;
+          s = context.AddRpcSidecar(RefCntBuffer(*rows_data[i]), &rows_data_sidecar_idx);
           RETURN_UNKNOWN_ERROR_IF_NOT_OK(s, resp, &context);
-          ql_response.set_rows_data_sidecar(rows_data_sidecar_idx);
+          resp->mutable_ql_batch(i)->set_rows_data_sidecar(rows_data_sidecar_idx);
         }
-        *(resp->add_ql_batch()) = ql_response;
       }
       break;
     }
@@ -999,6 +1147,78 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   TRACE("Done Read");
 }
 
+Status TabletServiceImpl::ProcessReadBatch(
+    const std::vector<int>& order, const std::function<Status(const int*, const int*)>& process) {
+  const int threshold = FLAGS_tserver_read_batch_parallel_threshold;
+  const int size = order.size();
+  const int max_chunks = std::min(FLAGS_tserver_read_batch_max_parallelism,
+                                  threshold > 0 ? size / threshold : 0);
+  if (max_chunks <= 1) {
+    return process(order.data(), order.data() + size);
+  }
+
+  // Each chunk is a contiguous range of the sorted order. Chunks are claimed from a shared
+  // counter by the calling thread and by pool workers, so the batch completes even if the pool
+  // is saturated or drops queued tasks on shutdown. The state is shared because a pool task may
+  // start after all chunks were already claimed and this function has returned.
+  struct State {
+    explicit State(int num_chunks_)
+        : num_chunks(num_chunks_), latch(num_chunks_), statuses(num_chunks_) {}
+
+    std::atomic<int> next_chunk{0};
+    const int num_chunks;
+    CountDownLatch latch;
+    // Each chunk only sets its own status.
+    std::vector<Status> statuses;
+    // Number of chunks being processed, and the largest number processed at the same time.
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+  };
+  const int chunk_size = (size + max_chunks - 1) / max_chunks;
+  auto state = std::make_shared<State>((size + chunk_size - 1) / chunk_size);
+  std::function<void()> run_chunks = [state, &order, &process, size, chunk_size]() {
+    for (;;) {
+      const int chunk = state->next_chunk.fetch_add(1, std::memory_order_acq_rel);
+      if (chunk >= state->num_chunks) {
+        return;
+      }
+      const int running = state->running.fetch_add(1, std::memory_order_acq_rel) + 1;
+      int max_running = state->max_running.load(std::memory_order_acquire);
+      while (running > max_running &&
+             !state->max_running.compare_exchange_weak(max_running, running)) {
+      }
+      if (PREDICT_FALSE(FLAGS_read_batch_chunk_delay_ms > 0)) {
+        SleepFor(MonoDelta::FromMilliseconds(FLAGS_read_batch_chunk_delay_ms));
+      }
+      const int end = std::min(size, (chunk + 1) * chunk_size);
+      state->statuses[chunk] = process(order.data() + chunk * chunk_size, order.data() + end);
+      state->running.fetch_sub(1, std::memory_order_acq_rel);
+      state->latch.CountDown();
+    }
+  };
+
+  scoped_refptr<Trace> trace(Trace::CurrentTrace());
+  for (int i = 1; i < state->num_chunks; ++i) {
+    Status s = read_batch_pool_->SubmitFunc([run_chunks, trace]() {
+      ADOPT_TRACE(trace.get());
+      run_chunks();
+    });
+    if (!s.ok()) {
+      break;
+    }
+  }
+  run_chunks();
+  state->latch.Wait();
+
+  if (state->max_running.load(std::memory_order_acquire) > 1) {
+    concurrent_read_batches_->Increment();
+  }
+  for (const auto& status : state->statuses) {
+    RETURN_NOT_OK(status);
+  }
+  return Status::OK();
+}
+
 ConsensusServiceImpl::ConsensusServiceImpl(const scoped_refptr<MetricEntity>& metric_entity,
                                            TabletPeerLookupIf* tablet_manager)
     : ConsensusServiceIf(metric_entity),
@@ -1508,6 +1728,9 @@ void TabletServiceImpl::ImportData(const ImportDataRequestPB* req,
 }
 
 void TabletServiceImpl::Shutdown() {
+  if (read_batch_pool_) {
+    read_batch_pool_->Shutdown();
+  }
 }
 
 // Extract a void* pointer suitable for use in a ColumnRangePredicate from the
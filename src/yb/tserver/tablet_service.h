@@ -32,6 +32,7 @@
 #ifndef YB_TSERVER_TABLET_SERVICE_H_
 #define YB_TSERVER_TABLET_SERVICE_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -44,10 +45,12 @@
 #include "yb/tserver/tserver_service.service.h"
 
 namespace yb {
+class Counter;
 class RowwiseIterator;
 class Schema;
 class Status;
 class HybridTime;
+class ThreadPool;
 
 namespace tablet {
 class Tablet;
@@ -66,6 +69,8 @@ class TabletServiceImpl : public TabletServerServiceIf {
  public:
   explicit TabletServiceImpl(TabletServerIf* server);
 
+  ~TabletServiceImpl();
+
   void Write(const WriteRequestPB* req, WriteResponsePB* resp, rpc::RpcContext context) override;
 
   void Read(const ReadRequestPB* req, ReadResponsePB* resp, rpc::RpcContext context) override;
@@ -149,13 +154,23 @@ class TabletServiceImpl : public TabletServerServiceIf {
   CHECKED_STATUS CheckPeerIsLeader(const tablet::TabletPeer& tablet_peer,
                                    TabletServerErrorPB::Code* error_code);
 
+  // Check if the tablet peer is the leader and its hybrid time lease covers read_ht, so that the
+  // read could be served locally.
+  CHECKED_STATUS CheckPeerIsLeaderForRead(const tablet::TabletPeer& tablet_peer,
+                                          HybridTime read_ht,
+                                          TabletServerErrorPB::Code* error_code,
+                                          consensus::LeaderLeaseStatus* leader_lease_status);
+
   CHECKED_STATUS CheckPeerIsReady(const tablet::TabletPeer& tablet_peer,
                                   TabletServerErrorPB::Code* error_code);
 
+  // Looks up the tablet to read from. Sets 'read_time' when the read has to be performed at a
+  // specific hybrid time rather than at the tablet's current safe time.
   virtual bool GetTabletOrRespond(const ReadRequestPB* req,
                                   ReadResponsePB* resp,
                                   rpc::RpcContext* context,
-                                  std::shared_ptr<tablet::AbstractTablet>* tablet);
+                                  std::shared_ptr<tablet::AbstractTablet>* tablet,
+                                  HybridTime* read_time);
 
   template<class Req, class Resp>
   bool PrepareModify(const Req& req,
@@ -164,7 +179,20 @@ class TabletServiceImpl : public TabletServerServiceIf {
                      tablet::TabletPeerPtr* tablet_peer,
                      tablet::TabletPtr* tablet);
 
+  // Runs process(begin, end) over contiguous chunks of 'order' that cover all of it. Batches of at
+  // least FLAGS_tserver_read_batch_parallel_threshold entries are split into several chunks that
+  // are processed concurrently on read_batch_pool_, smaller ones are processed as a single chunk.
+  // Returns the first failure of any chunk.
+  CHECKED_STATUS ProcessReadBatch(
+      const std::vector<int>& order, const std::function<Status(const int*, const int*)>& process);
+
   TabletServerIf *const server_;
+
+  // Pool used to execute chunks of large batched reads concurrently.
+  std::unique_ptr<ThreadPool> read_batch_pool_;
+
+  // Number of batched reads that had several chunks processed at the same time.
+  scoped_refptr<Counter> concurrent_read_batches_;
 };
 
 class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
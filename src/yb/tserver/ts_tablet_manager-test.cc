@@ -57,6 +57,11 @@
   ASSERT_NO_FATALS(AssertMonotonicReportSeqno(report_seqno, tablet_report))
 
 DECLARE_bool(pretend_memory_exceeded_enforce_flush);
+DECLARE_int64(db_block_cache_size_bytes);
+DECLARE_int32(db_block_cache_size_percentage);
+DECLARE_int32(db_compressed_block_cache_size_percentage);
+DECLARE_int32(db_low_priority_block_cache_size_percentage);
+DECLARE_int32(db_block_cache_max_reserved_percentage);
 
 namespace yb {
 namespace tserver {
@@ -305,5 +310,131 @@ TEST_F(TsTabletManagerTest, TestTabletReports) {
   ASSERT_MONOTONIC_REPORT_SEQNO(&seqno, report);
 }
 
+TEST_F(TsTabletManagerTest, TestTabletOpenClass) {
+  Schema full_schema = SchemaBuilder(schema_).Build();
+  std::pair<PartitionSchema, Partition> partition = tablet::CreateDefaultPartition(full_schema);
+
+  // The transaction status table is a Redis table, a user table of the same name is not.
+  scoped_refptr<TabletPeer> status_peer;
+  ASSERT_OK(tablet_manager_->CreateNewTablet(
+      "status-table", "status-tablet", partition.second, "transactions",
+      TableType::REDIS_TABLE_TYPE, full_schema, partition.first, config_, &status_peer));
+  ASSERT_EQ(TabletOpenClass::kTransactionStatus,
+            GetTabletOpenClass(fs_manager_, *status_peer->tablet_metadata()));
+
+  scoped_refptr<TabletPeer> user_peer;
+  ASSERT_OK(tablet_manager_->CreateNewTablet(
+      "user-table", "user-tablet", partition.second, "transactions",
+      TableType::YQL_TABLE_TYPE, full_schema, partition.first, config_, &user_peer));
+  ASSERT_NE(TabletOpenClass::kTransactionStatus,
+            GetTabletOpenClass(fs_manager_, *user_peer->tablet_metadata()));
+}
+
+TEST_F(TsTabletManagerTest, TestOrderTabletsToOpen) {
+  // Tablets are told apart by their WAL sizes.
+  std::vector<TabletToOpen> tablets = {
+      {nullptr, "/a", TabletOpenClass::kRegular, 1},
+      {nullptr, "/a", TabletOpenClass::kRegular, 3},
+      {nullptr, "/a", TabletOpenClass::kRegular, 2},
+      {nullptr, "/b", TabletOpenClass::kRegular, 4},
+      {nullptr, "/b", TabletOpenClass::kFormerLeader, 5},
+      {nullptr, "/a", TabletOpenClass::kFormerLeader, 6},
+      {nullptr, "/b", TabletOpenClass::kTransactionStatus, 7},
+  };
+  OrderTabletsToOpen(&tablets);
+
+  // Classes come in priority order. Within a class the tablets with the most WAL go first, and
+  // directories are taken in turns.
+  std::vector<uint64_t> wal_sizes;
+  for (const auto& tablet : tablets) {
+    wal_sizes.push_back(tablet.wal_size_bytes);
+  }
+  ASSERT_EQ(std::vector<uint64_t>({7, 6, 5, 4, 3, 2, 1}), wal_sizes);
+
+  tablets = {
+      {nullptr, "/a", TabletOpenClass::kRegular, 6},
+      {nullptr, "/a", TabletOpenClass::kRegular, 5},
+      {nullptr, "/a", TabletOpenClass::kRegular, 4},
+      {nullptr, "/b", TabletOpenClass::kRegular, 3},
+      {nullptr, "/b", TabletOpenClass::kRegular, 2},
+      {nullptr, "/c", TabletOpenClass::kRegular, 1},
+  };
+  OrderTabletsToOpen(&tablets);
+  wal_sizes.clear();
+  for (const auto& tablet : tablets) {
+    wal_sizes.push_back(tablet.wal_size_bytes);
+  }
+  ASSERT_EQ(std::vector<uint64_t>({6, 3, 1, 5, 2, 4}), wal_sizes);
+}
+
+TEST_F(TsTabletManagerTest, TestValidateBlockCacheSizePercentages) {
+  FlagSaver flag_saver;
+  FLAGS_db_block_cache_size_bytes = -1;
+  FLAGS_db_block_cache_size_percentage = 50;
+  FLAGS_db_compressed_block_cache_size_percentage = 30;
+  FLAGS_db_low_priority_block_cache_size_percentage = 5;
+  ASSERT_OK(ValidateBlockCacheSizePercentages());
+
+  // The block caches together can't take more than all of the memory.
+  FLAGS_db_compressed_block_cache_size_percentage = 46;
+  auto status = ValidateBlockCacheSizePercentages();
+  ASSERT_TRUE(status.IsInvalidArgument()) << status;
+  ASSERT_STR_CONTAINS(status.ToString(), "101%");
+
+  FLAGS_db_low_priority_block_cache_size_percentage = 0;
+  ASSERT_OK(ValidateBlockCacheSizePercentages());
+
+  // The block cache percentage is ignored when its size is given in bytes...
+  FLAGS_db_block_cache_size_percentage = 90;
+  ASSERT_TRUE(ValidateBlockCacheSizePercentages().IsInvalidArgument());
+  FLAGS_db_block_cache_size_bytes = 1024 * 1024 * 1024;
+  ASSERT_OK(ValidateBlockCacheSizePercentages());
+
+  // ... and no block caches are created when it is disabled.
+  FLAGS_db_block_cache_size_bytes = -2;
+  FLAGS_db_low_priority_block_cache_size_percentage = 60;
+  ASSERT_OK(ValidateBlockCacheSizePercentages());
+
+  FLAGS_db_compressed_block_cache_size_percentage = 100;
+  ASSERT_TRUE(ValidateBlockCacheSizePercentages().IsInvalidArgument());
+}
+
+TEST_F(TsTabletManagerTest, TestTableBlockCaches) {
+  FlagSaver flag_saver;
+  FLAGS_db_block_cache_size_bytes = 10 * 1024 * 1024;
+  FLAGS_db_block_cache_max_reserved_percentage = 50;
+  mini_server_->Shutdown();
+  mini_server_.reset(new MiniTabletServer(test_data_root_, 0));
+  ASSERT_OK(mini_server_->Start());
+  mini_server_->FailHeartbeats();
+  config_ = mini_server_->CreateLocalConfig();
+  tablet_manager_ = mini_server_->server()->tablet_manager();
+
+  TableProperties table_properties;
+  table_properties.SetBlockCacheReservedBytes(2 * 1024 * 1024);
+  Schema schema({ ColumnSchema("key", UINT32) }, 1, table_properties);
+
+  // Each tablet is created in its own table.
+  ASSERT_OK(CreateNewTablet("tablet-1", schema, nullptr));
+  ASSERT_EQ(1U, tablet_manager_->GetNumTableBlockCachesForTests());
+  ASSERT_OK(CreateNewTablet("tablet-2", schema, nullptr));
+  ASSERT_EQ(2U, tablet_manager_->GetNumTableBlockCachesForTests());
+
+  // Another reservation would take more than half of the block cache, so this table uses the block
+  // cache instead.
+  ASSERT_OK(CreateNewTablet("tablet-3", schema, nullptr));
+  ASSERT_EQ(2U, tablet_manager_->GetNumTableBlockCachesForTests());
+
+  // The cache reserved for a table is released when the table goes away, making room for another
+  // reservation.
+  boost::optional<TabletServerErrorPB::Code> error_code;
+  ASSERT_OK(tablet_manager_->DeleteTablet(
+      "tablet-1", tablet::TABLET_DATA_DELETED, boost::none, &error_code));
+  ASSERT_OK(WaitFor([this] { return tablet_manager_->GetNumTableBlockCachesForTests() == 1; },
+                    MonoDelta::FromSeconds(10), "Release reserved block cache"));
+  ASSERT_OK(CreateNewTablet("tablet-4", schema, nullptr));
+  ASSERT_EQ(2U, tablet_manager_->GetNumTableBlockCachesForTests());
+}
+
 } // namespace tserver
 } // namespace yb
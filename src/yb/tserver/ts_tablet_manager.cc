@@ -39,6 +39,7 @@
 #include <vector>
 
 #include <boost/optional/optional.hpp>
+#include <boost/scope_exit.hpp>
 
 #include <glog/logging.h>
 
@@ -60,7 +61,10 @@
 #include "yb/master/master.pb.h"
 #include "yb/master/sys_catalog.h"
 
+#include "yb/rocksdb/env.h"
 #include "yb/rocksdb/memory_monitor.h"
+#include "yb/rocksdb/persistent_cache.h"
+#include "yb/rocksdb/rate_limiter.h"
 
 #include "yb/rpc/messenger.h"
 
@@ -69,6 +73,7 @@
 #include "yb/tablet/tablet.pb.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_mm_ops.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet_options.h"
 
@@ -79,11 +84,13 @@
 #include "yb/util/background_task.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/env.h"
+#include "yb/util/enums.h"
 #include "yb/util/env_util.h"
 #include "yb/util/fault_injection.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
+#include "yb/util/path_util.h"
 #include "yb/util/pb_util.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/trace.h"
@@ -155,6 +162,33 @@ DEFINE_int32(db_block_cache_size_percentage, 50,
              "Default percentage of total available memory to use as block cache size, if not "
              "asking for a raw number, through FLAGS_db_block_cache_size_bytes.");
 
+DEFINE_int32(db_compressed_block_cache_size_percentage, 0,
+             "Percentage of total available memory to use for a second block cache tier that "
+             "holds compressed blocks. It is consulted on block cache misses before reading from "
+             "disk, so working sets that don't fit in the block cache uncompressed can still be "
+             "served from memory. This is in addition to the block cache, and the block caches "
+             "together can't take more than 100% of the memory. 0 disables it.");
+
+DEFINE_int32(db_block_cache_max_reserved_percentage, 50,
+             "Percentage of the block cache that the caches reserved for tables with the "
+             "block_cache_reserved_bytes property can take together. The block cache shrinks by "
+             "the reserved bytes while they are in use. Tables that would exceed it use the block "
+             "cache instead.");
+
+DEFINE_int32(db_low_priority_block_cache_size_percentage, 5,
+             "Percentage of total available memory to use for the block cache shared by tables "
+             "with low block cache priority, so that their reads don't evict blocks of other "
+             "tables. 0 means these tables run without a block cache.");
+
+DEFINE_string(db_persistent_block_cache_path, "",
+              "Directory on local storage, e.g. an SSD, used to cache RocksDB data blocks of "
+              "all tablets. Useful when the data directories are on slower network storage. The "
+              "cache is reused after a restart. Empty disables it.");
+
+DEFINE_int64(db_persistent_block_cache_size_bytes, 0,
+             "Maximum size of the persistent block cache under db_persistent_block_cache_path. "
+             "0 disables it.");
+
 DEFINE_test_flag(int32, sleep_after_tombstoning_tablet_secs, 0,
                  "Whether we sleep in LogAndTombstone after calling DeleteTabletData.");
 
@@ -164,6 +198,11 @@ DEFINE_int32(tserver_yb_client_default_timeout_ms, kTServerYbClientDefaultTimeou
              "Default timeout for the YBClient embedded into the tablet server that is used "
              "for distributed transactions.");
 
+DEFINE_int64(remote_bootstrap_rate_limit_bytes_per_sec, 0,
+             "Maximum rate at which all the remote bootstrap sessions of a tablet server together "
+             "download data from their sources. 0 means unlimited.");
+TAG_FLAG(remote_bootstrap_rate_limit_bytes_per_sec, advanced);
+
 namespace yb {
 namespace tserver {
 
@@ -215,6 +254,149 @@ using tablet::TabletStatusListener;
 using tablet::TabletStatusPB;
 using tserver::RemoteBootstrapClient;
 
+namespace {
+
+// Name of the transaction status table, see client/transaction_manager.cc. It is created as a
+// Redis table in the system namespace. Tablet metadata does not record the namespace, so the
+// table type tells it apart from user tables of the same name, which are YQL tables.
+const char* const kTransactionStatusTableName = "transactions";
+
+// Returns the total size of WAL segments in the given directory, i.e. an estimate of the amount
+// of log bootstrap has to replay. Errors are ignored, as this is only used for ordering.
+uint64_t GetWalSizeBytes(Env* env, const string& wal_dir) {
+  vector<string> children;
+  if (!env->GetChildren(wal_dir, &children).ok()) {
+    return 0;
+  }
+  uint64_t result = 0;
+  for (const auto& child : children) {
+    if (!log::IsLogFileName(child)) {
+      continue;
+    }
+    uint64_t size = 0;
+    if (env->GetFileSize(JoinPathSegments(wal_dir, child), &size).ok()) {
+      result += size;
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+Status ValidateBlockCacheSizePercentages() {
+  const bool use_percentage = FLAGS_db_block_cache_size_bytes == kDbCacheSizeUsePercentage;
+  if (use_percentage &&
+      (FLAGS_db_block_cache_size_percentage <= 0 || FLAGS_db_block_cache_size_percentage > 100)) {
+    return STATUS_FORMAT(InvalidArgument,
+                         "Flag db_block_cache_size_percentage must be between 0 and 100. "
+                         "Current value: $0",
+                         FLAGS_db_block_cache_size_percentage);
+  }
+  if (FLAGS_db_compressed_block_cache_size_percentage < 0 ||
+      FLAGS_db_compressed_block_cache_size_percentage >= 100) {
+    return STATUS_FORMAT(InvalidArgument,
+                         "Flag db_compressed_block_cache_size_percentage must be between 0 and "
+                         "100. Current value: $0",
+                         FLAGS_db_compressed_block_cache_size_percentage);
+  }
+  if (FLAGS_db_low_priority_block_cache_size_percentage < 0 ||
+      FLAGS_db_low_priority_block_cache_size_percentage >= 100) {
+    return STATUS_FORMAT(InvalidArgument,
+                         "Flag db_low_priority_block_cache_size_percentage must be between 0 and "
+                         "100. Current value: $0",
+                         FLAGS_db_low_priority_block_cache_size_percentage);
+  }
+  if (FLAGS_db_block_cache_max_reserved_percentage < 0 ||
+      FLAGS_db_block_cache_max_reserved_percentage > 100) {
+    return STATUS_FORMAT(InvalidArgument,
+                         "Flag db_block_cache_max_reserved_percentage must be between 0 and 100. "
+                         "Current value: $0",
+                         FLAGS_db_block_cache_max_reserved_percentage);
+  }
+  if (FLAGS_db_block_cache_size_bytes == kDbCacheSizeCacheDisabled) {
+    // None of the block caches are created.
+    return Status::OK();
+  }
+  const int total_percentage =
+      (use_percentage ? FLAGS_db_block_cache_size_percentage : 0) +
+      FLAGS_db_compressed_block_cache_size_percentage +
+      FLAGS_db_low_priority_block_cache_size_percentage;
+  if (total_percentage > 100) {
+    return STATUS_FORMAT(InvalidArgument,
+                         "Block caches would use $0% of the available memory: "
+                         "db_block_cache_size_percentage=$1, "
+                         "db_compressed_block_cache_size_percentage=$2, "
+                         "db_low_priority_block_cache_size_percentage=$3",
+                         total_percentage,
+                         use_percentage ? FLAGS_db_block_cache_size_percentage : 0,
+                         FLAGS_db_compressed_block_cache_size_percentage,
+                         FLAGS_db_low_priority_block_cache_size_percentage);
+  }
+  return Status::OK();
+}
+
+const char* TabletOpenClassToString(TabletOpenClass open_class) {
+  switch (open_class) {
+    case TabletOpenClass::kTransactionStatus: return "transaction status tablet";
+    case TabletOpenClass::kFormerLeader: return "former leader";
+    case TabletOpenClass::kRegular: return "regular";
+  }
+  FATAL_INVALID_ENUM_VALUE(TabletOpenClass, open_class);
+}
+
+TabletOpenClass GetTabletOpenClass(FsManager* fs_manager, const TabletMetadata& meta) {
+  if (meta.table_type() == TableType::REDIS_TABLE_TYPE &&
+      meta.table_name() == kTransactionStatusTableName) {
+    return TabletOpenClass::kTransactionStatus;
+  }
+  gscoped_ptr<ConsensusMetadata> cmeta;
+  const auto s = ConsensusMetadata::Load(
+      fs_manager, meta.tablet_id(), fs_manager->uuid(), &cmeta);
+  if (s.ok() && cmeta->has_voted_for() && cmeta->voted_for() == fs_manager->uuid()) {
+    return TabletOpenClass::kFormerLeader;
+  }
+  return TabletOpenClass::kRegular;
+}
+
+void OrderTabletsToOpen(vector<TabletToOpen>* tablets) {
+  std::stable_sort(tablets->begin(), tablets->end(),
+                   [](const TabletToOpen& lhs, const TabletToOpen& rhs) {
+    if (lhs.open_class != rhs.open_class) {
+      return lhs.open_class < rhs.open_class;
+    }
+    return lhs.wal_size_bytes > rhs.wal_size_bytes;
+  });
+
+  vector<TabletToOpen> result;
+  result.reserve(tablets->size());
+  auto class_begin = tablets->begin();
+  while (class_begin != tablets->end()) {
+    auto class_end = std::find_if(class_begin, tablets->end(), [class_begin](const auto& t) {
+      return t.open_class != class_begin->open_class;
+    });
+    // Split the class into per-directory queues preserving the order, then round-robin over them.
+    vector<vector<TabletToOpen*>> queues;
+    std::unordered_map<string, size_t> queue_by_dir;
+    for (auto it = class_begin; it != class_end; ++it) {
+      auto insert_result = queue_by_dir.emplace(it->data_root_dir, queues.size());
+      if (insert_result.second) {
+        queues.emplace_back();
+      }
+      queues[insert_result.first->second].push_back(&*it);
+    }
+    const size_t class_end_pos = class_end - tablets->begin();
+    for (size_t pos = 0; result.size() < class_end_pos; ++pos) {
+      for (const auto& queue : queues) {
+        if (pos < queue.size()) {
+          result.push_back(std::move(*queue[pos]));
+        }
+      }
+    }
+    class_begin = class_end;
+  }
+  tablets->swap(result);
+}
+
 // Only called from the background task to ensure it's synchronized
 void TSTabletManager::MaybeFlushTablet() {
   int iteration = 0;
@@ -250,6 +432,84 @@ scoped_refptr<TabletPeer> TSTabletManager::TabletToFlush() {
   return tablet_to_flush;
 }
 
+// Block caches reserved for tables with the block_cache_reserved_bytes property, by table id. The
+// reserved bytes are taken from the shared block cache, whose capacity is reduced by them while
+// the reserved cache is in use. A reserved cache is released, and its entry erased, once no tablet
+// of its table uses it, e.g. after the table is dropped.
+class TableBlockCaches : public std::enable_shared_from_this<TableBlockCaches> {
+ public:
+  TableBlockCaches(std::shared_ptr<rocksdb::Cache> block_cache, MetricEntityPtr metric_entity)
+      : block_cache_(std::move(block_cache)),
+        block_cache_capacity_(block_cache_->GetCapacity()),
+        metric_entity_(std::move(metric_entity)) {}
+
+  // Returns the cache reserved for the table, or null if reserving it would exceed
+  // --db_block_cache_max_reserved_percentage of the block cache.
+  std::shared_ptr<rocksdb::Cache> Get(const std::string& table_id, size_t reserved_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = caches_.find(table_id);
+    if (it != caches_.end()) {
+      auto result = it->second.cache.lock();
+      if (result) {
+        return result;
+      }
+    }
+
+    const size_t max_reserved_bytes =
+        block_cache_capacity_ * FLAGS_db_block_cache_max_reserved_percentage / 100;
+    if (reserved_bytes_ + reserved_bytes > max_reserved_bytes) {
+      LOG(WARNING) << "Table " << table_id << " uses the block cache instead of reserving "
+                   << reserved_bytes << " bytes, " << reserved_bytes_ << " of "
+                   << max_reserved_bytes << " bytes that could be reserved are already reserved";
+      return nullptr;
+    }
+
+    // Metrics of the cache are added to the block cache metrics of the server, its own usage
+    // and hit rate are reported by the tablets using it.
+    std::shared_ptr<rocksdb::Cache> cache = rocksdb::NewLRUCache(reserved_bytes);
+    cache->SetMetrics(metric_entity_, CacheTier::kPrimary);
+    auto self = shared_from_this();
+    std::shared_ptr<rocksdb::Cache> result(
+        cache.get(), [self, table_id, reserved_bytes, cache](rocksdb::Cache*) {
+      self->Release(table_id, cache.get(), reserved_bytes);
+    });
+    caches_[table_id] = Entry{result, cache.get()};
+    reserved_bytes_ += reserved_bytes;
+    block_cache_->SetCapacity(block_cache_capacity_ - reserved_bytes_);
+    return result;
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return caches_.size();
+  }
+
+ private:
+  struct Entry {
+    std::weak_ptr<rocksdb::Cache> cache;
+    // Tells apart a cache that is being released from the one reserved for the table after it.
+    rocksdb::Cache* raw_cache;
+  };
+
+  void Release(const std::string& table_id, rocksdb::Cache* cache, size_t reserved_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = caches_.find(table_id);
+    if (it != caches_.end() && it->second.raw_cache == cache) {
+      caches_.erase(it);
+    }
+    reserved_bytes_ -= reserved_bytes;
+    block_cache_->SetCapacity(block_cache_capacity_ - reserved_bytes_);
+  }
+
+  const std::shared_ptr<rocksdb::Cache> block_cache_;
+  const size_t block_cache_capacity_;
+  const MetricEntityPtr metric_entity_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> caches_;
+  size_t reserved_bytes_ = 0;
+};
+
 TSTabletManager::TSTabletManager(FsManager* fs_manager,
                                  TabletServer* server,
                                  MetricRegistry* metric_registry)
@@ -270,25 +530,48 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
       METRIC_op_apply_queue_time.Instantiate(server_->metric_entity()));
   apply_pool_->SetRunTimeMicrosHistogram(
       METRIC_op_apply_run_time.Instantiate(server_->metric_entity()));
+  CHECK_OK(ThreadPoolBuilder("log-cache-read-ahead").Build(&log_cache_read_ahead_pool_));
 
+  CHECK_OK(ValidateBlockCacheSizePercentages());
   int64_t block_cache_size_bytes = FLAGS_db_block_cache_size_bytes;
   int64_t total_ram_avail = MemTracker::GetRootTracker()->limit();
   // Auto-compute size of block cache if asked to.
   if (FLAGS_db_block_cache_size_bytes == kDbCacheSizeUsePercentage) {
-    // Check some bounds.
-    CHECK(FLAGS_db_block_cache_size_percentage > 0 && FLAGS_db_block_cache_size_percentage <= 100)
-        << Substitute(
-               "Flag tablet_block_cache_size_percentage must be between 0 and 100. Current value: "
-               "$0",
-               FLAGS_db_block_cache_size_percentage);
-
     block_cache_size_bytes = total_ram_avail * FLAGS_db_block_cache_size_percentage / 100;
   }
   if (FLAGS_db_block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
     tablet_options_.block_cache = rocksdb::NewLRUCache(block_cache_size_bytes);
-    tablet_options_.block_cache->SetMetrics(server_->metric_entity());
+    tablet_options_.block_cache->SetMetrics(server_->metric_entity(), CacheTier::kPrimary);
+    table_block_caches_ = std::make_shared<TableBlockCaches>(
+        tablet_options_.block_cache, server_->metric_entity());
+
+    if (FLAGS_db_compressed_block_cache_size_percentage > 0) {
+      tablet_options_.compressed_block_cache = rocksdb::NewLRUCache(
+          total_ram_avail * FLAGS_db_compressed_block_cache_size_percentage / 100);
+      tablet_options_.compressed_block_cache->SetMetrics(
+          server_->metric_entity(), CacheTier::kCompressed);
+    }
+
+    if (FLAGS_db_low_priority_block_cache_size_percentage > 0) {
+      low_priority_block_cache_ = rocksdb::NewLRUCache(
+          total_ram_avail * FLAGS_db_low_priority_block_cache_size_percentage / 100);
+      low_priority_block_cache_->SetMetrics(server_->metric_entity(), CacheTier::kPrimary);
+    }
+  }
+
+  if (!FLAGS_db_persistent_block_cache_path.empty() &&
+      FLAGS_db_persistent_block_cache_size_bytes > 0) {
+    auto status = rocksdb::NewFilePersistentCache(
+        rocksdb::Env::Default(), FLAGS_db_persistent_block_cache_path,
+        FLAGS_db_persistent_block_cache_size_bytes, &tablet_options_.persistent_block_cache);
+    if (!status.ok()) {
+      LOG(WARNING) << "Running without the persistent block cache, failed to open it in "
+                   << FLAGS_db_persistent_block_cache_path << ": " << status.ToString();
+    }
   }
 
+  tablet_options_.history_gc_compactions = std::make_shared<tablet::HistoryGCCompactions>();
+
   // Calculate memstore_size_bytes
   bool should_count_memory = FLAGS_global_memstore_size_percentage > 0;
   CHECK(FLAGS_global_memstore_size_percentage > 0 && FLAGS_global_memstore_size_percentage <= 100)
@@ -303,6 +586,11 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
                                    static_cast<size_t>(FLAGS_global_memstore_size_mb_max << 20));
   }
 
+  if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
+    remote_bootstrap_rate_limiter_.reset(
+        rocksdb::NewGenericRateLimiter(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec));
+  }
+
   // Add memory monitor and background thread for flushing
   if (should_count_memory) {
     background_task_.reset(new BackgroundTask(
@@ -365,8 +653,32 @@ Status TSTabletManager::Init() {
     metas.push_back(meta);
   }
 
-  // Now submit the "Open" task for each.
+  // Decide the order to open tablets in, so that the tablets that matter most for serving
+  // requests become available first.
+  vector<TabletToOpen> tablets_to_open;
+  tablets_to_open.reserve(metas.size());
   for (const scoped_refptr<TabletMetadata>& meta : metas) {
+    tablets_to_open.push_back(TabletToOpen{
+        meta, meta->data_root_dir(), GetTabletOpenClass(fs_manager_, *meta),
+        GetWalSizeBytes(fs_manager_->env(), meta->wal_dir())});
+  }
+  OrderTabletsToOpen(&tablets_to_open);
+
+  {
+    std::lock_guard<std::mutex> lock(open_infos_mutex_);
+    for (size_t i = 0; i != tablets_to_open.size(); ++i) {
+      const auto& tablet = tablets_to_open[i];
+      auto& info = open_infos_[tablet.meta->tablet_id()];
+      info.tablet_id = tablet.meta->tablet_id();
+      info.open_order = i;
+      info.priority = TabletOpenClassToString(tablet.open_class);
+      info.wal_size_bytes = tablet.wal_size_bytes;
+    }
+  }
+
+  // Now submit the "Open" task for each.
+  for (const auto& tablet : tablets_to_open) {
+    const scoped_refptr<TabletMetadata>& meta = tablet.meta;
     scoped_refptr<TransitionInProgressDeleter> deleter;
     {
       std::lock_guard<rw_spinlock> lock(lock_);
@@ -674,6 +986,7 @@ scoped_refptr<TabletPeer> TSTabletManager::CreateAndRegisterTabletPeer(
       new TabletPeerClass(meta,
                           local_peer_pb_,
                           apply_pool_.get(),
+                          log_cache_read_ahead_pool_.get(),
                           Bind(&TSTabletManager::ApplyChange,
                                Unretained(this),
                                meta->tablet_id())));
@@ -825,6 +1138,50 @@ Status TSTabletManager::OpenTabletMeta(const string& tablet_id,
   return Status::OK();
 }
 
+void TSTabletManager::GetTabletOpenInfos(vector<TabletOpenInfo>* infos) const {
+  {
+    std::lock_guard<std::mutex> lock(open_infos_mutex_);
+    infos->clear();
+    infos->reserve(open_infos_.size());
+    for (const auto& entry : open_infos_) {
+      infos->push_back(entry.second);
+    }
+  }
+  std::sort(infos->begin(), infos->end(), [](const TabletOpenInfo& lhs, const TabletOpenInfo& rhs) {
+    return lhs.open_order < rhs.open_order;
+  });
+}
+
+void TSTabletManager::UpdateTabletOpenInfo(const string& tablet_id,
+                                           const std::function<void(TabletOpenInfo*)>& updater) {
+  std::lock_guard<std::mutex> lock(open_infos_mutex_);
+  auto it = open_infos_.find(tablet_id);
+  // Tablets created or remote bootstrapped after startup are not tracked.
+  if (it != open_infos_.end()) {
+    updater(&it->second);
+  }
+}
+
+tablet::TabletOptions TSTabletManager::TabletOptionsFor(const TabletMetadata& meta) {
+  tablet::TabletOptions result = tablet_options_;
+  if (!result.block_cache) {
+    return result;
+  }
+
+  const auto& table_properties = meta.schema().table_properties();
+  if (table_properties.block_cache_reserved_bytes() > 0) {
+    auto reserved_cache = table_block_caches_->Get(
+        meta.table_id(), table_properties.block_cache_reserved_bytes());
+    if (reserved_cache) {
+      result.block_cache = std::move(reserved_cache);
+      result.block_cache_reserved = true;
+    }
+  } else if (table_properties.block_cache_priority() == LOW_BLOCK_CACHE_PRIORITY) {
+    result.block_cache = low_priority_block_cache_;
+  }
+  return result;
+}
+
 void TSTabletManager::OpenTablet(const scoped_refptr<TabletMetadata>& meta,
                                  const scoped_refptr<TransitionInProgressDeleter>& deleter) {
   string tablet_id = meta->tablet_id();
@@ -842,6 +1199,16 @@ void TSTabletManager::OpenTablet(const scoped_refptr<TabletMetadata>& meta,
   LOG(INFO) << kLogPrefix << "Bootstrapping tablet";
   TRACE("Bootstrapping tablet");
 
+  UpdateTabletOpenInfo(tablet_id, [](TabletOpenInfo* info) {
+    info->start_time = MonoTime::Now(MonoTime::FINE);
+  });
+  // Record when the tablet finished opening, however that happened.
+  BOOST_SCOPE_EXIT(this_, &tablet_id) {
+    this_->UpdateTabletOpenInfo(tablet_id, [](TabletOpenInfo* info) {
+      info->finish_time = MonoTime::Now(MonoTime::FINE);
+    });
+  } BOOST_SCOPE_EXIT_END;
+
   consensus::ConsensusBootstrapInfo bootstrap_info;
   Status s;
   LOG_TIMING_PREFIX(INFO, kLogPrefix, "bootstrapping tablet") {
@@ -855,7 +1222,7 @@ void TSTabletManager::OpenTablet(const scoped_refptr<TabletMetadata>& meta,
         metric_registry_,
         tablet_peer->status_listener(),
         tablet_peer->log_anchor_registry(),
-        tablet_options_,
+        TabletOptionsFor(*meta),
         tablet_peer.get(),
         tablet_peer.get()};
     s = BootstrapTablet(data, &tablet, &log, &bootstrap_info);
@@ -951,6 +1318,7 @@ void TSTabletManager::Shutdown() {
 
   // Shut down the apply pool.
   apply_pool_->Shutdown();
+  log_cache_read_ahead_pool_->Shutdown();
 
   {
     std::lock_guard<rw_spinlock> l(lock_);
@@ -1040,6 +1408,10 @@ int TSTabletManager::GetNumDirtyTabletsForTests() const {
   return dirty_tablets_.size();
 }
 
+size_t TSTabletManager::GetNumTableBlockCachesForTests() const {
+  return table_block_caches_ ? table_block_caches_->size() : 0;
+}
+
 int TSTabletManager::GetNumLiveTablets() const {
   int count = 0;
   boost::shared_lock<rw_spinlock> lock(lock_);
@@ -1171,7 +1543,7 @@ Status TSTabletManager::HandleNonReadyTabletOnStartup(const scoped_refptr<Tablet
   LOG(INFO) << kLogPrefix << "Tablet Manager startup: Rolling forward tablet deletion "
             << "of type " << TabletDataState_Name(data_state);
   // Passing no OpId will retain the last_logged_opid that was previously in the metadata.
-  RETURN_NOT_OK(DeleteTabletData(meta, data_state, fs_manager_->uuid(), boost::none));
+  RETURN_NOT_OK(DeleteTabletData(meta, data_state, fs_manager_->uuid(), boost::none, this));
 
   // We only delete the actual superblock of a TABLET_DATA_DELETED tablet on startup.
   // TODO: Consider doing this after a fixed delay, instead of waiting for a restart.
@@ -1370,6 +1742,10 @@ Status DeleteTabletData(const scoped_refptr<TabletMetadata>& meta,
   RETURN_NOT_OK(meta->DeleteTabletData(data_state, last_logged_opid));
   LOG(INFO) << kLogPrefix << "Tablet deleted. Last logged OpId: "
             << meta->tombstone_last_logged_opid();
+  // The tablet could be remote bootstrapped again later, with SST files of the same names.
+  if (ts_manager != nullptr && ts_manager->persistent_block_cache() != nullptr) {
+    ts_manager->persistent_block_cache()->EraseDirectory(meta->rocksdb_dir());
+  }
   MAYBE_FAULT(FLAGS_fault_crash_after_blocks_deleted);
 
   RETURN_NOT_OK(Log::DeleteOnDiskData(meta->fs_manager(), meta->tablet_id(), meta->wal_dir()));
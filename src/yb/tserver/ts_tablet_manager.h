@@ -32,7 +32,9 @@
 #ifndef YB_TSERVER_TS_TABLET_MANAGER_H
 #define YB_TSERVER_TS_TABLET_MANAGER_H
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -55,10 +57,15 @@
 #include "yb/tserver/tserver_admin.pb.h"
 #include "yb/util/locks.h"
 #include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
 #include "yb/util/status.h"
 #include "yb/util/threadpool.h"
 #include "yb/tablet/tablet_options.h"
 
+namespace rocksdb {
+class RateLimiter;
+}
+
 namespace yb {
 
 class PartitionSchema;
@@ -94,6 +101,53 @@ using rocksdb::MemoryMonitor;
 typedef std::unordered_map<std::string, std::string> TransitionInProgressMap;
 
 class TransitionInProgressDeleter;
+class TableBlockCaches;
+
+// Progress of opening a tablet found on disk when the tablet server starts.
+struct TabletOpenInfo {
+  std::string tablet_id;
+  // Position of the tablet in the order tablets are submitted for opening in.
+  int open_order = 0;
+  // Why the tablet got its position, e.g. "transaction status tablet" or "former leader".
+  std::string priority;
+  // Total size of the WAL segments of the tablet before bootstrap.
+  uint64_t wal_size_bytes = 0;
+  // Set when bootstrap of the tablet starts and when the tablet is started or fails to start.
+  MonoTime start_time;
+  MonoTime finish_time;
+};
+
+// Tablets are opened on startup in the order of these classes.
+enum class TabletOpenClass {
+  // Transactions on all other tablets depend on transaction status tablets.
+  kTransactionStatus,
+  // Tablets this server voted for itself in the last known term of, i.e. most likely leaders
+  // before the restart.
+  kFormerLeader,
+  kRegular,
+};
+
+const char* TabletOpenClassToString(TabletOpenClass open_class);
+
+// A tablet found on disk when the tablet server starts.
+struct TabletToOpen {
+  scoped_refptr<tablet::TabletMetadata> meta;
+  std::string data_root_dir;
+  TabletOpenClass open_class;
+  uint64_t wal_size_bytes;
+};
+
+TabletOpenClass GetTabletOpenClass(FsManager* fs_manager, const tablet::TabletMetadata& meta);
+
+// Checks the flags that size the block caches as percentages of the available memory, including
+// that the block caches together don't take more than all of it.
+CHECKED_STATUS ValidateBlockCacheSizePercentages();
+
+// Orders tablets so that more important tablets are opened first, see TabletOpenClass, and
+// among tablets of the same class the ones with the most WAL to replay go first. Within each
+// class tablets of different data directories are interleaved, so that the bootstrap threads
+// do not all compete for the same disk while others are idle.
+void OrderTabletsToOpen(std::vector<TabletToOpen>* tablets);
 
 // If 'expr' fails, log a message, tombstone the given tablet, and return the
 // error status.
@@ -224,6 +278,16 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // Get all of the tablets currently hosted on this server.
   void GetTabletPeers(std::vector<scoped_refptr<tablet::TabletPeer> >* tablet_peers) const;
 
+  // Get the opening progress of the tablets found on disk on startup, in the order they are
+  // opened in.
+  void GetTabletOpenInfos(std::vector<TabletOpenInfo>* infos) const;
+
+  // Bandwidth budget shared by all the remote bootstrap sessions downloading tablets to this
+  // server. Null if remote bootstrap bandwidth is not limited.
+  rocksdb::RateLimiter* remote_bootstrap_rate_limiter() const {
+    return remote_bootstrap_rate_limiter_.get();
+  }
+
   // Callback used for state changes outside of the control of TsTabletManager, such as a consensus
   // role change. They are applied asynchronously internally.
   void ApplyChange(const std::string& tablet_id,
@@ -238,6 +302,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // Returns the number of tablets in the "dirty" map, for use by unit tests.
   int GetNumDirtyTabletsForTests() const;
 
+  // Returns the number of block caches reserved for tables that are in use, for use by unit tests.
+  size_t GetNumTableBlockCachesForTests() const;
+
   // Return the number of tablets in RUNNING or BOOTSTRAPPING state.
   int GetNumLiveTablets() const;
 
@@ -273,6 +340,10 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
 
   MemoryMonitor* memory_monitor() { return tablet_options_.memory_monitor.get(); }
 
+  rocksdb::PersistentCache* persistent_block_cache() {
+    return tablet_options_.persistent_block_cache.get();
+  }
+
   // Flush some tablet if the memstore memory limit is exceeded
   void MaybeFlushTablet();
 
@@ -313,6 +384,10 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   CHECKED_STATUS OpenTabletMeta(const std::string& tablet_id,
                         scoped_refptr<tablet::TabletMetadata>* metadata);
 
+  // Returns the options for opening the given tablet, with the block cache assigned to its table
+  // by the block_cache_reserved_bytes and block_cache_priority table properties.
+  tablet::TabletOptions TabletOptionsFor(const tablet::TabletMetadata& meta);
+
   // Open a tablet whose metadata has already been loaded/created.
   // This method does not return anything as it can be run asynchronously.
   // Upon completion of this method the tablet should be initialized and running.
@@ -380,6 +455,10 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // running state.
   void InitLocalRaftPeerPB();
 
+  // Applies 'updater' to the opening progress of the given tablet, if it is tracked.
+  void UpdateTabletOpenInfo(const std::string& tablet_id,
+                            const std::function<void(TabletOpenInfo*)>& updater);
+
   FsManager* const fs_manager_;
 
   TabletServer* server_;
@@ -424,15 +503,30 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // Thread pool used to open the tablets async, whether bootstrap is required or not.
   gscoped_ptr<ThreadPool> open_tablet_pool_;
 
+  // Opening progress of the tablets found on disk on startup, keyed by tablet id.
+  mutable std::mutex open_infos_mutex_;
+  std::unordered_map<std::string, TabletOpenInfo> open_infos_;
+
   // Thread pool for apply transactions, shared between all tablets.
   gscoped_ptr<ThreadPool> apply_pool_;
 
+  // Thread pool reading WAL entries ahead into the log caches of all tablets.
+  gscoped_ptr<ThreadPool> log_cache_read_ahead_pool_;
+
   // Used for scheduling flushes
   std::unique_ptr<BackgroundTask> background_task_;
 
   // For block cache and memory monitor shared across tablets
   tablet::TabletOptions tablet_options_;
 
+  // Block cache shared by the tables with low block cache priority.
+  std::shared_ptr<rocksdb::Cache> low_priority_block_cache_;
+
+  // Block caches reserved for tables with the block_cache_reserved_bytes property.
+  std::shared_ptr<TableBlockCaches> table_block_caches_;
+
+  std::unique_ptr<rocksdb::RateLimiter> remote_bootstrap_rate_limiter_;
+
   yb::client::AsyncClientInitialiser async_client_init_;
 
   DISALLOW_COPY_AND_ASSIGN(TSTabletManager);
@@ -465,7 +559,8 @@ void LogAndTombstone(const scoped_refptr<tablet::TabletMetadata>& meta,
 
 // Delete the tablet using the specified delete_type as the final metadata
 // state. Deletes the on-disk data, as well as all WAL segments.
-// If ts_manager pointer is passed in, it will unregister from the directory assignment map.
+// If ts_manager pointer is passed in, it also drops the tablet's blocks from the persistent block
+// cache.
 Status DeleteTabletData(const scoped_refptr<tablet::TabletMetadata>& meta,
                         tablet::TabletDataState delete_type,
                         const std::string& uuid,
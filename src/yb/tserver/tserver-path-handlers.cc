@@ -110,6 +110,10 @@ Status TabletServerPathHandlers::Register(Webserver* server) {
       "/", "Dashboards",
       std::bind(&TabletServerPathHandlers::HandleDashboardsPage, this, _1, _2), true /* styled */,
       false /* is_on_nav_bar */);
+  server->RegisterPathHandler(
+      "/tablet-bootstrap", "",
+      std::bind(&TabletServerPathHandlers::HandleTabletBootstrapPage, this, _1, _2),
+      true /* styled */, false /* is_on_nav_bar */);
   server->RegisterPathHandler(
       "/maintenance-manager", "",
       std::bind(&TabletServerPathHandlers::HandleMaintenanceManagerPage, this, _1, _2),
@@ -476,6 +480,7 @@ string TabletServerPathHandlers::IteratorStatsToHtml(const Schema& projection,
   html << "<table>\n";
   html << "<tr><th>Column</th>"
        << "<th>Blocks read from disk</th>"
+       << "<th>Blocks prefetched</th>"
        << "<th>Bytes read from disk</th>"
        << "<th>Cells read from disk</th>"
        << "</tr>\n";
@@ -487,14 +492,17 @@ string TabletServerPathHandlers::IteratorStatsToHtml(const Schema& projection,
                        "<td title=\"$1\">$2</td>"
                        "<td title=\"$3\">$4</td>"
                        "<td title=\"$5\">$6</td>"
+                       "<td title=\"$7\">$8</td>"
                        "</tr>\n",
                        EscapeForHtmlToString(projection.column(idx).name()),  // $0
                        HumanReadableInt::ToString(stats[idx].data_blocks_read_from_disk),  // $1
                        stats[idx].data_blocks_read_from_disk,  // $2
-                       HumanReadableNumBytes::ToString(stats[idx].bytes_read_from_disk),  // $3
-                       stats[idx].bytes_read_from_disk,  // $4
-                       HumanReadableInt::ToString(stats[idx].cells_read_from_disk),  // $5
-                       stats[idx].cells_read_from_disk);  // $6
+                       HumanReadableInt::ToString(stats[idx].data_blocks_prefetched),  // $3
+                       stats[idx].data_blocks_prefetched,  // $4
+                       HumanReadableNumBytes::ToString(stats[idx].bytes_read_from_disk),  // $5
+                       stats[idx].bytes_read_from_disk,  // $6
+                       HumanReadableInt::ToString(stats[idx].cells_read_from_disk),  // $7
+                       stats[idx].cells_read_from_disk);  // $8
   }
   html << "</table>\n";
   return html.str();
@@ -512,6 +520,55 @@ void TabletServerPathHandlers::HandleDashboardsPage(const Webserver::WebRequest&
   *output << GetDashboardLine("maintenance-manager", "Maintenance Manager",
                               "List of operations that are currently running and those "
                               "that are registered.");
+  *output << GetDashboardLine("tablet-bootstrap", "Tablet Bootstrap",
+                              "Progress of opening the tablets found on disk on startup.");
+}
+
+void TabletServerPathHandlers::HandleTabletBootstrapPage(const Webserver::WebRequest& req,
+                                                         std::stringstream* output) {
+  vector<TabletOpenInfo> infos;
+  tserver_->tablet_manager()->GetTabletOpenInfos(&infos);
+
+  const MonoTime now = MonoTime::Now(MonoTime::FINE);
+  int num_finished = 0;
+  for (const auto& info : infos) {
+    if (info.finish_time.Initialized()) {
+      ++num_finished;
+    }
+  }
+
+  *output << "<h1>Tablet Bootstrap</h1>\n";
+  *output << Substitute("<p>Opened $0 of $1 tablets found on startup.</p>\n",
+                        num_finished, infos.size());
+  *output << "<table class='table table-striped'>\n";
+  *output << "  <tr><th>Order</th><th>Tablet ID</th><th>Priority</th><th>WAL size</th>"
+      "<th>State</th><th>Time</th><th>Last status</th></tr>\n";
+  for (const auto& info : infos) {
+    string state = "Queued";
+    string last_status;
+    scoped_refptr<TabletPeer> peer;
+    if (tserver_->tablet_manager()->LookupTablet(info.tablet_id, &peer)) {
+      state = peer->HumanReadableState();
+      last_status = peer->status_listener()->last_status();
+    }
+    string elapsed;
+    if (info.start_time.Initialized()) {
+      const MonoTime end = info.finish_time.Initialized() ? info.finish_time : now;
+      elapsed = HumanReadableElapsedTime::ToShortString(
+          end.GetDeltaSince(info.start_time).ToSeconds());
+    }
+    *output << Substitute(
+        "<tr><td>$0</td><td>$1</td><td>$2</td><td>$3</td><td>$4</td><td>$5</td><td>$6</td></tr>\n",
+        info.open_order,
+        peer && peer->tablet() != nullptr ? TabletLink(info.tablet_id)
+                                          : EscapeForHtmlToString(info.tablet_id),
+        EscapeForHtmlToString(info.priority),
+        HumanReadableNumBytes::ToString(info.wal_size_bytes),
+        EscapeForHtmlToString(state),
+        elapsed,
+        EscapeForHtmlToString(last_status));
+  }
+  *output << "</table>\n";
 }
 
 string TabletServerPathHandlers::GetDashboardLine(const std::string& link,
@@ -424,6 +424,8 @@ class ShardedLRUCache : public Cache {
     // 2. It is directly parented to the root MemTracker.
     mem_tracker_ = MemTracker::FindOrCreateTracker(
         -1, strings::Substitute("$0-sharded_lru_cache", id));
+    // All the shards charge the same tracker on every insert and eviction.
+    mem_tracker_->EnableConsumptionBatching();
 
     const size_t per_shard = (capacity + (kNumShards - 1)) / kNumShards;
     for (int s = 0; s < kNumShards; s++) {
@@ -44,8 +44,17 @@ class AtomicGauge;
 class Counter;
 class MetricEntity;
 
+// The block cache tier for which metrics are reported.
+enum class CacheTier {
+  // Holds uncompressed blocks.
+  kPrimary,
+  // Holds compressed blocks, looked up on a primary tier miss before reading from disk.
+  kCompressed,
+};
+
 struct CacheMetrics {
-  explicit CacheMetrics(const scoped_refptr<MetricEntity>& metric_entity);
+  explicit CacheMetrics(const scoped_refptr<MetricEntity>& metric_entity,
+                        CacheTier tier = CacheTier::kPrimary);
 
   scoped_refptr<Counter> inserts;
   scoped_refptr<Counter> lookups;
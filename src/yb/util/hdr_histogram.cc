@@ -38,6 +38,7 @@
 #include "yb/gutil/atomicops.h"
 #include "yb/gutil/bits.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/sysinfo.h"
 #include "yb/util/status.h"
 
 using base::subtle::Atomic64;
@@ -49,6 +50,14 @@ using strings::Substitute;
 
 namespace yb {
 
+namespace {
+
+// Threads are assigned count stripes round-robin, on first use.
+std::atomic<uint32_t> next_count_stripe{0};
+__thread int32_t thread_count_stripe = -1;
+
+} // namespace
+
 HdrHistogram::HdrHistogram(uint64_t highest_trackable_value, int num_significant_digits)
   : highest_trackable_value_(highest_trackable_value),
     num_significant_digits_(num_significant_digits),
@@ -58,11 +67,10 @@ HdrHistogram::HdrHistogram(uint64_t highest_trackable_value, int num_significant
     sub_bucket_half_count_magnitude_(0),
     sub_bucket_half_count_(0),
     sub_bucket_mask_(0),
-    total_count_(0),
-    total_sum_(0),
     min_value_(std::numeric_limits<Atomic64>::max()),
     max_value_(0),
-    counts_(nullptr) {
+    counts_(nullptr),
+    count_stripes_(nullptr) {
   Init();
 }
 
@@ -75,29 +83,32 @@ HdrHistogram::HdrHistogram(const HdrHistogram& other)
     sub_bucket_half_count_magnitude_(0),
     sub_bucket_half_count_(0),
     sub_bucket_mask_(0),
-    total_count_(0),
-    total_sum_(0),
     min_value_(std::numeric_limits<Atomic64>::max()),
     max_value_(0),
-    counts_(nullptr) {
+    counts_(nullptr),
+    count_stripes_(nullptr) {
   Init();
 
   // Not a consistent snapshot but we try to roughly keep it close.
   // Copy the sum and min first.
-  NoBarrier_Store(&total_sum_, NoBarrier_Load(&other.total_sum_));
+  total_sum_.IncrementBy(other.TotalSum());
   NoBarrier_Store(&min_value_, NoBarrier_Load(&other.min_value_));
 
   uint64_t total_copied_count = 0;
-  // Copy the counts in order of ascending magnitude.
+  // Copy the counts in order of ascending magnitude, merging the stripes of other.
   for (int i = 0; i < counts_array_length_; i++) {
-    uint64_t count = NoBarrier_Load(&other.counts_[i]);
+    uint64_t count = other.CountAtIndex(i);
     NoBarrier_Store(&counts_[i], count);
     total_copied_count += count;
   }
   // Copy the max observed value last.
   NoBarrier_Store(&max_value_, NoBarrier_Load(&other.max_value_));
   // We must ensure the total is consistent with the copied counts.
-  NoBarrier_Store(&total_count_, total_copied_count);
+  total_count_.IncrementBy(total_copied_count);
+}
+
+HdrHistogram::~HdrHistogram() {
+  delete[] count_stripes_.load(std::memory_order_acquire);
 }
 
 bool HdrHistogram::IsValidHighestTrackableValue(uint64_t highest_trackable_value) {
@@ -169,9 +180,9 @@ void HdrHistogram::IncrementBy(int64_t value, int64_t count) {
   int counts_index = CountsArrayIndex(bucket_index, sub_bucket_index);
 
   // Increment bucket, total, and sum.
-  NoBarrier_AtomicIncrement(&counts_[counts_index], count);
-  NoBarrier_AtomicIncrement(&total_count_, count);
-  NoBarrier_AtomicIncrement(&total_sum_, value * count);
+  IncrementCountAtIndex(counts_index, count);
+  total_count_.IncrementBy(count);
+  total_sum_.IncrementBy(value * count);
 
   // Update min, if needed.
   {
@@ -205,6 +216,59 @@ void HdrHistogram::IncrementWithExpectedInterval(int64_t value,
   }
 }
 
+int HdrHistogram::NumCountStripes() {
+  static const int num_stripes = std::min<int>(
+      1 << Bits::Log2Ceiling(std::max(base::NumCPUs(), 1)), kMaxCountStripes);
+  return num_stripes;
+}
+
+int HdrHistogram::ThreadCountStripe() {
+  if (PREDICT_FALSE(thread_count_stripe < 0)) {
+    thread_count_stripe = next_count_stripe.fetch_add(1, std::memory_order_relaxed) %
+                          NumCountStripes();
+  }
+  return thread_count_stripe;
+}
+
+void HdrHistogram::IncrementCountAtIndex(int index, int64_t count) {
+  Atomic64* stripes = count_stripes_.load(std::memory_order_acquire);
+  if (stripes == nullptr) {
+    // Uncontended fast path. A failed CAS means another thread is recording the same value at
+    // the same time, which is when sharing the counts array starts to hurt.
+    Atomic64 old_count = NoBarrier_Load(&counts_[index]);
+    if (PREDICT_TRUE(NoBarrier_CompareAndSwap(&counts_[index], old_count, old_count + count) ==
+                     old_count)) {
+      return;
+    }
+    AllocateCountStripes();
+    stripes = count_stripes_.load(std::memory_order_acquire);
+  }
+  NoBarrier_AtomicIncrement(&stripes[ThreadCountStripe() * counts_array_length_ + index], count);
+}
+
+uint64_t HdrHistogram::CountAtIndex(int index) const {
+  uint64_t result = NoBarrier_Load(&counts_[index]);
+  const Atomic64* stripes = count_stripes_.load(std::memory_order_acquire);
+  if (stripes != nullptr) {
+    const int num_stripes = NumCountStripes();
+    for (int i = 0; i < num_stripes; ++i) {
+      result += NoBarrier_Load(&stripes[i * counts_array_length_ + index]);
+    }
+  }
+  return result;
+}
+
+void HdrHistogram::AllocateCountStripes() {
+  if (count_stripes_.load(std::memory_order_acquire) != nullptr) {
+    return;
+  }
+  Atomic64* stripes = new Atomic64[NumCountStripes() * counts_array_length_]();
+  Atomic64* expected = nullptr;
+  if (!count_stripes_.compare_exchange_strong(expected, stripes, std::memory_order_acq_rel)) {
+    delete[] stripes;
+  }
+}
+
 ////////////////////////////////////
 
 int HdrHistogram::BucketIndex(uint64_t value) const {
@@ -240,7 +304,7 @@ int HdrHistogram::CountsArrayIndex(int bucket_index, int sub_bucket_index) const
 }
 
 uint64_t HdrHistogram::CountAt(int bucket_index, int sub_bucket_index) const {
-  return counts_[CountsArrayIndex(bucket_index, sub_bucket_index)];
+  return CountAtIndex(CountsArrayIndex(bucket_index, sub_bucket_index));
 }
 
 uint64_t HdrHistogram::CountInBucketForValue(uint64_t value) const {
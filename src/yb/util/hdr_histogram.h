@@ -58,9 +58,12 @@
 
 #include <stdint.h>
 
+#include <atomic>
+
 #include "yb/gutil/atomicops.h"
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/util/status.h"
+#include "yb/util/striped64.h"
 
 namespace yb {
 
@@ -78,6 +81,12 @@ class RecordedValuesIterator;
 // precision, then you will get about 10^3 sub-buckets (as a power of 2) for
 // each level of magnitude. Magnitude buckets are tracked in powers of 2.
 //
+// Writers on many cores would otherwise bounce the cache lines holding the total count and
+// sum, so those are LongAdders. The counts array starts out shared as well; the first time two
+// threads collide on the same count, the histogram allocates a few per-thread stripes of counts
+// and records into those from then on. Readers merge all stripes, so a copy-constructed
+// snapshot is a plain single-stripe histogram.
+//
 // This class is thread-safe.
 class HdrHistogram {
  public:
@@ -89,6 +98,8 @@ class HdrHistogram {
   // Copy-construct a (non-consistent) snapshot of other.
   explicit HdrHistogram(const HdrHistogram& other);
 
+  ~HdrHistogram();
+
   // Validate your params before trying to construct the object.
   static bool IsValidHighestTrackableValue(uint64_t highest_trackable_value);
   static bool IsValidNumSignificantDigits(int num_significant_digits);
@@ -113,10 +124,10 @@ class HdrHistogram {
   int SubBucketIndex(uint64_t value, int bucket_index) const;
 
   // Count of all events recorded.
-  uint64_t TotalCount() const { return base::subtle::NoBarrier_Load(&total_count_); }
+  uint64_t TotalCount() const { return total_count_.Value(); }
 
   // Sum of all events recorded.
-  uint64_t TotalSum() const { return base::subtle::NoBarrier_Load(&total_sum_); }
+  uint64_t TotalSum() const { return total_sum_.Value(); }
 
   // Return number of items at index.
   uint64_t CountAt(int bucket_index, int sub_bucket_index) const;
@@ -183,9 +194,26 @@ class HdrHistogram {
   static const int kMinValidNumSignificantDigits = 1;
   static const int kMaxValidNumSignificantDigits = 5;
 
+  // Upper bound on the number of count stripes, to bound the memory of contended histograms.
+  static const int kMaxCountStripes = 8;
+
   void Init();
   int CountsArrayIndex(int bucket_index, int sub_bucket_index) const;
 
+  // Add count to the counts array entry at index, in the calling thread's stripe if the
+  // histogram is striped.
+  void IncrementCountAtIndex(int index, int64_t count);
+
+  // Sum of the counts array entry at index over all stripes.
+  uint64_t CountAtIndex(int index) const;
+
+  // Allocate the count stripes, unless another thread already did.
+  void AllocateCountStripes();
+
+  // Number of count stripes of striped histograms, and the stripe used by the calling thread.
+  static int NumCountStripes();
+  static int ThreadCountStripe();
+
   uint64_t highest_trackable_value_;
   int num_significant_digits_;
   int counts_array_length_;
@@ -198,12 +226,15 @@ class HdrHistogram {
   uint32_t sub_bucket_mask_;
 
   // Also hot.
-  base::subtle::Atomic64 total_count_;
-  base::subtle::Atomic64 total_sum_;
+  LongAdder total_count_;
+  LongAdder total_sum_;
   base::subtle::Atomic64 min_value_;
   base::subtle::Atomic64 max_value_;
   gscoped_array<base::subtle::Atomic64> counts_;
 
+  // NumCountStripes() consecutive copies of the counts array, or null until writers contend.
+  std::atomic<base::subtle::Atomic64*> count_stripes_;
+
   HdrHistogram& operator=(const HdrHistogram& other); // Disable assignment operator.
 };
 
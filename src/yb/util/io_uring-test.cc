@@ -0,0 +1,113 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "yb/util/io_uring.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+
+class IoUringTest : public YBTest {
+};
+
+TEST_F(IoUringTest, WriteSyncAndRead) {
+  std::unique_ptr<IoUring> ring;
+  Status s = IoUring::Create(8, &ring);
+  if (s.IsNotSupported()) {
+    LOG(INFO) << "Skipping test: " << s;
+    return;
+  }
+  ASSERT_OK(s);
+  ASSERT_GE(ring->capacity(), 8U);
+
+  const std::string path = GetTestPath("io_uring_file");
+  const int fd = open(path.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+  ASSERT_GE(fd, 0);
+
+  // Two writes followed by a draining fsync, in one submission.
+  std::string first(4096, 'a');
+  std::string second(100, 'b');
+  struct iovec write_iov[2] = {{&first[0], first.size()}, {&second[0], second.size()}};
+  ASSERT_TRUE(ring->PrepareWritev(fd, &write_iov[0], 1, 0, 1));
+  ASSERT_TRUE(ring->PrepareWritev(fd, &write_iov[1], 1, first.size(), 2));
+  ASSERT_TRUE(ring->PrepareFsync(fd, true /* datasync */, true /* drain */, 3));
+  ASSERT_OK(ring->Submit(3));
+  std::vector<int32_t> results(4, -1);
+  uint64_t user_data = 0;
+  int32_t result = 0;
+  while (ring->PopCompletion(&user_data, &result)) {
+    ASSERT_LT(user_data, results.size());
+    results[user_data] = result;
+  }
+  ASSERT_EQ(0U, ring->in_flight());
+  ASSERT_EQ(static_cast<int32_t>(first.size()), results[1]);
+  ASSERT_EQ(static_cast<int32_t>(second.size()), results[2]);
+  ASSERT_EQ(0, results[3]);
+
+  // Batched reads, including one past the end of the file.
+  std::vector<std::string> buffers(3, std::string(100, '\0'));
+  const std::vector<uint64_t> offsets = {0, first.size(), first.size() + second.size()};
+  std::vector<struct iovec> read_iov(buffers.size());
+  for (size_t i = 0; i < buffers.size(); i++) {
+    read_iov[i] = {&buffers[i][0], buffers[i].size()};
+    ASSERT_TRUE(ring->PrepareReadv(fd, &read_iov[i], 1, offsets[i], i));
+  }
+  ASSERT_OK(ring->Submit(buffers.size()));
+  results.assign(buffers.size(), -1);
+  while (ring->PopCompletion(&user_data, &result)) {
+    results[user_data] = result;
+  }
+  ASSERT_EQ(100, results[0]);
+  ASSERT_EQ(std::string(100, 'a'), buffers[0]);
+  ASSERT_EQ(100, results[1]);
+  ASSERT_EQ(second, buffers[1]);
+  ASSERT_EQ(0, results[2]);
+
+  // A failed request reports the error of its system call.
+  ASSERT_TRUE(ring->PrepareReadv(-1, &read_iov[0], 1, 0, 0));
+  ASSERT_OK(ring->Submit(1));
+  ASSERT_TRUE(ring->PopCompletion(&user_data, &result));
+  ASSERT_EQ(-EBADF, result);
+
+  close(fd);
+}
+
+TEST_F(IoUringTest, FullQueue) {
+  std::unique_ptr<IoUring> ring;
+  Status s = IoUring::Create(2, &ring);
+  if (s.IsNotSupported()) {
+    LOG(INFO) << "Skipping test: " << s;
+    return;
+  }
+  ASSERT_OK(s);
+  const int fd = open("/dev/null", O_RDONLY);
+  ASSERT_GE(fd, 0);
+  char buf[1];
+  struct iovec iov = {buf, sizeof(buf)};
+  size_t queued = 0;
+  while (ring->PrepareReadv(fd, &iov, 1, 0, queued)) {
+    queued++;
+  }
+  ASSERT_EQ(ring->capacity(), queued);
+  ASSERT_OK(ring->Drain());
+  ASSERT_EQ(0U, ring->in_flight());
+  close(fd);
+}
+
+} // namespace yb
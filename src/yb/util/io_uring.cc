@@ -0,0 +1,399 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/io_uring.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define YB_HAVE_IO_URING 1
+#endif
+#endif
+
+#ifdef YB_HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+
+#include <boost/thread/tss.hpp>
+#include <gflags/gflags.h>
+
+#include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/monotime.h"
+
+DEFINE_bool(use_io_uring, false,
+            "Use Linux io_uring for batched reads of RocksDB data blocks, when supported by the "
+            "kernel. Otherwise, blocking system calls are used.");
+TAG_FLAG(use_io_uring, experimental);
+
+DEFINE_test_flag(bool, simulate_io_uring_unsupported, false,
+                 "Behave as if the system did not support io_uring.");
+
+#ifdef YB_HAVE_IO_URING
+// The system call numbers are the same on all architectures, but may be missing from old headers.
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#endif
+
+namespace yb {
+
+namespace {
+
+// Size of the ring of each thread, i.e. the number of reads one batched submission may hold.
+constexpr uint32_t kThreadRingEntries = 64;
+
+// Set once creating a ring failed, so that the system is not probed again.
+std::atomic<bool> io_uring_unsupported{false};
+
+#if __clang__ and __clang_major__ < 8
+boost::thread_specific_ptr<IoUring> thread_local_ring;
+#else
+thread_local std::unique_ptr<IoUring> thread_local_ring;
+#endif
+
+} // namespace
+
+#ifdef YB_HAVE_IO_URING
+
+class IoUring::Impl {
+ public:
+  ~Impl() {
+    if (sqes_ != nullptr) {
+      munmap(sqes_, sqes_size_);
+    }
+    if (cq_ring_ != nullptr) {
+      munmap(cq_ring_, cq_ring_size_);
+    }
+    if (sq_ring_ != nullptr) {
+      munmap(sq_ring_, sq_ring_size_);
+    }
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  Status Init(uint32_t entries, uint32_t* sq_entries) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    fd_ = syscall(__NR_io_uring_setup, entries, &params);
+    if (fd_ < 0) {
+      const int err = errno;
+      if (err == ENOSYS || err == EPERM) {
+        return STATUS(NotSupported, "io_uring is not supported", ErrnoToString(err), err);
+      }
+      return STATUS(IOError, "io_uring_setup failed", ErrnoToString(err), err);
+    }
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    RETURN_NOT_OK(Map(sq_ring_size_, IORING_OFF_SQ_RING, &sq_ring_));
+    RETURN_NOT_OK(Map(cq_ring_size_, IORING_OFF_CQ_RING, &cq_ring_));
+    void* sqes = nullptr;
+    RETURN_NOT_OK(Map(sqes_size_, IORING_OFF_SQES, &sqes));
+    sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+
+    char* sq = static_cast<char*>(sq_ring_);
+    sq_head_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    char* cq = static_cast<char*>(cq_ring_);
+    cq_head_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    sq_entries_ = params.sq_entries;
+    local_tail_ = *sq_tail_;
+    submitted_tail_ = local_tail_;
+    *sq_entries = sq_entries_;
+    return Status::OK();
+  }
+
+  // Returns the next free submission queue entry, cleared, or nullptr if the queue is full.
+  struct io_uring_sqe* NextSqe() {
+    const uint32_t head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (local_tail_ - head >= sq_entries_) {
+      return nullptr;
+    }
+    const uint32_t index = local_tail_ & sq_mask_;
+    struct io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    local_tail_++;
+    return sqe;
+  }
+
+  // Hands the queued entries to the kernel. The kernel may take only some of them, e.g. when it
+  // is short of memory, and then does not wait for completions, so the rest is submitted again.
+  // "submitted" is set to the number of entries the kernel took, also when this fails, in which
+  // case the entries it did not take are dropped.
+  Status Enter(uint32_t wait_nr, uint32_t* submitted) {
+    __atomic_store_n(sq_tail_, local_tail_, __ATOMIC_RELEASE);
+    const unsigned flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+    *submitted = 0;
+    for (;;) {
+      const uint32_t to_submit = local_tail_ - submitted_tail_;
+      const int result = syscall(
+          __NR_io_uring_enter, fd_, to_submit, wait_nr, flags, nullptr, 0);
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        const int err = errno;
+        DropUnsubmitted();
+        return STATUS(IOError, "io_uring_enter failed", ErrnoToString(err), err);
+      }
+      submitted_tail_ += result;
+      *submitted += result;
+      if (static_cast<uint32_t>(result) >= to_submit) {
+        return Status::OK();
+      }
+      if (result == 0) {
+        DropUnsubmitted();
+        return STATUS_FORMAT(IOError, "io_uring_enter submitted none of $0 requests", to_submit);
+      }
+    }
+  }
+
+  bool PopCompletion(uint64_t* user_data, int32_t* result) {
+    const uint32_t head = *cq_head_;
+    if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+      return false;
+    }
+    const struct io_uring_cqe& cqe = cqes_[head & cq_mask_];
+    *user_data = cqe.user_data;
+    *result = cqe.res;
+    __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+ private:
+  // Takes back the entries the kernel has not consumed, so that their buffers are not used after
+  // the caller gave up on them. The kernel only consumes entries in io_uring_enter, as the ring is
+  // set up without a polling thread.
+  void DropUnsubmitted() {
+    local_tail_ = submitted_tail_;
+    __atomic_store_n(sq_tail_, local_tail_, __ATOMIC_RELEASE);
+  }
+
+  Status Map(size_t size, off_t offset, void** result) {
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                     offset);
+    if (ptr == MAP_FAILED) {
+      const int err = errno;
+      return STATUS(IOError, "Failed to map io_uring", ErrnoToString(err), err);
+    }
+    *result = ptr;
+    return Status::OK();
+  }
+
+  int fd_ = -1;
+  void* sq_ring_ = nullptr;
+  void* cq_ring_ = nullptr;
+  struct io_uring_sqe* sqes_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  size_t cq_ring_size_ = 0;
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  struct io_uring_cqe* cqes_ = nullptr;
+
+  // Tail of the entries queued locally, and of the entries handed to the kernel.
+  uint32_t local_tail_ = 0;
+  uint32_t submitted_tail_ = 0;
+};
+
+Status IoUring::Create(uint32_t entries, std::unique_ptr<IoUring>* ring) {
+  std::unique_ptr<IoUring> result(new IoUring());
+  result->impl_.reset(new Impl());
+  RETURN_NOT_OK(result->impl_->Init(entries, &result->sq_entries_));
+  *ring = std::move(result);
+  return Status::OK();
+}
+
+bool IoUring::PrepareReadv(int fd, const struct iovec* iov, int iovcnt, uint64_t offset,
+                           uint64_t user_data) {
+  struct io_uring_sqe* sqe = impl_->NextSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_READV;
+  sqe->fd = fd;
+  sqe->off = offset;
+  sqe->addr = reinterpret_cast<uint64_t>(iov);
+  sqe->len = iovcnt;
+  sqe->user_data = user_data;
+  queued_++;
+  return true;
+}
+
+bool IoUring::PrepareWritev(int fd, const struct iovec* iov, int iovcnt, uint64_t offset,
+                            uint64_t user_data) {
+  struct io_uring_sqe* sqe = impl_->NextSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_WRITEV;
+  sqe->fd = fd;
+  sqe->off = offset;
+  sqe->addr = reinterpret_cast<uint64_t>(iov);
+  sqe->len = iovcnt;
+  sqe->user_data = user_data;
+  queued_++;
+  return true;
+}
+
+bool IoUring::PrepareFsync(int fd, bool datasync, bool drain, uint64_t user_data) {
+  struct io_uring_sqe* sqe = impl_->NextSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_FSYNC;
+  sqe->fd = fd;
+  sqe->fsync_flags = datasync ? IORING_FSYNC_DATASYNC : 0;
+  sqe->flags = drain ? IOSQE_IO_DRAIN : 0;
+  sqe->user_data = user_data;
+  queued_++;
+  return true;
+}
+
+Status IoUring::Submit(uint32_t wait_nr) {
+  uint32_t submitted = 0;
+  const Status s = impl_->Enter(wait_nr, &submitted);
+  // On failure, the requests the kernel did not take are dropped.
+  DCHECK_LE(submitted, queued_);
+  queued_ = 0;
+  in_flight_ += submitted;
+  return s;
+}
+
+bool IoUring::PopCompletion(uint64_t* user_data, int32_t* result) {
+  if (!impl_->PopCompletion(user_data, result)) {
+    return false;
+  }
+  DCHECK_GT(in_flight_, 0);
+  in_flight_--;
+  return true;
+}
+
+#else
+
+class IoUring::Impl {
+};
+
+Status IoUring::Create(uint32_t entries, std::unique_ptr<IoUring>* ring) {
+  return STATUS(NotSupported, "io_uring is not supported by this build");
+}
+
+bool IoUring::PrepareReadv(int fd, const struct iovec* iov, int iovcnt, uint64_t offset,
+                           uint64_t user_data) {
+  return false;
+}
+
+bool IoUring::PrepareWritev(int fd, const struct iovec* iov, int iovcnt, uint64_t offset,
+                            uint64_t user_data) {
+  return false;
+}
+
+bool IoUring::PrepareFsync(int fd, bool datasync, bool drain, uint64_t user_data) {
+  return false;
+}
+
+Status IoUring::Submit(uint32_t wait_nr) {
+  return STATUS(NotSupported, "io_uring is not supported by this build");
+}
+
+bool IoUring::PopCompletion(uint64_t* user_data, int32_t* result) {
+  return false;
+}
+
+#endif // YB_HAVE_IO_URING
+
+IoUring::IoUring() {
+}
+
+IoUring::~IoUring() {
+  WARN_NOT_OK(Drain(), "Failed to wait for io_uring requests");
+}
+
+Status IoUring::Drain() {
+  // Requests the kernel took before a failed submission are still in flight.
+  Status result = queued_ > 0 ? Submit() : Status::OK();
+  while (in_flight_ > 0) {
+    uint64_t user_data = 0;
+    int32_t res = 0;
+    if (!PopCompletion(&user_data, &res)) {
+      // The kernel may still write into the buffers of the requests in flight, so keep waiting
+      // for them even if waiting fails, e.g. with EAGAIN when the kernel is short of resources.
+      const Status s = Submit(1);
+      if (!s.ok()) {
+        if (result.ok()) {
+          LOG(WARNING) << "Failed to wait for " << in_flight_ << " io_uring requests, retrying: "
+                       << s;
+          result = s;
+        }
+        SleepFor(MonoDelta::FromMilliseconds(1));
+      }
+      continue;
+    }
+    if (res < 0 && result.ok()) {
+      result = STATUS(IOError, "io_uring request failed", ErrnoToString(-res), -res);
+    }
+  }
+  return result;
+}
+
+bool IoUring::Enabled() {
+  return FLAGS_use_io_uring && !FLAGS_simulate_io_uring_unsupported &&
+         !io_uring_unsupported.load(std::memory_order_relaxed);
+}
+
+IoUring* IoUring::ForCurrentThread() {
+  if (!Enabled()) {
+    return nullptr;
+  }
+  auto* result = thread_local_ring.get();
+  if (result != nullptr) {
+    return result;
+  }
+  std::unique_ptr<IoUring> ring;
+  const Status s = Create(kThreadRingEntries, &ring);
+  if (!s.ok()) {
+    if (!io_uring_unsupported.exchange(true)) {
+      LOG(WARNING) << "Falling back to blocking I/O, failed to create io_uring: " << s;
+    }
+    return nullptr;
+  }
+  thread_local_ring.reset(result = ring.release());
+  return result;
+}
+
+} // namespace yb
@@ -0,0 +1,85 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+// A minimal wrapper over the Linux io_uring asynchronous I/O interface, used through the raw system
+// calls. Requests are queued with Prepare*() calls, handed to the kernel by one Submit() call, and
+// their results collected with PopCompletion().
+//
+#ifndef YB_UTIL_IO_URING_H
+#define YB_UTIL_IO_URING_H
+
+#include <sys/uio.h>
+
+#include <memory>
+
+#include "yb/util/status.h"
+
+namespace yb {
+
+class IoUring {
+ public:
+  // Creates a ring that holds up to "entries" queued requests. Fails with NotSupported if the
+  // kernel or the build do not support io_uring.
+  static CHECKED_STATUS Create(uint32_t entries, std::unique_ptr<IoUring>* ring);
+
+  // Returns whether io_uring is enabled by --use_io_uring and supported by the system.
+  static bool Enabled();
+
+  // Returns the ring of the calling thread, creating it on first use, or nullptr if io_uring is
+  // not enabled.
+  static IoUring* ForCurrentThread();
+
+  ~IoUring();
+
+  // Number of requests the submission queue holds.
+  uint32_t capacity() const { return sq_entries_; }
+
+  // Number of requests submitted whose completion has not been popped yet.
+  uint32_t in_flight() const { return in_flight_; }
+
+  // Queue a vectored read or write at "offset" of "fd", or an fsync of "fd". The iovecs must stay
+  // valid until the request completes. With "drain", the request starts only after all requests
+  // queued before it have completed. Each returns false if the submission queue is full.
+  bool PrepareReadv(int fd, const struct iovec* iov, int iovcnt, uint64_t offset,
+                    uint64_t user_data);
+  bool PrepareWritev(int fd, const struct iovec* iov, int iovcnt, uint64_t offset,
+                     uint64_t user_data);
+  bool PrepareFsync(int fd, bool datasync, bool drain, uint64_t user_data);
+
+  // Submit the queued requests and wait until at least "wait_nr" completions are available. On
+  // failure, the requests that were not taken by the kernel are dropped, while the ones it took
+  // are still in flight.
+  CHECKED_STATUS Submit(uint32_t wait_nr = 0);
+
+  // Pop one available completion. "result" is set to the result of the system call the request
+  // stands for, or to -errno if it failed. Returns false if no completion is available.
+  bool PopCompletion(uint64_t* user_data, int32_t* result);
+
+  // Wait for all the requests in flight to complete, discarding their completions. Does not return
+  // before they did, even if waiting fails, so that their buffers can be reused afterwards. Returns
+  // the first error one of them, or waiting for them, failed with.
+  CHECKED_STATUS Drain();
+
+ private:
+  class Impl;
+
+  IoUring();
+
+  std::unique_ptr<Impl> impl_;
+  uint32_t sq_entries_ = 0;
+  uint32_t queued_ = 0;
+  uint32_t in_flight_ = 0;
+};
+
+} // namespace yb
+
+#endif // YB_UTIL_IO_URING_H
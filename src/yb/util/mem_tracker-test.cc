@@ -40,9 +40,13 @@
 #include <boost/bind.hpp>
 #include <gperftools/malloc_extension.h>
 
+#include "yb/gutil/strings/substitute.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/test_util.h"
+#include "yb/util/thread.h"
 
 DECLARE_int32(memory_limit_soft_percentage);
+DECLARE_int64(mem_tracker_update_batch_bytes);
 
 namespace yb {
 
@@ -352,4 +356,127 @@ TEST(MemTrackerTest, UnregisterFromParent) {
   c->UnregisterFromParent();
 }
 
+TEST(MemTrackerTest, ConsumptionBatching) {
+  FLAGS_mem_tracker_update_batch_bytes = 100;
+  shared_ptr<MemTracker> p = MemTracker::CreateTracker(-1, "p");
+  shared_ptr<MemTracker> c = MemTracker::CreateTracker(-1, "c", p);
+  c->EnableConsumptionBatching();
+
+  // The child is exact, the parent only sees the change once the batch is full.
+  c->Consume(60);
+  EXPECT_EQ(60, c->consumption());
+  EXPECT_EQ(0, p->consumption());
+  c->Consume(60);
+  EXPECT_EQ(120, c->consumption());
+  EXPECT_EQ(120, p->consumption());
+  c->Release(30);
+  EXPECT_EQ(90, c->consumption());
+  EXPECT_EQ(120, p->consumption());
+  c->Release(90);
+  EXPECT_EQ(0, c->consumption());
+  EXPECT_EQ(0, p->consumption());
+
+  // Changes still pending are applied to the parent when the child goes away.
+  c->Consume(10);
+  EXPECT_EQ(0, p->consumption());
+  c->Release(10);
+  c.reset();
+  EXPECT_EQ(0, p->consumption());
+}
+
+// TryConsume() is exact, so with batched releases the ancestors can only over-count, which keeps
+// their limits conservative.
+TEST(MemTrackerTest, ConsumptionBatchingWithTryConsume) {
+  FLAGS_mem_tracker_update_batch_bytes = 100;
+  shared_ptr<MemTracker> p = MemTracker::CreateTracker(150, "p");
+  shared_ptr<MemTracker> c = MemTracker::CreateTracker(100, "c", p);
+  c->EnableConsumptionBatching();
+
+  ASSERT_TRUE(c->TryConsume(60));
+  EXPECT_EQ(60, c->consumption());
+  EXPECT_EQ(60, p->consumption());
+  c->Release(60);
+  EXPECT_EQ(0, c->consumption());
+  EXPECT_EQ(60, p->consumption());
+
+  // The pending release still counts against the parent limit.
+  ASSERT_FALSE(c->TryConsume(100));
+  ASSERT_TRUE(c->TryConsume(90));
+  EXPECT_EQ(150, p->consumption());
+  c->Release(90);
+  EXPECT_EQ(0, c->consumption());
+  EXPECT_EQ(0, p->consumption());
+}
+
+// Batching a parent shared by many children keeps the children and the parent exact, and bounds the
+// lag of the grandparent regardless of the number of children.
+TEST(MemTrackerTest, ConsumptionBatchingOnSharedParent) {
+  FLAGS_mem_tracker_update_batch_bytes = 100;
+  const int kNumChildren = 10;
+  shared_ptr<MemTracker> gp = MemTracker::CreateTracker(-1, "gp");
+  shared_ptr<MemTracker> p = MemTracker::CreateTracker(-1, "p", gp);
+  p->EnableConsumptionBatching();
+  vector<shared_ptr<MemTracker>> children;
+  for (int i = 0; i < kNumChildren; ++i) {
+    children.push_back(MemTracker::CreateTracker(-1, strings::Substitute("c$0", i), p));
+  }
+
+  for (const auto& c : children) {
+    c->Consume(60);
+    EXPECT_EQ(60, c->consumption());
+  }
+  EXPECT_EQ(60 * kNumChildren, p->consumption());
+  // All the children share the stripe of this thread, so only the last change is still pending.
+  EXPECT_GE(gp->consumption(), 60 * kNumChildren - 100);
+  EXPECT_LE(gp->consumption(), 60 * kNumChildren);
+
+  for (const auto& c : children) {
+    c->Release(60);
+  }
+  EXPECT_EQ(0, p->consumption());
+  EXPECT_LE(std::abs(gp->consumption()), 100);
+  children.clear();
+  p.reset();
+  EXPECT_EQ(0, gp->consumption());
+}
+
+// Many threads consuming and releasing small amounts against trackers sharing the same parent,
+// with and without consumption batching.
+TEST(MemTrackerTest, BenchmarkConcurrentConsume) {
+  const int kNumThreads = 16;
+  const int kIterations = 200000;
+  FLAGS_mem_tracker_update_batch_bytes = 64 * 1024;
+
+  for (bool batching : {false, true}) {
+    shared_ptr<MemTracker> p = MemTracker::CreateTracker(-1, "p");
+    shared_ptr<MemTracker> c = MemTracker::CreateTracker(-1, "c", p);
+    if (batching) {
+      c->EnableConsumptionBatching();
+    }
+
+    Stopwatch sw(Stopwatch::ALL_THREADS);
+    sw.start();
+    vector<scoped_refptr<Thread>> threads(kNumThreads);
+    for (int i = 0; i < kNumThreads; ++i) {
+      ASSERT_OK(Thread::Create("test", strings::Substitute("thread-$0", i),
+          [c]() {
+            for (int j = 0; j < kIterations; ++j) {
+              c->Consume(64);
+              c->Release(64);
+            }
+          }, &threads[i]));
+    }
+    for (const auto& thread : threads) {
+      ASSERT_OK(ThreadJoiner(thread.get()).Join());
+    }
+    sw.stop();
+
+    ASSERT_EQ(0, c->consumption());
+    LOG(INFO) << (batching ? "Batched" : "Unbatched") << " consumption: "
+              << kNumThreads * kIterations * 2 << " updates in " << sw.elapsed().ToString();
+    c.reset();
+    ASSERT_EQ(0, p->consumption());
+  }
+}
+
 } // namespace yb
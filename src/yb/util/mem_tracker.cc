@@ -33,6 +33,7 @@
 #include "yb/util/mem_tracker.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <deque>
 #include <limits>
 #include <list>
@@ -89,6 +90,12 @@ TAG_FLAG(tcmalloc_max_free_bytes_percentage, advanced);
 DEFINE_bool(mem_tracker_logging, false,
             "Enable logging of memory tracker consume/release operations");
 
+DEFINE_int64(mem_tracker_update_batch_bytes, 64 * 1024,
+             "For memory trackers with consumption batching enabled, the number of bytes each "
+             "thread may consume or release before the change is applied to the ancestor "
+             "trackers.");
+TAG_FLAG(mem_tracker_update_batch_bytes, advanced);
+
 DEFINE_bool(mem_tracker_log_stack_trace, false,
             "Enable logging of stack traces on memory tracker consume/release operations. "
             "Only takes effect if mem_tracker_logging is also enabled.");
@@ -107,6 +114,8 @@ using std::vector;
 
 using strings::Substitute;
 
+using striped64::internal::Cell;
+
 // The ancestor for all trackers. Every tracker is visible from the root down.
 static shared_ptr<MemTracker> root_tracker;
 static GoogleOnceType root_tracker_once = GOOGLE_ONCE_INIT;
@@ -115,6 +124,10 @@ static GoogleOnceType root_tracker_once = GOOGLE_ONCE_INIT;
 // is greater than GC_RELEASE_SIZE, this will trigger a tcmalloc gc.
 static Atomic64 released_memory_since_gc;
 
+// Threads are assigned pending consumption stripes round-robin, on first use.
+static std::atomic<uint32_t> next_pending_stripe{0};
+static __thread int32_t thread_pending_stripe = -1;
+
 // Validate that various flags are percentages.
 static bool ValidatePercentage(const char* flagname, int value) {
   if (value >= 0 && value <= 100) {
@@ -200,6 +213,9 @@ MemTracker::MemTracker(ConsumptionFunction consumption_func, int64_t byte_limit,
 
 MemTracker::~MemTracker() {
   VLOG(1) << "Destroying tracker " << ToString();
+  FlushPendingConsumption();
+  // Cell is a POD, so no need to destruct each one.
+  free(pending_.load(std::memory_order_acquire));
   if (parent_) {
     DCHECK(consumption() == 0) << "Memory tracker " << ToString()
         << " has unreleased consumption " << consumption();
@@ -311,12 +327,7 @@ void MemTracker::Consume(int64_t bytes) {
   if (PREDICT_FALSE(enable_logging_)) {
     LogUpdate(true, bytes);
   }
-  for (auto& tracker : all_trackers_) {
-    tracker->consumption_.IncrementBy(bytes);
-    if (tracker->consumption_func_) {
-      DCHECK_GE(tracker->consumption_.current_value(), 0);
-    }
-  }
+  UpdateAllTrackers(bytes);
 }
 
 bool MemTracker::TryConsume(int64_t bytes) {
@@ -379,7 +390,10 @@ void MemTracker::Release(int64_t bytes) {
     return;
   }
 
-  if (PREDICT_FALSE(base::subtle::Barrier_AtomicIncrement(&released_memory_since_gc, bytes) >
+  // Batched trackers count released memory when they apply it, to not touch the shared counter
+  // on every call.
+  if (pending_.load(std::memory_order_acquire) == nullptr &&
+      PREDICT_FALSE(base::subtle::Barrier_AtomicIncrement(&released_memory_since_gc, bytes) >
                     GC_RELEASE_SIZE)) {
     GcTcmalloc();
   }
@@ -395,9 +409,31 @@ void MemTracker::Release(int64_t bytes) {
   if (PREDICT_FALSE(enable_logging_)) {
     LogUpdate(false, bytes);
   }
+  UpdateAllTrackers(-bytes);
+}
 
-  for (auto& tracker : all_trackers_) {
-    tracker->consumption_.IncrementBy(-bytes);
+void MemTracker::EnableConsumptionBatching() {
+  if (consumption_func_ || pending_.load(std::memory_order_acquire) != nullptr) {
+    return;
+  }
+  void* buffer = nullptr;
+  int err = posix_memalign(&buffer, CACHELINE_SIZE, sizeof(Cell) * kNumPendingStripes);
+  CHECK_EQ(0, err) << "error calling posix_memalign";
+  Cell* cells = new (buffer) Cell[kNumPendingStripes];
+  Cell* expected = nullptr;
+  if (!pending_.compare_exchange_strong(expected, cells, std::memory_order_acq_rel)) {
+    free(buffer);
+  }
+}
+
+void MemTracker::UpdateAllTrackers(int64_t bytes) {
+  UpdateTrackersFrom(0, bytes);
+}
+
+void MemTracker::UpdateTrackersFrom(size_t first, int64_t bytes) {
+  for (size_t i = first; i < all_trackers_.size(); ++i) {
+    MemTracker* tracker = all_trackers_[i];
+    tracker->consumption_.IncrementBy(bytes);
     // If a UDF calls FunctionContext::TrackAllocation() but allocates less than the
     // reported amount, the subsequent call to FunctionContext::Free() may cause the
     // process mem tracker to go negative until it is synced back to the tcmalloc
@@ -407,6 +443,46 @@ void MemTracker::Release(int64_t bytes) {
     if (tracker->consumption_func_) {
       DCHECK_GE(tracker->consumption_.current_value(), 0);
     }
+
+    // The ancestors of a batched tracker are only updated once the stripe of the calling thread
+    // is full, whichever descendant the change comes from.
+    Cell* pending = tracker->pending_.load(std::memory_order_acquire);
+    if (pending == nullptr || i + 1 == all_trackers_.size()) {
+      continue;
+    }
+    if (PREDICT_FALSE(thread_pending_stripe < 0)) {
+      thread_pending_stripe = next_pending_stripe.fetch_add(1, std::memory_order_relaxed) %
+                              kNumPendingStripes;
+    }
+    Cell& cell = pending[thread_pending_stripe];
+    const int64_t accumulated = cell.value_.IncrementBy(bytes);
+    if (std::abs(accumulated) < FLAGS_mem_tracker_update_batch_bytes) {
+      return;
+    }
+    // Other threads sharing the stripe may have added to it in the meantime, take it all.
+    bytes = cell.value_.Exchange(0);
+    if (bytes == 0) {
+      return;
+    }
+    // Release() does not count the memory released through a batched tracker of its own.
+    if (i == 0 && bytes < 0 &&
+        base::subtle::Barrier_AtomicIncrement(&released_memory_since_gc, -bytes) >
+            GC_RELEASE_SIZE) {
+      GcTcmalloc();
+    }
+  }
+}
+
+void MemTracker::FlushPendingConsumption() {
+  Cell* pending = pending_.load(std::memory_order_acquire);
+  if (pending == nullptr) {
+    return;
+  }
+  for (int i = 0; i < kNumPendingStripes; ++i) {
+    const int64_t bytes = pending[i].value_.Exchange(0);
+    if (bytes != 0) {
+      UpdateTrackersFrom(1, bytes);
+    }
   }
 }
 
@@ -34,6 +34,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <functional>
 #include <list>
 #include <memory>
@@ -45,6 +46,7 @@
 #include "yb/util/locks.h"
 #include "yb/util/mutex.h"
 #include "yb/util/random.h"
+#include "yb/util/striped64.h"
 
 #include <gperftools/malloc_extension.h> // NOLINT
 
@@ -211,6 +213,19 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   // Decreases consumption of this tracker and its ancestors by 'bytes'.
   void Release(int64_t bytes);
 
+  // Batches the propagation of Consume() and Release() calls on this tracker and its descendants:
+  // threads accumulate their changes in per-thread stripes and apply them to this tracker's
+  // ancestors only once a stripe exceeds --mem_tracker_update_batch_bytes. consumption() of this
+  // tracker and its descendants remains exact, but its ancestors may lag behind by up to
+  // kNumPendingStripes times that amount.
+  //
+  // Meant for long-lived trackers updated with many small amounts from many threads, such as
+  // caches or the parent shared by the per-tablet trackers of a component. Enabling it on
+  // per-tablet trackers would make the lag grow with the number of tablets. TryConsume() is not
+  // batched, so when it is paired with batched releases the ancestors can only over-count. Has
+  // no effect on a tracker with a consumption function.
+  void EnableConsumptionBatching();
+
   // Returns true if a valid limit of this tracker or one of its ancestors is
   // exceeded.
   bool AnyLimitExceeded();
@@ -309,6 +324,17 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   // Further initializes the tracker.
   void Init();
 
+  // Adds 'bytes' to this tracker and its ancestors. The ancestors of a tracker with consumption
+  // batching enabled are updated through the calling thread's pending stripe.
+  void UpdateAllTrackers(int64_t bytes);
+
+  // Adds 'bytes' to all_trackers_ starting from the given index, stopping at the first tracker
+  // with consumption batching enabled whose pending stripe is not full yet.
+  void UpdateTrackersFrom(size_t first, int64_t bytes);
+
+  // Applies the changes accumulated in all pending stripes to the ancestors.
+  void FlushPendingConsumption();
+
   // Adds tracker to child_trackers_.
   //
   // child_trackers_lock_ must be held.
@@ -346,6 +372,9 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   // TODO: this is a stopgap.
   static const int64_t GC_RELEASE_SIZE = 128 * 1024L * 1024L;
 
+  // Number of pending stripes of a tracker with consumption batching enabled.
+  static const int kNumPendingStripes = 8;
+
   simple_spinlock gc_lock_;
 
   int64_t limit_;
@@ -356,6 +385,10 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
 
   HighWaterMark consumption_;
 
+  // kNumPendingStripes cache line aligned cells with the changes not yet applied to the
+  // ancestors, or null if consumption batching is disabled.
+  std::atomic<striped64::internal::Cell*> pending_{nullptr};
+
   ConsumptionFunction consumption_func_;
 
   // this tracker plus all of its ancestors
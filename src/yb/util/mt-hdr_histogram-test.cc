@@ -38,6 +38,7 @@
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/hdr_histogram.h"
 #include "yb/util/status.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/test_util.h"
 #include "yb/util/thread.h"
 
@@ -123,4 +124,38 @@ TEST_F(MtHdrHistogramTest, ConcurrentCopyWhileWritingTest) {
   delete[] threads;
 }
 
+// Measures recording from many threads at once, which is when counts are striped, and checks that
+// the stripes add up.
+TEST_F(MtHdrHistogramTest, BenchmarkConcurrentIncrements) {
+  HdrHistogram hist(60000000LU, 2);
+
+  Stopwatch sw(Stopwatch::ALL_THREADS);
+  sw.start();
+  auto threads = new scoped_refptr<yb::Thread>[num_threads_];
+  for (int i = 0; i < num_threads_; i++) {
+    // Latency-like values: most threads record the same few buckets.
+    CHECK_OK(yb::Thread::Create("test", strings::Substitute("thread-$0", i),
+        IncrementSameHistValue, &hist, 100 + i % 4, num_times_, &threads[i]));
+  }
+  for (int i = 0; i < num_threads_; i++) {
+    CHECK_OK(ThreadJoiner(threads[i].get()).Join());
+  }
+  sw.stop();
+  delete[] threads;
+
+  LOG(INFO) << num_threads_ * num_times_ << " concurrent increments in "
+            << sw.elapsed().ToString();
+
+  HdrHistogram snapshot(hist);
+  ASSERT_EQ(num_threads_ * num_times_, hist.TotalCount());
+  ASSERT_EQ(num_threads_ * num_times_, snapshot.TotalCount());
+  uint64_t total = 0;
+  for (uint64_t value = 100; value < 104; ++value) {
+    total += snapshot.CountInBucketForValue(value);
+  }
+  ASSERT_EQ(num_threads_ * num_times_, total);
+  ASSERT_EQ(100U, snapshot.MinValue());
+  ASSERT_EQ(103U, snapshot.MaxValue());
+}
+
 } // namespace yb
@@ -21,6 +21,9 @@
 
 #include <atomic>
 #include <string>
+#include <utility>
+
+#include "yb/util/slice.h"
 
 namespace yb {
 
@@ -53,7 +56,7 @@ class RefCntBuffer {
   ~RefCntBuffer();
 
   size_t size() const {
-    return size_reference();
+    return data_ != nullptr ? size_reference() : 0;
   }
 
   bool empty() const {
@@ -115,6 +118,55 @@ class RefCntBuffer {
   char *data_;
 };
 
+// Part of the data of a RefCntBuffer, that keeps the whole buffer alive. Used to hand over a piece
+// of a received message, e.g. an RPC sidecar, without copying it out of the message.
+class RefCntSlice {
+ public:
+  RefCntSlice() {}
+
+  // Implicit, so that a whole buffer could be used wherever a slice of one is expected.
+  RefCntSlice(RefCntBuffer holder) // NOLINT
+      : holder_(std::move(holder)),
+        slice_(holder_ ? Slice(holder_.udata(), holder_.size()) : Slice()) {}
+
+  // 'slice' must point into the data of 'holder'.
+  RefCntSlice(RefCntBuffer holder, const Slice& slice)
+      : holder_(std::move(holder)), slice_(slice) {}
+
+  char* data() const {
+    return const_cast<char*>(slice_.cdata());
+  }
+
+  const uint8_t* udata() const {
+    return slice_.data();
+  }
+
+  size_t size() const {
+    return slice_.size();
+  }
+
+  bool empty() const {
+    return slice_.empty();
+  }
+
+  const Slice& AsSlice() const {
+    return slice_;
+  }
+
+  const RefCntBuffer& holder() const {
+    return holder_;
+  }
+
+  void Reset() {
+    holder_.Reset();
+    slice_.clear();
+  }
+
+ private:
+  RefCntBuffer holder_;
+  Slice slice_;
+};
+
 } // namespace yb
 
 #endif // YB_UTIL_REF_CNT_BUFFER_H